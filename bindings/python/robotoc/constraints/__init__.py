@@ -9,6 +9,8 @@ from .joint_acceleration_upper_limit import *
 from .joint_torques_lower_limit import *
 from .joint_torques_upper_limit import *
 from .friction_cone import *
+from .soc_friction_cone import *
+from .collision_avoidance import *
 from .impulse_friction_cone import *
 from .wrench_friction_cone import *
 from .impulse_wrench_friction_cone import *
@@ -0,0 +1,33 @@
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+#include <pybind11/eigen.h>
+
+#include "robotoc/constraints/collision_avoidance.hpp"
+
+
+namespace robotoc {
+namespace python {
+
+namespace py = pybind11;
+
+PYBIND11_MODULE(collision_avoidance, m) {
+  py::class_<CollisionAvoidance, ConstraintComponentBase, 
+             std::shared_ptr<CollisionAvoidance>>(m, "CollisionAvoidance")
+    .def(py::init<const Robot&, const double, const double>(),
+          py::arg("robot"), py::arg("min_distance")=0.0, 
+          py::arg("activation_distance")=0.1)
+    .def("add_collision_sphere", &CollisionAvoidance::addCollisionSphere,
+          py::arg("frame_id"), py::arg("offset"), py::arg("radius"))
+    .def("add_obstacle_sphere", &CollisionAvoidance::addObstacleSphere,
+          py::arg("center"), py::arg("radius"))
+    .def("set_obstacle_position", &CollisionAvoidance::setObstaclePosition,
+          py::arg("sphere"), py::arg("center"))
+    .def("add_collision_pair", &CollisionAvoidance::addCollisionPair,
+          py::arg("sphere1"), py::arg("sphere2"))
+    .def("add_environment_collision_pairs", &CollisionAvoidance::addEnvironmentCollisionPairs)
+    .def("num_spheres", &CollisionAvoidance::numSpheres)
+    .def("num_collision_pairs", &CollisionAvoidance::numCollisionPairs);
+}
+
+} // namespace python
+} // namespace robotoc
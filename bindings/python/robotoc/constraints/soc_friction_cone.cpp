@@ -0,0 +1,26 @@
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+#include "robotoc/constraints/soc_friction_cone.hpp"
+
+
+namespace robotoc {
+namespace python {
+
+namespace py = pybind11;
+
+PYBIND11_MODULE(soc_friction_cone, m) {
+  py::class_<SOCFrictionCone, ConstraintComponentBase, 
+             std::shared_ptr<SOCFrictionCone>>(m, "SOCFrictionCone")
+    .def(py::init<const Robot&, const std::vector<double>&>(),
+          py::arg("robot"), py::arg("mu"))
+    .def(py::init<const Robot&, const double>(),
+          py::arg("robot"), py::arg("mu"))
+    .def("set_friction_coefficient", static_cast<void (SOCFrictionCone::*)(const std::vector<double>&)>(&SOCFrictionCone::setFrictionCoefficient),
+          py::arg("mu"))
+    .def("set_friction_coefficient", static_cast<void (SOCFrictionCone::*)(const double)>(&SOCFrictionCone::setFrictionCoefficient),
+          py::arg("mu"));
+}
+
+} // namespace python
+} // namespace robotoc
\ No newline at end of file
@@ -13,4 +13,5 @@ from .local_contact_force_cost import *
 from .periodic_swing_foot_ref import *
 from .periodic_com_ref import *
 from .discrete_time_swing_foot_ref import *
-from .discrete_time_com_ref import *
\ No newline at end of file
+from .discrete_time_com_ref import *
+from .terminal_lqr_cost import *
\ No newline at end of file
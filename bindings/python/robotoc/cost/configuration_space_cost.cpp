@@ -42,7 +42,9 @@ PYBIND11_MODULE(configuration_space_cost, m) {
     .def("set_v_weight_impulse", &ConfigurationSpaceCost::set_v_weight_impulse,
           py::arg("v_weight_impulse"))
     .def("set_dv_weight_impulse", &ConfigurationSpaceCost::set_dv_weight_impulse,
-          py::arg("dv_weight_impulse"));
+          py::arg("dv_weight_impulse"))
+    .def("set_small_angle_approximation", &ConfigurationSpaceCost::set_small_angle_approximation,
+          py::arg("small_angle_approximation"));
 }
 
 } // namespace python
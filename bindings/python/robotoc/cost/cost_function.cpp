@@ -1,4 +1,5 @@
 #include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
 
 #include "robotoc/cost/cost_function.hpp"
 
@@ -17,6 +18,11 @@ PYBIND11_MODULE(cost_function, m) {
           py::arg("discount_factor"), py::arg("discount_time_step"))
     .def("discount_factor", &CostFunction::discountFactor)
     .def("discount_time_step", &CostFunction::discountTimeStep)
+    .def("set_time_varying_weight", &CostFunction::setTimeVaryingWeight,
+          py::arg("elapsed_times"), py::arg("weights"))
+    .def("clear_time_varying_weight", &CostFunction::clearTimeVaryingWeight)
+    .def("weight", &CostFunction::weight,
+          py::arg("t0"), py::arg("t"))
     .def("push_back", &CostFunction::push_back)
     .def("clear", &CostFunction::clear)
     .def("create_cost_function_data", &CostFunction::createCostFunctionData,
@@ -0,0 +1,40 @@
+#include <pybind11/pybind11.h>
+#include <pybind11/eigen.h>
+#include <pybind11/numpy.h>
+
+#include "robotoc/cost/terminal_lqr_cost.hpp"
+
+
+namespace robotoc {
+namespace python {
+
+namespace py = pybind11;
+
+PYBIND11_MODULE(terminal_lqr_cost, m) {
+  py::class_<TerminalLQRCost, CostFunctionComponentBase,
+             std::shared_ptr<TerminalLQRCost>>(m, "TerminalLQRCost")
+    .def(py::init<const Robot&>(),
+          py::arg("robot"))
+    .def("set_riccati_iteration_options", &TerminalLQRCost::setRiccatiIterationOptions,
+          py::arg("max_iter"), py::arg("tol"))
+    .def("set_refresh_tolerance", &TerminalLQRCost::setRefreshTolerance,
+          py::arg("refresh_tol"))
+    .def("set_cost_to_go", &TerminalLQRCost::setCostToGo,
+          py::arg("P"), py::arg("q_ref"), py::arg("v_ref"))
+    .def("compute_cost_to_go", &TerminalLQRCost::computeCostToGo,
+          py::arg("robot"), py::arg("cost"), py::arg("constraints"), 
+          py::arg("contact_status"), py::arg("dt"), py::arg("s"))
+    .def("request_cost_to_go_update", &TerminalLQRCost::requestCostToGoUpdate,
+          py::arg("robot"), py::arg("cost"), py::arg("constraints"), 
+          py::arg("contact_status"), py::arg("dt"), py::arg("s"))
+    .def("synchronize", &TerminalLQRCost::synchronize,
+          py::arg("wait")=false)
+    .def("is_updating", &TerminalLQRCost::isUpdating)
+    .def("cost_to_go_hessian", &TerminalLQRCost::costToGoHessian)
+    .def("q_ref", &TerminalLQRCost::q_ref)
+    .def("v_ref", &TerminalLQRCost::v_ref)
+    .def("num_riccati_iterations", &TerminalLQRCost::numRiccatiIterations);
+}
+
+} // namespace python
+} // namespace robotoc
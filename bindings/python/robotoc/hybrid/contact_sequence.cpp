@@ -15,6 +15,9 @@ PYBIND11_MODULE(contact_sequence, m) {
   py::class_<ContactSequence, std::shared_ptr<ContactSequence>>(m, "ContactSequence")
     .def(py::init<const Robot&, const int>(),
          py::arg("robot"), py::arg("reserved_num_discrete_events")=0)
+    .def(py::init<const Robot&, const int, const int>(),
+         py::arg("robot"), py::arg("reserved_num_impulse_events"), 
+         py::arg("reserved_num_lift_events"))
     .def("init", &ContactSequence::init,
            py::arg("contact_status"))
     .def("push_back", static_cast<void (ContactSequence::*)(const DiscreteEvent&, const double, const bool)>(&ContactSequence::push_back),
@@ -54,9 +57,13 @@ PYBIND11_MODULE(contact_sequence, m) {
     .def("event_type", &ContactSequence::eventType,
           py::arg("event_index"))
     .def("event_times", &ContactSequence::eventTimes)
-    .def("reserve", &ContactSequence::reserve,
+    .def("reserve", static_cast<void (ContactSequence::*)(const int)>(&ContactSequence::reserve),
          py::arg("reserved_num_discrete_events"))
+    .def("reserve", static_cast<void (ContactSequence::*)(const int, const int)>(&ContactSequence::reserve),
+         py::arg("reserved_num_impulse_events"), py::arg("reserved_num_lift_events"))
     .def("reserved_num_discrete_events", &ContactSequence::reservedNumDiscreteEvents)
+    .def("reserved_num_impulse_events", &ContactSequence::reservedNumImpulseEvents)
+    .def("reserved_num_lift_events", &ContactSequence::reservedNumLiftEvents)
     .def("__str__", [](const ContactSequence& self) {
         std::stringstream ss;
         ss << self;
@@ -13,4 +13,5 @@ from .mpc_crawl import *
 from .mpc_pace import *
 from .mpc_biped_walk import *
 from .mpc_jump import *
-from .mpc_flying_trot import *
\ No newline at end of file
+from .mpc_flying_trot import *
+from .mpc_manipulator import *
\ No newline at end of file
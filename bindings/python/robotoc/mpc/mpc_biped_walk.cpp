@@ -27,8 +27,11 @@ PYBIND11_MODULE(mpc_biped_walk, m) {
           py::arg("q"), py::arg("v"))
     .def("set_solver_options", &MPCBipedWalk::setSolverOptions,
           py::arg("solver_options"))
+    .def("set_pipelined_tick", &MPCBipedWalk::setPipelinedTick,
+          py::arg("enable"))
     .def("update_solution", &MPCBipedWalk::updateSolution,
-          py::arg("t"), py::arg("dt"), py::arg("q"), py::arg("v"))
+          py::arg("t"), py::arg("dt"), py::arg("q"), py::arg("v"),
+          py::call_guard<py::gil_scoped_release>())
     .def("get_initial_control_input", &MPCBipedWalk::getInitialControlInput)
     .def("get_solution", &MPCBipedWalk::getSolution)
     .def("KKT_error", 
@@ -36,6 +39,7 @@ PYBIND11_MODULE(mpc_biped_walk, m) {
           py::arg("t"), py::arg("q"), py::arg("v"))
     .def("KKT_error", 
           static_cast<double (MPCBipedWalk::*)() const>(&MPCBipedWalk::KKTError))
+    .def("get_solver_statistics", &MPCBipedWalk::getSolverStatistics)
     .def("get_cost_handle", &MPCBipedWalk::getCostHandle)
     .def("get_config_cost_handle", &MPCBipedWalk::getConfigCostHandle)
     .def("get_base_rotation_cost_handle", &MPCBipedWalk::getBaseRotationCostHandle)
@@ -27,8 +27,13 @@ PYBIND11_MODULE(mpc_crawl, m) {
           py::arg("q"), py::arg("v"))
     .def("set_solver_options", &MPCCrawl::setSolverOptions,
           py::arg("solver_options"))
+    .def("set_pipelined_tick", &MPCCrawl::setPipelinedTick,
+          py::arg("enable"))
+    .def("set_periodic_warm_start", &MPCCrawl::setPeriodicWarmStart,
+          py::arg("enable"))
     .def("update_solution", &MPCCrawl::updateSolution,
-          py::arg("t"), py::arg("dt"), py::arg("q"), py::arg("v"))
+          py::arg("t"), py::arg("dt"), py::arg("q"), py::arg("v"),
+          py::call_guard<py::gil_scoped_release>())
     .def("get_initial_control_input", &MPCCrawl::getInitialControlInput)
     .def("get_solution", &MPCCrawl::getSolution)
     .def("KKT_error", 
@@ -36,6 +41,7 @@ PYBIND11_MODULE(mpc_crawl, m) {
           py::arg("t"), py::arg("q"), py::arg("v"))
     .def("KKT_error", 
           static_cast<double (MPCCrawl::*)() const>(&MPCCrawl::KKTError))
+    .def("get_solver_statistics", &MPCCrawl::getSolverStatistics)
     .def("get_cost_handle", &MPCCrawl::getCostHandle)
     .def("get_config_cost_handle", &MPCCrawl::getConfigCostHandle)
     .def("get_base_rotation_cost_handle", &MPCCrawl::getBaseRotationCostHandle)
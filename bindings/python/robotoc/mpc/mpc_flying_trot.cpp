@@ -27,8 +27,13 @@ PYBIND11_MODULE(mpc_flying_trot, m) {
           py::arg("q"), py::arg("v"))
     .def("set_solver_options", &MPCFlyingTrot::setSolverOptions,
           py::arg("solver_options"))
+    .def("set_pipelined_tick", &MPCFlyingTrot::setPipelinedTick,
+          py::arg("enable"))
+    .def("set_periodic_warm_start", &MPCFlyingTrot::setPeriodicWarmStart,
+          py::arg("enable"))
     .def("update_solution", &MPCFlyingTrot::updateSolution,
-          py::arg("t"), py::arg("dt"), py::arg("q"), py::arg("v"))
+          py::arg("t"), py::arg("dt"), py::arg("q"), py::arg("v"),
+          py::call_guard<py::gil_scoped_release>())
     .def("get_initial_control_input", &MPCFlyingTrot::getInitialControlInput)
     .def("get_solution", &MPCFlyingTrot::getSolution)
     .def("KKT_error", 
@@ -36,6 +41,7 @@ PYBIND11_MODULE(mpc_flying_trot, m) {
           py::arg("t"), py::arg("q"), py::arg("v"))
     .def("KKT_error", 
           static_cast<double (MPCFlyingTrot::*)() const>(&MPCFlyingTrot::KKTError))
+    .def("get_solver_statistics", &MPCFlyingTrot::getSolverStatistics)
     .def("get_cost_handle", &MPCFlyingTrot::getCostHandle)
     .def("get_config_cost_handle", &MPCFlyingTrot::getConfigCostHandle)
     .def("get_base_rotation_cost_handle", &MPCFlyingTrot::getBaseRotationCostHandle)
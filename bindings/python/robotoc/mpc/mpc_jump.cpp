@@ -41,6 +41,7 @@ PYBIND11_MODULE(mpc_jump, m) {
           py::arg("t"), py::arg("q"), py::arg("v"))
     .def("KKT_error", 
           static_cast<double (MPCJump::*)() const>(&MPCJump::KKTError))
+    .def("get_solver_statistics", &MPCJump::getSolverStatistics)
     .def("get_cost_handle", &MPCJump::getCostHandle)
     .def("get_config_cost_handle", &MPCJump::getConfigCostHandle)
     .def("get_constraints_handle", &MPCJump::getConstraintsHandle)
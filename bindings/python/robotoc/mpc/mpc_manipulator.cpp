@@ -0,0 +1,51 @@
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+#include <pybind11/eigen.h>
+#include <pybind11/numpy.h>
+
+#include "robotoc/mpc/mpc_manipulator.hpp"
+
+
+namespace robotoc {
+namespace python {
+
+namespace py = pybind11;
+
+PYBIND11_MODULE(mpc_manipulator, m) {
+  py::class_<MPCManipulator>(m, "MPCManipulator")
+    .def(py::init<const Robot&, const double, const int, const int>(),
+         py::arg("robot"), py::arg("T"), py::arg("N"), py::arg("nthreads"))
+    .def(py::init<const Robot&, const std::string&, const double, const int, const int>(),
+         py::arg("robot"), py::arg("end_effector_frame"), py::arg("T"), 
+         py::arg("N"), py::arg("nthreads"))
+    .def("set_joint_space_target", &MPCManipulator::setJointSpaceTarget,
+          py::arg("q_ref"))
+    .def("set_task_space_target", &MPCManipulator::setTaskSpaceTarget,
+          py::arg("position_ref"), py::arg("rotation_ref"))
+    .def("init", &MPCManipulator::init,
+          py::arg("t"), py::arg("q"), py::arg("v"), py::arg("solver_options"))
+    .def("set_solver_options", &MPCManipulator::setSolverOptions,
+          py::arg("solver_options"))
+    .def("update_solution", &MPCManipulator::updateSolution,
+          py::arg("t"), py::arg("dt"), py::arg("q"), py::arg("v"))
+    .def("get_initial_control_input", &MPCManipulator::getInitialControlInput)
+    .def("get_initial_feedback_gain", &MPCManipulator::getInitialFeedbackGain)
+    .def("get_solution", &MPCManipulator::getSolution,
+          py::arg("stage"))
+    .def("get_LQR_policy", &MPCManipulator::getLQRPolicy)
+    .def("KKT_error", 
+          static_cast<double (MPCManipulator::*)(const double, const Eigen::VectorXd&, const Eigen::VectorXd&)>(&MPCManipulator::KKTError),
+          py::arg("t"), py::arg("q"), py::arg("v"))
+    .def("KKT_error", 
+          static_cast<double (MPCManipulator::*)() const>(&MPCManipulator::KKTError))
+    .def("get_solver_statistics", &MPCManipulator::getSolverStatistics)
+    .def("get_cost_handle", &MPCManipulator::getCostHandle)
+    .def("get_config_cost_handle", &MPCManipulator::getConfigCostHandle)
+    .def("get_task_space_cost_handle", &MPCManipulator::getTaskSpaceCostHandle)
+    .def("get_constraints_handle", &MPCManipulator::getConstraintsHandle)
+    .def("get_solver", &MPCManipulator::getSolver)
+    .def("set_robot_properties", &MPCManipulator::setRobotProperties);
+}
+
+} // namespace python
+} // namespace robotoc
\ No newline at end of file
@@ -27,8 +27,13 @@ PYBIND11_MODULE(mpc_pace, m) {
           py::arg("q"), py::arg("v"))
     .def("set_solver_options", &MPCPace::setSolverOptions,
           py::arg("solver_options"))
+    .def("set_pipelined_tick", &MPCPace::setPipelinedTick,
+          py::arg("enable"))
+    .def("set_periodic_warm_start", &MPCPace::setPeriodicWarmStart,
+          py::arg("enable"))
     .def("update_solution", &MPCPace::updateSolution,
-          py::arg("t"), py::arg("dt"), py::arg("q"), py::arg("v"))
+          py::arg("t"), py::arg("dt"), py::arg("q"), py::arg("v"),
+          py::call_guard<py::gil_scoped_release>())
     .def("get_initial_control_input", &MPCPace::getInitialControlInput)
     .def("get_solution", &MPCPace::getSolution)
     .def("KKT_error", 
@@ -36,6 +41,7 @@ PYBIND11_MODULE(mpc_pace, m) {
           py::arg("t"), py::arg("q"), py::arg("v"))
     .def("KKT_error", 
           static_cast<double (MPCPace::*)() const>(&MPCPace::KKTError))
+    .def("get_solver_statistics", &MPCPace::getSolverStatistics)
     .def("get_cost_handle", &MPCPace::getCostHandle)
     .def("get_config_cost_handle", &MPCPace::getConfigCostHandle)
     .def("get_base_rotation_cost_handle", &MPCPace::getBaseRotationCostHandle)
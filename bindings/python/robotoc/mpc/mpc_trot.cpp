@@ -27,8 +27,13 @@ PYBIND11_MODULE(mpc_trot, m) {
           py::arg("q"), py::arg("v"))
     .def("set_solver_options", &MPCTrot::setSolverOptions,
           py::arg("solver_options"))
+    .def("set_pipelined_tick", &MPCTrot::setPipelinedTick,
+          py::arg("enable"))
+    .def("set_periodic_warm_start", &MPCTrot::setPeriodicWarmStart,
+          py::arg("enable"))
     .def("update_solution", &MPCTrot::updateSolution,
-          py::arg("t"), py::arg("dt"), py::arg("q"), py::arg("v"))
+          py::arg("t"), py::arg("dt"), py::arg("q"), py::arg("v"),
+          py::call_guard<py::gil_scoped_release>())
     .def("get_initial_control_input", &MPCTrot::getInitialControlInput)
     .def("get_solution", &MPCTrot::getSolution)
     .def("KKT_error", 
@@ -36,6 +41,7 @@ PYBIND11_MODULE(mpc_trot, m) {
           py::arg("t"), py::arg("q"), py::arg("v"))
     .def("KKT_error", 
           static_cast<double (MPCTrot::*)() const>(&MPCTrot::KKTError))
+    .def("get_solver_statistics", &MPCTrot::getSolverStatistics)
     .def("get_cost_handle", &MPCTrot::getCostHandle)
     .def("get_config_cost_handle", &MPCTrot::getConfigCostHandle)
     .def("get_base_rotation_cost_handle", &MPCTrot::getBaseRotationCostHandle)
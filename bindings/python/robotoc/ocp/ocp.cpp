@@ -10,6 +10,11 @@ namespace python {
 namespace py = pybind11;
 
 PYBIND11_MODULE(ocp, m) {
+  py::enum_<IntegrationScheme>(m, "IntegrationScheme", py::arithmetic())
+    .value("ForwardEuler", IntegrationScheme::ForwardEuler)
+    .value("Midpoint", IntegrationScheme::Midpoint)
+    .export_values();
+
   py::class_<OCP>(m, "OCP")
     .def(py::init<const Robot&, const std::shared_ptr<CostFunction>&,
                   const std::shared_ptr<Constraints>&, 
@@ -29,6 +34,9 @@ PYBIND11_MODULE(ocp, m) {
     .def(py::init<>())
     .def("set_discretization_method", &OCP::setDiscretizationMethod, 
           py::arg("discretization_method"))
+    .def("set_integration_scheme", &OCP::setIntegrationScheme, 
+          py::arg("integration_scheme"))
+    .def("integration_scheme", &OCP::integrationScheme)
     .def("discretize", &OCP::discretize, py::arg("t"))
     .def("mesh_refinement ", &OCP::meshRefinement, py::arg("t"))
     .def("discrete", &OCP::discrete)
@@ -41,6 +49,8 @@ PYBIND11_MODULE(ocp, m) {
     .def("T", &OCP::T)
     .def("N", &OCP::N)
     .def("reserved_num_discrete_events", &OCP::reservedNumDiscreteEvents)
+    .def("reserved_num_impulse_events", &OCP::reservedNumImpulseEvents)
+    .def("reserved_num_lift_events", &OCP::reservedNumLiftEvents)
     .def("is_sto_enabled", &OCP::isSTOEnabled)
     .def("__str__", [](const OCP& self) {
         std::stringstream ss;
@@ -17,6 +17,10 @@ PYBIND11_MODULE(split_kkt_matrix, m) {
     .def(py::init<>())
     .def("set_contact_status", &SplitKKTMatrix::setContactStatus,
           py::arg("contact_status"))
+    .def("set_lower_triangular_hessian", &SplitKKTMatrix::setLowerTriangularHessian,
+          py::arg("lower_triangular_hessian"))
+    .def("is_lower_triangular_hessian", &SplitKKTMatrix::isLowerTriangularHessian)
+    .def("symmetrize_hessian", &SplitKKTMatrix::symmetrizeHessian)
     .def("is_dimension_consistent", &SplitKKTMatrix::isDimensionConsistent)
     .def_readwrite("Fxx", &SplitKKTMatrix::Fxx)
     .def_readwrite("Fvu", &SplitKKTMatrix::Fvu)
@@ -2,4 +2,6 @@ from .solver_options import *
 from .solver_statistics import *
 from .ocp_solver import *
 from .unconstr_ocp_solver import *
-from .unconstr_parnmpc_solver import *
\ No newline at end of file
+from .unconstr_parnmpc_solver import *
+from .solver_autotuner import *
+from .ocp_solver_pool import *
\ No newline at end of file
@@ -47,6 +47,8 @@ PYBIND11_MODULE(ocp_solver, m) {
           py::arg("t"))
     .def("extrapolate_solution_initial_phase", &OCPSolver::extrapolateSolutionInitialPhase,
           py::arg("t"))
+    .def("extrapolate_solution_periodic", &OCPSolver::extrapolateSolutionPeriodic,
+          py::arg("t"), py::arg("num_phases_in_period"), py::arg("R"), py::arg("p"))
     .def("KKT_error", 
           static_cast<double (OCPSolver::*)(const double, const Eigen::VectorXd&, const Eigen::VectorXd&)>(&OCPSolver::KKTError),
           py::arg("t"), py::arg("q"), py::arg("v"))
@@ -0,0 +1,53 @@
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+#include <pybind11/eigen.h>
+#include <pybind11/numpy.h>
+
+#include "robotoc/solver/ocp_solver_pool.hpp"
+
+
+namespace robotoc {
+namespace python {
+
+namespace py = pybind11;
+
+PYBIND11_MODULE(ocp_solver_pool, m) {
+  py::class_<OCPSolverRequest>(m, "OCPSolverRequest")
+    .def(py::init<>())
+    .def_readwrite("ocp", &OCPSolverRequest::ocp)
+    .def_readwrite("solver_options", &OCPSolverRequest::solver_options)
+    .def_readwrite("t", &OCPSolverRequest::t)
+    .def_readwrite("q", &OCPSolverRequest::q)
+    .def_readwrite("v", &OCPSolverRequest::v)
+    .def_readwrite("priority", &OCPSolverRequest::priority)
+    .def_readwrite("use_warm_start", &OCPSolverRequest::use_warm_start)
+    .def_readwrite("update_warm_start", &OCPSolverRequest::update_warm_start)
+    .def_readwrite("initial_guess", &OCPSolverRequest::initial_guess);
+
+  py::class_<OCPSolverResult>(m, "OCPSolverResult")
+    .def(py::init<>())
+    .def_readonly("solution", &OCPSolverResult::solution)
+    .def_readonly("statistics", &OCPSolverResult::statistics)
+    .def_readonly("kkt_error", &OCPSolverResult::kkt_error)
+    .def_readonly("warm_started", &OCPSolverResult::warm_started)
+    .def_readonly("wait_time", &OCPSolverResult::wait_time)
+    .def_readonly("solve_time", &OCPSolverResult::solve_time);
+
+  py::class_<OCPSolverPool>(m, "OCPSolverPool")
+    .def(py::init<const int, const int>(),
+          py::arg("nworkers"), py::arg("nthreads")=1)
+    .def("solve", &OCPSolverPool::solve,
+          py::arg("requests"), py::call_guard<py::gil_scoped_release>())
+    .def("reserve", &OCPSolverPool::reserve,
+          py::arg("ocp"), py::arg("num_solvers"))
+    .def("set_warm_start", &OCPSolverPool::setWarmStart,
+          py::arg("ocp"), py::arg("solution"))
+    .def("clear_warm_starts", &OCPSolverPool::clearWarmStarts)
+    .def("num_solvers", &OCPSolverPool::numSolvers)
+    .def("num_warm_starts", &OCPSolverPool::numWarmStarts)
+    .def("num_pending_requests", &OCPSolverPool::numPendingRequests)
+    .def("nworkers", &OCPSolverPool::nworkers);
+}
+
+} // namespace python
+} // namespace robotoc
@@ -0,0 +1,41 @@
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+#include <pybind11/eigen.h>
+
+#include <sstream>
+
+#include "robotoc/solver/solver_autotuner.hpp"
+
+
+namespace robotoc {
+namespace python {
+
+namespace py = pybind11;
+
+PYBIND11_MODULE(solver_autotuner, m) {
+  py::class_<SolverAutotuner>(m, "SolverAutotuner")
+    .def(py::init<const std::string&, const int, const int, const int>(),
+          py::arg("cache_file")="", py::arg("max_threads")=0,
+          py::arg("num_calibration_solves")=3, py::arg("max_calibration_iter")=5)
+    .def("tune", 
+          static_cast<int (SolverAutotuner::*)(const OCP&, const SolverOptions&, const double, const Eigen::VectorXd&, const Eigen::VectorXd&)>(&SolverAutotuner::tune),
+          py::arg("ocp"), py::arg("solver_options"), py::arg("t"), py::arg("q"), py::arg("v"))
+    .def("tune", 
+          static_cast<int (SolverAutotuner::*)(const OCP&, const SolverOptions&, const double, const Eigen::VectorXd&, const Eigen::VectorXd&, const Solution&)>(&SolverAutotuner::tune),
+          py::arg("ocp"), py::arg("solver_options"), py::arg("t"), py::arg("q"), py::arg("v"), py::arg("s"))
+    .def("nthreads", &SolverAutotuner::nthreads)
+    .def("is_cached", &SolverAutotuner::isCached)
+    .def("candidate_num_threads", &SolverAutotuner::candidateNumThreads)
+    .def("cpu_times", &SolverAutotuner::cpuTimes)
+    .def_static("problem_signature", &SolverAutotuner::problemSignature,
+          py::arg("ocp"))
+    .def_static("machine_signature", &SolverAutotuner::machineSignature)
+    .def("__str__", [](const SolverAutotuner& self) {
+        std::stringstream ss;
+        ss << self;
+        return ss.str();
+      });
+}
+
+} // namespace python
+} // namespace robotoc
@@ -11,10 +11,26 @@ namespace python {
 namespace py = pybind11;
 
 PYBIND11_MODULE(solver_options, m) {
+  py::enum_<AuxMatInitialization>(m, "AuxMatInitialization", py::arithmetic())
+    .value("TerminalCostHessian", AuxMatInitialization::TerminalCostHessian)
+    .value("TerminalLQR", AuxMatInitialization::TerminalLQR)
+    .value("Riccati", AuxMatInitialization::Riccati)
+    .value("Shift", AuxMatInitialization::Shift)
+    .export_values();
+
+  py::enum_<ForwardPassMethod>(m, "ForwardPassMethod", py::arithmetic())
+    .value("LinearStep", ForwardPassMethod::LinearStep)
+    .value("NonlinearRollout", ForwardPassMethod::NonlinearRollout)
+    .export_values();
+
   py::class_<SolverOptions>(m, "SolverOptions")
     .def(py::init<>())
     .def_readwrite("max_iter", &SolverOptions::max_iter)
     .def_readwrite("kkt_tol", &SolverOptions::kkt_tol)
+    .def_readwrite("num_leading_stages", &SolverOptions::num_leading_stages)
+    .def_readwrite("kkt_tol_leading", &SolverOptions::kkt_tol_leading)
+    .def_readwrite("kkt_tol_tail", &SolverOptions::kkt_tol_tail)
+    .def_readwrite("initial_input_tol", &SolverOptions::initial_input_tol)
     .def_readwrite("mu_init", &SolverOptions::mu_init)
     .def_readwrite("mu_min", &SolverOptions::mu_min)
     .def_readwrite("kkt_tol_mu", &SolverOptions::kkt_tol_mu)
@@ -23,12 +39,19 @@ PYBIND11_MODULE(solver_options, m) {
     .def_readwrite("enable_line_search", &SolverOptions::enable_line_search)
     .def_readwrite("line_search_settings", &SolverOptions::line_search_settings)
     .def_readwrite("discretization_method", &SolverOptions::discretization_method)
+    .def_readwrite("integration_scheme", &SolverOptions::integration_scheme)
+    .def_readwrite("enable_lower_triangular_hessian", &SolverOptions::enable_lower_triangular_hessian)
+    .def_readwrite("forward_pass_method", &SolverOptions::forward_pass_method)
     .def_readwrite("initial_sto_reg_iter", &SolverOptions::initial_sto_reg_iter)
     .def_readwrite("initial_sto_reg", &SolverOptions::initial_sto_reg)
     .def_readwrite("kkt_tol_mesh", &SolverOptions::kkt_tol_mesh)
     .def_readwrite("max_dt_mesh", &SolverOptions::max_dt_mesh)
     .def_readwrite("max_dts_riccati", &SolverOptions::max_dts_riccati)
+    .def_readwrite("partial_condensing_block_size", &SolverOptions::partial_condensing_block_size)
+    .def_readwrite("aux_mat_initialization", &SolverOptions::aux_mat_initialization)
+    .def_readwrite("num_blocks_parnmpc", &SolverOptions::num_blocks_parnmpc)
     .def_readwrite("enable_benchmark", &SolverOptions::enable_benchmark)
+    .def_readwrite("enable_performance_counter", &SolverOptions::enable_performance_counter)
     .def("__str__", [](const SolverOptions& self) {
         std::stringstream ss;
         ss << self;
@@ -14,6 +14,22 @@ namespace python {
 namespace py = pybind11;
 
 PYBIND11_MODULE(solver_statistics, m) {
+  py::enum_<SolverPhase>(m, "SolverPhase", py::arithmetic())
+    .value("KKTSystem", SolverPhase::KKTSystem)
+    .value("BackwardRiccati", SolverPhase::BackwardRiccati)
+    .value("ForwardRiccati", SolverPhase::ForwardRiccati)
+    .value("LineSearch", SolverPhase::LineSearch)
+    .value("Integration", SolverPhase::Integration)
+    .export_values();
+
+  py::class_<PerformanceCounts>(m, "PerformanceCounts")
+    .def(py::init<>())
+    .def_readonly("cycles", &PerformanceCounts::cycles)
+    .def_readonly("instructions", &PerformanceCounts::instructions)
+    .def_readonly("cache_misses", &PerformanceCounts::cache_misses)
+    .def_readonly("branch_misses", &PerformanceCounts::branch_misses)
+    .def("ipc", &PerformanceCounts::ipc);
+
   py::class_<SolverStatistics>(m, "SolverStatistics")
     .def(py::init<>())
     .def_readonly("convergence", &SolverStatistics::convergence)
@@ -23,7 +39,16 @@ PYBIND11_MODULE(solver_statistics, m) {
     .def_readonly("dual_step_size", &SolverStatistics::dual_step_size)
     .def_readonly("ts", &SolverStatistics::ts)
     .def_readonly("mesh_refinement_iter", &SolverStatistics::mesh_refinement_iter)
+    .def_readonly("kkt_error_dynamics", &SolverStatistics::kkt_error_dynamics)
+    .def_readonly("kkt_error_constraints", &SolverStatistics::kkt_error_constraints)
+    .def_readonly("kkt_error_complementarity", &SolverStatistics::kkt_error_complementarity)
+    .def_readonly("kkt_error_sto", &SolverStatistics::kkt_error_sto)
+    .def_readonly("kkt_error_leading", &SolverStatistics::kkt_error_leading)
+    .def_readonly("kkt_error_tail", &SolverStatistics::kkt_error_tail)
     .def_readonly("cpu_time", &SolverStatistics::cpu_time)
+    .def_readonly("phase_cpu_time", &SolverStatistics::phase_cpu_time)
+    .def_readonly("performance_counts", &SolverStatistics::performance_counts)
+    .def_readonly("performance_counter_available", &SolverStatistics::performance_counter_available)
     .def("__str__", [](const SolverStatistics& self) {
         std::stringstream ss;
         ss << self;
@@ -31,6 +31,8 @@ PYBIND11_MODULE(unconstr_ocp_solver, m) {
           static_cast<std::vector<Eigen::VectorXd> (UnconstrOCPSolver::*)(const std::string&) const>(&UnconstrOCPSolver::getSolution))
     .def("set_solution", &UnconstrOCPSolver::setSolution,
           py::arg("name"), py::arg("value"))
+    .def("shift_solution", &UnconstrOCPSolver::shiftSolution,
+          py::arg("shift_time"))
     .def("get_LQR_policy", &UnconstrOCPSolver::getLQRPolicy)
     .def("KKT_error", 
           static_cast<double (UnconstrOCPSolver::*)(const double, const Eigen::VectorXd&, const Eigen::VectorXd&)>(&UnconstrOCPSolver::KKTError),
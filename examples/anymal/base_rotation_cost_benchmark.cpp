@@ -0,0 +1,183 @@
+#include <string>
+#include <memory>
+#include <vector>
+#include <iostream>
+
+#include "Eigen/Core"
+#include "Eigen/Geometry"
+
+#include "robotoc/robot/robot.hpp"
+#include "robotoc/hybrid/grid_info.hpp"
+#include "robotoc/cost/configuration_space_cost.hpp"
+#include "robotoc/cost/configuration_space_ref_base.hpp"
+#include "robotoc/cost/cost_function_data.hpp"
+#include "robotoc/ocp/split_solution.hpp"
+#include "robotoc/ocp/split_kkt_residual.hpp"
+#include "robotoc/ocp/split_kkt_matrix.hpp"
+#include "robotoc/mpc/mpc_trot.hpp"
+#include "robotoc/mpc/trot_foot_step_planner.hpp"
+#include "robotoc/solver/solver_options.hpp"
+#include "robotoc/utils/timer.hpp"
+#include "robotoc/utils/aligned_vector.hpp"
+
+
+// Reference of the base orientation that rotates the base in yaw over the
+// horizon as MPCPeriodicConfigurationRef.
+class YawRotationRef final : public robotoc::ConfigurationSpaceRefBase {
+public:
+  YawRotationRef(const Eigen::VectorXd& q, const double yaw, const double T,
+                 const bool cache)
+    : q_(q),
+      quat0_(Eigen::Quaterniond(q.template segment<4>(3))),
+      quat1_(quat0_*Eigen::AngleAxisd(yaw, Eigen::Vector3d::UnitZ())),
+      T_(T),
+      cache_(cache) {
+  }
+
+  void updateRef(const robotoc::Robot& robot,
+                 const robotoc::GridInfo& grid_info,
+                 Eigen::VectorXd& q_ref) const override {
+    q_ref = q_;
+    const double rate = (grid_info.t-grid_info.t0) / T_;
+    q_ref.template segment<4>(3) = quat0_.slerp(rate, quat1_).coeffs();
+  }
+
+  bool isActive(const robotoc::GridInfo& grid_info) const override {
+    return true;
+  }
+
+  unsigned long version() const override { return (cache_ ? 1 : 0); }
+
+private:
+  Eigen::VectorXd q_;
+  Eigen::Quaterniond quat0_, quat1_;
+  double T_;
+  bool cache_;
+};
+
+
+// Evaluates the base-rotation cost and its derivatives over the horizon as
+// in the Newton iterations of the MPC.
+void runCostBenchmark(const std::string& name, robotoc::Robot& robot,
+                      const Eigen::VectorXd& q0, const bool cache,
+                      const bool small_angle_approximation) {
+  const double T = 0.5;
+  const int N = 18;
+  const int num_iter = 10000;
+  auto ref = std::make_shared<YawRotationRef>(q0, 0.2, T, cache);
+  auto cost = std::make_shared<robotoc::ConfigurationSpaceCost>(robot, ref);
+  Eigen::VectorXd base_rot_weight = Eigen::VectorXd::Zero(robot.dimv());
+  base_rot_weight.template head<6>() << 0, 0, 0, 1000, 1000, 1000;
+  cost->set_q_weight(base_rot_weight);
+  cost->set_small_angle_approximation(small_angle_approximation);
+  const auto contact_status = robot.createContactStatus();
+  robotoc::aligned_vector<robotoc::CostFunctionData> data(N, robotoc::CostFunctionData(robot));
+  std::vector<robotoc::GridInfo> grid_info(N);
+  robotoc::aligned_vector<robotoc::SplitSolution> s(N, robotoc::SplitSolution(robot));
+  for (int i=0; i<N; ++i) {
+    grid_info[i].t0 = 0;
+    grid_info[i].t = i * T / N;
+    grid_info[i].dt = T / N;
+    const Eigen::VectorXd dq = 0.01 * Eigen::VectorXd::Random(robot.dimv());
+    robot.integrateConfiguration(q0, dq, 1.0, s[i].q);
+  }
+  robotoc::SplitKKTResidual kkt_residual(robot);
+  robotoc::SplitKKTMatrix kkt_matrix(robot);
+  robotoc::Timer timer;
+  double l = 0;
+  timer.tick();
+  for (int iter=0; iter<num_iter; ++iter) {
+    for (int i=0; i<N; ++i) {
+      l += cost->evalStageCost(robot, contact_status, data[i], grid_info[i], s[i]);
+      cost->evalStageCostDerivatives(robot, contact_status, data[i],
+                                     grid_info[i], s[i], kkt_residual);
+      cost->evalStageCostHessian(robot, contact_status, data[i],
+                                 grid_info[i], s[i], kkt_matrix);
+    }
+  }
+  timer.tock();
+  std::cout << name << ": CPU time per horizon: "
+            << 1.0e03 * timer.ms() / num_iter << " [us] (cost: "
+            << l / num_iter << ")" << std::endl;
+}
+
+
+// Runs MPCTrot in closed loop, in which the state of the next tick is the
+// predicted state of the MPC.
+void runMPCBenchmark(const std::string& name, const robotoc::Robot& robot,
+                     const Eigen::VectorXd& q0,
+                     const bool small_angle_approximation) {
+  const Eigen::Vector3d step_length = {0.15, 0, 0};
+  const double step_yaw = 0.1;
+  const double swing_height = 0.1;
+  const double swing_time = 0.25;
+  const double stance_time = 0.0;
+  const double swing_start_time = 0.5;
+  const double T = 0.5;
+  const int N = 18;
+  const int nthreads = 4;
+  robotoc::MPCTrot mpc(robot, T, N, nthreads);
+  auto planner = std::make_shared<robotoc::TrotFootStepPlanner>(robot);
+  planner->setGaitPattern(step_length, step_yaw, (stance_time > 0.));
+  mpc.setGaitPattern(planner, swing_height, swing_time, stance_time,
+                     swing_start_time);
+  mpc.getBaseRotationCostHandle()->set_small_angle_approximation(
+      small_angle_approximation);
+
+  double t = 0.0;
+  Eigen::VectorXd q = q0;
+  Eigen::VectorXd v = Eigen::VectorXd::Zero(robot.dimv());
+  auto option_init = robotoc::SolverOptions::defaultOptions();
+  option_init.max_iter = 10;
+  mpc.init(t, q, v, option_init);
+  auto option_mpc = robotoc::SolverOptions::defaultOptions();
+  option_mpc.max_iter = 2;
+  mpc.setSolverOptions(option_mpc);
+
+  const double dt = T / N;
+  const double sim_time = 5.0;
+  const int num_ticks = sim_time / dt;
+  robotoc::Timer timer;
+  double total_time = 0;
+  double total_kkt_error = 0;
+  for (int i=0; i<num_ticks; ++i) {
+    timer.tick();
+    mpc.updateSolution(t, dt, q, v);
+    timer.tock();
+    total_time += timer.ms();
+    total_kkt_error += mpc.KKTError();
+    q = mpc.getSolution()[1].q;
+    v = mpc.getSolution()[1].v;
+    t += dt;
+  }
+  std::cout << name << ": average KKT error: " << total_kkt_error/num_ticks
+            << ", average CPU time per tick: " << total_time/num_ticks
+            << " [ms]" << std::endl;
+}
+
+
+int main(int argc, char *argv[]) {
+  const std::string path_to_urdf = "../anymal_b_simple_description/urdf/anymal.urdf";
+  const std::vector<std::string> contact_frames = {"LF_FOOT", "LH_FOOT", "RF_FOOT", "RH_FOOT"};
+  const std::vector<robotoc::ContactType> contact_types(4, robotoc::ContactType::PointContact);
+  const double baumgarte_time_step = 0.05;
+  robotoc::Robot robot(path_to_urdf, robotoc::BaseJointType::FloatingBase,
+                       contact_frames, contact_types, baumgarte_time_step);
+  Eigen::VectorXd q0(Eigen::VectorXd::Zero(robot.dimq()));
+  q0 << 0, 0, 0.4842, 0, 0, 0, 1,
+        -0.1,  0.7, -1.0,
+        -0.1, -0.7,  1.0,
+         0.1,  0.7, -1.0,
+         0.1, -0.7,  1.0;
+
+  std::cout << "---------- Base-rotation cost ----------" << std::endl;
+  runCostBenchmark("reference recomputed", robot, q0, false, false);
+  runCostBenchmark("reference cached", robot, q0, true, false);
+  runCostBenchmark("reference cached, small-angle approximation", robot, q0,
+                   true, true);
+
+  std::cout << "---------- MPCTrot ----------" << std::endl;
+  runMPCBenchmark("exact", robot, q0, false);
+  runMPCBenchmark("small-angle approximation", robot, q0, true);
+  return 0;
+}
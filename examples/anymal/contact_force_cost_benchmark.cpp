@@ -0,0 +1,187 @@
+#include <string>
+#include <memory>
+#include <vector>
+#include <chrono>
+#include <iostream>
+
+#include "Eigen/Core"
+
+#include "robotoc/robot/robot.hpp"
+#include "robotoc/robot/contact_status.hpp"
+#include "robotoc/robot/impulse_status.hpp"
+#include "robotoc/cost/cost_function_data.hpp"
+#include "robotoc/cost/local_contact_force_cost.hpp"
+#include "robotoc/cost/com_cost.hpp"
+#include "robotoc/ocp/split_solution.hpp"
+#include "robotoc/ocp/split_kkt_residual.hpp"
+#include "robotoc/ocp/split_kkt_matrix.hpp"
+#include "robotoc/impulse/impulse_split_solution.hpp"
+#include "robotoc/impulse/impulse_split_kkt_residual.hpp"
+#include "robotoc/impulse/impulse_split_kkt_matrix.hpp"
+
+
+// Per-contact loop that the stacked kernel of LocalContactForceCost replaces.
+double evalPerContactLoop(const robotoc::Robot& robot, 
+                          const robotoc::ContactStatus& contact_status,
+                          const std::vector<Eigen::Vector3d>& f_weight,
+                          const std::vector<Eigen::Vector3d>& f_ref,
+                          const double dt, const robotoc::SplitSolution& s,
+                          robotoc::SplitKKTResidual& kkt_residual,
+                          robotoc::SplitKKTMatrix& kkt_matrix) {
+  double l = 0;
+  int dimf_stack = 0;
+  for (int i=0; i<robot.maxNumContacts(); ++i) {
+    if (contact_status.isContactActive(i)) {
+      const auto& fl = s.f[i].template head<3>();
+      l += (f_weight[i].array() * (fl.array()-f_ref[i].array()) 
+                                * (fl.array()-f_ref[i].array())).sum();
+      kkt_residual.lf().template segment<3>(dimf_stack).array()
+          += dt * f_weight[i].array() * (fl.array()-f_ref[i].array());
+      kkt_matrix.Qff().diagonal().template segment<3>(dimf_stack).noalias() 
+          += dt * f_weight[i];
+      switch (robot.contactTypes()[i]) {
+        case robotoc::ContactType::PointContact:
+          dimf_stack += 3;
+          break;
+        case robotoc::ContactType::SurfaceContact:
+          dimf_stack += 6;
+          break;
+        default:
+          break;
+      }
+    }
+  }
+  return 0.5 * dt * l;
+}
+
+
+int main() {
+  // Create a robot.
+  const int LF_foot_id = 12;
+  const int LH_foot_id = 22;
+  const int RF_foot_id = 32;
+  const int RH_foot_id = 42;
+  const std::vector<int> contact_frames = {LF_foot_id, LH_foot_id, RF_foot_id, RH_foot_id}; 
+  const std::vector<robotoc::ContactType> contact_types = {robotoc::ContactType::PointContact, 
+                                                           robotoc::ContactType::PointContact,
+                                                           robotoc::ContactType::PointContact,
+                                                           robotoc::ContactType::PointContact};
+  const std::string path_to_urdf = "../anymal_b_simple_description/urdf/anymal.urdf";
+  const double baumgarte_time_step = 0.5 / 20;
+  robotoc::Robot robot(path_to_urdf, robotoc::BaseJointType::FloatingBase, 
+                       contact_frames, contact_types, baumgarte_time_step);
+
+  // Create the costs.
+  std::vector<Eigen::Vector3d> f_weight, f_ref;
+  for (int i=0; i<robot.maxNumContacts(); ++i) {
+    f_weight.push_back(Eigen::Vector3d::Constant(0.001));
+    f_ref.push_back(Eigen::Vector3d(0, 0, 0.25*robot.totalWeight()));
+  }
+  auto local_contact_force_cost = std::make_shared<robotoc::LocalContactForceCost>(robot);
+  local_contact_force_cost->set_f_weight(f_weight);
+  local_contact_force_cost->set_f_ref(f_ref);
+  local_contact_force_cost->set_fi_weight(f_weight);
+  local_contact_force_cost->set_fi_ref(f_ref);
+  auto com_cost = std::make_shared<robotoc::CoMCost>(robot);
+  com_cost->set_weight(Eigen::Vector3d::Constant(1.0e03));
+  com_cost->set_weight_impulse(Eigen::Vector3d::Constant(1.0e03));
+
+  auto contact_status = robot.createContactStatus();
+  contact_status.activateContacts(std::vector<int>({0, 3}));
+  auto impulse_status = robot.createImpulseStatus();
+  impulse_status.activateImpulses(std::vector<int>({1, 2}));
+  const auto grid_info = robotoc::GridInfo::Random();
+  robotoc::CostFunctionData data(robot);
+  const auto s = robotoc::SplitSolution::Random(robot, contact_status);
+  const auto si = robotoc::ImpulseSplitSolution::Random(robot, impulse_status);
+  robotoc::SplitKKTResidual kkt_residual(robot);
+  robotoc::SplitKKTMatrix kkt_matrix(robot);
+  kkt_residual.setContactStatus(contact_status);
+  kkt_matrix.setContactStatus(contact_status);
+  robotoc::ImpulseSplitKKTResidual impulse_kkt_residual(robot);
+  robotoc::ImpulseSplitKKTMatrix impulse_kkt_matrix(robot);
+  impulse_kkt_residual.setImpulseStatus(impulse_status);
+  impulse_kkt_matrix.setImpulseStatus(impulse_status);
+  robot.updateKinematics(s.q);
+
+  const int num_iteration = 1000000;
+  double l = 0;
+  std::cout << "---------- Cost benchmark : CPU time per stage [us] ----------" << std::endl;
+  auto start_clock = std::chrono::high_resolution_clock::now();
+  for (int i=0; i<num_iteration; ++i) {
+    l += evalPerContactLoop(robot, contact_status, f_weight, f_ref, grid_info.dt, 
+                            s, kkt_residual, kkt_matrix);
+  }
+  auto end_clock = std::chrono::high_resolution_clock::now();
+  std::chrono::duration<double, std::micro> timing = end_clock - start_clock;
+  std::cout << "local contact force (per-contact loop): " 
+            << timing.count() / num_iteration << std::endl;
+
+  start_clock = std::chrono::high_resolution_clock::now();
+  for (int i=0; i<num_iteration; ++i) {
+    l += local_contact_force_cost->evalStageCost(robot, contact_status, data, grid_info, s);
+    local_contact_force_cost->evalStageCostDerivatives(robot, contact_status, data, 
+                                                       grid_info, s, kkt_residual);
+    local_contact_force_cost->evalStageCostHessian(robot, contact_status, data, 
+                                                   grid_info, s, kkt_matrix);
+  }
+  end_clock = std::chrono::high_resolution_clock::now();
+  timing = end_clock - start_clock;
+  std::cout << "local contact force (stacked): " 
+            << timing.count() / num_iteration << std::endl;
+
+  start_clock = std::chrono::high_resolution_clock::now();
+  for (int i=0; i<num_iteration; ++i) {
+    l += local_contact_force_cost->evalImpulseCost(robot, impulse_status, data, grid_info, si);
+    local_contact_force_cost->evalImpulseCostDerivatives(robot, impulse_status, data, 
+                                                         grid_info, si, impulse_kkt_residual);
+    local_contact_force_cost->evalImpulseCostHessian(robot, impulse_status, data, 
+                                                     grid_info, si, impulse_kkt_matrix);
+  }
+  end_clock = std::chrono::high_resolution_clock::now();
+  timing = end_clock - start_clock;
+  std::cout << "local contact force impulse (stacked): " 
+            << timing.count() / num_iteration << std::endl;
+
+  start_clock = std::chrono::high_resolution_clock::now();
+  for (int i=0; i<num_iteration; ++i) {
+    data.J_3d.setZero();
+    robot.getCoMJacobian(data.J_3d);
+    l += com_cost->evalStageCost(robot, contact_status, data, grid_info, s);
+    kkt_residual.lq().noalias() 
+        += grid_info.dt * data.J_3d.transpose() * Eigen::Vector3d::Constant(1.0e03).asDiagonal() * data.diff_3d;
+    kkt_matrix.Qqq().noalias()
+        += grid_info.dt * data.J_3d.transpose() * Eigen::Vector3d::Constant(1.0e03).asDiagonal() * data.J_3d;
+  }
+  end_clock = std::chrono::high_resolution_clock::now();
+  timing = end_clock - start_clock;
+  std::cout << "CoM (copied Jacobian): " << timing.count() / num_iteration << std::endl;
+
+  start_clock = std::chrono::high_resolution_clock::now();
+  for (int i=0; i<num_iteration; ++i) {
+    l += com_cost->evalStageCost(robot, contact_status, data, grid_info, s);
+    com_cost->evalStageCostDerivatives(robot, contact_status, data, grid_info, 
+                                       s, kkt_residual);
+    com_cost->evalStageCostHessian(robot, contact_status, data, grid_info, 
+                                   s, kkt_matrix);
+  }
+  end_clock = std::chrono::high_resolution_clock::now();
+  timing = end_clock - start_clock;
+  std::cout << "CoM (precomputed Jacobian): " << timing.count() / num_iteration << std::endl;
+
+  start_clock = std::chrono::high_resolution_clock::now();
+  for (int i=0; i<num_iteration; ++i) {
+    l += com_cost->evalImpulseCost(robot, impulse_status, data, grid_info, si);
+    com_cost->evalImpulseCostDerivatives(robot, impulse_status, data, grid_info, 
+                                         si, impulse_kkt_residual);
+    com_cost->evalImpulseCostHessian(robot, impulse_status, data, grid_info, 
+                                     si, impulse_kkt_matrix);
+  }
+  end_clock = std::chrono::high_resolution_clock::now();
+  timing = end_clock - start_clock;
+  std::cout << "CoM impulse (precomputed Jacobian): " << timing.count() / num_iteration << std::endl;
+  // Prevents the loops from being optimized out.
+  std::cout << "(accumulated cost: " << l << ")" << std::endl;
+
+  return 0;
+}
@@ -0,0 +1,104 @@
+#include <string>
+#include <memory>
+#include <vector>
+#include <iostream>
+#include <algorithm>
+
+#include "Eigen/Core"
+
+#include "robotoc/robot/robot.hpp"
+#include "robotoc/mpc/mpc_trot.hpp"
+#include "robotoc/mpc/mpc_crawl.hpp"
+#include "robotoc/mpc/trot_foot_step_planner.hpp"
+#include "robotoc/mpc/crawl_foot_step_planner.hpp"
+#include "robotoc/solver/solver_options.hpp"
+#include "robotoc/utils/timer.hpp"
+
+
+// Runs the MPC in closed loop, in which the state of the next tick is the
+// predicted state of the MPC, i.e., the model is assumed to be perfect.
+template <typename MPCType, typename FootStepPlannerType>
+void runClosedLoop(const std::string& gait_name, const robotoc::Robot& robot,
+                   const Eigen::VectorXd& q0, const bool periodic_warm_start) {
+  const Eigen::Vector3d step_length = {0.15, 0, 0};
+  const double step_yaw = 0;
+  const double swing_height = 0.1;
+  const double swing_time = 0.25;
+  const double stance_time = 0.0;
+  const double swing_start_time = 0.5;
+  const double T = 0.5;
+  const int N = 18;
+  const int nthreads = 4;
+  MPCType mpc(robot, T, N, nthreads);
+  auto planner = std::make_shared<FootStepPlannerType>(robot);
+  planner->setGaitPattern(step_length, step_yaw, (stance_time > 0.));
+  mpc.setGaitPattern(planner, swing_height, swing_time, stance_time,
+                     swing_start_time);
+  mpc.setPeriodicWarmStart(periodic_warm_start);
+
+  double t = 0.0;
+  Eigen::VectorXd q = q0;
+  Eigen::VectorXd v = Eigen::VectorXd::Zero(robot.dimv());
+  auto option_init = robotoc::SolverOptions::defaultOptions();
+  option_init.max_iter = 10;
+  mpc.init(t, q, v, option_init);
+  auto option_mpc = robotoc::SolverOptions::defaultOptions();
+  option_mpc.max_iter = 10;
+  option_mpc.kkt_tol = 1.0e-03;
+  mpc.setSolverOptions(option_mpc);
+
+  const double dt = T / N;
+  const double sim_time = 5.0;
+  const int num_ticks = sim_time / dt;
+  robotoc::Timer timer;
+  double total_time = 0;
+  double max_time = 0;
+  double total_kkt_error = 0;
+  int total_iter = 0;
+  for (int i=0; i<num_ticks; ++i) {
+    timer.tick();
+    mpc.updateSolution(t, dt, q, v);
+    timer.tock();
+    total_time += timer.ms();
+    max_time = std::max(max_time, timer.ms());
+    total_iter += mpc.getSolverStatistics().iter;
+    total_kkt_error += mpc.KKTError();
+    q = mpc.getSolution()[1].q;
+    v = mpc.getSolution()[1].v;
+    t += dt;
+  }
+  std::cout << "---------- " << gait_name << " (periodic warm start: "
+            << std::boolalpha << periodic_warm_start << ") ----------"
+            << std::endl;
+  std::cout << "average iterations per tick: "
+            << static_cast<double>(total_iter)/num_ticks << std::endl;
+  std::cout << "average KKT error: " << total_kkt_error/num_ticks << std::endl;
+  std::cout << "average CPU time per tick: " << total_time/num_ticks
+            << " [ms]" << std::endl;
+  std::cout << "max CPU time per tick: " << max_time << " [ms]" << std::endl;
+}
+
+
+int main(int argc, char *argv[]) {
+  const std::string path_to_urdf = "../anymal_b_simple_description/urdf/anymal.urdf";
+  const std::vector<std::string> contact_frames = {"LF_FOOT", "LH_FOOT", "RF_FOOT", "RH_FOOT"};
+  const std::vector<robotoc::ContactType> contact_types(4, robotoc::ContactType::PointContact);
+  const double baumgarte_time_step = 0.05;
+  robotoc::Robot robot(path_to_urdf, robotoc::BaseJointType::FloatingBase,
+                       contact_frames, contact_types, baumgarte_time_step);
+  Eigen::VectorXd q0(Eigen::VectorXd::Zero(robot.dimq()));
+  q0 << 0, 0, 0.4842, 0, 0, 0, 1,
+        -0.1,  0.7, -1.0,
+        -0.1, -0.7,  1.0,
+         0.1,  0.7, -1.0,
+         0.1, -0.7,  1.0;
+  for (const bool periodic_warm_start : {false, true}) {
+    runClosedLoop<robotoc::MPCTrot, robotoc::TrotFootStepPlanner>(
+        "trot", robot, q0, periodic_warm_start);
+  }
+  for (const bool periodic_warm_start : {false, true}) {
+    runClosedLoop<robotoc::MPCCrawl, robotoc::CrawlFootStepPlanner>(
+        "crawl", robot, q0, periodic_warm_start);
+  }
+  return 0;
+}
@@ -0,0 +1,206 @@
+#include <string>
+#include <memory>
+#include <vector>
+#include <iostream>
+
+#include "Eigen/Core"
+
+#include "robotoc/solver/ocp_solver.hpp"
+#include "robotoc/solver/ocp_solver_pool.hpp"
+#include "robotoc/ocp/ocp.hpp"
+#include "robotoc/robot/robot.hpp"
+#include "robotoc/hybrid/contact_sequence.hpp"
+#include "robotoc/cost/cost_function.hpp"
+#include "robotoc/cost/configuration_space_cost.hpp"
+#include "robotoc/cost/com_cost.hpp"
+#include "robotoc/cost/periodic_com_ref.hpp"
+#include "robotoc/constraints/constraints.hpp"
+#include "robotoc/constraints/joint_position_lower_limit.hpp"
+#include "robotoc/constraints/joint_position_upper_limit.hpp"
+#include "robotoc/constraints/joint_velocity_lower_limit.hpp"
+#include "robotoc/constraints/joint_velocity_upper_limit.hpp"
+#include "robotoc/constraints/joint_torques_lower_limit.hpp"
+#include "robotoc/constraints/joint_torques_upper_limit.hpp"
+#include "robotoc/constraints/friction_cone.hpp"
+#include "robotoc/solver/solver_options.hpp"
+#include "robotoc/utils/timer.hpp"
+
+
+void printResult(const std::string& name, const int num_converged,
+                 const int num_instances, const double total_iter,
+                 const double total_time, const double reference_time) {
+  std::cout << "---------- " << name << " ----------" << std::endl;
+  std::cout << "converged: " << num_converged << "/" << num_instances << std::endl;
+  std::cout << "average iterations: " << total_iter/num_instances << std::endl;
+  std::cout << "total time: " << total_time << " [ms]" << std::endl;
+  std::cout << "throughput: " << 1000.0*num_instances/total_time
+            << " [instances/s]" << std::endl;
+  if (reference_time > 0) {
+    std::cout << "speedup: " << reference_time/total_time << std::endl;
+  }
+}
+
+
+// Solves the jump OCP from many perturbed initial states as in the
+// Monte-Carlo robustness studies.
+int main(int argc, char *argv[]) {
+  const std::string path_to_urdf = "../anymal_b_simple_description/urdf/anymal.urdf";
+  const std::vector<std::string> contact_frames = {"LF_FOOT", "LH_FOOT", "RF_FOOT", "RH_FOOT"};
+  const std::vector<robotoc::ContactType> contact_types(4, robotoc::ContactType::PointContact);
+  const double baumgarte_time_step = 0.04;
+  robotoc::Robot robot(path_to_urdf, robotoc::BaseJointType::FloatingBase,
+                       contact_frames, contact_types, baumgarte_time_step);
+  Eigen::VectorXd q_standing(Eigen::VectorXd::Zero(robot.dimq()));
+  q_standing << 0, 0, 0.4792, 0, 0, 0, 1,
+                -0.1,  0.7, -1.0,
+                -0.1, -0.7,  1.0,
+                 0.1,  0.7, -1.0,
+                 0.1, -0.7,  1.0;
+  const Eigen::VectorXd v_standing(Eigen::VectorXd::Zero(robot.dimv()));
+  const double ground_time = 0.30;
+  const double flying_time = 0.30;
+  const double T = flying_time + 2 * ground_time;
+  const int N = 90;
+  const Eigen::Vector3d jump_length = {0.5, 0, 0};
+
+  // Create the cost function.
+  auto cost = std::make_shared<robotoc::CostFunction>();
+  Eigen::VectorXd q_weight(Eigen::VectorXd::Zero(robot.dimv()));
+  q_weight << 0, 0, 0, 250000, 250000, 250000,
+              0.0001, 0.0001, 0.0001,
+              0.0001, 0.0001, 0.0001,
+              0.0001, 0.0001, 0.0001,
+              0.0001, 0.0001, 0.0001;
+  Eigen::VectorXd v_weight(Eigen::VectorXd::Constant(robot.dimv(), 1));
+  v_weight.head(6).setConstant(100);
+  auto config_cost = std::make_shared<robotoc::ConfigurationSpaceCost>(robot);
+  config_cost->set_q_ref(q_standing);
+  config_cost->set_q_weight(q_weight);
+  config_cost->set_q_weight_terminal(q_weight);
+  config_cost->set_q_weight_impulse(Eigen::VectorXd::Constant(robot.dimv(), 100));
+  config_cost->set_v_weight(v_weight);
+  config_cost->set_v_weight_terminal(v_weight);
+  config_cost->set_v_weight_impulse(Eigen::VectorXd::Constant(robot.dimv(), 100));
+  config_cost->set_u_weight(Eigen::VectorXd::Constant(robot.dimu(), 1e-01));
+  cost->push_back(config_cost);
+  robot.updateFrameKinematics(q_standing);
+  const Eigen::Vector3d com_ref0_landed = robot.CoM() + jump_length;
+  auto com_ref_landed = std::make_shared<robotoc::PeriodicCoMRef>(
+      com_ref0_landed, Eigen::Vector3d::Zero(), ground_time+flying_time,
+      ground_time, ground_time+flying_time, false);
+  auto com_cost_landed = std::make_shared<robotoc::CoMCost>(robot, com_ref_landed);
+  com_cost_landed->set_weight(Eigen::Vector3d::Constant(1.0e06));
+  cost->push_back(com_cost_landed);
+
+  // Create the constraints.
+  auto constraints = std::make_shared<robotoc::Constraints>(1.0e-03, 0.995);
+  constraints->push_back(std::make_shared<robotoc::JointPositionLowerLimit>(robot));
+  constraints->push_back(std::make_shared<robotoc::JointPositionUpperLimit>(robot));
+  constraints->push_back(std::make_shared<robotoc::JointVelocityLowerLimit>(robot));
+  constraints->push_back(std::make_shared<robotoc::JointVelocityUpperLimit>(robot));
+  constraints->push_back(std::make_shared<robotoc::JointTorquesLowerLimit>(robot));
+  constraints->push_back(std::make_shared<robotoc::JointTorquesUpperLimit>(robot));
+  constraints->push_back(std::make_shared<robotoc::FrictionCone>(robot, 0.7));
+
+  // Create the contact sequence.
+  std::vector<Eigen::Vector3d> x3d0;
+  for (const auto& e : contact_frames) {
+    x3d0.push_back(robot.framePosition(e));
+  }
+  auto contact_sequence = std::make_shared<robotoc::ContactSequence>(robot);
+  auto contact_status_standing = robot.createContactStatus();
+  contact_status_standing.activateContacts({0, 1, 2, 3});
+  contact_status_standing.setContactPlacements(x3d0);
+  contact_sequence->init(contact_status_standing);
+  contact_sequence->push_back(robot.createContactStatus(), ground_time);
+  std::vector<Eigen::Vector3d> x3d_landed = x3d0;
+  for (auto& e : x3d_landed) { e += jump_length; }
+  contact_status_standing.setContactPlacements(x3d_landed);
+  contact_sequence->push_back(contact_status_standing, ground_time+flying_time);
+  const robotoc::OCP ocp(robot, cost, constraints, contact_sequence, T, N);
+
+  // Perturbed initial states.
+  const int num_instances = 32;
+  const double t = 0;
+  std::vector<Eigen::VectorXd> q(num_instances), v(num_instances);
+  for (int i=0; i<num_instances; ++i) {
+    Eigen::VectorXd dq = Eigen::VectorXd::Zero(robot.dimv());
+    dq.head(6) = 0.02 * Eigen::VectorXd::Random(6);
+    robot.integrateConfiguration(q_standing, dq, 1.0, q[i]);
+    v[i] = v_standing;
+    v[i].head(6) = 0.1 * Eigen::VectorXd::Random(6);
+  }
+  Eigen::Vector3d f_init;
+  f_init << 0, 0, 0.25*robot.totalWeight();
+  const int nthreads = 4;
+  robotoc::Timer timer;
+
+  // Sequential solves with the time stages parallelized.
+  robotoc::OCPSolver ocp_solver(ocp, robotoc::SolverOptions::defaultOptions(),
+                                nthreads);
+  int num_converged = 0;
+  double total_iter = 0;
+  timer.tick();
+  for (int i=0; i<num_instances; ++i) {
+    ocp_solver.setSolution("q", q[i]);
+    ocp_solver.setSolution("v", v[i]);
+    ocp_solver.setSolution("f", f_init);
+    ocp_solver.solve(t, q[i], v[i]);
+    if (ocp_solver.getSolverStatistics().convergence) ++num_converged;
+    total_iter += ocp_solver.getSolverStatistics().iter;
+  }
+  timer.tock();
+  const double sequential_time = timer.ms();
+  printResult("sequential (stage-parallel, nthreads: " + std::to_string(nthreads) + ")",
+              num_converged, num_instances, total_iter, sequential_time, 0);
+
+  // Solver pool warm-started by the solution of the last converged request.
+  robotoc::OCPSolverPool pool(nthreads);
+  std::vector<robotoc::OCPSolverRequest> requests(num_instances);
+  for (int i=0; i<num_instances; ++i) {
+    requests[i].ocp = ocp;
+    requests[i].t = t;
+    requests[i].q = q[i];
+    requests[i].v = v[i];
+    requests[i].initial_guess["f"] = f_init;
+  }
+  // Constructs the solvers in advance.
+  pool.reserve(ocp, nthreads);
+  timer.tick();
+  auto results = pool.solve(requests);
+  timer.tock();
+  num_converged = 0;
+  total_iter = 0;
+  for (const auto& e : results) {
+    if (e.statistics.convergence) ++num_converged;
+    total_iter += e.statistics.iter;
+  }
+  printResult("solver pool (nworkers: " + std::to_string(nthreads) + ")",
+              num_converged, num_instances, total_iter, timer.ms(),
+              sequential_time);
+
+  // Solver pool warm-started by the solution of the nominal problem. The 
+  // perturbed problems do not replace the warm start, so all of them start 
+  // from the same initial guess.
+  timer.tick();
+  ocp_solver.setSolution("q", q_standing);
+  ocp_solver.setSolution("v", v_standing);
+  ocp_solver.setSolution("f", f_init);
+  ocp_solver.solve(t, q_standing, v_standing);
+  pool.setWarmStart(ocp, ocp_solver.getSolution());
+  for (auto& e : requests) {
+    e.update_warm_start = false;
+  }
+  results = pool.solve(requests);
+  timer.tock();
+  num_converged = 0;
+  total_iter = 0;
+  for (const auto& e : results) {
+    if (e.statistics.convergence) ++num_converged;
+    total_iter += e.statistics.iter;
+  }
+  printResult("solver pool from nominal (nworkers: " + std::to_string(nthreads) + ")",
+              num_converged, num_instances, total_iter, timer.ms(),
+              sequential_time);
+  return 0;
+}
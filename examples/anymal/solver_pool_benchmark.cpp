@@ -0,0 +1,193 @@
+#include <string>
+#include <memory>
+#include <vector>
+#include <future>
+#include <iostream>
+
+#include "Eigen/Core"
+
+#include "robotoc/solver/ocp_solver.hpp"
+#include "robotoc/solver/ocp_solver_pool.hpp"
+#include "robotoc/ocp/ocp.hpp"
+#include "robotoc/robot/robot.hpp"
+#include "robotoc/hybrid/contact_sequence.hpp"
+#include "robotoc/cost/cost_function.hpp"
+#include "robotoc/cost/configuration_space_cost.hpp"
+#include "robotoc/cost/com_cost.hpp"
+#include "robotoc/cost/periodic_com_ref.hpp"
+#include "robotoc/constraints/constraints.hpp"
+#include "robotoc/constraints/joint_position_lower_limit.hpp"
+#include "robotoc/constraints/joint_position_upper_limit.hpp"
+#include "robotoc/constraints/joint_velocity_lower_limit.hpp"
+#include "robotoc/constraints/joint_velocity_upper_limit.hpp"
+#include "robotoc/constraints/joint_torques_lower_limit.hpp"
+#include "robotoc/constraints/joint_torques_upper_limit.hpp"
+#include "robotoc/constraints/friction_cone.hpp"
+#include "robotoc/solver/solver_options.hpp"
+#include "robotoc/utils/timer.hpp"
+
+
+// Cost function of the jump of the given length. The cost function is shared
+// by all the requests of the same jump length, i.e., of the same signature.
+std::shared_ptr<robotoc::CostFunction> createJumpCost(
+    robotoc::Robot& robot, const Eigen::VectorXd& q_standing,
+    const Eigen::Vector3d& jump_length, const double ground_time,
+    const double flying_time) {
+  auto cost = std::make_shared<robotoc::CostFunction>();
+  Eigen::VectorXd q_weight(Eigen::VectorXd::Zero(robot.dimv()));
+  q_weight << 0, 0, 0, 250000, 250000, 250000,
+              0.0001, 0.0001, 0.0001,
+              0.0001, 0.0001, 0.0001,
+              0.0001, 0.0001, 0.0001,
+              0.0001, 0.0001, 0.0001;
+  Eigen::VectorXd v_weight(Eigen::VectorXd::Constant(robot.dimv(), 1));
+  v_weight.head(6).setConstant(100);
+  auto config_cost = std::make_shared<robotoc::ConfigurationSpaceCost>(robot);
+  config_cost->set_q_ref(q_standing);
+  config_cost->set_q_weight(q_weight);
+  config_cost->set_q_weight_terminal(q_weight);
+  config_cost->set_q_weight_impulse(Eigen::VectorXd::Constant(robot.dimv(), 100));
+  config_cost->set_v_weight(v_weight);
+  config_cost->set_v_weight_terminal(v_weight);
+  config_cost->set_v_weight_impulse(Eigen::VectorXd::Constant(robot.dimv(), 100));
+  config_cost->set_u_weight(Eigen::VectorXd::Constant(robot.dimu(), 1e-01));
+  cost->push_back(config_cost);
+  robot.updateFrameKinematics(q_standing);
+  const Eigen::Vector3d com_ref0_landed = robot.CoM() + jump_length;
+  auto com_ref_landed = std::make_shared<robotoc::PeriodicCoMRef>(
+      com_ref0_landed, Eigen::Vector3d::Zero(), ground_time+flying_time,
+      ground_time, ground_time+flying_time, false);
+  auto com_cost_landed = std::make_shared<robotoc::CoMCost>(robot, com_ref_landed);
+  com_cost_landed->set_weight(Eigen::Vector3d::Constant(1.0e06));
+  cost->push_back(com_cost_landed);
+  return cost;
+}
+
+
+int main(int argc, char *argv[]) {
+  const std::string path_to_urdf = "../anymal_b_simple_description/urdf/anymal.urdf";
+  const std::vector<std::string> contact_frames = {"LF_FOOT", "LH_FOOT", "RF_FOOT", "RH_FOOT"};
+  const std::vector<robotoc::ContactType> contact_types(4, robotoc::ContactType::PointContact);
+  const double baumgarte_time_step = 0.04;
+  robotoc::Robot robot(path_to_urdf, robotoc::BaseJointType::FloatingBase,
+                       contact_frames, contact_types, baumgarte_time_step);
+  Eigen::VectorXd q_standing(Eigen::VectorXd::Zero(robot.dimq()));
+  q_standing << 0, 0, 0.4792, 0, 0, 0, 1,
+                -0.1,  0.7, -1.0,
+                -0.1, -0.7,  1.0,
+                 0.1,  0.7, -1.0,
+                 0.1, -0.7,  1.0;
+  const Eigen::VectorXd v_standing(Eigen::VectorXd::Zero(robot.dimv()));
+  const double ground_time = 0.30;
+  const double flying_time = 0.30;
+  const double T = flying_time + 2 * ground_time;
+  const int N = 90;
+
+  auto constraints = std::make_shared<robotoc::Constraints>(1.0e-03, 0.995);
+  constraints->push_back(std::make_shared<robotoc::JointPositionLowerLimit>(robot));
+  constraints->push_back(std::make_shared<robotoc::JointPositionUpperLimit>(robot));
+  constraints->push_back(std::make_shared<robotoc::JointVelocityLowerLimit>(robot));
+  constraints->push_back(std::make_shared<robotoc::JointVelocityUpperLimit>(robot));
+  constraints->push_back(std::make_shared<robotoc::JointTorquesLowerLimit>(robot));
+  constraints->push_back(std::make_shared<robotoc::JointTorquesUpperLimit>(robot));
+  constraints->push_back(std::make_shared<robotoc::FrictionCone>(robot, 0.7));
+
+  // Requests: jumps of different lengths (different signatures) and different
+  // lift-off times (different contact sequences of the same signature).
+  const std::vector<double> jump_lengths = {0.3, 0.5};
+  const std::vector<double> lift_off_time_offsets = {-0.04, -0.02, 0.0, 0.02, 0.04};
+  const int num_repetitions = 4;
+  robot.updateFrameKinematics(q_standing);
+  std::vector<Eigen::Vector3d> x3d0;
+  for (const auto& e : contact_frames) {
+    x3d0.push_back(robot.framePosition(e));
+  }
+  Eigen::Vector3d f_init;
+  f_init << 0, 0, 0.25*robot.totalWeight();
+  std::vector<robotoc::OCPSolverRequest> requests;
+  for (const auto jump_length_x : jump_lengths) {
+    const Eigen::Vector3d jump_length = {jump_length_x, 0, 0};
+    auto cost = createJumpCost(robot, q_standing, jump_length, ground_time,
+                               flying_time);
+    for (const auto offset : lift_off_time_offsets) {
+      auto contact_sequence = std::make_shared<robotoc::ContactSequence>(robot);
+      auto contact_status_standing = robot.createContactStatus();
+      contact_status_standing.activateContacts({0, 1, 2, 3});
+      contact_status_standing.setContactPlacements(x3d0);
+      contact_sequence->init(contact_status_standing);
+      contact_sequence->push_back(robot.createContactStatus(),
+                                  ground_time+offset);
+      std::vector<Eigen::Vector3d> x3d_landed = x3d0;
+      for (auto& e : x3d_landed) { e += jump_length; }
+      contact_status_standing.setContactPlacements(x3d_landed);
+      contact_sequence->push_back(contact_status_standing,
+                                  ground_time+flying_time);
+      robotoc::OCPSolverRequest request;
+      request.ocp = robotoc::OCP(robot, cost, constraints, contact_sequence, T, N);
+      request.t = 0;
+      request.q = q_standing;
+      request.v = v_standing;
+      request.initial_guess["f"] = f_init;
+      for (int i=0; i<num_repetitions; ++i) {
+        requests.push_back(request);
+      }
+    }
+  }
+  const int num_requests = requests.size();
+
+  // Construct-per-request: the current usage of the offline planners.
+  robotoc::Timer timer;
+  timer.tick();
+  int num_converged = 0;
+  for (const auto& request : requests) {
+    robotoc::OCPSolver ocp_solver(request.ocp, request.solver_options);
+    ocp_solver.setSolution("q", request.q);
+    ocp_solver.setSolution("v", request.v);
+    ocp_solver.setSolution("f", f_init);
+    ocp_solver.solve(request.t, request.q, request.v);
+    if (ocp_solver.getSolverStatistics().convergence) ++num_converged;
+  }
+  timer.tock();
+  const double construct_per_request_time = timer.ms();
+  std::cout << "---------- construct-per-request ----------" << std::endl;
+  std::cout << "converged: " << num_converged << "/" << num_requests << std::endl;
+  std::cout << "total time: " << construct_per_request_time << " [ms]" << std::endl;
+  std::cout << "throughput: " << 1000.0*num_requests/construct_per_request_time
+            << " [requests/s]" << std::endl;
+
+  const std::vector<int> nworkers_list = {1, 2, 4};
+  for (const auto nworkers : nworkers_list) {
+    for (const bool use_warm_start : {false, true}) {
+      robotoc::OCPSolverPool pool(nworkers);
+      for (auto& e : requests) {
+        e.use_warm_start = use_warm_start;
+      }
+      // Warm-up pass that constructs the solvers and the warm starts.
+      pool.solve(requests);
+      timer.tick();
+      std::vector<std::future<robotoc::OCPSolverResult>> futures;
+      for (const auto& e : requests) {
+        futures.push_back(pool.submit(e));
+      }
+      num_converged = 0;
+      double total_iter = 0;
+      for (auto& e : futures) {
+        const auto result = e.get();
+        if (result.statistics.convergence) ++num_converged;
+        total_iter += result.statistics.iter;
+      }
+      timer.tock();
+      std::cout << "---------- solver pool (nworkers: " << nworkers
+                << ", warm start: " << std::boolalpha << use_warm_start
+                << ") ----------" << std::endl;
+      std::cout << "pooled solvers: " << pool.numSolvers() << std::endl;
+      std::cout << "converged: " << num_converged << "/" << num_requests << std::endl;
+      std::cout << "average iterations: " << total_iter/num_requests << std::endl;
+      std::cout << "total time: " << timer.ms() << " [ms]" << std::endl;
+      std::cout << "throughput: " << 1000.0*num_requests/timer.ms()
+                << " [requests/s]" << std::endl;
+      std::cout << "speedup: " << construct_per_request_time/timer.ms() << std::endl;
+    }
+  }
+  return 0;
+}
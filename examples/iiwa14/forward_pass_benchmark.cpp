@@ -0,0 +1,106 @@
+#include <string>
+#include <memory>
+#include <vector>
+#include <chrono>
+#include <iostream>
+
+#include "Eigen/Core"
+
+#include "robotoc/ocp/ocp.hpp"
+#include "robotoc/solver/ocp_solver.hpp"
+#include "robotoc/unconstr/unconstr_ocp.hpp"
+#include "robotoc/solver/unconstr_ocp_solver.hpp"
+#include "robotoc/robot/robot.hpp"
+#include "robotoc/cost/cost_function.hpp"
+#include "robotoc/cost/configuration_space_cost.hpp"
+#include "robotoc/constraints/constraints.hpp"
+#include "robotoc/constraints/joint_position_lower_limit.hpp"
+#include "robotoc/constraints/joint_position_upper_limit.hpp"
+#include "robotoc/constraints/joint_velocity_lower_limit.hpp"
+#include "robotoc/constraints/joint_velocity_upper_limit.hpp"
+#include "robotoc/constraints/joint_torques_lower_limit.hpp"
+#include "robotoc/constraints/joint_torques_upper_limit.hpp"
+#include "robotoc/ocp/forward_pass_method.hpp"
+
+
+template <typename SolverType>
+void printResult(const std::string& name, SolverType& solver,
+                 const double t, const Eigen::VectorXd& q,
+                 const Eigen::VectorXd& v, const int num_trials) {
+  double total_time = 0;
+  for (int i=0; i<num_trials; ++i) {
+    solver.setSolution("q", q);
+    solver.setSolution("v", v);
+    solver.setSolution("a", Eigen::VectorXd::Zero(v.size()));
+    const auto start_clock = std::chrono::high_resolution_clock::now();
+    solver.solve(t, q, v);
+    const auto end_clock = std::chrono::high_resolution_clock::now();
+    const std::chrono::duration<double, std::milli> timing = end_clock - start_clock;
+    total_time += timing.count();
+  }
+  const auto& statistics = solver.getSolverStatistics();
+  std::cout << name << ": converged: " << std::boolalpha << statistics.convergence
+            << ", iterations: " << statistics.iter
+            << ", CPU time: " << total_time / num_trials << " [ms]" << std::endl;
+}
+
+
+int main() {
+  // Create a robot.
+  const std::string path_to_urdf = "../iiwa_description/urdf/iiwa14.urdf";
+  robotoc::Robot robot(path_to_urdf);
+
+  // Create a cost function.
+  robot.setJointEffortLimit(Eigen::VectorXd::Constant(robot.dimu(), 200));
+  auto cost = std::make_shared<robotoc::CostFunction>();
+  auto config_cost = std::make_shared<robotoc::ConfigurationSpaceCost>(robot);
+  config_cost->set_q_ref(Eigen::VectorXd::Constant(robot.dimv(), -5));
+  config_cost->set_v_ref(Eigen::VectorXd::Constant(robot.dimv(), -9));
+  config_cost->set_q_weight(Eigen::VectorXd::Constant(robot.dimv(), 10));
+  config_cost->set_q_weight_terminal(Eigen::VectorXd::Constant(robot.dimv(), 10));
+  config_cost->set_v_weight(Eigen::VectorXd::Constant(robot.dimv(), 0.1));
+  config_cost->set_v_weight_terminal(Eigen::VectorXd::Constant(robot.dimv(), 0.1));
+  config_cost->set_a_weight(Eigen::VectorXd::Constant(robot.dimv(), 0.01));
+  cost->push_back(config_cost);
+
+  // Create joint constraints.
+  const double barrier = 1.0e-03;
+  const double fraction_to_boundary_rule = 0.995;
+  auto constraints = std::make_shared<robotoc::Constraints>(barrier, fraction_to_boundary_rule);
+  constraints->push_back(std::make_shared<robotoc::JointPositionLowerLimit>(robot));
+  constraints->push_back(std::make_shared<robotoc::JointPositionUpperLimit>(robot));
+  constraints->push_back(std::make_shared<robotoc::JointVelocityLowerLimit>(robot));
+  constraints->push_back(std::make_shared<robotoc::JointVelocityUpperLimit>(robot));
+  constraints->push_back(std::make_shared<robotoc::JointTorquesLowerLimit>(robot));
+  constraints->push_back(std::make_shared<robotoc::JointTorquesUpperLimit>(robot));
+
+  auto contact_sequence = std::make_shared<robotoc::ContactSequence>(robot);
+  const double t = 0;
+  const Eigen::VectorXd q = Eigen::VectorXd::Constant(robot.dimq(), 2);
+  const Eigen::VectorXd v = Eigen::VectorXd::Zero(robot.dimv());
+  const double T = 1.0;
+  const int N = 50;
+  const int nthreads = 4;
+  const int num_trials = 10;
+  robotoc::OCP ocp(robot, cost, constraints, contact_sequence, T, N);
+  robotoc::UnconstrOCP unconstr_ocp(robot, cost, constraints, T, N);
+
+  std::cout << "---------- Forward pass benchmark ----------" << std::endl;
+  for (const auto method : {robotoc::ForwardPassMethod::LinearStep,
+                            robotoc::ForwardPassMethod::NonlinearRollout}) {
+    auto solver_options = robotoc::SolverOptions::defaultOptions();
+    solver_options.forward_pass_method = method;
+    solver_options.max_iter = 200;
+    const std::string method_name
+        = (method == robotoc::ForwardPassMethod::LinearStep)
+            ? "linear step" : "nonlinear rollout";
+    robotoc::OCPSolver ocp_solver(ocp, solver_options, nthreads);
+    ocp_solver.initConstraints(t);
+    printResult("OCPSolver, " + method_name, ocp_solver, t, q, v, num_trials);
+    robotoc::UnconstrOCPSolver unconstr_ocp_solver(unconstr_ocp, solver_options,
+                                                   nthreads);
+    printResult("UnconstrOCPSolver, " + method_name, unconstr_ocp_solver,
+                t, q, v, num_trials);
+  }
+  return 0;
+}
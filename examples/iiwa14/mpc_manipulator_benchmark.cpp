@@ -0,0 +1,82 @@
+#include <string>
+#include <iostream>
+#include <algorithm>
+
+#include "Eigen/Core"
+
+#include "robotoc/robot/robot.hpp"
+#include "robotoc/mpc/mpc_manipulator.hpp"
+#include "robotoc/solver/solver_options.hpp"
+#include "robotoc/utils/timer.hpp"
+
+
+// Runs the MPC in closed loop at 1 kHz, in which the state of the next tick
+// is integrated from the initial stage of the MPC solution, i.e., the model
+// is assumed to be perfect.
+void runClosedLoop(const std::string& name, const robotoc::Robot& robot,
+                   const std::string& ee_frame, const int N, const int nthreads,
+                   const int num_iter) {
+  const double T = 0.5;
+  robotoc::MPCManipulator mpc(robot, ee_frame, T, N, nthreads);
+  Eigen::VectorXd q(Eigen::VectorXd::Zero(robot.dimq()));
+  q << 0, M_PI_2, 0, M_PI_2, 0, M_PI_2, 0;
+  Eigen::VectorXd v(Eigen::VectorXd::Zero(robot.dimv()));
+  mpc.setJointSpaceTarget(q);
+  const Eigen::Vector3d position_ref = {0.4, 0.2, 0.6};
+  const Eigen::Matrix3d rotation_ref = Eigen::Matrix3d::Identity();
+  mpc.setTaskSpaceTarget(position_ref, rotation_ref);
+
+  double t = 0.0;
+  auto option_init = robotoc::SolverOptions::defaultOptions();
+  option_init.max_iter = 50;
+  mpc.init(t, q, v, option_init);
+  auto option_mpc = robotoc::SolverOptions::defaultOptions();
+  option_mpc.max_iter = num_iter;
+  mpc.setSolverOptions(option_mpc);
+
+  const double dt = 0.001;
+  const double sim_time = 2.0;
+  const int num_ticks = sim_time / dt;
+  robotoc::Timer timer;
+  double total_time = 0;
+  double max_time = 0;
+  double total_kkt_error = 0;
+  for (int i=0; i<num_ticks; ++i) {
+    // Switch the task-space target in the middle of the simulation.
+    if (i == num_ticks/2) {
+      mpc.setTaskSpaceTarget(position_ref-Eigen::Vector3d(0, 0.4, 0),
+                             rotation_ref);
+    }
+    timer.tick();
+    mpc.updateSolution(t, dt, q, v);
+    timer.tock();
+    total_time += timer.ms();
+    max_time = std::max(max_time, timer.ms());
+    total_kkt_error += mpc.KKTError();
+    const auto& s = mpc.getSolution(0);
+    q.noalias() += dt * s.v;
+    v.noalias() += dt * s.a;
+    t += dt;
+  }
+  std::cout << "---------- " << name << " ----------" << std::endl;
+  std::cout << "average KKT error: " << total_kkt_error/num_ticks << std::endl;
+  std::cout << "average CPU time per tick: " << total_time/num_ticks
+            << " [ms]" << std::endl;
+  std::cout << "maximum CPU time per tick: " << max_time << " [ms]" << std::endl;
+  std::cout << "achievable rate: " << 1.0/(total_time/num_ticks)
+            << " [kHz]" << std::endl;
+}
+
+
+int main() {
+  const std::string path_to_urdf = "../iiwa_description/urdf/iiwa14.urdf";
+  robotoc::Robot robot(path_to_urdf);
+  robot.setJointEffortLimit(Eigen::VectorXd::Constant(robot.dimu(), 200));
+  const std::string ee_frame = "iiwa_link_ee_kuka";
+
+  const int N = 20;
+  runClosedLoop("1 thread, 1 iteration", robot, ee_frame, N, 1, 1);
+  runClosedLoop("2 threads, 1 iteration", robot, ee_frame, N, 2, 1);
+  runClosedLoop("2 threads, 2 iterations", robot, ee_frame, N, 2, 2);
+  return 0;
+}
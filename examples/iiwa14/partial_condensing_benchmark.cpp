@@ -0,0 +1,91 @@
+#include <string>
+#include <memory>
+#include <vector>
+#include <chrono>
+#include <iostream>
+
+#include "Eigen/Core"
+
+#include "robotoc/ocp/ocp.hpp"
+#include "robotoc/solver/ocp_solver.hpp"
+#include "robotoc/robot/robot.hpp"
+#include "robotoc/cost/cost_function.hpp"
+#include "robotoc/cost/configuration_space_cost.hpp"
+#include "robotoc/constraints/constraints.hpp"
+#include "robotoc/constraints/joint_position_lower_limit.hpp"
+#include "robotoc/constraints/joint_position_upper_limit.hpp"
+#include "robotoc/constraints/joint_velocity_lower_limit.hpp"
+#include "robotoc/constraints/joint_velocity_upper_limit.hpp"
+#include "robotoc/constraints/joint_torques_lower_limit.hpp"
+#include "robotoc/constraints/joint_torques_upper_limit.hpp"
+#include "robotoc/riccati/partial_condensing.hpp"
+
+
+int main() {
+  // Create a robot.
+  const std::string path_to_urdf = "../iiwa_description/urdf/iiwa14.urdf";
+  robotoc::Robot robot(path_to_urdf);
+
+  // Create a cost function.
+  robot.setJointEffortLimit(Eigen::VectorXd::Constant(robot.dimu(), 200));
+  auto cost = std::make_shared<robotoc::CostFunction>();
+  auto config_cost = std::make_shared<robotoc::ConfigurationSpaceCost>(robot);
+  config_cost->set_q_ref(Eigen::VectorXd::Constant(robot.dimv(), -5));
+  config_cost->set_v_ref(Eigen::VectorXd::Constant(robot.dimv(), -9));
+  config_cost->set_q_weight(Eigen::VectorXd::Constant(robot.dimv(), 10));
+  config_cost->set_q_weight_terminal(Eigen::VectorXd::Constant(robot.dimv(), 10));
+  config_cost->set_v_weight(Eigen::VectorXd::Constant(robot.dimv(), 0.1));
+  config_cost->set_v_weight_terminal(Eigen::VectorXd::Constant(robot.dimv(), 0.1));
+  config_cost->set_a_weight(Eigen::VectorXd::Constant(robot.dimv(), 0.01));
+  cost->push_back(config_cost);
+
+  // Create joint constraints.
+  const double barrier = 1.0e-03;
+  const double fraction_to_boundary_rule = 0.995;
+  auto constraints = std::make_shared<robotoc::Constraints>(barrier, fraction_to_boundary_rule);
+  constraints->push_back(std::make_shared<robotoc::JointPositionLowerLimit>(robot));
+  constraints->push_back(std::make_shared<robotoc::JointPositionUpperLimit>(robot));
+  constraints->push_back(std::make_shared<robotoc::JointVelocityLowerLimit>(robot));
+  constraints->push_back(std::make_shared<robotoc::JointVelocityUpperLimit>(robot));
+  constraints->push_back(std::make_shared<robotoc::JointTorquesLowerLimit>(robot));
+  constraints->push_back(std::make_shared<robotoc::JointTorquesUpperLimit>(robot));
+
+  auto contact_sequence = std::make_shared<robotoc::ContactSequence>(robot);
+  const double t = 0;
+  const Eigen::VectorXd q = Eigen::VectorXd::Constant(robot.dimq(), 2);
+  const Eigen::VectorXd v = Eigen::VectorXd::Zero(robot.dimv());
+  const int nthreads = 4;
+  const int num_iteration = 1000;
+
+  // Block size 0 means the default block size.
+  const std::vector<int> horizon_lengths = {20, 50, 100};
+  const std::vector<int> block_sizes = {1, 2, 4, 8, 0};
+  std::cout << "Default block size: "
+            << robotoc::PartialCondensing::defaultBlockSize(robot) << std::endl;
+  std::cout << "---------- Partial condensing benchmark : CPU time per update [ms] ----------" << std::endl;
+  for (const int N : horizon_lengths) {
+    const double T = 0.05 * N;
+    robotoc::OCP ocp(robot, cost, constraints, contact_sequence, T, N);
+    for (const int block_size : block_sizes) {
+      auto solver_options = robotoc::SolverOptions::defaultOptions();
+      solver_options.partial_condensing_block_size = block_size;
+      robotoc::OCPSolver ocp_solver(ocp, solver_options, nthreads);
+      ocp_solver.setSolution("q", q);
+      ocp_solver.setSolution("v", v);
+      ocp_solver.initConstraints(t);
+      ocp_solver.solve(t, q, v);
+      const double kkt_error = ocp_solver.KKTError(t, q, v);
+      const auto start_clock = std::chrono::high_resolution_clock::now();
+      for (int i=0; i<num_iteration; ++i) {
+        ocp_solver.updateSolution(t, q, v);
+      }
+      const auto end_clock = std::chrono::high_resolution_clock::now();
+      const std::chrono::duration<double, std::milli> timing = end_clock - start_clock;
+      std::cout << "N = " << N << ", M = " << block_size
+                << ": " << timing.count() / num_iteration
+                << ", KKT error after convergence: " << kkt_error << std::endl;
+    }
+  }
+
+  return 0;
+}
@@ -0,0 +1,149 @@
+#include <string>
+#include <memory>
+#include <chrono>
+#include <iostream>
+
+#include "Eigen/Core"
+
+#include "robotoc/ocp/ocp.hpp"
+#include "robotoc/solver/ocp_solver.hpp"
+#include "robotoc/robot/robot.hpp"
+#include "robotoc/cost/cost_function.hpp"
+#include "robotoc/cost/configuration_space_cost.hpp"
+#include "robotoc/cost/terminal_lqr_cost.hpp"
+#include "robotoc/constraints/constraints.hpp"
+#include "robotoc/constraints/joint_position_lower_limit.hpp"
+#include "robotoc/constraints/joint_position_upper_limit.hpp"
+#include "robotoc/constraints/joint_velocity_lower_limit.hpp"
+#include "robotoc/constraints/joint_velocity_upper_limit.hpp"
+#include "robotoc/constraints/joint_torques_lower_limit.hpp"
+#include "robotoc/constraints/joint_torques_upper_limit.hpp"
+
+
+struct ClosedLoopResult {
+  double cost;
+  double cpu_time_per_update;
+};
+
+
+// Simulates the closed-loop system with the MPC whose horizon is dt * N. The
+// closed-loop performance is measured by the stage cost accumulated along
+// the simulated trajectory.
+ClosedLoopResult runClosedLoop(robotoc::Robot& robot, const int N,
+                               const double dt, const bool use_terminal_lqr) {
+  const Eigen::VectorXd q_weight = Eigen::VectorXd::Constant(robot.dimv(), 10);
+  const Eigen::VectorXd v_weight = Eigen::VectorXd::Constant(robot.dimv(), 0.1);
+  const Eigen::VectorXd a_weight = Eigen::VectorXd::Constant(robot.dimv(), 0.01);
+  Eigen::VectorXd q_ref(Eigen::VectorXd::Zero(robot.dimq()));
+  q_ref << 0, M_PI_2, 0, M_PI_2, 0, M_PI_2, 0;
+
+  auto cost = std::make_shared<robotoc::CostFunction>();
+  auto config_cost = std::make_shared<robotoc::ConfigurationSpaceCost>(robot);
+  config_cost->set_q_ref(q_ref);
+  config_cost->set_q_weight(q_weight);
+  config_cost->set_v_weight(v_weight);
+  config_cost->set_a_weight(a_weight);
+  cost->push_back(config_cost);
+  auto terminal_lqr_cost = std::make_shared<robotoc::TerminalLQRCost>(robot);
+  if (use_terminal_lqr) {
+    cost->push_back(terminal_lqr_cost);
+  }
+  else {
+    config_cost->set_q_weight_terminal(q_weight);
+    config_cost->set_v_weight_terminal(v_weight);
+  }
+
+  const double barrier = 1.0e-03;
+  const double fraction_to_boundary_rule = 0.995;
+  auto constraints = std::make_shared<robotoc::Constraints>(barrier, fraction_to_boundary_rule);
+  constraints->push_back(std::make_shared<robotoc::JointPositionLowerLimit>(robot));
+  constraints->push_back(std::make_shared<robotoc::JointPositionUpperLimit>(robot));
+  constraints->push_back(std::make_shared<robotoc::JointVelocityLowerLimit>(robot));
+  constraints->push_back(std::make_shared<robotoc::JointVelocityUpperLimit>(robot));
+  constraints->push_back(std::make_shared<robotoc::JointTorquesLowerLimit>(robot));
+  constraints->push_back(std::make_shared<robotoc::JointTorquesUpperLimit>(robot));
+
+  if (use_terminal_lqr) {
+    // The operating point is the equilibrium at the reference configuration.
+    robotoc::SplitSolution s(robot);
+    s.q = q_ref;
+    s.v.setZero();
+    s.a.setZero();
+    robot.RNEA(s.q, s.v, s.a, s.u);
+    terminal_lqr_cost->requestCostToGoUpdate(robot, cost, constraints,
+                                             robot.createContactStatus(), dt, s);
+    terminal_lqr_cost->synchronize(true);
+  }
+
+  auto contact_sequence = std::make_shared<robotoc::ContactSequence>(robot);
+  const double T = N * dt;
+  robotoc::OCP ocp(robot, cost, constraints, contact_sequence, T, N);
+  auto solver_options = robotoc::SolverOptions::defaultOptions();
+  const int nthreads = 4;
+  robotoc::OCPSolver ocp_solver(ocp, solver_options, nthreads);
+
+  double t = 0;
+  Eigen::VectorXd q(Eigen::VectorXd::Zero(robot.dimq()));
+  q << M_PI_2, 0, M_PI_2, 0, M_PI_2, 0, M_PI_2;
+  Eigen::VectorXd v = Eigen::VectorXd::Zero(robot.dimv());
+  ocp_solver.setSolution("q", q);
+  ocp_solver.setSolution("v", v);
+  ocp_solver.initConstraints(t);
+  ocp_solver.solve(t, q, v);
+
+  const double sim_time = 3.0;
+  const int num_sim_steps = static_cast<int>(sim_time/dt);
+  const int num_iteration_per_update = 1;
+  Eigen::VectorXd q_next(robot.dimq());
+  ClosedLoopResult result;
+  result.cost = 0;
+  result.cpu_time_per_update = 0;
+  for (int i=0; i<num_sim_steps; ++i) {
+    const auto time_begin = std::chrono::high_resolution_clock::now();
+    for (int j=0; j<num_iteration_per_update; ++j) {
+      ocp_solver.updateSolution(t, q, v);
+    }
+    const auto time_end = std::chrono::high_resolution_clock::now();
+    result.cpu_time_per_update
+        += 1.0e-03 * std::chrono::duration_cast<std::chrono::microseconds>(
+              time_end-time_begin).count();
+    const Eigen::VectorXd& a = ocp_solver.getSolution(0).a;
+    result.cost += 0.5 * dt * ((q_weight.array()*(q-q_ref).array().square()).sum()
+                                + (v_weight.array()*v.array().square()).sum()
+                                + (a_weight.array()*a.array().square()).sum());
+    robot.integrateConfiguration(q, v, dt, q_next);
+    v += dt * a;
+    q = q_next;
+    t += dt;
+  }
+  result.cpu_time_per_update /= num_sim_steps;
+  return result;
+}
+
+
+int main() {
+  // Create a robot.
+  const std::string path_to_urdf = "../iiwa_description/urdf/iiwa14.urdf";
+  robotoc::Robot robot(path_to_urdf);
+  robot.setJointEffortLimit(Eigen::VectorXd::Constant(robot.dimu(), 200));
+
+  const double dt = 0.02;
+  const int N_long = 50;
+  const int N_short = 10;
+  const auto long_horizon = runClosedLoop(robot, N_long, dt, false);
+  const auto short_horizon = runClosedLoop(robot, N_short, dt, false);
+  const auto short_horizon_lqr = runClosedLoop(robot, N_short, dt, true);
+
+  std::cout << "---------- Closed-loop performance of the MPC ----------" << std::endl;
+  std::cout << "N = " << N_long << " with terminal weights: closed-loop cost = "
+            << long_horizon.cost << ", CPU time per update = "
+            << long_horizon.cpu_time_per_update << " [ms]" << std::endl;
+  std::cout << "N = " << N_short << " with terminal weights: closed-loop cost = "
+            << short_horizon.cost << ", CPU time per update = "
+            << short_horizon.cpu_time_per_update << " [ms]" << std::endl;
+  std::cout << "N = " << N_short << " with terminal LQR cost: closed-loop cost = "
+            << short_horizon_lqr.cost << ", CPU time per update = "
+            << short_horizon_lqr.cpu_time_per_update << " [ms]" << std::endl;
+
+  return 0;
+}
@@ -1,5 +1,7 @@
 #include <string>
 #include <memory>
+#include <vector>
+#include <utility>
 
 #include "Eigen/Core"
 
@@ -16,6 +18,7 @@
 #include "robotoc/constraints/joint_torques_lower_limit.hpp"
 #include "robotoc/constraints/joint_torques_upper_limit.hpp"
 #include "robotoc/utils/ocp_benchmarker.hpp"
+#include "robotoc/utils/timer.hpp"
 
 
 int main() {
@@ -81,5 +84,67 @@ int main() {
   const int num_iteration_CPU = 10000;
   robotoc::benchmark::CPUTime(parnmpc_solver, t, q, v, num_iteration_CPU);
 
+  // Compares the initialization methods of the auxiliary matrices in terms of 
+  // the number of iterations and the CPU time, including a solve after a large 
+  // jump of the initial state and a warm-started solve after the horizon moves 
+  // forward. The refresh of the auxiliary matrices runs synchronously in 
+  // initBackwardCorrection(), so its latency is added to that of the solve and 
+  // is reported separately.
+  const std::vector<std::pair<std::string, robotoc::AuxMatInitialization>> 
+      aux_mat_initializations 
+          = {{"terminal-cost-Hessian", robotoc::AuxMatInitialization::TerminalCostHessian}, 
+             {"terminal-LQR", robotoc::AuxMatInitialization::TerminalLQR}, 
+             {"Riccati", robotoc::AuxMatInitialization::Riccati}, 
+             {"shift", robotoc::AuxMatInitialization::Shift}};
+  const Eigen::VectorXd q_jump = q + Eigen::VectorXd::Constant(robot.dimq(), 0.5);
+  solver_options.enable_benchmark = true;
+  for (const auto& e : aux_mat_initializations) {
+    solver_options.aux_mat_initialization = e.second;
+    robotoc::UnconstrParNMPCSolver solver(parnmpc, solver_options, nthreads);
+    solver.setSolution("q", q);
+    solver.setSolution("v", v);
+    solver.solve(t, q, v);
+    const int iter_cold = solver.getSolverStatistics().iter;
+    const double cpu_time_cold = solver.getSolverStatistics().cpu_time;
+    solver.solve(t+T/N, q_jump, v);
+    const int iter_jump = solver.getSolverStatistics().iter;
+    const double cpu_time_jump = solver.getSolverStatistics().cpu_time;
+    solver.solve(t+2*T/N, solver.getSolution(0).q, solver.getSolution(0).v, 
+                 false);
+    const int iter_warm = solver.getSolverStatistics().iter;
+    const double cpu_time_warm = solver.getSolverStatistics().cpu_time;
+    const int num_refresh = 1000;
+    robotoc::Timer timer;
+    timer.tick();
+    for (int i=0; i<num_refresh; ++i) {
+      solver.initBackwardCorrection(t+(i+3)*T/N);
+    }
+    timer.tock();
+    std::cout << e.first << ": " 
+              << "cold start: " << iter_cold << " iterations, " 
+              << cpu_time_cold << " [ms], "
+              << "after state jump: " << iter_jump << " iterations, " 
+              << cpu_time_jump << " [ms], "
+              << "warm start: " << iter_warm << " iterations, " 
+              << cpu_time_warm << " [ms], "
+              << "synchronous refresh latency: " << timer.ms()/num_refresh 
+              << " [ms]" << std::endl;
+  }
+  solver_options.aux_mat_initialization 
+      = robotoc::AuxMatInitialization::TerminalCostHessian;
+
+  // Compares the number of the blocks of the backward correction, from the 
+  // exact Riccati recursion (1 block) to the stage-wise ParNMPC (N blocks).
+  for (const int num_blocks : {1, 2, 4, nthreads, N}) {
+    solver_options.num_blocks_parnmpc = num_blocks;
+    robotoc::UnconstrParNMPCSolver solver(parnmpc, solver_options, nthreads);
+    solver.setSolution("q", q);
+    solver.setSolution("v", v);
+    solver.solve(t, q, v);
+    std::cout << num_blocks << " blocks: " 
+              << solver.getSolverStatistics().iter << " iterations, " 
+              << solver.getSolverStatistics().cpu_time << " [ms]" << std::endl;
+  }
+
   return 0;
 }
\ No newline at end of file
@@ -0,0 +1,277 @@
+#ifndef ROBOTOC_COLLISION_AVOIDANCE_HPP_
+#define ROBOTOC_COLLISION_AVOIDANCE_HPP_
+
+#include <vector>
+#include <utility>
+
+#include "Eigen/Core"
+
+#include "robotoc/robot/robot.hpp"
+#include "robotoc/robot/contact_status.hpp"
+#include "robotoc/ocp/split_solution.hpp"
+#include "robotoc/ocp/split_direction.hpp"
+#include "robotoc/constraints/constraint_component_base.hpp"
+#include "robotoc/constraints/constraint_component_data.hpp"
+#include "robotoc/ocp/split_kkt_residual.hpp"
+#include "robotoc/ocp/split_kkt_matrix.hpp"
+
+
+namespace robotoc {
+
+///
+/// @class CollisionAvoidance
+/// @brief Constraint on the distances between collision spheres, i.e.,
+/// ||p_1 - p_2|| - r_1 - r_2 >= min_distance, where p_1, p_2 are the centers
+/// and r_1, r_2 are the radii of the spheres. Each sphere is either attached
+/// to a frame of the robot (self-collision) or fixed in the world
+/// (environment). A sweep-and-prune broad phase along the x-axis selects the
+/// pairs whose distances are smaller than the activation distance. The order
+/// of the spheres in the sweep is kept in ConstraintComponentData so that it
+/// is almost sorted over the iterations and MPC cycles. The distances and
+/// Jacobians are computed only for these pairs, and the other pairs are
+/// regarded as inactive, i.e., their primal residuals and Jacobians are zero.
+/// The slack and dual of an inactive pair are not tracked, so they are reset 
+/// to the values on the central path at the current distance when the pair 
+/// is activated.
+/// @note The spheres and pairs must be added before the optimal control
+/// problem is constructed with this constraint.
+///
+class CollisionAvoidance final : public ConstraintComponentBase {
+public:
+  ///
+  /// @brief Constructor.
+  /// @param[in] robot Robot model.
+  /// @param[in] min_distance Minimum distance between the spheres.
+  /// Default is 0.
+  /// @param[in] activation_distance Pairs whose distances are smaller than
+  /// this value are active. Must be larger than min_distance. Default is 0.1.
+  ///
+  CollisionAvoidance(const Robot& robot, const double min_distance=0.0,
+                     const double activation_distance=0.1);
+
+  ///
+  /// @brief Default constructor.
+  ///
+  CollisionAvoidance();
+
+  ///
+  /// @brief Destructor.
+  ///
+  ~CollisionAvoidance();
+
+  ///
+  /// @brief Default copy constructor.
+  ///
+  CollisionAvoidance(const CollisionAvoidance&) = default;
+
+  ///
+  /// @brief Default copy operator.
+  ///
+  CollisionAvoidance& operator=(const CollisionAvoidance&) = default;
+
+  ///
+  /// @brief Default move constructor.
+  ///
+  CollisionAvoidance(CollisionAvoidance&&) noexcept = default;
+
+  ///
+  /// @brief Default move assign operator.
+  ///
+  CollisionAvoidance& operator=(CollisionAvoidance&&) noexcept = default;
+
+  ///
+  /// @brief Adds a collision sphere attached to a frame of the robot.
+  /// @param[in] frame_id Index of the frame. See Robot::frameId() to get it
+  /// from the name of the frame.
+  /// @param[in] offset Center of the sphere expressed in the local
+  /// coordinate of the frame.
+  /// @param[in] radius Radius of the sphere. Must be non-negative.
+  /// @return Index of the sphere.
+  ///
+  int addCollisionSphere(const int frame_id, const Eigen::Vector3d& offset,
+                         const double radius);
+
+  ///
+  /// @brief Adds an obstacle sphere fixed in the world.
+  /// @param[in] center Center of the sphere in the world frame.
+  /// @param[in] radius Radius of the sphere. Must be non-negative.
+  /// @return Index of the sphere.
+  ///
+  int addObstacleSphere(const Eigen::Vector3d& center, const double radius);
+
+  ///
+  /// @brief Moves an obstacle sphere, e.g., between MPC cycles.
+  /// @param[in] sphere Index of the obstacle sphere.
+  /// @param[in] center Center of the sphere in the world frame.
+  ///
+  void setObstaclePosition(const int sphere, const Eigen::Vector3d& center);
+
+  ///
+  /// @brief Adds a pair of spheres whose distance is constrained. At least
+  /// one of the spheres must be attached to the robot.
+  /// @param[in] sphere1 Index of the first sphere.
+  /// @param[in] sphere2 Index of the second sphere.
+  ///
+  void addCollisionPair(const int sphere1, const int sphere2);
+
+  ///
+  /// @brief Adds the pairs of all the collision spheres attached to the robot
+  /// and all the obstacle spheres.
+  ///
+  void addEnvironmentCollisionPairs();
+
+  ///
+  /// @brief Returns the number of the spheres.
+  /// @return The number of the spheres.
+  ///
+  int numSpheres() const;
+
+  ///
+  /// @brief Returns the number of the collision pairs.
+  /// @return The number of the collision pairs.
+  ///
+  int numCollisionPairs() const;
+
+  ///
+  /// @brief Checks if a pair is active, i.e., its distance is smaller than
+  /// the activation distance, at the last evaluation.
+  /// @param[in] data Constraint component data.
+  /// @param[in] pair Index of the collision pair.
+  /// @return true if the pair is active and false if not.
+  ///
+  bool isActive(const ConstraintComponentData& data, const int pair) const;
+
+  ///
+  /// @brief Returns the distance of a pair at the last evaluation. Only valid
+  /// for active pairs.
+  /// @param[in] data Constraint component data.
+  /// @param[in] pair Index of the collision pair.
+  /// @return The distance between the surfaces of the spheres.
+  ///
+  double distance(const ConstraintComponentData& data, const int pair) const;
+
+  bool useKinematics() const override;
+
+  KinematicsLevel kinematicsLevel() const override;
+
+  void allocateExtraData(ConstraintComponentData& data) const override;
+
+  bool isFeasible(Robot& robot, const ContactStatus& contact_status,
+                  ConstraintComponentData& data,
+                  const SplitSolution& s) const override;
+
+  void setSlack(Robot& robot, const ContactStatus& contact_status,
+                ConstraintComponentData& data,
+                const SplitSolution& s) const override;
+
+  void evalConstraint(Robot& robot, const ContactStatus& contact_status,
+                      ConstraintComponentData& data,
+                      const SplitSolution& s) const override;
+
+  void evalDerivatives(Robot& robot, const ContactStatus& contact_status,
+                       ConstraintComponentData& data, const SplitSolution& s,
+                       SplitKKTResidual& kkt_residual) const override;
+
+  void condenseSlackAndDual(const ContactStatus& contact_status,
+                            ConstraintComponentData& data,
+                            SplitKKTMatrix& kkt_matrix,
+                            SplitKKTResidual& kkt_residual) const override;
+
+  void expandSlackAndDual(const ContactStatus& contact_status,
+                          ConstraintComponentData& data,
+                          const SplitDirection& d) const override;
+
+  int dimc() const override;
+
+private:
+  int dimv_;
+  double min_distance_, activation_distance_;
+  std::vector<int> sphere_frames_, sphere_frame_slots_, unique_frames_;
+  std::vector<Eigen::Vector3d> sphere_offsets_;
+  std::vector<double> sphere_radii_;
+  std::vector<std::pair<int, int>> pairs_;
+  Eigen::MatrixXi pair_index_;
+
+  // World positions of the spheres (size 3 * numSpheres()).
+  static Eigen::VectorXd& spherePositions(ConstraintComponentData& data) {
+    return data.r[0];
+  }
+
+  static const Eigen::VectorXd& spherePositions(
+      const ConstraintComponentData& data) {
+    return data.r[0];
+  }
+
+  // Distances of the pairs (size numCollisionPairs()).
+  static Eigen::VectorXd& distances(ConstraintComponentData& data) {
+    return data.r[1];
+  }
+
+  static const Eigen::VectorXd& distances(
+      const ConstraintComponentData& data) {
+    return data.r[1];
+  }
+
+  // 1 if the pair is active and 0 if not (size numCollisionPairs()).
+  static Eigen::VectorXd& activeFlags(ConstraintComponentData& data) {
+    return data.r[2];
+  }
+
+  static const Eigen::VectorXd& activeFlags(
+      const ConstraintComponentData& data) {
+    return data.r[2];
+  }
+
+  // 1 if the pair is active at the last linearization and 0 if not. The
+  // slack and dual of the pair are reset if it is activated after it is
+  // inactive at the last linearization (size numCollisionPairs()).
+  static Eigen::VectorXd& linearizedFlags(ConstraintComponentData& data) {
+    return data.r[3];
+  }
+
+  // Order of the spheres in the sweep-and-prune (size numSpheres()).
+  static std::vector<int>& sweepOrder(ConstraintComponentData& data) {
+    return data.index;
+  }
+
+  // 1 if the Jacobian of the frame is computed and 0 if not.
+  static Eigen::VectorXd& frameJacobianFlags(ConstraintComponentData& data) {
+    return data.r[4];
+  }
+
+  // Jacobians of the distances of the pairs (numCollisionPairs() x dimv).
+  static Eigen::MatrixXd& distanceJacobian(ConstraintComponentData& data) {
+    return data.J[0];
+  }
+
+  static const Eigen::MatrixXd& distanceJacobian(
+      const ConstraintComponentData& data) {
+    return data.J[0];
+  }
+
+  // Jacobian of the frame in the local coordinate (6 x dimv).
+  static Eigen::MatrixXd& frameJacobian(ConstraintComponentData& data,
+                                        const int frame_slot) {
+    return data.J[1+frame_slot];
+  }
+
+  void computeSpherePositions(const Robot& robot,
+                              ConstraintComponentData& data) const;
+
+  void computeDistances(ConstraintComponentData& data,
+                        const bool use_broad_phase) const;
+
+  void resetSlackAndDual(ConstraintComponentData& data, const int pair) const;
+
+  void computeDistanceJacobian(Robot& robot, ConstraintComponentData& data,
+                               const int pair) const;
+
+  void addSphereJacobian(Robot& robot, ConstraintComponentData& data,
+                         const int sphere, const Eigen::Vector3d& n,
+                         const int pair) const;
+
+};
+
+} // namespace robotoc
+
+#endif // ROBOTOC_COLLISION_AVOIDANCE_HPP_
@@ -173,10 +173,12 @@ public:
   virtual int dimc() const = 0;
 
   ///
-  /// @brief Sets the slack and dual variables positive.
+  /// @brief Sets the slack and dual variables positive. The default 
+  /// implementation is for the elementwise (nonnegative orthant) constraints.
+  /// Override this for other cones, e.g., the second-order cones.
   /// @param[in, out] data Constraint data.
   ///
-  void setSlackAndDualPositive(ConstraintComponentData& data) const;
+  virtual void setSlackAndDualPositive(ConstraintComponentData& data) const;
 
   ///
   /// @brief Computes and returns the maximum step size by applying 
@@ -184,7 +186,7 @@ public:
   /// @param[in] data Constraint data.
   /// @return Maximum step size regarding the slack variable.
   ///
-  double maxSlackStepSize(const ConstraintComponentData& data) const;
+  virtual double maxSlackStepSize(const ConstraintComponentData& data) const;
 
   ///
   /// @brief Computes and returns the maximum step size by applying 
@@ -192,7 +194,7 @@ public:
   /// @param[in] data Constraint data. 
   /// @return Maximum step size regarding the dual variable.
   ///
-  double maxDualStepSize(const ConstraintComponentData& data) const;
+  virtual double maxDualStepSize(const ConstraintComponentData& data) const;
 
   ///
   /// @brief Updates the slack variable according to the step size.
@@ -113,6 +113,12 @@ public:
   ///
   std::vector<Eigen::MatrixXd> J;
 
+  ///
+  /// @brief std vector of int used to store integer data, e.g., orderings, 
+  /// temporaly. Only be allocated in ConstraintComponentBase::allocateExtraData().
+  ///
+  std::vector<int> index;
+
   ///
   /// @brief Copies the slack and dual variables from another constraint 
   /// component data. this->dimc() and other.dimc() must be the same.
@@ -22,6 +22,7 @@ inline ConstraintComponentData::ConstraintComponentData(const int dimc,
     log_barrier(0),
     r(),
     J(),
+    index(),
     dimc_(dimc) {
   try {
     if (dimc <= 0) {
@@ -51,6 +52,7 @@ inline ConstraintComponentData::ConstraintComponentData()
     log_barrier(0),
     r(),
     J(),
+    index(),
     dimc_(0) {
 }
 
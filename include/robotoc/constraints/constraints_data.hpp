@@ -82,6 +82,20 @@ public:
   ///
   double KKTError() const;
 
+  ///
+  /// @brief Returns the sum of the squared norm of the primal residual of all 
+  /// the constraints. 
+  /// @return The sum of the squared norm of the primal residual.
+  ///
+  double primalResidualError() const;
+
+  ///
+  /// @brief Returns the sum of the squared norm of the complementary slackness
+  /// of all the constraints. 
+  /// @return The sum of the squared norm of the complementary slackness.
+  ///
+  double complementarityError() const;
+
   ///
   /// @brief Returns the sum of the log-barrier of the slack variables of all 
   /// the constraints. 
@@ -124,6 +124,58 @@ inline double ConstraintsData::KKTError() const {
 }
 
 
+inline double ConstraintsData::primalResidualError() const {
+  double err = 0.0;
+  if (isPositionLevelValid()) {
+    for (const auto& data : position_level_data) {
+      err += data.residual.squaredNorm();
+    }
+  }
+  if (isVelocityLevelValid()) {
+    for (const auto& data : velocity_level_data) {
+      err += data.residual.squaredNorm();
+    }
+  }
+  if (isAccelerationLevelValid()) {
+    for (const auto& data : acceleration_level_data) {
+      err += data.residual.squaredNorm();
+    }
+  }
+  if (isImpulseLevelValid()) {
+    for (const auto& data : impulse_level_data) {
+      err += data.residual.squaredNorm();
+    }
+  }
+  return err;
+}
+
+
+inline double ConstraintsData::complementarityError() const {
+  double err = 0.0;
+  if (isPositionLevelValid()) {
+    for (const auto& data : position_level_data) {
+      err += data.cmpl.squaredNorm();
+    }
+  }
+  if (isVelocityLevelValid()) {
+    for (const auto& data : velocity_level_data) {
+      err += data.cmpl.squaredNorm();
+    }
+  }
+  if (isAccelerationLevelValid()) {
+    for (const auto& data : acceleration_level_data) {
+      err += data.cmpl.squaredNorm();
+    }
+  }
+  if (isImpulseLevelValid()) {
+    for (const auto& data : impulse_level_data) {
+      err += data.cmpl.squaredNorm();
+    }
+  }
+  return err;
+}
+
+
 inline double ConstraintsData::logBarrier() const {
   double lb = 0.0;
   if (isPositionLevelValid()) {
@@ -0,0 +1,148 @@
+#ifndef ROBOTOC_CONSTRAINTS_SOC_PDIPM_HPP_
+#define ROBOTOC_CONSTRAINTS_SOC_PDIPM_HPP_
+
+#include "Eigen/Core"
+
+#include "robotoc/constraints/constraint_component_data.hpp"
+
+
+namespace robotoc {
+///
+/// @namespace socpdipm
+/// @brief Primal-dual interior point method for the 3-dimensional second-order
+/// cones K = {(t, x) | t >= ||x||}. The slack and dual variables of a cone are
+/// stored in the consecutive 3 elements of ConstraintComponentData, and the
+/// complementarity is s o z = barrier * e with the Jordan product o and
+/// e = (1, 0, 0). The Newton direction is computed with the Nesterov-Todd
+/// scaling so that the condensed Hessian is symmetric positive definite.
+///
+namespace socpdipm {
+
+///
+/// @brief Computes the determinant t^2 - ||x||^2 of a vector (t, x).
+/// @param[in] v A vector. Size must be 3.
+/// @return The determinant.
+///
+template <typename VectorType>
+double det(const Eigen::MatrixBase<VectorType>& v);
+
+///
+/// @brief Checks if a vector lies in the interior of the second-order cone.
+/// @param[in] v A vector. Size must be 3.
+/// @return true if v is in the interior of the cone and false if not.
+///
+template <typename VectorType>
+bool isInterior(const Eigen::MatrixBase<VectorType>& v);
+
+///
+/// @brief Sets the slack variable in the interior of the cone and sets the
+/// dual variable on the central path, i.e., s o z = barrier * e.
+/// @param[in] barrier Barrier parameter. Must be positive.
+/// @param[in, out] data Constraint component data.
+/// @param[in] start Start position of the cone.
+///
+void setSlackAndDualInterior(const double barrier,
+                             ConstraintComponentData& data, const int start);
+
+///
+/// @brief Computes the residual in the complementarity slackness between
+/// the slack and dual variables, i.e., s o z - barrier * e.
+/// @param[in] barrier Barrier parameter. Must be positive.
+/// @param[in, out] data Constraint component data.
+/// @param[in] start Start position of the cone.
+///
+void computeComplementarySlackness(const double barrier,
+                                   ConstraintComponentData& data,
+                                   const int start);
+
+///
+/// @brief Computes the Nesterov-Todd scaling matrix W that satisfies
+/// W^{-1} s = W z.
+/// @param[in] s Slack variable. Must be in the interior of the cone.
+/// @param[in] z Dual variable. Must be in the interior of the cone.
+/// @param[out] W The scaling matrix.
+/// @param[out] Winv Inverse of the scaling matrix.
+///
+void computeNesterovToddScaling(const Eigen::Vector3d& s,
+                                const Eigen::Vector3d& z, Eigen::Matrix3d& W,
+                                Eigen::Matrix3d& Winv);
+
+///
+/// @brief Computes the coefficients of the condensing. The Newton direction
+/// of the dual is given by ddual = dz0 - H * dslack.
+/// @param[in] barrier Barrier parameter. Must be positive.
+/// @param[in, out] data Constraint component data. data.cond is computed.
+/// @param[in] start Start position of the cone.
+/// @param[out] H Condensed Hessian W^{-2}. Size must be 3x3.
+/// @param[out] dz0 Constant term of the direction of the dual. Size must be 3.
+///
+template <typename MatrixType, typename VectorType>
+void computeCondensingCoeffcient(const double barrier,
+                                 ConstraintComponentData& data, const int start,
+                                 const Eigen::MatrixBase<MatrixType>& H,
+                                 const Eigen::MatrixBase<VectorType>& dz0);
+
+///
+/// @brief Computes the direction of the dual variable from the direction of
+/// the slack and the coefficients computed by computeCondensingCoeffcient().
+/// @param[in, out] data Constraint component data.
+/// @param[in] start Start position of the cone.
+/// @param[in] H Condensed Hessian W^{-2}. Size must be 3x3.
+/// @param[in] dz0 Constant term of the direction of the dual. Size must be 3.
+///
+template <typename MatrixType, typename VectorType>
+void computeDualDirection(ConstraintComponentData& data, const int start,
+                          const Eigen::MatrixBase<MatrixType>& H,
+                          const Eigen::MatrixBase<VectorType>& dz0);
+
+///
+/// @brief Applies the fraction-to-boundary-rule to a cone.
+/// @param[in] fraction_rate Must be larger than 0 and smaller than 1. Should be
+/// between 0.9 and 0.995.
+/// @param[in] v A vector in the interior of the cone. Size must be 3.
+/// @param[in] dv A direction of v. Size must be 3.
+/// @return Fraction-to-boundary of dv.
+///
+template <typename VectorType1, typename VectorType2>
+double fractionToBoundary(const double fraction_rate,
+                          const Eigen::MatrixBase<VectorType1>& v,
+                          const Eigen::MatrixBase<VectorType2>& dv);
+
+///
+/// @brief Applies the fraction-to-boundary-rule to the directions of the slack
+/// variables. data.dimc() must be a multiple of 3.
+/// @param[in] fraction_rate Must be larger than 0 and smaller than 1. Should be
+/// between 0.9 and 0.995.
+/// @param[in] data Constraint component data.
+/// @return Fraction-to-boundary of the direction of the slack variables.
+///
+double fractionToBoundarySlack(const double fraction_rate,
+                               const ConstraintComponentData& data);
+
+///
+/// @brief Applies the fraction-to-boundary-rule to the directions of the dual
+/// variables. data.dimc() must be a multiple of 3.
+/// @param[in] fraction_rate Must be larger than 0 and smaller than 1. Should be
+/// between 0.9 and 0.995.
+/// @param[in] data Constraint component data.
+/// @return Fraction-to-boundary of the direction of the dual variables.
+///
+double fractionToBoundaryDual(const double fraction_rate,
+                              const ConstraintComponentData& data);
+
+///
+/// @brief Computes the log barrier function of a cone, i.e.,
+/// - 0.5 * barrier * log(t^2 - ||x||^2).
+/// @param[in] barrier Barrier parameter. Must be positive.
+/// @param[in] v A vector in the interior of the cone. Size must be 3.
+/// @return log barrier function.
+///
+template <typename VectorType>
+double logBarrier(const double barrier, const Eigen::MatrixBase<VectorType>& v);
+
+} // namespace socpdipm
+} // namespace robotoc
+
+#include "robotoc/constraints/soc_pdipm.hxx"
+
+#endif // ROBOTOC_CONSTRAINTS_SOC_PDIPM_HPP_
\ No newline at end of file
@@ -0,0 +1,228 @@
+#ifndef ROBOTOC_CONSTRAINTS_SOC_PDIPM_HXX_
+#define ROBOTOC_CONSTRAINTS_SOC_PDIPM_HXX_
+
+#include "robotoc/constraints/soc_pdipm.hpp"
+
+#include <cmath>
+#include <cassert>
+
+
+namespace robotoc {
+namespace socpdipm {
+
+template <typename VectorType>
+inline double det(const Eigen::MatrixBase<VectorType>& v) {
+  assert(v.size() == 3);
+  return (v.coeff(0)*v.coeff(0) - v.coeff(1)*v.coeff(1)
+                                - v.coeff(2)*v.coeff(2));
+}
+
+
+template <typename VectorType>
+inline bool isInterior(const Eigen::MatrixBase<VectorType>& v) {
+  assert(v.size() == 3);
+  return (v.coeff(0) > 0 && det(v) > 0);
+}
+
+
+inline void setSlackAndDualInterior(const double barrier,
+                                    ConstraintComponentData& data,
+                                    const int start) {
+  assert(barrier > 0);
+  assert(data.checkDimensionalConsistency());
+  const double sqrt_barrier = std::sqrt(barrier);
+  const double x_norm = data.slack.template segment<2>(start+1).norm();
+  if (data.slack.coeff(start) - x_norm < sqrt_barrier) {
+    data.slack.coeffRef(start) = x_norm + sqrt_barrier;
+  }
+  // dual = barrier * slack^{-1}, where slack^{-1} is the Jordan inverse.
+  const double c = barrier / det(data.slack.template segment<3>(start));
+  data.dual.coeffRef(start) = c * data.slack.coeff(start);
+  data.dual.template segment<2>(start+1)
+      = - c * data.slack.template segment<2>(start+1);
+}
+
+
+inline void computeComplementarySlackness(const double barrier,
+                                          ConstraintComponentData& data,
+                                          const int start) {
+  assert(barrier > 0);
+  assert(data.checkDimensionalConsistency());
+  data.cmpl.coeffRef(start)
+      = data.slack.template segment<3>(start).dot(
+            data.dual.template segment<3>(start)) - barrier;
+  data.cmpl.template segment<2>(start+1)
+      = data.slack.coeff(start) * data.dual.template segment<2>(start+1)
+          + data.dual.coeff(start) * data.slack.template segment<2>(start+1);
+}
+
+
+inline void computeNesterovToddScaling(const Eigen::Vector3d& s,
+                                       const Eigen::Vector3d& z,
+                                       Eigen::Matrix3d& W,
+                                       Eigen::Matrix3d& Winv) {
+  assert(isInterior(s));
+  assert(isInterior(z));
+  const double sqrt_det_s = std::sqrt(det(s));
+  const double sqrt_det_z = std::sqrt(det(z));
+  const Eigen::Vector3d s_normalized = s / sqrt_det_s;
+  const Eigen::Vector3d z_normalized = z / sqrt_det_z;
+  const double gamma = std::sqrt(0.5*(1.0+s_normalized.dot(z_normalized)));
+  // Scaling point w = (s_normalized + J * z_normalized) / (2 * gamma), where
+  // J = diag(1, -1, -1).
+  const double w0 = (s_normalized.coeff(0)+z_normalized.coeff(0)) / (2.0*gamma);
+  const Eigen::Vector2d w1 = (s_normalized.tail<2>()
+                               -z_normalized.tail<2>()) / (2.0*gamma);
+  const double eta = std::sqrt(sqrt_det_s/sqrt_det_z);
+  W.coeffRef(0, 0) = w0;
+  W.block<1, 2>(0, 1) = w1.transpose();
+  W.block<2, 1>(1, 0) = w1;
+  W.block<2, 2>(1, 1).noalias() = w1 * w1.transpose() / (1.0+w0);
+  W.block<2, 2>(1, 1).diagonal().array() += 1.0;
+  Winv = W;
+  Winv.block<1, 2>(0, 1) = - w1.transpose();
+  Winv.block<2, 1>(1, 0) = - w1;
+  W.array() *= eta;
+  Winv.array() /= eta;
+}
+
+
+template <typename MatrixType, typename VectorType>
+inline void computeCondensingCoeffcient(
+    const double barrier, ConstraintComponentData& data, const int start,
+    const Eigen::MatrixBase<MatrixType>& H,
+    const Eigen::MatrixBase<VectorType>& dz0) {
+  assert(barrier > 0);
+  assert(data.checkDimensionalConsistency());
+  assert(H.rows() == 3);
+  assert(H.cols() == 3);
+  assert(dz0.size() == 3);
+  Eigen::Matrix3d W, Winv;
+  computeNesterovToddScaling(data.slack.template segment<3>(start),
+                             data.dual.template segment<3>(start), W, Winv);
+  // Scaled variable lambda = W * z and its Jordan inverse.
+  const Eigen::Vector3d lambda = W * data.dual.template segment<3>(start);
+  Eigen::Vector3d lambda_inv;
+  lambda_inv.coeffRef(0) = lambda.coeff(0);
+  lambda_inv.tail<2>() = - lambda.tail<2>();
+  lambda_inv.array() /= det(lambda);
+  const_cast<Eigen::MatrixBase<MatrixType>&>(H).noalias() = Winv * Winv;
+  const_cast<Eigen::MatrixBase<VectorType>&>(dz0).noalias()
+      = barrier * Winv * lambda_inv;
+  const_cast<Eigen::MatrixBase<VectorType>&>(dz0).noalias()
+      -= data.dual.template segment<3>(start);
+  data.cond.template segment<3>(start) = dz0;
+  data.cond.template segment<3>(start).noalias()
+      += H * data.residual.template segment<3>(start);
+}
+
+
+template <typename MatrixType, typename VectorType>
+inline void computeDualDirection(ConstraintComponentData& data,
+                                 const int start,
+                                 const Eigen::MatrixBase<MatrixType>& H,
+                                 const Eigen::MatrixBase<VectorType>& dz0) {
+  assert(data.checkDimensionalConsistency());
+  assert(H.rows() == 3);
+  assert(H.cols() == 3);
+  assert(dz0.size() == 3);
+  data.ddual.template segment<3>(start) = dz0;
+  data.ddual.template segment<3>(start).noalias()
+      -= H * data.dslack.template segment<3>(start);
+}
+
+
+template <typename VectorType1, typename VectorType2>
+inline double fractionToBoundary(const double fraction_rate,
+                                 const Eigen::MatrixBase<VectorType1>& v,
+                                 const Eigen::MatrixBase<VectorType2>& dv) {
+  assert(fraction_rate > 0);
+  assert(fraction_rate <= 1);
+  assert(v.size() == 3);
+  assert(dv.size() == 3);
+  // The maximum step size is the smallest positive root of
+  // det(v + step_size * dv) = a * step_size^2 + b * step_size + c.
+  const double a = det(dv);
+  const double b = 2.0 * (v.coeff(0)*dv.coeff(0) - v.coeff(1)*dv.coeff(1)
+                                                 - v.coeff(2)*dv.coeff(2));
+  const double c = det(v);
+  double max_step_size = -1.0;
+  if (a == 0) {
+    if (b < 0) {
+      max_step_size = - c / b;
+    }
+  }
+  else {
+    const double disc = b * b - 4.0 * a * c;
+    if (disc >= 0) {
+      const double q = - 0.5 * (b + std::copysign(std::sqrt(disc), b));
+      const double root1 = q / a;
+      const double root2 = c / q;
+      if (root1 > 0) {
+        max_step_size = root1;
+      }
+      if (root2 > 0 && (max_step_size < 0 || root2 < max_step_size)) {
+        max_step_size = root2;
+      }
+    }
+  }
+  const double fraction_to_boundary = fraction_rate * max_step_size;
+  if (fraction_to_boundary > 0 && fraction_to_boundary < 1) {
+    return fraction_to_boundary;
+  }
+  else {
+    return 1.0;
+  }
+}
+
+
+inline double fractionToBoundarySlack(const double fraction_rate,
+                                      const ConstraintComponentData& data) {
+  assert(fraction_rate > 0);
+  assert(fraction_rate <= 1);
+  assert(data.checkDimensionalConsistency());
+  assert(data.dimc()%3 == 0);
+  double min_fraction_to_boundary = 1;
+  for (int i=0; i<data.dimc(); i+=3) {
+    const double fraction_to_boundary
+        = fractionToBoundary(fraction_rate, data.slack.template segment<3>(i),
+                             data.dslack.template segment<3>(i));
+    if (fraction_to_boundary < min_fraction_to_boundary) {
+      min_fraction_to_boundary = fraction_to_boundary;
+    }
+  }
+  return min_fraction_to_boundary;
+}
+
+
+inline double fractionToBoundaryDual(const double fraction_rate,
+                                     const ConstraintComponentData& data) {
+  assert(fraction_rate > 0);
+  assert(fraction_rate <= 1);
+  assert(data.checkDimensionalConsistency());
+  assert(data.dimc()%3 == 0);
+  double min_fraction_to_boundary = 1;
+  for (int i=0; i<data.dimc(); i+=3) {
+    const double fraction_to_boundary
+        = fractionToBoundary(fraction_rate, data.dual.template segment<3>(i),
+                             data.ddual.template segment<3>(i));
+    if (fraction_to_boundary < min_fraction_to_boundary) {
+      min_fraction_to_boundary = fraction_to_boundary;
+    }
+  }
+  return min_fraction_to_boundary;
+}
+
+
+template <typename VectorType>
+inline double logBarrier(const double barrier,
+                         const Eigen::MatrixBase<VectorType>& v) {
+  assert(barrier > 0);
+  assert(isInterior(v));
+  return (- 0.5 * barrier * std::log(det(v)));
+}
+
+} // namespace socpdipm
+} // namespace robotoc
+
+#endif // ROBOTOC_CONSTRAINTS_SOC_PDIPM_HXX_
\ No newline at end of file
@@ -188,6 +188,39 @@ private:
   Eigen::Vector3d const_ref_, weight_, weight_terminal_, weight_impulse_;
   std::shared_ptr<CoMRefBase> ref_;
   bool use_nonconst_ref_, enable_cost_, enable_cost_terminal_, enable_cost_impulse_;
+
+  double evalCost_impl(const Eigen::Vector3d& weight, 
+                       const CostFunctionData& data) const {
+    return (weight.array()*data.diff_3d.array()*data.diff_3d.array()).sum();
+  }
+
+  template <typename VectorType>
+  void evalCostDerivatives_impl(const Robot& robot, 
+                                const Eigen::Vector3d& weight, 
+                                const double coeff, 
+                                const CostFunctionData& data,
+                                const Eigen::MatrixBase<VectorType>& lq) const {
+    const Eigen::Vector3d wdiff = coeff * weight.cwiseProduct(data.diff_3d);
+    const_cast<Eigen::MatrixBase<VectorType>&>(lq).noalias() 
+        += robot.CoMJacobian().transpose() * wdiff;
+  }
+
+  template <typename MatrixType>
+  void evalCostHessian_impl(const Robot& robot, const Eigen::Vector3d& weight, 
+                            const double coeff, CostFunctionData& data,
+                            const Eigen::MatrixBase<MatrixType>& Qqq,
+                            const bool lower_triangular=false) const {
+    data.J_3d.noalias() = (coeff * weight).asDiagonal() * robot.CoMJacobian();
+    if (lower_triangular) {
+      const_cast<Eigen::MatrixBase<MatrixType>&>(Qqq)
+          .template triangularView<Eigen::Lower>() 
+              += robot.CoMJacobian().transpose() * data.J_3d;
+    }
+    else {
+      const_cast<Eigen::MatrixBase<MatrixType>&>(Qqq).noalias() 
+          += robot.CoMJacobian().transpose() * data.J_3d;
+    }
+  }
 };
 
 } // namespace robotoc
@@ -2,8 +2,10 @@
 #define ROBOTOC_CONFIGURATION_SPACE_COST_HPP_
 
 #include "Eigen/Core"
+#include "Eigen/Geometry"
 
 #include "robotoc/robot/robot.hpp"
+#include "robotoc/robot/se3.hpp"
 #include "robotoc/robot/contact_status.hpp"
 #include "robotoc/robot/impulse_status.hpp"
 #include "robotoc/cost/cost_function_component_base.hpp"
@@ -160,6 +162,18 @@ public:
   ///
   void set_dv_weight_impulse(const Eigen::VectorXd& dv_weight_impulse);
 
+  ///
+  /// @brief Enables or disables the small-angle approximation of the 
+  /// difference of the floating base configuration. If enabled, the 
+  /// rotational part of the difference is approximated by the skew-symmetric 
+  /// part of the relative rotation matrix and its Jacobian by the identity, 
+  /// which avoids the log map of SE3 and its Jacobian. Suitable only if the 
+  /// orientation error from the reference is small, e.g., in MPC. Default is 
+  /// false.
+  /// @param[in] small_angle_approximation Flag to enable the approximation.
+  ///
+  void set_small_angle_approximation(const bool small_angle_approximation);
+
   ///
   /// @brief Evaluate if the cost on the configuration q is active for given 
   /// grid_info. 
@@ -185,21 +199,13 @@ public:
   ///
   void evalConfigDiff(const Robot& robot, CostFunctionData& data, 
                       const GridInfo& grid_info, 
-                      const Eigen::VectorXd& q) const {
-    if (use_nonconst_ref_) {
-      if (ref_->isActive(grid_info)) {
-        ref_->updateRef(robot, grid_info, data.q_ref);
-        robot.subtractConfiguration(q, data.q_ref, data.qdiff);
-      }
-    }
-    else {
-      robot.subtractConfiguration(q, q_ref_, data.qdiff);
-    }
-  }
+                      const Eigen::VectorXd& q) const;
 
   ///
   /// @brief Evaluate the Jacobian of the difference between the configuration 
-  /// and the reference configuration. 
+  /// and the reference configuration. evalConfigDiff() must be called with 
+  /// the same configuration before calling this function since the 
+  /// intermediates of the difference are reused.
   /// @param[in] robot Robot model.
   /// @param[in, out] data Cost funciton data.
   /// @param[in] grid_info Grid info
@@ -207,16 +213,7 @@ public:
   ///
   void evalConfigDiffJac(const Robot& robot, CostFunctionData& data, 
                          const GridInfo& grid_info, 
-                         const Eigen::VectorXd& q) const {
-    if (use_nonconst_ref_) {
-      if (ref_->isActive(grid_info)) {
-        robot.dSubtractConfiguration_dqf(q, data.q_ref, data.J_qdiff);
-      }
-    }
-    else {
-      robot.dSubtractConfiguration_dqf(q, q_ref_, data.J_qdiff);
-    }
-  }
+                         const Eigen::VectorXd& q) const;
 
   bool useKinematics() const override;
 
@@ -259,6 +256,8 @@ public:
                               const ImpulseSplitSolution& s, 
                               ImpulseSplitKKTMatrix& kkt_matrix) const override;
 
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
 private:
   int dimq_, dimv_, dimu_;
   Eigen::VectorXd q_ref_, v_ref_, u_ref_, 
@@ -266,10 +265,34 @@ private:
                   q_weight_terminal_, v_weight_terminal_, 
                   q_weight_impulse_, v_weight_impulse_, dv_weight_impulse_;
   std::shared_ptr<ConfigurationSpaceRefBase> ref_;
+  SE3 q_ref_base_;
+  unsigned long ref_id_;
   bool use_nonconst_ref_, 
        enable_q_cost_, enable_v_cost_, enable_a_cost_, enable_u_cost_,
        enable_q_cost_terminal_, enable_v_cost_terminal_,
-       enable_q_cost_impulse_, enable_v_cost_impulse_, enable_dv_cost_impulse_;
+       enable_q_cost_impulse_, enable_v_cost_impulse_, enable_dv_cost_impulse_,
+       split_base_diff_, small_angle_approximation_;
+
+  // Reads the time-varying reference configuration from data, which is 
+  // recomputed only when the grid or the reference changes.
+  void updateRefCache(const Robot& robot, CostFunctionData& data, 
+                      const GridInfo& grid_info) const;
+
+  void computeConfigDiff(const Robot& robot, CostFunctionData& data, 
+                         const Eigen::VectorXd& q, 
+                         const Eigen::VectorXd& q_ref,
+                         const SE3& q_ref_base) const;
+
+  void computeConfigDiffJac(const Robot& robot, CostFunctionData& data, 
+                            const Eigen::VectorXd& q, 
+                            const Eigen::VectorXd& q_ref) const;
+
+  static SE3 baseSE3(const Eigen::VectorXd& q) {
+    return SE3(Eigen::Quaterniond(q.template segment<4>(3)).toRotationMatrix(), 
+               q.template head<3>());
+  }
+
+  static unsigned long newRefId();
 };
 
 } // namespace robotoc
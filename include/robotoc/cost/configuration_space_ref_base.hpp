@@ -70,6 +70,16 @@ public:
   /// @return true if the cost is active at time t. false if not.
   ///
   virtual bool isActive(const GridInfo& grid_info) const = 0;
+
+  ///
+  /// @brief Returns the version of the settings of the reference, which must 
+  /// be changed whenever the settings are changed. If this is positive, 
+  /// ConfigurationSpaceCost caches the reference configuration of each grid 
+  /// and recomputes it only when the grid or the version changes. Default 
+  /// implementation returns 0, i.e., the reference is not cached.
+  /// @return Version of the settings of the reference.
+  ///
+  virtual unsigned long version() const { return 0; }
 };
 
 } // namespace robotoc
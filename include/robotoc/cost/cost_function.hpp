@@ -95,6 +95,35 @@ public:
   ///
   double discountTimeStep() const;
 
+  ///
+  /// @brief Sets the time-varying weight of the cost function, which is the 
+  /// piecewise linear interpolation of the specified weights w.r.t. the 
+  /// elapsed time from the initial time of the horizon. Before the first 
+  /// (after the last) elapsed time, the first (last) weight is used. 
+  /// The weight is multiplied to the stage, terminal, and impulse costs 
+  /// together with the discount factor. 
+  /// @param[in] elapsed_times Elapsed times from the initial time of the 
+  /// horizon. Must be strictly increasing.
+  /// @param[in] weights Weights at elapsed_times. Size must be the same as 
+  /// elapsed_times. Must be non-negative.
+  ///
+  void setTimeVaryingWeight(const std::vector<double>& elapsed_times, 
+                            const std::vector<double>& weights);
+
+  ///
+  /// @brief Disables the time-varying weight of the cost function. 
+  ///
+  void clearTimeVaryingWeight();
+
+  ///
+  /// @brief Computes the scale factor of the cost, that is, the product of 
+  /// the discount factor and the time-varying weight.
+  /// @param[in] t0 Initial time of the horizon. 
+  /// @param[in] t Time of the grid. Must be larger than or equal to t0.
+  /// @return The scale factor of the cost. 
+  ///
+  double weight(const double t0, const double t) const;
+
   ///
   /// @brief Append a cost function component to the cost function.
   /// @param[in] cost shared pointer to the cost function component appended 
@@ -131,6 +160,12 @@ public:
   /// @param[in] grid_info Grid info.
   /// @param[in] s Split solution.
   /// @return Stage cost.
+  /// @note The stage cost is discounted by 
+  /// pow(discount_factor, (grid_info.t-grid_info.t0)/discount_time_step) as 
+  /// in linearizeStageCost() and quadratizeStageCost(). Formerly, this 
+  /// function used pow(discount_factor, grid_info.time_stage) instead, 
+  /// which differs from the above when discount_time_step is not the time 
+  /// step of the grid.
   ///
   double evalStageCost(Robot& robot, const ContactStatus& contact_status,
                        CostFunctionData& data, const GridInfo& grid_info, 
@@ -268,13 +303,35 @@ public:
 private:
   std::vector<CostFunctionComponentBasePtr> costs_;
 
+  std::vector<double> weight_times_, weight_values_;
+  double discount_factor_, discount_time_step_;
+  unsigned long weight_id_;
+  bool discounted_cost_, time_varying_weight_;
+
   double discount(const double t0, const double t) const {
     assert(t >= t0);
     return std::pow(discount_factor_, ((t-t0)/discount_time_step_));
   }
 
-  double discount_factor_, discount_time_step_;
-  bool discounted_cost_;
+  double timeVaryingWeight(const double elapsed_time) const;
+
+  bool isWeighted() const {
+    return (discounted_cost_ || time_varying_weight_);
+  }
+
+  // Reads the scale factor from the table in data, which is rebuilt only 
+  // when the grid or the weight settings change.
+  double stageWeight(CostFunctionData& data, const GridInfo& grid_info) const {
+    const double elapsed_time = grid_info.t - grid_info.t0;
+    if (data.weight_id != weight_id_ || data.weight_time != elapsed_time) {
+      data.weight = weight(grid_info.t0, grid_info.t);
+      data.weight_time = elapsed_time;
+      data.weight_id = weight_id_;
+    }
+    return data.weight;
+  }
+
+  static unsigned long newWeightId();
 };
 
 } // namespace robotoc
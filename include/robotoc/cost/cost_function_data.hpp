@@ -67,6 +67,41 @@ public:
   ///
   Eigen::VectorXd q_ref;
 
+  ///
+  /// @brief SE3 of the floating base of q_ref used in 
+  /// ConfigurationSpaceCost. 
+  ///
+  SE3 q_ref_base;
+
+  ///
+  /// @brief Difference of the SE3 of the floating base from the reference 
+  /// used in ConfigurationSpaceCost. Shared by the evaluations of the cost and 
+  /// its derivatives. 
+  ///
+  SE3 qdiff_base;
+
+  ///
+  /// @brief Time of the grid at which q_ref is computed.
+  ///
+  double q_ref_time;
+
+  ///
+  /// @brief Contact phase of the grid at which q_ref is computed.
+  ///
+  int q_ref_phase;
+
+  ///
+  /// @brief Identifier of the ConfigurationSpaceCost with which q_ref is 
+  /// computed.
+  ///
+  unsigned long q_ref_id;
+
+  ///
+  /// @brief Version of the reference (ConfigurationSpaceRefBase::version()) 
+  /// with which q_ref is computed.
+  ///
+  unsigned long q_ref_version;
+
   ///
   /// @brief Vector used for set the reference position of the end-effector in 
   /// TaskSpace3DCost. 
@@ -144,6 +179,24 @@ public:
   ///
   Eigen::MatrixXd JJ_6d;
 
+  ///
+  /// @brief Scale factor of the cost at this grid, i.e., the product of the 
+  /// discount factor and the time-varying weight. Cached by CostFunction.
+  ///
+  double weight;
+
+  ///
+  /// @brief Elapsed time from the initial time of the horizon at which weight 
+  /// is computed.
+  ///
+  double weight_time;
+
+  ///
+  /// @brief Identifier of the weight settings of CostFunction with which 
+  /// weight is computed.
+  ///
+  unsigned long weight_id;
+
   EIGEN_MAKE_ALIGNED_OPERATOR_NEW 
 };
 
@@ -3,11 +3,19 @@
 
 #include "robotoc/cost/cost_function_data.hpp"
 
+#include <limits>
+
 namespace robotoc {
 
 inline CostFunctionData::CostFunctionData(const Robot& robot) 
   : qdiff(Eigen::VectorXd::Zero(robot.dimv())),
     q_ref(Eigen::VectorXd::Zero(robot.dimq())),
+    q_ref_base(SE3(Eigen::Matrix3d::Identity(), Eigen::Vector3d::Zero())),
+    qdiff_base(SE3(Eigen::Matrix3d::Identity(), Eigen::Vector3d::Zero())),
+    q_ref_time(std::numeric_limits<double>::quiet_NaN()),
+    q_ref_phase(-1),
+    q_ref_id(0),
+    q_ref_version(0),
     x3d_ref(Eigen::VectorXd::Zero(3)),
     diff_3d(Eigen::VectorXd::Zero(3)),
     diff_6d(Eigen::VectorXd::Zero(6)),
@@ -18,7 +26,10 @@ inline CostFunctionData::CostFunctionData(const Robot& robot)
     J_6d(Eigen::MatrixXd::Zero(6, robot.dimv())),
     J_3d(Eigen::MatrixXd::Zero(3, robot.dimv())),
     J_66(Eigen::MatrixXd::Zero(6, 6)),
-    JJ_6d(Eigen::MatrixXd::Zero(6, robot.dimv())) {
+    JJ_6d(Eigen::MatrixXd::Zero(6, robot.dimv())),
+    weight(1.0),
+    weight_time(std::numeric_limits<double>::quiet_NaN()),
+    weight_id(0) {
   if (robot.hasFloatingBase()) {
     qdiff.resize(robot.dimv());
     qdiff.setZero();
@@ -31,6 +42,12 @@ inline CostFunctionData::CostFunctionData(const Robot& robot)
 inline CostFunctionData::CostFunctionData() 
   : qdiff(),
     q_ref(),
+    q_ref_base(),
+    qdiff_base(),
+    q_ref_time(std::numeric_limits<double>::quiet_NaN()),
+    q_ref_phase(-1),
+    q_ref_id(0),
+    q_ref_version(0),
     x3d_ref(),
     diff_3d(),
     diff_6d(),
@@ -41,7 +58,10 @@ inline CostFunctionData::CostFunctionData()
     J_6d(),
     J_3d(),
     J_66(),
-    JJ_6d() {
+    JJ_6d(),
+    weight(1.0),
+    weight_time(std::numeric_limits<double>::quiet_NaN()),
+    weight_id(0) {
 }
 
 
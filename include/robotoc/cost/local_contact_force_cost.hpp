@@ -23,6 +23,12 @@ namespace robotoc {
 ///
 /// @class LocalContactForceCost
 /// @brief Cost on the contact forces expressed in the local frames.
+/// The weights and references are stacked in advance for every combination
+/// of the active contacts, so that the cost is evaluated over the stacked 
+/// contact forces (SplitSolution::f_stack()) by a single vectorized kernel
+/// without per-contact branching. The number of the combinations is 
+/// 2^Robot::maxNumContacts(), and Robot::maxNumContacts() must not be 
+/// larger than LocalContactForceCost::kMaxNumContacts.
 ///
 class LocalContactForceCost final : public CostFunctionComponentBase {
 public:
@@ -62,6 +68,11 @@ public:
   ///
   LocalContactForceCost& operator=(LocalContactForceCost&&) noexcept = default;
 
+  ///
+  /// @brief Maximum number of the contacts supported by this cost.
+  ///
+  static constexpr int kMaxNumContacts = 10;
+
   ///
   /// @brief Sets the reference contact forces expressed in the local frames. 
   /// @param[in] f_ref Reference contact forces expressed in the local frames. 
@@ -140,6 +151,45 @@ private:
   int max_num_contacts_, max_dimf_;
   std::vector<ContactType> contact_types_;
   std::vector<Eigen::Vector3d> f_ref_, f_weight_, fi_ref_, fi_weight_;
+  std::vector<Eigen::VectorXd> f_ref_stack_, f_weight_stack_, 
+                               fi_ref_stack_, fi_weight_stack_;
+
+  void setStack(const std::vector<Eigen::Vector3d>& ref,
+                const std::vector<Eigen::Vector3d>& weight,
+                std::vector<Eigen::VectorXd>& ref_stack, 
+                std::vector<Eigen::VectorXd>& weight_stack) const;
+
+  static int activeContactsIndex(const std::vector<bool>& is_contact_active) {
+    int index = 0;
+    for (int i=0; i<is_contact_active.size(); ++i) {
+      index |= (static_cast<int>(is_contact_active[i]) << i);
+    }
+    return index;
+  }
+
+  template <typename VectorType>
+  static double evalCost_impl(const Eigen::VectorXd& ref, 
+                              const Eigen::VectorXd& weight, 
+                              const Eigen::MatrixBase<VectorType>& f_stack) {
+    return (weight.array() * (f_stack.array()-ref.array()).square()).sum();
+  }
+
+  template <typename VectorType1, typename VectorType2>
+  static void evalCostDerivatives_impl(
+      const Eigen::VectorXd& ref, const Eigen::VectorXd& weight, 
+      const double coeff, const Eigen::MatrixBase<VectorType1>& f_stack,
+      const Eigen::MatrixBase<VectorType2>& lf) {
+    const_cast<Eigen::MatrixBase<VectorType2>&>(lf).array()
+        += coeff * weight.array() * (f_stack.array()-ref.array());
+  }
+
+  template <typename MatrixType>
+  static void evalCostHessian_impl(const Eigen::VectorXd& weight, 
+                                   const double coeff, 
+                                   const Eigen::MatrixBase<MatrixType>& Qff) {
+    const_cast<Eigen::MatrixBase<MatrixType>&>(Qff).diagonal().noalias()
+        += coeff * weight;
+  }
 
 };
 
@@ -0,0 +1,280 @@
+#ifndef ROBOTOC_TERMINAL_LQR_COST_HPP_
+#define ROBOTOC_TERMINAL_LQR_COST_HPP_
+
+#include <memory>
+#include <future>
+
+#include "Eigen/Core"
+
+#include "robotoc/robot/robot.hpp"
+#include "robotoc/robot/contact_status.hpp"
+#include "robotoc/robot/impulse_status.hpp"
+#include "robotoc/cost/cost_function_component_base.hpp"
+#include "robotoc/cost/cost_function_data.hpp"
+#include "robotoc/cost/cost_function.hpp"
+#include "robotoc/constraints/constraints.hpp"
+#include "robotoc/ocp/split_solution.hpp"
+#include "robotoc/ocp/split_kkt_residual.hpp"
+#include "robotoc/ocp/split_kkt_matrix.hpp"
+#include "robotoc/impulse/impulse_split_solution.hpp"
+#include "robotoc/impulse/impulse_split_kkt_residual.hpp"
+#include "robotoc/impulse/impulse_split_kkt_matrix.hpp"
+#include "robotoc/utils/aligned_vector.hpp"
+
+
+namespace robotoc {
+
+///
+/// @class TerminalLQRCost
+/// @brief Terminal cost 0.5 * dx^T * P * dx, where dx is the difference
+/// between the state and the operating point and P is the solution of the
+/// discrete-time algebraic Riccati equation (DARE), i.e., the cost-to-go of
+/// the infinite-horizon LQR problem around the operating point. The DARE is
+/// solved by the fixed-point iteration of the backward Riccati recursion of
+/// RiccatiFactorizer on the stage linearized at the operating point. This
+/// cost approximates the tail of the horizon so that a shorter horizon can
+/// be used. The stage and impulse costs of this component are zero.
+/// @note The terminal weights of the other cost components should be zero
+/// since the cost-to-go already includes the stage costs after the terminal
+/// stage.
+///
+class TerminalLQRCost final : public CostFunctionComponentBase {
+public:
+  ///
+  /// @brief Constructor. The cost-to-go is zero until it is computed or set.
+  /// @param[in] robot Robot model.
+  ///
+  TerminalLQRCost(const Robot& robot);
+
+  ///
+  /// @brief Default constructor.
+  ///
+  TerminalLQRCost();
+
+  ///
+  /// @brief Destructor. Waits for the update in the background if any.
+  ///
+  ~TerminalLQRCost();
+
+  ///
+  /// @brief Deleted copy constructor since the update in the background
+  /// refers to this object.
+  ///
+  TerminalLQRCost(const TerminalLQRCost&) = delete;
+
+  ///
+  /// @brief Deleted copy operator.
+  ///
+  TerminalLQRCost& operator=(const TerminalLQRCost&) = delete;
+
+  ///
+  /// @brief Deleted move constructor.
+  ///
+  TerminalLQRCost(TerminalLQRCost&&) noexcept = delete;
+
+  ///
+  /// @brief Deleted move assign operator.
+  ///
+  TerminalLQRCost& operator=(TerminalLQRCost&&) noexcept = delete;
+
+  ///
+  /// @brief Sets the options of the fixed-point iteration.
+  /// @param[in] max_iter Maximum number of the iterations. Must be positive.
+  /// Default is 10000.
+  /// @param[in] tol The iteration terminates if the relative change in the
+  /// Frobenius norm of P is smaller than this value. Must be positive.
+  /// Default is 1.0e-08.
+  ///
+  void setRiccatiIterationOptions(const int max_iter, const double tol);
+
+  ///
+  /// @brief Sets the tolerance of the change in the operating point.
+  /// requestCostToGoUpdate() does nothing if the distance between the new
+  /// and the current operating points is smaller than this value.
+  /// @param[in] refresh_tol The tolerance. Must be non-negative. Default is 0.
+  ///
+  void setRefreshTolerance(const double refresh_tol);
+
+  ///
+  /// @brief Sets the cost-to-go directly.
+  /// @param[in] P Hessian of the cost-to-go. Size must be
+  /// 2 * Robot::dimv() x 2 * Robot::dimv().
+  /// @param[in] q_ref Configuration of the operating point. Size must be
+  /// Robot::dimq().
+  /// @param[in] v_ref Velocity of the operating point. Size must be
+  /// Robot::dimv().
+  ///
+  void setCostToGo(const Eigen::MatrixXd& P, const Eigen::VectorXd& q_ref,
+                   const Eigen::VectorXd& v_ref);
+
+  ///
+  /// @brief Computes the cost-to-go around the operating point.
+  /// @param[in] robot Robot model.
+  /// @param[in] cost Stage cost of the OCP.
+  /// @param[in] constraints Constraints of the OCP.
+  /// @param[in] contact_status Contact status at the operating point.
+  /// @param[in] dt Time step of the OCP. Must be positive.
+  /// @param[in] s Operating point, e.g., a stance with zero velocity and the
+  /// gravity-compensating torques and contact forces.
+  /// @return true if the fixed-point iteration converges and false if not.
+  ///
+  bool computeCostToGo(const Robot& robot,
+                       const std::shared_ptr<CostFunction>& cost,
+                       const std::shared_ptr<Constraints>& constraints,
+                       const ContactStatus& contact_status, const double dt,
+                       const SplitSolution& s);
+
+  ///
+  /// @brief Requests computing the cost-to-go around the operating point in
+  /// a background thread. The KKT system is linearized around the operating
+  /// point on the calling thread and only the fixed-point iteration on the 
+  /// snapshot of the linearization runs in the background, so the cost and 
+  /// constraints can be used by the solver during the update. The result is 
+  /// applied by synchronize(). If the previous update has finished but its 
+  /// result is not applied yet, the result is applied before the new update
+  /// is started, so call this between the solver updates as well.
+  /// @param[in] robot Robot model.
+  /// @param[in] cost Stage cost of the OCP.
+  /// @param[in] constraints Constraints of the OCP.
+  /// @param[in] contact_status Contact status at the operating point.
+  /// @param[in] dt Time step of the OCP. Must be positive.
+  /// @param[in] s Operating point.
+  /// @return true if the update is started and false if the previous update
+  /// is still running or the operating point has not changed.
+  ///
+  bool requestCostToGoUpdate(const Robot& robot,
+                             const std::shared_ptr<CostFunction>& cost,
+                             const std::shared_ptr<Constraints>& constraints,
+                             const ContactStatus& contact_status,
+                             const double dt, const SplitSolution& s);
+
+  ///
+  /// @brief Applies the result of the update in the background if it is
+  /// finished. Call this between the solver updates, e.g., at the beginning
+  /// of each MPC cycle, so that the cost does not change during an update.
+  /// @param[in] wait If true, waits for the update. Default is false.
+  /// @return true if a new cost-to-go is applied and false if not.
+  ///
+  bool synchronize(const bool wait=false);
+
+  ///
+  /// @brief Checks if the update in the background is running.
+  /// @return true if the update is running and false if not.
+  ///
+  bool isUpdating() const;
+
+  ///
+  /// @brief Gets the Hessian of the cost-to-go.
+  /// @return const reference to the Hessian of the cost-to-go.
+  ///
+  const Eigen::MatrixXd& costToGoHessian() const;
+
+  ///
+  /// @brief Gets the configuration of the operating point.
+  /// @return const reference to the configuration of the operating point.
+  ///
+  const Eigen::VectorXd& q_ref() const;
+
+  ///
+  /// @brief Gets the velocity of the operating point.
+  /// @return const reference to the velocity of the operating point.
+  ///
+  const Eigen::VectorXd& v_ref() const;
+
+  ///
+  /// @brief Returns the number of the fixed-point iterations of the last
+  /// computation of the cost-to-go.
+  /// @return The number of the iterations.
+  ///
+  int numRiccatiIterations() const;
+
+  bool useKinematics() const override;
+
+  double evalStageCost(Robot& robot, const ContactStatus& contact_status,
+                       CostFunctionData& data, const GridInfo& grid_info,
+                       const SplitSolution& s) const override;
+
+  void evalStageCostDerivatives(Robot& robot, const ContactStatus& contact_status,
+                                CostFunctionData& data, const GridInfo& grid_info,
+                                const SplitSolution& s,
+                                SplitKKTResidual& kkt_residual) const override;
+
+  void evalStageCostHessian(Robot& robot, const ContactStatus& contact_status,
+                            CostFunctionData& data, const GridInfo& grid_info,
+                            const SplitSolution& s,
+                            SplitKKTMatrix& kkt_matrix) const override;
+
+  double evalTerminalCost(Robot& robot, CostFunctionData& data,
+                          const GridInfo& grid_info,
+                          const SplitSolution& s) const override;
+
+  void evalTerminalCostDerivatives(Robot& robot, CostFunctionData& data,
+                                   const GridInfo& grid_info,
+                                   const SplitSolution& s,
+                                   SplitKKTResidual& kkt_residual) const override;
+
+  void evalTerminalCostHessian(Robot& robot, CostFunctionData& data,
+                               const GridInfo& grid_info,
+                               const SplitSolution& s,
+                               SplitKKTMatrix& kkt_matrix) const override;
+
+  double evalImpulseCost(Robot& robot, const ImpulseStatus& impulse_status,
+                         CostFunctionData& data, const GridInfo& grid_info,
+                         const ImpulseSplitSolution& s) const override;
+
+  void evalImpulseCostDerivatives(Robot& robot, const ImpulseStatus& impulse_status,
+                                  CostFunctionData& data, const GridInfo& grid_info,
+                                  const ImpulseSplitSolution& s,
+                                  ImpulseSplitKKTResidual& kkt_residual) const override;
+
+  void evalImpulseCostHessian(Robot& robot, const ImpulseStatus& impulse_status,
+                              CostFunctionData& data, const GridInfo& grid_info,
+                              const ImpulseSplitSolution& s,
+                              ImpulseSplitKKTMatrix& kkt_matrix) const override;
+
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+private:
+  struct CostToGo {
+    Eigen::MatrixXd P;
+    Eigen::VectorXd q_ref, v_ref;
+    int num_iterations;
+    bool converged;
+  };
+
+  int dimq_, dimv_, max_iter_, num_iterations_;
+  double tol_, refresh_tol_;
+  Eigen::MatrixXd P_;
+  Eigen::VectorXd q_ref_, v_ref_;
+
+  // Snapshot of the linearization used by the update in the background.
+  aligned_vector<Robot> robot_op_;
+  SplitSolution s_op_;
+  SplitKKTMatrix kkt_matrix_op_;
+  SplitKKTResidual kkt_residual_op_;
+  std::future<CostToGo> future_;
+
+  static void linearizeKKTSystem(Robot& robot, 
+                                 const std::shared_ptr<CostFunction>& cost,
+                                 const std::shared_ptr<Constraints>& constraints,
+                                 const ContactStatus& contact_status, 
+                                 const double dt, const SplitSolution& s,
+                                 SplitKKTMatrix& kkt_matrix, 
+                                 SplitKKTResidual& kkt_residual);
+
+  static CostToGo solveRiccatiFixedPoint(const Robot& robot,
+                                         const SplitKKTMatrix& kkt_matrix,
+                                         const SplitKKTResidual& kkt_residual,
+                                         const SplitSolution& s, 
+                                         const int max_iter, const double tol);
+
+  void applyCostToGo(const CostToGo& cost_to_go);
+
+  double operatingPointDistance(const Robot& robot,
+                                const SplitSolution& s) const;
+
+};
+
+} // namespace robotoc
+
+#endif // ROBOTOC_TERMINAL_LQR_COST_HPP_
@@ -30,6 +30,17 @@ public:
   ///
   ContactSequence(const Robot& robot, const int reserved_num_discrete_events=0);
 
+  ///
+  /// @brief Constructor. 
+  /// @param[in] robot Robot model. 
+  /// @param[in] reserved_num_impulse_events Reserved number of the impulse 
+  /// events to avoid dynamic memory allocation. Must be non-negative.
+  /// @param[in] reserved_num_lift_events Reserved number of the lift events 
+  /// to avoid dynamic memory allocation. Must be non-negative.
+  ///
+  ContactSequence(const Robot& robot, const int reserved_num_impulse_events, 
+                  const int reserved_num_lift_events);
+
   ///
   /// @brief Default constructor. 
   ///
@@ -252,11 +263,39 @@ public:
   ///
   void reserve(const int reserved_num_discrete_events);
 
+  ///
+  /// @brief Reserves the impulse and lift events separately to avoid dynamic 
+  /// memory allocation. Use this if the numbers of the two kinds of events 
+  /// differ, e.g., gaits without stance phases, in which almost all the 
+  /// discrete events are impulse events.
+  /// @param[in] reserved_num_impulse_events The reserved number of the 
+  /// impulse events.
+  /// @param[in] reserved_num_lift_events The reserved number of the lift 
+  /// events.
+  ///
+  void reserve(const int reserved_num_impulse_events, 
+               const int reserved_num_lift_events);
+
   ///
   /// @brief Returns reserved size of container of each discrete events.
   ///
   int reservedNumDiscreteEvents() const;
 
+  ///
+  /// @brief Returns the largest number of the impulse events that the 
+  /// contact sequence has held or has been reserved for. The data of the 
+  /// impulse, auxiliary, and switching stages of the optimal control problem 
+  /// is sized by this value.
+  ///
+  int reservedNumImpulseEvents() const;
+
+  ///
+  /// @brief Returns the largest number of the lift events that the 
+  /// contact sequence has held or has been reserved for. The data of the 
+  /// lift stages of the optimal control problem is sized by this value.
+  ///
+  int reservedNumLiftEvents() const;
+
   ///
   /// @brief Displays the contact sequence onto a ostream.
   ///
@@ -270,7 +309,8 @@ public:
       const std::shared_ptr<ContactSequence>& contact_sequence);
 
 private:
-  int reserved_num_discrete_events_;
+  int reserved_num_discrete_events_, reserved_num_impulse_events_, 
+      reserved_num_lift_events_;
   ContactStatus default_contact_status_;
   std::deque<ContactStatus> contact_statuses_;
   std::deque<DiscreteEvent> impulse_events_;
@@ -284,6 +324,7 @@ private:
   static void reserveDeque(std::deque<T>& deq, const int size) {
     if (deq.empty()) {
       deq.resize(size);
+      deq.clear();
     }
     else {
       const int current_size = deq.size();
@@ -12,21 +12,35 @@ namespace robotoc {
 
 inline ContactSequence::ContactSequence(const Robot& robot, 
                                         const int reserved_num_discrete_events)
-  : reserved_num_discrete_events_(reserved_num_discrete_events),
+  : ContactSequence(robot, reserved_num_discrete_events, 
+                    reserved_num_discrete_events) {
+}
+
+
+inline ContactSequence::ContactSequence(const Robot& robot, 
+                                        const int reserved_num_impulse_events,
+                                        const int reserved_num_lift_events)
+  : reserved_num_discrete_events_(std::max(reserved_num_impulse_events, 
+                                           reserved_num_lift_events)),
+    reserved_num_impulse_events_(reserved_num_impulse_events),
+    reserved_num_lift_events_(reserved_num_lift_events),
     default_contact_status_(robot.createContactStatus()),
-    contact_statuses_(2*reserved_num_discrete_events+1),
-    impulse_events_(reserved_num_discrete_events),
-    event_index_impulse_(reserved_num_discrete_events), 
-    event_index_lift_(reserved_num_discrete_events),
-    event_time_(2*reserved_num_discrete_events),
-    impulse_time_(reserved_num_discrete_events),
-    lift_time_(reserved_num_discrete_events),
-    is_impulse_event_(2*reserved_num_discrete_events),
-    sto_impulse_(reserved_num_discrete_events), 
-    sto_lift_(reserved_num_discrete_events) {
+    contact_statuses_(reserved_num_impulse_events+reserved_num_lift_events+1),
+    impulse_events_(reserved_num_impulse_events),
+    event_index_impulse_(reserved_num_impulse_events), 
+    event_index_lift_(reserved_num_lift_events),
+    event_time_(reserved_num_impulse_events+reserved_num_lift_events),
+    impulse_time_(reserved_num_impulse_events),
+    lift_time_(reserved_num_lift_events),
+    is_impulse_event_(reserved_num_impulse_events+reserved_num_lift_events),
+    sto_impulse_(reserved_num_impulse_events), 
+    sto_lift_(reserved_num_lift_events) {
   try {
-    if (reserved_num_discrete_events < 0) {
-      throw std::out_of_range("invalid argument: reserved_num_discrete_events must be non-negative!");
+    if (reserved_num_impulse_events < 0) {
+      throw std::out_of_range("invalid argument: reserved_num_impulse_events must be non-negative!");
+    }
+    if (reserved_num_lift_events < 0) {
+      throw std::out_of_range("invalid argument: reserved_num_lift_events must be non-negative!");
     }
   }
   catch(const std::exception& e) {
@@ -40,6 +54,8 @@ inline ContactSequence::ContactSequence(const Robot& robot,
 
 inline ContactSequence::ContactSequence()
   : reserved_num_discrete_events_(0),
+    reserved_num_impulse_events_(0),
+    reserved_num_lift_events_(0),
     default_contact_status_(),
     contact_statuses_(),
     impulse_events_(),
@@ -114,6 +130,12 @@ inline void ContactSequence::push_back(const DiscreteEvent& discrete_event,
   if (reserved_num_discrete_events_ < numDiscreteEvents()) {
     reserved_num_discrete_events_ = numDiscreteEvents();
   }
+  if (reserved_num_impulse_events_ < numImpulseEvents()) {
+    reserved_num_impulse_events_ = numImpulseEvents();
+  }
+  if (reserved_num_lift_events_ < numLiftEvents()) {
+    reserved_num_lift_events_ = numLiftEvents();
+  }
 }
 
 
@@ -428,17 +450,38 @@ inline const std::deque<double>& ContactSequence::eventTimes() const {
 
 
 inline void ContactSequence::reserve(const int reserved_num_discrete_events) {
+  reserve(reserved_num_discrete_events, reserved_num_discrete_events);
+}
+
+
+inline void ContactSequence::reserve(const int reserved_num_impulse_events, 
+                                     const int reserved_num_lift_events) {
+  const int reserved_num_total_events 
+      = reserved_num_impulse_events + reserved_num_lift_events;
+  const bool reserve_total_events 
+      = (reserved_num_impulse_events_ + reserved_num_lift_events_ 
+          < reserved_num_total_events);
+  if (reserved_num_impulse_events_ < reserved_num_impulse_events) {
+    reserveDeque(impulse_events_, reserved_num_impulse_events);
+    reserveDeque(event_index_impulse_, reserved_num_impulse_events);
+    reserveDeque(impulse_time_, reserved_num_impulse_events);
+    reserveDeque(sto_impulse_, reserved_num_impulse_events);
+    reserved_num_impulse_events_ = reserved_num_impulse_events;
+  }
+  if (reserved_num_lift_events_ < reserved_num_lift_events) {
+    reserveDeque(event_index_lift_, reserved_num_lift_events);
+    reserveDeque(lift_time_, reserved_num_lift_events);
+    reserveDeque(sto_lift_, reserved_num_lift_events);
+    reserved_num_lift_events_ = reserved_num_lift_events;
+  }
+  if (reserve_total_events) {
+    reserveDeque(contact_statuses_, reserved_num_total_events+1);
+    reserveDeque(event_time_, reserved_num_total_events);
+    reserveDeque(is_impulse_event_, reserved_num_total_events);
+  }
+  const int reserved_num_discrete_events 
+      = std::max(reserved_num_impulse_events, reserved_num_lift_events);
   if (reserved_num_discrete_events_ < reserved_num_discrete_events) {
-    reserveDeque(contact_statuses_, 2*reserved_num_discrete_events+1);
-    reserveDeque(impulse_events_, reserved_num_discrete_events);
-    reserveDeque(event_index_impulse_, reserved_num_discrete_events);
-    reserveDeque(event_index_lift_, reserved_num_discrete_events);
-    reserveDeque(event_time_, 2*reserved_num_discrete_events);
-    reserveDeque(impulse_time_, reserved_num_discrete_events);
-    reserveDeque(lift_time_, reserved_num_discrete_events);
-    reserveDeque(is_impulse_event_, 2*reserved_num_discrete_events);
-    reserveDeque(sto_impulse_, reserved_num_discrete_events);
-    reserveDeque(sto_lift_, reserved_num_discrete_events);
     reserved_num_discrete_events_ = reserved_num_discrete_events;
   }
 }
@@ -449,6 +492,16 @@ inline int ContactSequence::reservedNumDiscreteEvents() const {
 }
 
 
+inline int ContactSequence::reservedNumImpulseEvents() const {
+  return reserved_num_impulse_events_;
+}
+
+
+inline int ContactSequence::reservedNumLiftEvents() const {
+  return reserved_num_lift_events_;
+}
+
+
 inline void ContactSequence::clear_all() {
   contact_statuses_.clear();
   impulse_events_.clear();
@@ -189,6 +189,13 @@ public:
   ///
   double KKTError() const;
 
+  ///
+  /// @brief Returns the absolute value of the primal residual. 
+  /// evalConstraint() must be called before calling this function.
+  /// @return Constraint violation. 
+  ///
+  double constraintViolation() const;
+
   ///
   /// @brief Sets the barrier parameter for all the constraint components.
   /// @param[in] barrier Barrier parameter. Must be positive. Should be small.
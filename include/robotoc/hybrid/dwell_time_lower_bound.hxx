@@ -179,6 +179,11 @@ inline double DwellTimeLowerBound::KKTError() const {
 }
 
 
+inline double DwellTimeLowerBound::constraintViolation() const {
+  return std::abs(residual_);
+}
+
+
 inline void DwellTimeLowerBound::setBarrier(const double _barrier) {
   assert(_barrier > 0.0);
   barrier_ = _barrier;
@@ -2,6 +2,7 @@
 #define ROBOTOC_HYBRID_CONTAINER_HPP_
 
 #include <vector>
+#include <algorithm>
 #include <cassert>
 #include <iostream>
 
@@ -40,7 +41,9 @@ public:
 /// the auxiliary stages (additional time stages just after the impulse events)
 /// (with Type), data for impulse stages (additional time stages at the impulse 
 /// events) (with ImpulseType), and data for switching constraints (with 
-/// SwitchingType).
+/// SwitchingType). The impulse, auxiliary, and switching data are sized by the 
+/// number of the impulse events and the lift data by the number of the lift 
+/// events, and each of them grows only on demand via reserve().
 /// @tparam Type The type name of the standard data type.
 /// @tparam ImpulseType The type name of the impulse data type. Defalt is 
 /// internal::EmptyType.
@@ -62,12 +65,32 @@ public:
   ///
   hybrid_container(const Robot& robot, const int N, 
                    const int reserved_num_discrete_events=1) 
+    : hybrid_container(robot, N, reserved_num_discrete_events, 
+                       reserved_num_discrete_events) {
+  }
+
+  ///
+  /// @brief Constructor. 
+  /// @param[in] robot Robot model.
+  /// @param[in] N Number of the discretization grids of the horizon except for 
+  /// the discrete events. Must be positive.
+  /// @param[in] reserved_num_impulse_events Reserved number of the impulse 
+  /// events on the horizon. The impulse, auxiliary, and switching data are 
+  /// constructed according to this value. Must be non-negative.
+  /// @param[in] reserved_num_lift_events Reserved number of the lift events on 
+  /// the horizon. The lift data are constructed according to this value. 
+  /// Must be non-negative.
+  ///
+  hybrid_container(const Robot& robot, const int N, 
+                   const int reserved_num_impulse_events,
+                   const int reserved_num_lift_events) 
     : data(N+1, Type(robot)), 
-      aux(reserved_num_discrete_events, Type(robot)), 
-      lift(reserved_num_discrete_events, Type(robot)),
-      impulse(reserved_num_discrete_events, ImpulseType(robot)),
-      switching(reserved_num_discrete_events, SwitchingType(robot)),
-      reserved_num_discrete_events_(reserved_num_discrete_events) {
+      aux(reserved_num_impulse_events, Type(robot)), 
+      lift(reserved_num_lift_events, Type(robot)),
+      impulse(reserved_num_impulse_events, ImpulseType(robot)),
+      switching(reserved_num_impulse_events, SwitchingType(robot)),
+      reserved_num_impulse_events_(reserved_num_impulse_events),
+      reserved_num_lift_events_(reserved_num_lift_events) {
   }
 
   ///
@@ -78,7 +101,9 @@ public:
       aux(),
       lift(),
       impulse(),
-      switching() {
+      switching(),
+      reserved_num_impulse_events_(0),
+      reserved_num_lift_events_(0) {
   }
 
   ///
@@ -109,31 +134,61 @@ public:
   /// according to this value. Must be non-negative.
   ///
   void reserve(const Robot& robot, const int reserved_num_discrete_events) {
-    assert(impulse.size() == reserved_num_discrete_events_);
-    assert(aux.size() == reserved_num_discrete_events_);
-    assert(switching.size() == reserved_num_discrete_events_);
-    assert(lift.size() == reserved_num_discrete_events_);
-    assert(reserved_num_discrete_events >= 0);
-    while (reserved_num_discrete_events > impulse.size()) {
+    reserve(robot, reserved_num_discrete_events, reserved_num_discrete_events);
+  }
+
+  ///
+  /// @brief Reserve the discrete-event data. The data never shrinks. 
+  /// @param[in] robot Robot model.
+  /// @param[in] reserved_num_impulse_events Reserved number of the impulse 
+  /// events on the horizon. Must be non-negative.
+  /// @param[in] reserved_num_lift_events Reserved number of the lift events on 
+  /// the horizon. Must be non-negative.
+  ///
+  void reserve(const Robot& robot, const int reserved_num_impulse_events,
+               const int reserved_num_lift_events) {
+    assert(impulse.size() == reserved_num_impulse_events_);
+    assert(aux.size() == reserved_num_impulse_events_);
+    assert(switching.size() == reserved_num_impulse_events_);
+    assert(lift.size() == reserved_num_lift_events_);
+    assert(reserved_num_impulse_events >= 0);
+    assert(reserved_num_lift_events >= 0);
+    while (reserved_num_impulse_events > impulse.size()) {
       impulse.emplace_back(robot);
     }
-    while (reserved_num_discrete_events > aux.size()) {
+    while (reserved_num_impulse_events > aux.size()) {
       aux.emplace_back(robot);
     }
-    while (reserved_num_discrete_events > switching.size()) {
+    while (reserved_num_impulse_events > switching.size()) {
       switching.emplace_back(robot);
     }
-    while (reserved_num_discrete_events > lift.size()) {
+    while (reserved_num_lift_events > lift.size()) {
       lift.emplace_back(robot);
     }
-    reserved_num_discrete_events_ = reserved_num_discrete_events;
+    reserved_num_impulse_events_ = impulse.size();
+    reserved_num_lift_events_ = lift.size();
   }
 
   ///
-  /// @return Reserved size of the discrete-event data. 
+  /// @return Reserved size of the discrete-event data, i.e., the larger one 
+  /// of reservedNumImpulseEvents() and reservedNumLiftEvents(). 
   ///
   int reservedNumDiscreteEvents() const {
-    return reserved_num_discrete_events_;
+    return std::max(reserved_num_impulse_events_, reserved_num_lift_events_);
+  }
+
+  ///
+  /// @return Reserved size of the impulse, auxiliary, and switching data. 
+  ///
+  int reservedNumImpulseEvents() const {
+    return reserved_num_impulse_events_;
+  }
+
+  ///
+  /// @return Reserved size of the lift data. 
+  ///
+  int reservedNumLiftEvents() const {
+    return reserved_num_lift_events_;
   }
 
   ///
@@ -213,7 +268,7 @@ public:
   }
 
 private:
-  int reserved_num_discrete_events_;
+  int reserved_num_impulse_events_, reserved_num_lift_events_;
 };
 
 } // namespace robotoc
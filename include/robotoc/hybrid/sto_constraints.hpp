@@ -164,6 +164,14 @@ public:
   ///
   double KKTError() const;
 
+  ///
+  /// @brief Returns the l1-norm of the primal residuals of all the 
+  /// constraints. evalConstraint() must be called before calling this 
+  /// function.
+  /// @return Constraint violation. 
+  ///
+  double constraintViolation() const;
+
   ///
   /// @brief Sets the minimum dwell times. 
   /// @param[in] min_dt Minimum dwell time. Must be non-negative. The all 
@@ -7,6 +7,8 @@
 #include <cmath>
 #include <iostream>
 
+#include "Eigen/Core"
+
 #include "robotoc/hybrid/discretization_method.hpp"
 #include "robotoc/hybrid/contact_sequence.hpp"
 #include "robotoc/hybrid/grid_info.hpp"
@@ -100,6 +102,22 @@ public:
   void meshRefinement(const std::shared_ptr<ContactSequence>& contact_sequence, 
                       const double t);
 
+  ///
+  /// @brief Moves the switching times of the discrete events and updates 
+  /// the time steps while keeping the structure of the discretization, i.e., 
+  /// the time stages before the discrete events. Only the grids of the 
+  /// contact phases adjacent to the moved events change. This is used to 
+  /// evaluate the trial switching times in the line search.
+  /// @param[in] impulse_times Switching times of the impulse events. 
+  /// Size must be at least N_impulse().
+  /// @param[in] lift_times Switching times of the lift events. 
+  /// Size must be at least N_lift().
+  /// @note This function is valid only if the discretization method is 
+  /// DiscretizationMethod::PhaseBased.
+  ///
+  void setSwitchingTimes(const Eigen::VectorXd& impulse_times, 
+                         const Eigen::VectorXd& lift_times);
+
   ///
   /// @return Number of the time stages on the horizon. 
   ///
@@ -130,6 +130,21 @@ inline void TimeDiscretization::meshRefinement(
 }
 
 
+inline void TimeDiscretization::setSwitchingTimes(
+    const Eigen::VectorXd& impulse_times, const Eigen::VectorXd& lift_times) {
+  assert(discretization_method_ == DiscretizationMethod::PhaseBased);
+  assert(impulse_times.size() >= N_impulse());
+  assert(lift_times.size() >= N_lift());
+  for (int impulse_index=0; impulse_index<N_impulse(); ++impulse_index) {
+    grid_impulse_[impulse_index].t = impulse_times.coeff(impulse_index);
+  }
+  for (int lift_index=0; lift_index<N_lift(); ++lift_index) {
+    grid_lift_[lift_index].t = lift_times.coeff(lift_index);
+  }
+  countTimeStepsPhaseBased(t0());
+}
+
+
 inline int TimeDiscretization::N() const {
   return N_;
 }
@@ -10,6 +10,7 @@
 #include "robotoc/cost/cost_function.hpp"
 #include "robotoc/constraints/constraints.hpp"
 #include "robotoc/hybrid/contact_sequence.hpp"
+#include "robotoc/hybrid/time_discretization.hpp"
 #include "robotoc/ocp/ocp.hpp"
 #include "robotoc/ocp/solution.hpp"
 #include "robotoc/ocp/direction.hpp"
@@ -76,6 +77,10 @@ public:
   /// @param[in] s Solution. 
   /// @param[in] d Direction. 
   /// @param[in] max_primal_step_size Maximum primal step size. 
+  /// @note If the switching time optimization (STO) is enabled, the trial 
+  /// points also involve the trial switching times, i.e., the grids of the 
+  /// contact phases adjacent to the STO-enabled events are moved, and the 
+  /// STO cost and constraints are taken into account.
   ///
   double computeStepSize(
       OCP& ocp, aligned_vector<Robot>& robots,
@@ -83,6 +88,23 @@ public:
       const Eigen::VectorXd& q, const Eigen::VectorXd& v, const Solution& s, 
       const Direction& d, const double max_primal_step_size);
 
+  ///
+  /// @brief Computes the merit function of the solution, i.e., the sum of 
+  /// the costs and the constraint violations weighted by the penalty 
+  /// parameter that is used in the merit backtracking line search.
+  /// @param[in, out] ocp optimal control problem.
+  /// @param[in] robots aligned_vector of Robot.
+  /// @param[in] contact_sequence Shared ptr to the contact sequence. 
+  /// @param[in] q Initial configuration.
+  /// @param[in] v Initial generalized velocity.
+  /// @param[in] s Solution. 
+  /// @return The merit function of the solution.
+  ///
+  double computeMerit(
+      OCP& ocp, aligned_vector<Robot>& robots,
+      const std::shared_ptr<ContactSequence>& contact_sequence, 
+      const Eigen::VectorXd& q, const Eigen::VectorXd& v, const Solution& s);
+
   ///
   /// @brief Clear the line search filter. 
   ///
@@ -112,10 +134,14 @@ private:
   Eigen::VectorXd costs_, costs_impulse_, costs_aux_, costs_lift_, violations_, 
                   violations_impulse_, violations_aux_, violations_lift_; 
   Solution s_trial_;
+  TimeDiscretization discretization_trial_;
+  Eigen::VectorXd impulse_times_trial_, lift_times_trial_;
+  double cost_sto_, violation_sto_;
   KKTResidual kkt_residual_;
 
   void computeCostAndViolation(
-      OCP& ocp, aligned_vector<Robot>& robots, 
+      OCP& ocp, const TimeDiscretization& discretization,
+      aligned_vector<Robot>& robots, 
       const std::shared_ptr<ContactSequence>& contact_sequence, 
       const Eigen::VectorXd& q, const Eigen::VectorXd& v, const Solution& s);
 
@@ -123,6 +149,13 @@ private:
                             const Solution& s, const Direction& d, 
                             const double step_size);
 
+  void computeSwitchingTimesTrial(const OCP& ocp, const Direction& d, 
+                                  const double step_size);
+
+  const TimeDiscretization& discretizationTrial(const OCP& ocp) const {
+    return (ocp.isSTOEnabled() ? discretization_trial_ : ocp.discrete());
+  }
+
   static void computeSolutionTrial(const Robot& robot, const SplitSolution& s, 
                                    const SplitDirection& d, 
                                    const double step_size, 
@@ -156,6 +189,7 @@ private:
     costs_impulse_.setZero();
     costs_aux_.setZero();
     costs_lift_.setZero();
+    cost_sto_ = 0;
   }
 
   void clearViolations() {
@@ -163,16 +197,17 @@ private:
     violations_impulse_.setZero();
     violations_aux_.setZero();
     violations_lift_.setZero();
+    violation_sto_ = 0;
   }
 
   double totalCosts() const {
     return (costs_.sum()+costs_impulse_.sum()+costs_aux_.sum()
-            +costs_lift_.sum());
+            +costs_lift_.sum()+cost_sto_);
   }
 
   double totalViolations() const {
     return (violations_.sum()+violations_impulse_.sum()+violations_aux_.sum()
-            +violations_lift_.sum());
+            +violations_lift_.sum()+violation_sto_);
   }
 
   double lineSearchFilterMethod(
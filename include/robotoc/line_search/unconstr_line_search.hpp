@@ -2,6 +2,7 @@
 #define ROBOTOC_UNCONSTR_LINE_SEARCH_HPP_
 
 #include <vector>
+#include <algorithm>
 
 #include "Eigen/Core"
 
@@ -126,6 +127,30 @@ public:
     }
   }
 
+  ///
+  /// @brief Computes the merit function of the solution, i.e., the sum of 
+  /// the costs and the constraint violations weighted by the l-infinity norm 
+  /// of the Lagrange multipliers.
+  /// @param[in, out] ocp Optimal control problem.
+  /// @param[in] robots aligned_vector of Robot.
+  /// @param[in] t Current time.
+  /// @param[in] q Initial configuration.
+  /// @param[in] v Initial generalized velocity.
+  /// @param[in] s Solution. 
+  /// @return The merit function of the solution.
+  ///
+  template <typename UnconstrOCPType>
+  double computeMerit(UnconstrOCPType& ocp, aligned_vector<Robot>& robots, 
+                      const double t, const Eigen::VectorXd& q, 
+                      const Eigen::VectorXd& v, const Solution& s) {
+    computeCostAndViolation(ocp, robots, t, q, v, s);
+    double penalty_param = 0;
+    for (int i=0; i<=N_; ++i) {
+      penalty_param = std::max(penalty_param, s[i].lagrangeMultiplierLinfNorm());
+    }
+    return totalCosts() + penalty_param * totalViolations();
+  }
+
   ///
   /// @brief Clear the line search filter. 
   ///
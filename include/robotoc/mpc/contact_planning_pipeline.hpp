@@ -0,0 +1,124 @@
+#ifndef ROBOTOC_CONTACT_PLANNING_PIPELINE_HPP_
+#define ROBOTOC_CONTACT_PLANNING_PIPELINE_HPP_
+
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+#include "Eigen/Core"
+
+#include "robotoc/robot/contact_status.hpp"
+#include "robotoc/mpc/contact_planner_base.hpp"
+
+
+namespace robotoc {
+
+///
+/// @class ContactPlanningPipeline
+/// @brief Runs the contact planning of the next MPC tick on a helper thread
+/// while the optimal control problem of the current tick is being solved.
+/// The inputs of the planning are copied at launch() (double-buffered) and
+/// the planner is touched only by the helper thread until synchronize()
+/// returns, so the planned contact placements can be committed to the contact
+/// sequence and the references atomically at the tick boundary.
+///
+class ContactPlanningPipeline {
+public:
+  ///
+  /// @brief Default constructor. The helper thread is launched lazily at the
+  /// first call of launch().
+  ///
+  ContactPlanningPipeline();
+
+  ///
+  /// @brief Destructor. Waits for the in-flight planning and joins the helper
+  /// thread.
+  ///
+  ~ContactPlanningPipeline();
+
+  ///
+  /// @brief Copy constructor. The helper thread and the in-flight planning
+  /// are not copied: the copied pipeline is idle.
+  ///
+  ContactPlanningPipeline(const ContactPlanningPipeline&);
+
+  ///
+  /// @brief Copy assign operator. The helper thread and the in-flight
+  /// planning are not copied: the in-flight planning of this pipeline is
+  /// discarded.
+  ///
+  ContactPlanningPipeline& operator=(const ContactPlanningPipeline&);
+
+  ///
+  /// @brief Move constructor. The moved pipeline is idle.
+  ///
+  ContactPlanningPipeline(ContactPlanningPipeline&&) noexcept;
+
+  ///
+  /// @brief Move assign operator. The in-flight planning of this pipeline is
+  /// discarded.
+  ///
+  ContactPlanningPipeline& operator=(ContactPlanningPipeline&&) noexcept;
+
+  ///
+  /// @brief Launches the contact planning on the helper thread. Waits for
+  /// the previous planning if it is still in flight.
+  /// @param[in] planner Contact planner. Must not be accessed by other
+  /// threads until synchronize() or cancel() is called.
+  /// @param[in] t Time at which the plan is used.
+  /// @param[in] q Configuration. Size must be Robot::dimq().
+  /// @param[in] v Velocity. Size must be Robot::dimv().
+  /// @param[in] contact_status Initial contact status.
+  /// @param[in] planning_steps Number of planning steps. Must be non-negative.
+  ///
+  void launch(const std::shared_ptr<ContactPlannerBase>& planner,
+              const double t, const Eigen::VectorXd& q,
+              const Eigen::VectorXd& v, const ContactStatus& contact_status,
+              const int planning_steps);
+
+  ///
+  /// @brief Waits for the in-flight planning.
+  /// @param[in] contact_status Initial contact status of the current tick.
+  /// @param[in] planning_steps Number of planning steps of the current tick.
+  /// @return true if a planning has been in flight and it was launched with
+  /// the same active contacts in the initial contact status and the same 
+  /// number of planning steps, that is, the planned contact placements can be 
+  /// committed. false otherwise.
+  ///
+  bool synchronize(const ContactStatus& contact_status,
+                   const int planning_steps);
+
+  ///
+  /// @brief Waits for the in-flight planning and discards it.
+  ///
+  void cancel();
+
+  ///
+  /// @brief Checks whether a planning is in flight, i.e., launched but not
+  /// synchronized yet.
+  ///
+  bool isInFlight() const { return is_in_flight_; }
+
+private:
+  std::thread worker_;
+  std::mutex mtx_;
+  std::condition_variable cv_;
+  bool has_task_, is_in_flight_, terminate_;
+  std::shared_ptr<ContactPlannerBase> planner_;
+  double t_;
+  Eigen::VectorXd q_, v_;
+  ContactStatus contact_status_;
+  int planning_steps_;
+
+  void run();
+
+  void wait();
+
+  void terminate();
+
+};
+
+} // namespace robotoc
+
+#endif // ROBOTOC_CONTACT_PLANNING_PIPELINE_HPP_
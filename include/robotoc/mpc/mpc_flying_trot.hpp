@@ -14,6 +14,7 @@
 #include "robotoc/constraints/constraints.hpp"
 #include "robotoc/solver/solver_options.hpp"
 #include "robotoc/mpc/contact_planner_base.hpp"
+#include "robotoc/mpc/contact_planning_pipeline.hpp"
 #include "robotoc/cost/configuration_space_cost.hpp"
 #include "robotoc/cost/task_space_3d_cost.hpp"
 #include "robotoc/cost/com_cost.hpp"
@@ -120,6 +121,31 @@ public:
   ///
   void setSolverOptions(const SolverOptions& solver_options);
 
+  ///
+  /// @brief Enables or disables the pipelined MPC tick. If enabled, the foot 
+  /// step planning for the next tick runs on a helper thread while the 
+  /// optimal control problem of the current tick is being solved, and the 
+  /// planned contact placements and references are committed at the 
+  /// beginning of the next tick. The plan is therefore based on the state of 
+  /// the previous tick. If the contact sequence changes at the tick, i.e., a 
+  /// step is added or removed, the planning falls back to the synchronous one.
+  /// Default is false.
+  /// @param[in] enable If true, the pipelined tick is enabled.
+  ///
+  void setPipelinedTick(const bool enable);
+
+  ///
+  /// @brief Enables or disables the periodic warm start. If enabled, the 
+  /// solution guess on the contact phase appended at the end of the horizon 
+  /// is built from the solution one gait period earlier, displaced by the 
+  /// base displacement over the period planned by the foot step planner. 
+  /// See OCPSolver::extrapolateSolutionPeriodic() for details. Otherwise, the 
+  /// appended phase keeps the solution of the previous MPC tick. 
+  /// Default is false.
+  /// @param[in] enable If true, the periodic warm start is enabled.
+  ///
+  void setPeriodicWarmStart(const bool enable);
+
   ///
   /// @brief Updates the solution by iterationg the Newton-type method.
   /// @param[in] t Initial time of the horizon. 
@@ -152,6 +178,10 @@ public:
 
   ///
   /// @brief Computes the KKT residual of the optimal control problem. 
+  /// This re-evaluates the KKT residual over the whole horizon and is 
+  /// intended as a diagnostic. To monitor the MPC at every control cycle, use 
+  /// MPCFlyingTrot::KKTError() or MPCFlyingTrot::getSolverStatistics() instead, which are 
+  /// by-products of MPCFlyingTrot::updateSolution() and need no additional computation.
   /// @param[in] t Initial time of the horizon. 
   /// @param[in] q Initial configuration. Size must be Robot::dimq().
   /// @param[in] v Initial velocity. Size must be Robot::dimv().
@@ -168,6 +198,13 @@ public:
   ///
   double KKTError() const;
 
+  ///
+  /// @brief Gets the solver statistics of the last call of 
+  /// MPCFlyingTrot::updateSolution(), including the components of the KKT error. 
+  /// @return Const reference to the solver statistics.
+  ///
+  const SolverStatistics& getSolverStatistics() const;
+
   ///
   /// @brief Gets the cost function handle.  
   /// @return Shared ptr to the cost function.
@@ -251,6 +288,8 @@ private:
   double swing_height_, flying_time_, stance_time_, swing_start_time_, 
          T_, dt_, dtm_, ts_last_, eps_;
   int N_, current_step_, predict_step_;
+  ContactPlanningPipeline contact_planning_pipeline_;
+  bool enable_pipelined_tick_, enable_periodic_warm_start_;
 
   std::shared_ptr<ConfigurationSpaceCost> config_cost_;
   std::shared_ptr<ConfigurationSpaceCost> base_rot_cost_;
@@ -268,6 +307,10 @@ private:
   void resetContactPlacements(const double t, const Eigen::VectorXd& q, 
                               const Eigen::VectorXd& v);
 
+  void commitContactPlacements();
+
+  void extrapolateSolutionPeriodic(const double t);
+
 };
 
 } // namespace robotoc 
@@ -163,6 +163,10 @@ public:
 
   ///
   /// @brief Computes the KKT residual of the optimal control problem. 
+  /// This re-evaluates the KKT residual over the whole horizon and is 
+  /// intended as a diagnostic. To monitor the MPC at every control cycle, use 
+  /// MPCJump::KKTError() or MPCJump::getSolverStatistics() instead, which are 
+  /// by-products of MPCJump::updateSolution() and need no additional computation.
   /// @param[in] t Initial time of the horizon. 
   /// @param[in] q Initial configuration. Size must be Robot::dimq().
   /// @param[in] v Initial velocity. Size must be Robot::dimv().
@@ -179,6 +183,13 @@ public:
   ///
   double KKTError() const;
 
+  ///
+  /// @brief Gets the solver statistics of the last call of 
+  /// MPCJump::updateSolution(), including the components of the KKT error. 
+  /// @return Const reference to the solver statistics.
+  ///
+  const SolverStatistics& getSolverStatistics() const;
+
   ///
   /// @brief Gets the cost function handle.  
   /// @return Shared ptr to the cost function.
@@ -0,0 +1,247 @@
+#ifndef ROBOTOC_MPC_MANIPULATOR_HPP_
+#define ROBOTOC_MPC_MANIPULATOR_HPP_
+
+#include <vector>
+#include <memory>
+#include <string>
+
+#include "Eigen/Core"
+
+#include "robotoc/robot/robot.hpp"
+#include "robotoc/unconstr/unconstr_ocp.hpp"
+#include "robotoc/solver/unconstr_ocp_solver.hpp"
+#include "robotoc/cost/cost_function.hpp"
+#include "robotoc/constraints/constraints.hpp"
+#include "robotoc/solver/solver_options.hpp"
+#include "robotoc/solver/solver_statistics.hpp"
+#include "robotoc/riccati/lqr_policy.hpp"
+#include "robotoc/cost/configuration_space_cost.hpp"
+#include "robotoc/cost/task_space_6d_cost.hpp"
+#include "robotoc/constraints/joint_position_lower_limit.hpp"
+#include "robotoc/constraints/joint_position_upper_limit.hpp"
+#include "robotoc/constraints/joint_velocity_lower_limit.hpp"
+#include "robotoc/constraints/joint_velocity_upper_limit.hpp"
+#include "robotoc/constraints/joint_torques_lower_limit.hpp"
+#include "robotoc/constraints/joint_torques_upper_limit.hpp"
+
+
+namespace robotoc {
+
+///
+/// @class MPCManipulator
+/// @brief MPC solver for fixed-base manipulators tracking a joint-space or
+/// task-space target. At each control cycle, the previous solution is
+/// shifted by the sampling time to warm-start the problem and a fixed
+/// number of the Newton-type iterations are performed. All the memory is
+/// allocated in the constructor.
+///
+class MPCManipulator {
+public:
+  ///
+  /// @brief Construct MPC solver tracking a joint-space target.
+  /// @param[in] robot Robot model. Must be a fixed-base robot without
+  /// contacts.
+  /// @param[in] T Length of the horizon.
+  /// @param[in] N Number of the discretization grids of the horizon.
+  /// @param[in] nthreads Number of threads used in the parallel computing.
+  ///
+  MPCManipulator(const Robot& robot, const double T, const int N,
+                 const int nthreads);
+
+  ///
+  /// @brief Construct MPC solver tracking a joint-space target and a
+  /// task-space target of the end-effector.
+  /// @param[in] robot Robot model. Must be a fixed-base robot without
+  /// contacts.
+  /// @param[in] end_effector_frame Name of the end-effector frame.
+  /// @param[in] T Length of the horizon.
+  /// @param[in] N Number of the discretization grids of the horizon.
+  /// @param[in] nthreads Number of threads used in the parallel computing.
+  ///
+  MPCManipulator(const Robot& robot, const std::string& end_effector_frame,
+                 const double T, const int N, const int nthreads);
+
+  ///
+  /// @brief Default constructor.
+  ///
+  MPCManipulator();
+
+  ///
+  /// @brief Destructor.
+  ///
+  ~MPCManipulator();
+
+  ///
+  /// @brief Default copy constructor.
+  ///
+  MPCManipulator(const MPCManipulator&) = default;
+
+  ///
+  /// @brief Default copy assign operator.
+  ///
+  MPCManipulator& operator=(const MPCManipulator&) = default;
+
+  ///
+  /// @brief Default move constructor.
+  ///
+  MPCManipulator(MPCManipulator&&) noexcept = default;
+
+  ///
+  /// @brief Default move assign operator.
+  ///
+  MPCManipulator& operator=(MPCManipulator&&) noexcept = default;
+
+  ///
+  /// @brief Sets the joint-space target.
+  /// @param[in] q_ref Target configuration. Size must be Robot::dimq().
+  ///
+  void setJointSpaceTarget(const Eigen::VectorXd& q_ref);
+
+  ///
+  /// @brief Sets the task-space target of the end-effector. Can be called
+  /// only if the end-effector frame is given in the constructor.
+  /// @param[in] position_ref Target position of the end-effector.
+  /// @param[in] rotation_ref Target rotation matrix of the end-effector.
+  ///
+  void setTaskSpaceTarget(const Eigen::Vector3d& position_ref,
+                          const Eigen::Matrix3d& rotation_ref);
+
+  ///
+  /// @brief Initializes the optimal control problem solover.
+  /// @param[in] t Initial time of the horizon.
+  /// @param[in] q Initial configuration. Size must be Robot::dimq().
+  /// @param[in] v Initial velocity. Size must be Robot::dimv().
+  /// @param[in] solver_options Solver options for the initialization.
+  ///
+  void init(const double t, const Eigen::VectorXd& q, const Eigen::VectorXd& v,
+            const SolverOptions& solver_options);
+
+  ///
+  /// @brief Sets the solver options used in updateSolution().
+  /// SolverOptions::max_iter is the number of the Newton-type iterations
+  /// per control cycle, e.g., 1 for the real-time iteration.
+  /// @param[in] solver_options Solver options.
+  ///
+  void setSolverOptions(const SolverOptions& solver_options);
+
+  ///
+  /// @brief Shifts the solution by the sampling time and updates it by
+  /// iterating the Newton-type method. Also computes the feedback gain of
+  /// the initial control input.
+  /// @param[in] t Initial time of the horizon.
+  /// @param[in] dt Sampling time of MPC. Must be positive.
+  /// @param[in] q Configuration. Size must be Robot::dimq().
+  /// @param[in] v Velocity. Size must be Robot::dimv().
+  ///
+  void updateSolution(const double t, const double dt, const Eigen::VectorXd& q,
+                      const Eigen::VectorXd& v);
+
+  ///
+  /// @brief Get the initial control input.
+  /// @return Const reference to the control input.
+  ///
+  const Eigen::VectorXd& getInitialControlInput() const;
+
+  ///
+  /// @brief Get the feedback gain of the initial control input with respect
+  /// to the state, i.e., the torques are given by
+  /// u + K [q - q0; v - v0] around the initial state (q0, v0) of the horizon.
+  /// @return Const reference to the feedback gain. Size is
+  /// Robot::dimu() x 2 * Robot::dimv().
+  ///
+  const Eigen::MatrixXd& getInitialFeedbackGain() const;
+
+  ///
+  /// @brief Get the split solution of a time stage.
+  /// @param[in] stage Time stage of interest.
+  /// @return Const reference to the split solution.
+  ///
+  const SplitSolution& getSolution(const int stage) const;
+
+  ///
+  /// @brief Gets of the local LQR policies over the horizon. Note that the
+  /// LQR policies are of the joint accelerations.
+  /// @return const reference to the local LQR policies.
+  ///
+  const std::vector<LQRPolicy>& getLQRPolicy() const;
+
+  ///
+  /// @brief Computes the KKT residual of the optimal control problem.
+  /// This re-evaluates the KKT residual over the whole horizon and is
+  /// intended as a diagnostic.
+  /// @param[in] t Initial time of the horizon.
+  /// @param[in] q Initial configuration. Size must be Robot::dimq().
+  /// @param[in] v Initial velocity. Size must be Robot::dimv().
+  ///
+  double KKTError(const double t, const Eigen::VectorXd& q,
+                  const Eigen::VectorXd& v);
+
+  ///
+  /// @brief Returns the l2-norm of the KKT residuals.
+  /// MPCManipulator::updateSolution() must be computed.
+  /// @return The l2-norm of the KKT residual.
+  ///
+  double KKTError() const;
+
+  ///
+  /// @brief Gets the solver statistics of the last call of
+  /// MPCManipulator::updateSolution().
+  /// @return Const reference to the solver statistics.
+  ///
+  const SolverStatistics& getSolverStatistics() const;
+
+  ///
+  /// @brief Gets the cost function handle.
+  /// @return Shared ptr to the cost function.
+  ///
+  std::shared_ptr<CostFunction> getCostHandle();
+
+  ///
+  /// @brief Gets the configuration space cost handle.
+  /// @return Shared ptr to the configuration space cost.
+  ///
+  std::shared_ptr<ConfigurationSpaceCost> getConfigCostHandle();
+
+  ///
+  /// @brief Gets the task space cost handle. Null if the end-effector frame
+  /// is not given in the constructor.
+  /// @return Shared ptr to the task space cost.
+  ///
+  std::shared_ptr<TaskSpace6DCost> getTaskSpaceCostHandle();
+
+  ///
+  /// @brief Gets the constraints handle.
+  /// @return Shared ptr to the constraints.
+  ///
+  std::shared_ptr<Constraints> getConstraintsHandle();
+
+  ///
+  /// @brief Gets the const handle of the MPC solver.
+  /// @return Const reference to the MPC solver.
+  ///
+  const UnconstrOCPSolver& getSolver() const { return ocp_solver_; }
+
+  ///
+  /// @brief Sets a collection of the properties for robot model in this MPC.
+  /// @param[in] properties A collection of the properties for the robot model.
+  ///
+  void setRobotProperties(const RobotProperties& properties);
+
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+private:
+  Robot robot_;
+  std::shared_ptr<CostFunction> cost_;
+  std::shared_ptr<Constraints> constraints_;
+  std::shared_ptr<ConfigurationSpaceCost> config_cost_;
+  std::shared_ptr<TaskSpace6DCost> task_cost_;
+  UnconstrOCPSolver ocp_solver_;
+  Eigen::MatrixXd dRNEA_dq_, dRNEA_dv_, dRNEA_da_, K_;
+
+  void computeInitialFeedbackGain();
+
+};
+
+} // namespace robotoc
+
+#endif // ROBOTOC_MPC_MANIPULATOR_HPP_
@@ -67,6 +67,8 @@ public:
 
   bool isActive(const GridInfo& grid_info) const override;
 
+  unsigned long version() const override { return version_; }
+
   EIGEN_MAKE_ALIGNED_OPERATOR_NEW
 
 private:
@@ -75,6 +77,7 @@ private:
   std::vector<bool> has_inactive_contacts_;
   double swing_start_time_, period_active_, period_inactive_, period_;
   int num_phases_in_period_;
+  unsigned long version_;
 };
 
 } // namespace robotoc
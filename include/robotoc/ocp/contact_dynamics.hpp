@@ -82,6 +82,40 @@ public:
                                 const SplitSolution& s, 
                                 SplitKKTResidual& kkt_residual);
 
+  ///
+  /// @brief Computes the acceleration and the contact forces of a split 
+  /// solution by the constrained forward dynamics of its configuration, 
+  /// velocity, and control input torques. Since the contact dynamics is 
+  /// linear in the acceleration and the contact forces, this is a single 
+  /// Newton step from the current acceleration and contact forces, solved 
+  /// by Robot::solveMJtJ() without forming the inverse of the contact 
+  /// dynamics matrix. The internal data is overwritten, so this must not be
+  /// called between condenseContactDynamics() and expandDual().
+  /// @param[in] robot Robot model. 
+  /// @param[in] contact_status Contact status of this time stage. 
+  /// @param[in, out] s Split solution of this time stage. The acceleration 
+  /// and the contact forces are overwritten.
+  ///
+  void computeForwardDynamics(Robot& robot, 
+                              const ContactStatus& contact_status, 
+                              SplitSolution& s) {
+    computeForwardDynamics(robot, contact_status, data_, s);
+  }
+
+  ///
+  /// @brief Computes the acceleration and the contact forces of a split 
+  /// solution by the constrained forward dynamics using external data.
+  /// @param[in] robot Robot model. 
+  /// @param[in] contact_status Contact status of this time stage. 
+  /// @param[in, out] data Contact dynamics data used as the workspace.
+  /// @param[in, out] s Split solution of this time stage. The acceleration 
+  /// and the contact forces are overwritten.
+  ///
+  static void computeForwardDynamics(Robot& robot, 
+                                     const ContactStatus& contact_status, 
+                                     ContactDynamicsData& data,
+                                     SplitSolution& s);
+
   ///
   /// @brief Condenses the acceleration, contact forces, and Lagrange
   /// multipliers. 
@@ -121,22 +155,7 @@ public:
   template <typename SplitDirectionType>
   void expandDual(const double dt, const double dts, 
                   const SplitDirectionType& d_next, SplitDirection& d) {
-    assert(dt > 0);
-    if (has_floating_base_) {
-      d.dnu_passive            = - data_.lu_passive;
-      d.dnu_passive.noalias() -= data_.Quu_passive_topRight * d.du;
-      d.dnu_passive.noalias() -= data_.Qxu_passive.transpose() * d.dx;
-      d.dnu_passive.noalias() 
-          -= dt * data_.MJtJinv().leftCols(dimv_).template topRows<kDimFloatingBase>() 
-                * d_next.dgmm();
-    }
-    data_.laf().noalias() += data_.Qafqv() * d.dx;
-    data_.laf().noalias() += data_.Qafu() * d.du;
-    data_.la().noalias()  += dt * d_next.dgmm();
-    constexpr double eps = std::numeric_limits<double>::epsilon();
-    if (dts < - eps || dts > eps) {
-      data_.laf().noalias() += dts * data_.haf();
-    }
+    expandDual_impl(dt, dts, d_next.dgmm(), d);
     d.dbetamu().noalias()  = - data_.MJtJinv() * data_.laf();
   }
 
@@ -154,23 +173,42 @@ public:
                   const SplitDirectionType& d_next, 
                   const SwitchingConstraintJacobian& sc_jacobian,
                   SplitDirection& d) {
-    assert(dt > 0);
-    if (has_floating_base_) {
-      d.dnu_passive            = - data_.lu_passive;
-      d.dnu_passive.noalias() -= data_.Quu_passive_topRight * d.du;
-      d.dnu_passive.noalias() -= data_.Qxu_passive.transpose() * d.dx;
-      d.dnu_passive.noalias() 
-          -= dt * data_.MJtJinv().leftCols(dimv_).template topRows<kDimFloatingBase>() 
-                * d_next.dgmm();
-    }
-    data_.laf().noalias() += data_.Qafqv() * d.dx;
-    data_.laf().noalias() += data_.Qafu() * d.du;
-    data_.la().noalias()  += dt * d_next.dgmm();
+    expandDual_impl(dt, dts, d_next.dgmm(), d);
+    data_.la().noalias()  += sc_jacobian.Phia().transpose() * d.dxi();
+    d.dbetamu().noalias()  = - data_.MJtJinv() * data_.laf();
+  }
+
+  ///
+  /// @brief Expands the dual variables, i.e., computes the Newton direction 
+  /// of the condensed dual variables (Lagrange multipliers) of this stage.
+  /// @param[in] dt Time step of this time stage. 
+  /// @param[in] dts Direction of the switching time regarding of this time stage. 
+  /// @param[in] dgmm_next Direction of the costate coupled with the 
+  /// acceleration through the state equation, e.g., StateEquation::dgmmNext().
+  /// @param[in, out] d Split direction of this time stage.
+  /// 
+  void expandDual(const double dt, const double dts, 
+                  const Eigen::VectorXd& dgmm_next, SplitDirection& d) {
+    expandDual_impl(dt, dts, dgmm_next, d);
+    d.dbetamu().noalias()  = - data_.MJtJinv() * data_.laf();
+  }
+
+  ///
+  /// @brief Expands the dual variables, i.e., computes the Newton direction 
+  /// of the condensed dual variables (Lagrange multipliers) of this stage.
+  /// @param[in] dt Time step of this time stage. 
+  /// @param[in] dts Direction of the switching time regarding of this time stage. 
+  /// @param[in] dgmm_next Direction of the costate coupled with the 
+  /// acceleration through the state equation, e.g., StateEquation::dgmmNext().
+  /// @param[in] sc_jacobian Jacobian of the switching constraint. 
+  /// @param[in, out] d Split direction of this time stage.
+  /// 
+  void expandDual(const double dt, const double dts, 
+                  const Eigen::VectorXd& dgmm_next, 
+                  const SwitchingConstraintJacobian& sc_jacobian,
+                  SplitDirection& d) {
+    expandDual_impl(dt, dts, dgmm_next, d);
     data_.la().noalias()  += sc_jacobian.Phia().transpose() * d.dxi();
-    constexpr double eps = std::numeric_limits<double>::epsilon();
-    if (dts < - eps || dts > eps) {
-      data_.laf().noalias() += dts * data_.haf();
-    }
     d.dbetamu().noalias()  = - data_.MJtJinv() * data_.laf();
   }
 
@@ -213,6 +251,28 @@ private:
   int dimv_, dimu_, dim_passive_;
   static constexpr int kDimFloatingBase = 6;
 
+  template <typename VectorType>
+  void expandDual_impl(const double dt, const double dts, 
+                       const Eigen::MatrixBase<VectorType>& dgmm_next, 
+                       SplitDirection& d) {
+    assert(dt > 0);
+    if (has_floating_base_) {
+      d.dnu_passive            = - data_.lu_passive;
+      d.dnu_passive.noalias() -= data_.Quu_passive_topRight * d.du;
+      d.dnu_passive.noalias() -= data_.Qxu_passive.transpose() * d.dx;
+      d.dnu_passive.noalias() 
+          -= dt * data_.MJtJinv().leftCols(dimv_).template topRows<kDimFloatingBase>() 
+                * dgmm_next;
+    }
+    data_.laf().noalias() += data_.Qafqv() * d.dx;
+    data_.laf().noalias() += data_.Qafu() * d.du;
+    data_.la().noalias()  += dt * dgmm_next;
+    constexpr double eps = std::numeric_limits<double>::epsilon();
+    if (dts < - eps || dts > eps) {
+      data_.laf().noalias() += dts * data_.haf();
+    }
+  }
+
 };
 
 } // namespace robotoc 
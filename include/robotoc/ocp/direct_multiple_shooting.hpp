@@ -129,6 +129,37 @@ public:
   ///
   static double KKTError(const OCP& ocp, const KKTResidual& kkt_residual);
 
+  ///
+  /// @brief Returns the squared norm of the KKT residual of the leading time 
+  /// stages, i.e., the time stages before num_leading_stages and the 
+  /// impulse and lift stages on them. Used for the stage-weighted convergence 
+  /// criterion.
+  /// @param[in] ocp Optimal control problem.
+  /// @param[in] kkt_residual KKT residual. 
+  /// @param[in] num_leading_stages Number of the leading time stages. 
+  ///
+  static double KKTErrorLeadingStages(const OCP& ocp, 
+                                      const KKTResidual& kkt_residual,
+                                      const int num_leading_stages);
+
+  ///
+  /// @brief Returns the squared norm of the primal residual of the inequality
+  /// constraints of optimal control problem. The values computed in the last 
+  /// DirectMultipleShooting::computeKKTResidual() or 
+  /// DirectMultipleShooting::computeKKTSystem() are used.
+  /// @param[in] ocp Optimal control problem.
+  ///
+  static double constraintsPrimalResidualError(const OCP& ocp);
+
+  ///
+  /// @brief Returns the squared norm of the complementary slackness of the 
+  /// inequality constraints of optimal control problem. The values computed in
+  /// the last DirectMultipleShooting::computeKKTResidual() or 
+  /// DirectMultipleShooting::computeKKTSystem() are used.
+  /// @param[in] ocp Optimal control problem.
+  ///
+  static double constraintsComplementarityError(const OCP& ocp);
+
   ///
   /// @brief Returns the total value of the cost function.
   /// @param[in] ocp Optimal control problem.
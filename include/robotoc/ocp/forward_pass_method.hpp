@@ -0,0 +1,27 @@
+#ifndef ROBOTOC_FORWARD_PASS_METHOD_HPP_
+#define ROBOTOC_FORWARD_PASS_METHOD_HPP_
+
+namespace robotoc {
+
+///
+/// @enum ForwardPassMethod
+/// @brief Update of the primal solution after the Newton-type direction is 
+/// computed.
+/// LinearStep: all the stages are updated along the direction with the 
+/// primal step size, which closes the defects of the dynamics only at the 
+/// convergence.
+/// NonlinearRollout: after the linear step, the states are rolled out by the 
+/// nonlinear dynamics under the feedback gains of the LQR policies as in the
+/// feasibility-driven DDP, i.e., the defects of the state equation are 
+/// reduced by the factor (1 - primal step size) and the dynamics of the 
+/// control input is satisfied exactly at every iterate. The solvers keep 
+/// the linear step instead if the rollout increases the merit function.
+///
+enum class ForwardPassMethod {
+  LinearStep,
+  NonlinearRollout
+};
+
+} // namespace robotoc
+
+#endif // ROBOTOC_FORWARD_PASS_METHOD_HPP_
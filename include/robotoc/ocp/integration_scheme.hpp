@@ -0,0 +1,22 @@
+#ifndef ROBOTOC_INTEGRATION_SCHEME_HPP_
+#define ROBOTOC_INTEGRATION_SCHEME_HPP_
+
+namespace robotoc {
+
+///
+/// @enum IntegrationScheme
+/// @brief Integration scheme of the state equation.
+/// ForwardEuler: q_next = q + dt * v and v_next = v + dt * a.
+/// Midpoint: q_next = q + dt * (v + 0.5 * dt * a) and v_next = v + dt * a,
+/// that is, the configuration is integrated with the midpoint velocity
+/// 0.5 * (v + v_next). This is exact under the piecewise-constant
+/// acceleration and is second-order accurate in the configuration.
+///
+enum class IntegrationScheme {
+  ForwardEuler,
+  Midpoint
+};
+
+} // namespace robotoc
+
+#endif // ROBOTOC_INTEGRATION_SCHEME_HPP_
@@ -0,0 +1,107 @@
+#ifndef ROBOTOC_NONLINEAR_ROLLOUT_HPP_
+#define ROBOTOC_NONLINEAR_ROLLOUT_HPP_
+
+#include <vector>
+
+#include "Eigen/Core"
+
+#include "robotoc/robot/robot.hpp"
+#include "robotoc/ocp/ocp.hpp"
+#include "robotoc/ocp/solution.hpp"
+#include "robotoc/ocp/contact_dynamics_data.hpp"
+#include "robotoc/hybrid/hybrid_container.hpp"
+#include "robotoc/riccati/lqr_policy.hpp"
+
+
+namespace robotoc {
+
+///
+/// @class NonlinearRollout
+/// @brief Nonlinear rollout of the forward pass (ForwardPassMethod::
+/// NonlinearRollout) of the optimal control problem. The control inputs are
+/// corrected by the feedback gains of the LQR policies, the acceleration and
+/// contact forces are given by the constrained forward dynamics, and the
+/// states are integrated by the state equation while the defects are reduced
+/// by the factor (1 - primal step size) as in the feasibility-driven DDP.
+///
+class NonlinearRollout {
+public:
+  ///
+  /// @brief Construct the nonlinear rollout.
+  /// @param[in] ocp Optimal control problem.
+  ///
+  NonlinearRollout(const OCP& ocp);
+
+  ///
+  /// @brief Default constructor.
+  ///
+  NonlinearRollout();
+
+  ///
+  /// @brief Destructor.
+  ///
+  ~NonlinearRollout();
+
+  ///
+  /// @brief Default copy constructor.
+  ///
+  NonlinearRollout(const NonlinearRollout&) = default;
+
+  ///
+  /// @brief Default copy assign operator.
+  ///
+  NonlinearRollout& operator=(const NonlinearRollout&) = default;
+
+  ///
+  /// @brief Default move constructor.
+  ///
+  NonlinearRollout(NonlinearRollout&&) noexcept = default;
+
+  ///
+  /// @brief Default move assign operator.
+  ///
+  NonlinearRollout& operator=(NonlinearRollout&&) noexcept = default;
+
+  ///
+  /// @brief Returns the number of the time stages that are rolled out, i.e.,
+  /// the time stages before the first discrete event. Returns 0 if the
+  /// switching time optimization is enabled since the time steps then
+  /// change with the step.
+  /// @param[in] ocp Optimal control problem.
+  ///
+  static int rolloutHorizon(const OCP& ocp);
+
+  ///
+  /// @brief Computes the defects of the state equation of the stages that
+  /// are rolled out at the current solution. Must be called before the
+  /// solution is updated.
+  /// @param[in] ocp Optimal control problem.
+  /// @param[in] robot Robot model.
+  /// @param[in] s Solution.
+  ///
+  void computeDefects(const OCP& ocp, const Robot& robot, const Solution& s);
+
+  ///
+  /// @brief Rolls out the nonlinear dynamics from the linearly updated
+  /// solution.
+  /// @param[in] ocp Optimal control problem.
+  /// @param[in] robot Robot model.
+  /// @param[in] lqr_policy LQR policies computed in the Riccati recursion.
+  /// @param[in] primal_step_size Primal step size of the linear step.
+  /// @param[in, out] s Solution updated by the linear step.
+  ///
+  void rollout(const OCP& ocp, Robot& robot,
+               const hybrid_container<LQRPolicy>& lqr_policy,
+               const double primal_step_size, Solution& s);
+
+private:
+  std::vector<Eigen::VectorXd> defects_;
+  ContactDynamicsData data_;
+  Eigen::VectorXd dx_, dq_, q_next_, v_next_;
+  int dimv_;
+
+};
+
+} // namespace robotoc
+
+#endif // ROBOTOC_NONLINEAR_ROLLOUT_HPP_
@@ -6,6 +6,7 @@
 #include <cassert>
 
 #include "robotoc/robot/robot.hpp"
+#include "robotoc/ocp/integration_scheme.hpp"
 #include "robotoc/ocp/split_ocp.hpp"
 #include "robotoc/impulse/impulse_split_ocp.hpp"
 #include "robotoc/ocp/terminal_ocp.hpp"
@@ -94,6 +95,19 @@ public:
   ///
   void setDiscretizationMethod(const DiscretizationMethod discretization_method);
 
+  ///
+  /// @brief Sets the integration scheme of the state equation of all the 
+  /// time stages. Default is IntegrationScheme::ForwardEuler.
+  /// @param[in] integration_scheme The integration scheme.
+  ///
+  void setIntegrationScheme(const IntegrationScheme integration_scheme);
+
+  ///
+  /// @brief Gets the integration scheme of the state equation. 
+  /// @return The integration scheme.
+  ///
+  IntegrationScheme integrationScheme() const;
+
   ///
   /// @brief Discretizes the optimal control problem according to the 
   /// input current contact sequence and intial time of the horizon.
@@ -163,6 +177,16 @@ public:
   ///
   int reservedNumDiscreteEvents() const;
 
+  ///
+  /// @return Reserved size of the impulse and auxiliary stages. 
+  ///
+  int reservedNumImpulseEvents() const;
+
+  ///
+  /// @return Reserved size of the lift stages. 
+  ///
+  int reservedNumLiftEvents() const;
+
   ///
   /// @return true if the switching time optimization (STO) algorithm is enalbed. 
   /// false if not.
@@ -232,8 +256,10 @@ private:
   std::shared_ptr<ContactSequence> contact_sequence_;
   TimeDiscretization discretization_;
   double T_;
-  int N_, reserved_num_discrete_events_;
+  int N_, reserved_num_discrete_events_, reserved_num_impulse_events_, 
+      reserved_num_lift_events_;
   bool is_sto_enabled_;
+  IntegrationScheme integration_scheme_;
 
   void reserve();
 
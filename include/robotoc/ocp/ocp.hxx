@@ -16,9 +16,9 @@ inline OCP::OCP(const Robot& robot, const std::shared_ptr<CostFunction>& cost,
                 const std::shared_ptr<ContactSequence>& contact_sequence,
                 const double T, const int N) 
   : data(N, SplitOCP(robot, cost, constraints)), 
-    aux(contact_sequence->reservedNumDiscreteEvents(), SplitOCP(robot, cost, constraints)),
-    lift(contact_sequence->reservedNumDiscreteEvents(), SplitOCP(robot, cost, constraints)),
-    impulse(contact_sequence->reservedNumDiscreteEvents(), ImpulseSplitOCP(robot, cost, constraints)),
+    aux(contact_sequence->reservedNumImpulseEvents(), SplitOCP(robot, cost, constraints)),
+    lift(contact_sequence->reservedNumLiftEvents(), SplitOCP(robot, cost, constraints)),
+    impulse(contact_sequence->reservedNumImpulseEvents(), ImpulseSplitOCP(robot, cost, constraints)),
     terminal(TerminalOCP(robot, cost, constraints)),
     robot_(robot),
     cost_(cost),
@@ -30,7 +30,10 @@ inline OCP::OCP(const Robot& robot, const std::shared_ptr<CostFunction>& cost,
     T_(T),
     N_(N),
     reserved_num_discrete_events_(contact_sequence->reservedNumDiscreteEvents()),
-    is_sto_enabled_(true) {
+    reserved_num_impulse_events_(contact_sequence->reservedNumImpulseEvents()),
+    reserved_num_lift_events_(contact_sequence->reservedNumLiftEvents()),
+    is_sto_enabled_(true),
+    integration_scheme_(IntegrationScheme::ForwardEuler) {
   try {
     if (T <= 0) {
       throw std::out_of_range("invalid value: T must be positive!");
@@ -61,9 +64,9 @@ inline OCP::OCP(const Robot& robot, const std::shared_ptr<CostFunction>& cost,
                 const std::shared_ptr<ContactSequence>& contact_sequence,
                 const double T, const int N) 
   : data(N, SplitOCP(robot, cost, constraints)), 
-    aux(contact_sequence->reservedNumDiscreteEvents(), SplitOCP(robot, cost, constraints)),
-    lift(contact_sequence->reservedNumDiscreteEvents(), SplitOCP(robot, cost, constraints)),
-    impulse(contact_sequence->reservedNumDiscreteEvents(), ImpulseSplitOCP(robot, cost, constraints)),
+    aux(contact_sequence->reservedNumImpulseEvents(), SplitOCP(robot, cost, constraints)),
+    lift(contact_sequence->reservedNumLiftEvents(), SplitOCP(robot, cost, constraints)),
+    impulse(contact_sequence->reservedNumImpulseEvents(), ImpulseSplitOCP(robot, cost, constraints)),
     terminal(TerminalOCP(robot, cost, constraints)),
     robot_(robot),
     cost_(cost),
@@ -75,7 +78,10 @@ inline OCP::OCP(const Robot& robot, const std::shared_ptr<CostFunction>& cost,
     T_(T),
     N_(N),
     reserved_num_discrete_events_(contact_sequence->reservedNumDiscreteEvents()),
-    is_sto_enabled_(false) {
+    reserved_num_impulse_events_(contact_sequence->reservedNumImpulseEvents()),
+    reserved_num_lift_events_(contact_sequence->reservedNumLiftEvents()),
+    is_sto_enabled_(false),
+    integration_scheme_(IntegrationScheme::ForwardEuler) {
   try {
     if (T <= 0) {
       throw std::out_of_range("invalid value: T must be positive!");
@@ -107,28 +113,37 @@ inline OCP::OCP()
     T_(0),
     N_(0),
     reserved_num_discrete_events_(0),
-    is_sto_enabled_(false) {
+    reserved_num_impulse_events_(0),
+    reserved_num_lift_events_(0),
+    is_sto_enabled_(false),
+    integration_scheme_(IntegrationScheme::ForwardEuler) {
 }
 
 
 inline void OCP::reserve() {
-  assert(impulse.size() == reserved_num_discrete_events_);
-  assert(aux.size() == reserved_num_discrete_events_);
-  assert(lift.size() == reserved_num_discrete_events_);
-  const int new_reserved_num_discrete_events 
-      = discretization_.reservedNumDiscreteEvents();
-  if (new_reserved_num_discrete_events > reserved_num_discrete_events_) {
-    while (impulse.size() < new_reserved_num_discrete_events) {
-      impulse.emplace_back(robot_, cost_, constraints_);
-    }
-    while (aux.size() < new_reserved_num_discrete_events) {
-      aux.emplace_back(robot_, cost_, constraints_);
-    }
-    while (lift.size() < new_reserved_num_discrete_events) {
-      lift.emplace_back(robot_, cost_, constraints_);
-    }
-    reserved_num_discrete_events_ = new_reserved_num_discrete_events;
+  assert(impulse.size() == reserved_num_impulse_events_);
+  assert(aux.size() == reserved_num_impulse_events_);
+  assert(lift.size() == reserved_num_lift_events_);
+  reserved_num_discrete_events_ = discretization_.reservedNumDiscreteEvents();
+  // The impulse and auxiliary stages are grown only up to the number of the 
+  // impulse events and the lift stages only up to that of the lift events.
+  const int new_reserved_num_impulse_events 
+      = contact_sequence_->reservedNumImpulseEvents();
+  while (impulse.size() < new_reserved_num_impulse_events) {
+    impulse.emplace_back(robot_, cost_, constraints_);
+  }
+  while (aux.size() < new_reserved_num_impulse_events) {
+    aux.emplace_back(robot_, cost_, constraints_);
+    aux.back().setIntegrationScheme(integration_scheme_);
+  }
+  const int new_reserved_num_lift_events 
+      = contact_sequence_->reservedNumLiftEvents();
+  while (lift.size() < new_reserved_num_lift_events) {
+    lift.emplace_back(robot_, cost_, constraints_);
+    lift.back().setIntegrationScheme(integration_scheme_);
   }
+  reserved_num_impulse_events_ = impulse.size();
+  reserved_num_lift_events_ = lift.size();
 }
 
 
@@ -142,6 +157,20 @@ inline void OCP::setDiscretizationMethod(
 }
 
 
+inline void OCP::setIntegrationScheme(
+    const IntegrationScheme integration_scheme) {
+  integration_scheme_ = integration_scheme;
+  for (auto& e : data) { e.setIntegrationScheme(integration_scheme); }
+  for (auto& e : aux)  { e.setIntegrationScheme(integration_scheme); }
+  for (auto& e : lift) { e.setIntegrationScheme(integration_scheme); }
+}
+
+
+inline IntegrationScheme OCP::integrationScheme() const {
+  return integration_scheme_;
+}
+
+
 inline void OCP::discretize(const double t) {
   discretization_.discretize(contact_sequence_, t);
   reserve();
@@ -204,6 +233,16 @@ inline int OCP::reservedNumDiscreteEvents() const {
 }
 
 
+inline int OCP::reservedNumImpulseEvents() const {
+  return reserved_num_impulse_events_;
+}
+
+
+inline int OCP::reservedNumLiftEvents() const {
+  return reserved_num_lift_events_;
+}
+
+
 inline bool OCP::isSTOEnabled() const {
   return is_sto_enabled_;
 }
@@ -214,6 +253,11 @@ inline void OCP::disp(std::ostream& os) const {
   os << "T: " << T_ << std::endl;
   os << "N: " << N_ << std::endl;
   os << "reserved_num_discrete_events: " << reserved_num_discrete_events_ << std::endl;
+  os << "reserved_num_impulse_events: " << reserved_num_impulse_events_ << std::endl;
+  os << "reserved_num_lift_events: " << reserved_num_lift_events_ << std::endl;
+  os << "integration_scheme: ";
+  if (integration_scheme_ == IntegrationScheme::ForwardEuler) os << "forward-Euler" << std::endl;
+  else os << "midpoint" << std::endl;
   os << robot_ << std::endl;
   os << discretization_ << std::endl;
 }
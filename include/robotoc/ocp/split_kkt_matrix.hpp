@@ -117,6 +117,13 @@ public:
   ///
   Eigen::MatrixXd Fvu;
 
+  ///
+  /// @brief Jacobian of the state equation (w.r.t. q) w.r.t. u. Nonzero only 
+  /// if the state equation is discretized by IntegrationScheme::Midpoint. 
+  /// Otherwise, the size is zero.
+  ///
+  Eigen::MatrixXd Fqu;
+
   ///
   /// @brief Hessian w.r.t. to the state x and state x.
   ///
@@ -340,6 +347,31 @@ public:
   ///
   int dimf() const;
 
+  ///
+  /// @brief Sets the storage of the symmetric Hessian blocks Qxx, Quu, and 
+  /// Qff(). If true, the costs, constraints, and condensing of the contact 
+  /// dynamics accumulate only the lower triangular parts of these blocks and 
+  /// the Riccati recursion reads them in the symmetric form. The strictly 
+  /// upper triangular parts are then unspecified. Default is false.
+  /// @param[in] lower_triangular_hessian Flag for the lower triangular 
+  /// Hessian storage.
+  ///
+  void setLowerTriangularHessian(const bool lower_triangular_hessian);
+
+  ///
+  /// @brief Checks if only the lower triangular parts of the symmetric 
+  /// Hessian blocks are accumulated. 
+  /// @return true if only the lower triangular parts are accumulated. false 
+  /// if the full blocks are accumulated.
+  ///
+  bool isLowerTriangularHessian() const;
+
+  ///
+  /// @brief Copies the lower triangular parts of the symmetric Hessian blocks
+  /// Qxx, Quu, and Qff() into their strictly upper triangular parts.
+  ///
+  void symmetrizeHessian();
+
   ///
   /// @brief Checks dimensional consistency of each component. 
   /// @return true if the dimension is consistent. false if not.
@@ -397,7 +429,7 @@ public:
 private:
   Eigen::MatrixXd Qff_full_, Qqf_full_;
   Eigen::VectorXd hf_full_;
-  bool has_floating_base_;
+  bool has_floating_base_, lower_triangular_hessian_;
   int dimv_, dimx_, dimu_, dimf_;
 
 };
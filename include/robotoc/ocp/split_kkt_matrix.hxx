@@ -11,6 +11,7 @@ namespace robotoc {
 inline SplitKKTMatrix::SplitKKTMatrix(const Robot& robot) 
   : Fxx(Eigen::MatrixXd::Zero(2*robot.dimv(), 2*robot.dimv())),
     Fvu(Eigen::MatrixXd::Zero(robot.dimv(), robot.dimu())),
+    Fqu(),
     Qxx(Eigen::MatrixXd::Zero(2*robot.dimv(), 2*robot.dimv())),
     Qaa(Eigen::MatrixXd::Zero(robot.dimv(), robot.dimv())),
     Qxu(Eigen::MatrixXd::Zero(2*robot.dimv(), robot.dimu())),
@@ -26,6 +27,7 @@ inline SplitKKTMatrix::SplitKKTMatrix(const Robot& robot)
     Qqf_full_(Eigen::MatrixXd::Zero(robot.dimv(), robot.max_dimf())),
     hf_full_(Eigen::VectorXd::Zero(robot.max_dimf())),
     has_floating_base_(robot.hasFloatingBase()),
+    lower_triangular_hessian_(false),
     dimv_(robot.dimv()), 
     dimx_(2*robot.dimv()), 
     dimu_(robot.dimu()), 
@@ -40,6 +42,7 @@ inline SplitKKTMatrix::SplitKKTMatrix(const Robot& robot)
 inline SplitKKTMatrix::SplitKKTMatrix() 
   : Fxx(),
     Fvu(),
+    Fqu(),
     Qxx(),
     Qaa(),
     Qxu(),
@@ -55,6 +58,7 @@ inline SplitKKTMatrix::SplitKKTMatrix()
     Qqf_full_(),
     hf_full_(),
     has_floating_base_(false),
+    lower_triangular_hessian_(false),
     dimv_(0), 
     dimx_(0), 
     dimu_(0), 
@@ -250,6 +254,7 @@ SplitKKTMatrix::hf() const {
 inline void SplitKKTMatrix::setZero() {
   Fxx.setZero();
   Fvu.setZero();
+  Fqu.setZero();
   Qxx.setZero();
   Qaa.setZero();
   Qxu.setZero();
@@ -272,11 +277,35 @@ inline int SplitKKTMatrix::dimf() const {
 }
 
 
+inline void SplitKKTMatrix::setLowerTriangularHessian(
+    const bool lower_triangular_hessian) {
+  lower_triangular_hessian_ = lower_triangular_hessian;
+}
+
+
+inline bool SplitKKTMatrix::isLowerTriangularHessian() const {
+  return lower_triangular_hessian_;
+}
+
+
+inline void SplitKKTMatrix::symmetrizeHessian() {
+  Qxx.triangularView<Eigen::StrictlyUpper>() = Qxx.transpose();
+  Quu.triangularView<Eigen::StrictlyUpper>() = Quu.transpose();
+  if (dimf_ > 0) {
+    Qff().triangularView<Eigen::StrictlyUpper>() = Qff().transpose();
+  }
+}
+
+
 inline bool SplitKKTMatrix::isDimensionConsistent() const {
   if (Fxx.rows() != 2*dimv_) return false;
   if (Fxx.cols() != 2*dimv_) return false;
   if (Fvu.rows() != dimv_) return false;
   if (Fvu.cols() != dimu_) return false;
+  if (Fqu.size() > 0) {
+    if (Fqu.rows() != dimv_) return false;
+    if (Fqu.cols() != dimu_) return false;
+  }
   if (Qxx.rows() != 2*dimv_) return false;
   if (Qxx.cols() != 2*dimv_) return false;
   if (Qaa.rows() != dimv_) return false;
@@ -300,6 +329,8 @@ inline bool SplitKKTMatrix::isDimensionConsistent() const {
 inline bool SplitKKTMatrix::isApprox(const SplitKKTMatrix& other) const {
   if (!Fxx.isApprox(other.Fxx)) return false;
   if (!Fvu.isApprox(other.Fvu)) return false;
+  if (Fqu.size() != other.Fqu.size()) return false;
+  if (!Fqu.isApprox(other.Fqu)) return false;
   if (!Qxx.isApprox(other.Qxx)) return false;
   if (!Qaa.isApprox(other.Qaa)) return false;
   if (!Qxu.isApprox(other.Qxu)) return false;
@@ -323,6 +354,7 @@ inline bool SplitKKTMatrix::isApprox(const SplitKKTMatrix& other) const {
 inline bool SplitKKTMatrix::hasNaN() const {
   if (Fxx.hasNaN()) return true;
   if (Fvu.hasNaN()) return true;
+  if (Fqu.hasNaN()) return true;
   if (Qxx.hasNaN()) return true;
   if (Qaa.hasNaN()) return true;
   if (Qxu.hasNaN()) return true;
@@ -345,6 +377,7 @@ inline bool SplitKKTMatrix::hasNaN() const {
 inline void SplitKKTMatrix::setRandom() {
   Fxx.setRandom();
   Fvu.setRandom();
+  Fqu.setRandom();
   const Eigen::MatrixXd Qxxuu_seed = Eigen::MatrixXd::Random(dimx_+dimu_, dimx_+dimu_);
   const Eigen::MatrixXd Qxxuu = Qxxuu_seed * Qxxuu_seed.transpose();
   Qxx = Qxxuu.topLeftCorner(dimx_, dimx_);
@@ -15,6 +15,7 @@
 #include "robotoc/cost/cost_function_data.hpp"
 #include "robotoc/constraints/constraints.hpp"
 #include "robotoc/constraints/constraints_data.hpp"
+#include "robotoc/ocp/integration_scheme.hpp"
 #include "robotoc/ocp/state_equation.hpp"
 #include "robotoc/ocp/contact_dynamics.hpp"
 #include "robotoc/ocp/switching_constraint.hpp"
@@ -73,6 +74,18 @@ public:
   ///
   SplitOCP& operator=(SplitOCP&&) noexcept = default;
 
+  ///
+  /// @brief Sets the integration scheme of the state equation. 
+  /// @param[in] integration_scheme The integration scheme. 
+  ///
+  void setIntegrationScheme(const IntegrationScheme integration_scheme);
+
+  ///
+  /// @brief Gets the integration scheme of the state equation. 
+  /// @return The integration scheme. 
+  ///
+  IntegrationScheme integrationScheme() const;
+
   ///
   /// @brief Checks whether the solution is feasible under inequality constraints.
   /// @param[in] robot Robot model. 
@@ -294,6 +307,28 @@ public:
   /// 
   void expandPrimal(const ContactStatus& contact_status, SplitDirection& d);
 
+  ///
+  /// @brief Stores the costate direction of the next time stage, which is  
+  /// required in SplitOCP::expandDual() under IntegrationScheme::Midpoint. 
+  /// Must be called before the costate direction of the next time stage is 
+  /// corrected in the expansion of the dual variables of the next time stage.
+  /// @param[in] grid_info Grid info of this time stage.
+  /// @param[in] d_next Split direction of the next time stage.
+  /// 
+  void setCostateDirectionNext(const GridInfo& grid_info, 
+                               const SplitDirection& d_next);
+
+  ///
+  /// @brief Stores the costate direction of the next time stage, which is  
+  /// required in SplitOCP::expandDual() under IntegrationScheme::Midpoint. 
+  /// Must be called before the costate direction of the next time stage is 
+  /// corrected in the expansion of the dual variables of the next time stage.
+  /// @param[in] grid_info Grid info of this time stage.
+  /// @param[in] d_next Split direction of the next time stage.
+  /// 
+  void setCostateDirectionNext(const GridInfo& grid_info, 
+                               const ImpulseSplitDirection& d_next);
+
   ///
   /// @brief Expands the condensed dual variables, i.e., computes the Newton 
   /// direction of the condensed dual variables of this stage.
@@ -302,6 +337,9 @@ public:
   /// @param[in, out] d Split direction of this time stage.
   /// @param[in] dts Direction of the switching time regarding of this time 
   /// stage. 
+  /// @note Under IntegrationScheme::Midpoint, the costate direction of the 
+  /// next time stage stored by SplitOCP::setCostateDirectionNext() is used 
+  /// instead of that of d_next.
   /// 
   void expandDual(const GridInfo& grid_info, const SplitDirection& d_next, 
                   SplitDirection& d, const double dts);
@@ -314,6 +352,9 @@ public:
   /// @param[in, out] d Split direction of this time stage.
   /// @param[in] dts Direction of the switching time regarding of this time 
   /// stage. 
+  /// @note Under IntegrationScheme::Midpoint, the costate direction of the 
+  /// next time stage stored by SplitOCP::setCostateDirectionNext() is used 
+  /// instead of that of d_next.
   /// 
   void expandDual(const GridInfo& grid_info, const ImpulseSplitDirection& d_next, 
                   SplitDirection& d, const double dts);
@@ -327,6 +368,9 @@ public:
   /// @param[in, out] d Split direction of this time stage.
   /// @param[in] dts Direction of the switching time regarding of this time 
   /// stage. 
+  /// @note Under IntegrationScheme::Midpoint, the costate direction of the 
+  /// next time stage stored by SplitOCP::setCostateDirectionNext() is used 
+  /// instead of that of d_next.
   /// 
   void expandDual(const GridInfo& grid_info, const SplitDirection& d_next, 
                   const SwitchingConstraintJacobian& sc_jacobian,
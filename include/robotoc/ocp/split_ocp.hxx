@@ -75,7 +75,12 @@ inline void SplitOCP::expandDual_impl(const GridInfo& grid_info,
                                       const SplitDirectionType& d_next, 
                                       SplitDirection& d, const double dts) {
   assert(grid_info.dt > 0);
-  contact_dynamics_.expandDual(grid_info.dt, dts, d_next, d);
+  if (state_equation_.integrationScheme() == IntegrationScheme::Midpoint) {
+    contact_dynamics_.expandDual(grid_info.dt, dts, state_equation_.dgmmNext(), d);
+  }
+  else {
+    contact_dynamics_.expandDual(grid_info.dt, dts, d_next, d);
+  }
   state_equation_.correctCostateDirection(d);
 }
 
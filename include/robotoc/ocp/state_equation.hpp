@@ -9,7 +9,9 @@
 #include "robotoc/ocp/split_direction.hpp"
 #include "robotoc/ocp/split_kkt_residual.hpp"
 #include "robotoc/ocp/split_kkt_matrix.hpp"
+#include "robotoc/ocp/integration_scheme.hpp"
 #include "robotoc/impulse/impulse_split_solution.hpp"
+#include "robotoc/impulse/impulse_split_direction.hpp"
 
 
 namespace robotoc {
@@ -56,6 +58,18 @@ public:
   ///
   StateEquation& operator=(StateEquation&&) noexcept = default;
 
+  ///
+  /// @brief Sets the integration scheme of the state equation. 
+  /// @param[in] integration_scheme The integration scheme. 
+  ///
+  void setIntegrationScheme(const IntegrationScheme integration_scheme);
+
+  ///
+  /// @brief Gets the integration scheme of the state equation. 
+  /// @return The integration scheme. 
+  ///
+  IntegrationScheme integrationScheme() const;
+
   ///
   /// @brief Computes the residual in the state equation. 
   /// @param[in] robot Robot model. 
@@ -65,11 +79,11 @@ public:
   /// @param[in] v_next Generalized velocity at the next time stage. 
   /// @param[in, out] kkt_residual Split KKT residual at the current time stage. 
   ///
-  static void evalStateEquation(const Robot& robot, const double dt, 
-                                const SplitSolution& s, 
-                                const Eigen::VectorXd& q_next, 
-                                const Eigen::VectorXd& v_next, 
-                                SplitKKTResidual& kkt_residual);
+  void evalStateEquation(const Robot& robot, const double dt, 
+                         const SplitSolution& s, 
+                         const Eigen::VectorXd& q_next, 
+                         const Eigen::VectorXd& v_next, 
+                         SplitKKTResidual& kkt_residual) const;
 
   ///
   /// @brief Linearizes the state equation. 
@@ -81,12 +95,12 @@ public:
   /// @param[in, out] kkt_matrix Split KKT matrix at the current time stage. 
   /// @param[in, out] kkt_residual Split KKT residual at the current time stage. 
   ///
-  static void linearizeStateEquation(const Robot& robot, const double dt, 
-                                     const Eigen::VectorXd& q_prev, 
-                                     const SplitSolution& s, 
-                                     const SplitSolution& s_next, 
-                                     SplitKKTMatrix& kkt_matrix, 
-                                     SplitKKTResidual& kkt_residual);
+  void linearizeStateEquation(const Robot& robot, const double dt, 
+                              const Eigen::VectorXd& q_prev, 
+                              const SplitSolution& s, 
+                              const SplitSolution& s_next, 
+                              SplitKKTMatrix& kkt_matrix, 
+                              SplitKKTResidual& kkt_residual) const;
 
   ///
   /// @brief Linearizes the state equation. 
@@ -98,16 +112,19 @@ public:
   /// @param[in, out] kkt_matrix Split KKT matrix at the current time stage. 
   /// @param[in, out] kkt_residual Split KKT residual at the current time stage. 
   ///
-  static void linearizeStateEquation(const Robot& robot, const double dt, 
-                                     const Eigen::VectorXd& q_prev, 
-                                     const SplitSolution& s, 
-                                     const ImpulseSplitSolution& s_next, 
-                                     SplitKKTMatrix& kkt_matrix, 
-                                     SplitKKTResidual& kkt_residual);
+  void linearizeStateEquation(const Robot& robot, const double dt, 
+                              const Eigen::VectorXd& q_prev, 
+                              const SplitSolution& s, 
+                              const ImpulseSplitSolution& s_next, 
+                              SplitKKTMatrix& kkt_matrix, 
+                              SplitKKTResidual& kkt_residual) const;
 
   ///
   /// @brief Corrects the linearized state equation using the Jacobian of the 
-  /// Lie group. 
+  /// Lie group. If the integration scheme is IntegrationScheme::Midpoint, 
+  /// also sets the Jacobians of the configuration equation through the 
+  /// condensed acceleration. Therefore, this must be called after 
+  /// ContactDynamics::condenseContactDynamics().
   /// @param[in] robot Robot model. 
   /// @param[in] dt Time step. 
   /// @param[in] s Solution at the current stage. 
@@ -123,7 +140,10 @@ public:
 
   ///
   /// @brief Corrects the linearized state equation using the Jacobian of the 
-  /// Lie group. 
+  /// Lie group. If the integration scheme is IntegrationScheme::Midpoint, 
+  /// also sets the Jacobians of the configuration equation through the 
+  /// condensed acceleration. Therefore, this must be called after 
+  /// ContactDynamics::condenseContactDynamics().
   /// @param[in] robot Robot model. 
   /// @param[in] dt Time step. 
   /// @param[in] s Solution at the current stage. 
@@ -148,6 +168,42 @@ public:
     }
   }
 
+  ///
+  /// @brief Stores the direction of the costate at the next time stage that  
+  /// is required to expand the dual directions of the condensed acceleration 
+  /// under IntegrationScheme::Midpoint. Must be called before the costate 
+  /// direction at the next time stage is corrected by 
+  /// correctCostateDirection() of the next time stage.
+  /// @param[in] dt Time step. 
+  /// @param[in] d_next Split direction at the next time stage. 
+  ///
+  template <typename SplitDirectionType>
+  void setCostateDirectionNext(const double dt, 
+                               const SplitDirectionType& d_next) {
+    assert(dt > 0);
+    const int dimv = dgmm_next_.size();
+    dgmm_next_ = d_next.dgmm();
+    if (has_floating_base_) {
+      Fq_tmp_.noalias() = - Fqq_inv_.transpose() * d_next.dlmd().template head<6>();
+      dgmm_next_.template head<6>().noalias() += (0.5*dt) * Fq_tmp_;
+      dgmm_next_.tail(dimv-6).noalias() 
+          += (0.5*dt) * d_next.dlmd().tail(dimv-6);
+    }
+    else {
+      dgmm_next_.noalias() += (0.5*dt) * d_next.dlmd();
+    }
+  }
+
+  ///
+  /// @brief Returns the direction of the costate at the next time stage 
+  /// stored by setCostateDirectionNext(), i.e., dgmm_next + 0.5 * dt * dlmd_next
+  /// with dlmd_next on the Lie group. 
+  /// @return const reference to the direction. 
+  ///
+  const Eigen::VectorXd& dgmmNext() const {
+    return dgmm_next_;
+  }
+
   ///
   /// @brief Computes the initial state direction using the result of  
   /// StateEquation::linearizeStateEquationAlongLieGroup().
@@ -164,18 +220,19 @@ public:
                                     SplitDirection& d0) const;
 
 private:
-  Eigen::MatrixXd Fqq_inv_, Fqq_prev_inv_, Fqq_tmp_;  
-  Eigen::VectorXd Fq_tmp_;
+  Eigen::MatrixXd Fqq_inv_, Fqq_prev_inv_, Fqq_tmp_, Fqx_tmp_, Fqu_tmp_;  
+  Eigen::VectorXd Fq_tmp_, Fv_tmp_, dgmm_next_;
   SE3JacobianInverse se3_jac_inverse_;
+  IntegrationScheme integration_scheme_;
   bool has_floating_base_;
 
   template <typename SplitSolutionType>
-  static void linearizeStateEquation_impl(const Robot& robot, const double dt, 
-                                          const Eigen::VectorXd& q_prev, 
-                                          const SplitSolution& s, 
-                                          const SplitSolutionType& s_next, 
-                                          SplitKKTMatrix& kkt_matrix, 
-                                          SplitKKTResidual& kkt_residual) {
+  void linearizeStateEquation_impl(const Robot& robot, const double dt, 
+                                   const Eigen::VectorXd& q_prev, 
+                                   const SplitSolution& s, 
+                                   const SplitSolutionType& s_next, 
+                                   SplitKKTMatrix& kkt_matrix, 
+                                   SplitKKTResidual& kkt_residual) const {
     assert(dt > 0);
     assert(q_prev.size() == robot.dimq());
     evalStateEquation(robot, dt, s, s_next.q, s_next.v, kkt_residual);
@@ -205,6 +262,14 @@ private:
     kkt_matrix.ha.noalias()   += s_next.gmm;
     kkt_matrix.fq() = s.v;
     kkt_matrix.fv() = s.a;
+    if (integration_scheme_ == IntegrationScheme::Midpoint) {
+      // Fq additionally has 0.5 * dt^2 * a.
+      kkt_residual.la.noalias() += (0.5*dt*dt) * s_next.lmd;
+      kkt_residual.h += dt * s_next.lmd.dot(s.a);
+      kkt_matrix.ha.noalias() += dt * s_next.lmd;
+      kkt_matrix.fq().noalias() += dt * s.a;
+      kkt_matrix.Qtt += s_next.lmd.dot(s.a);
+    }
   }
 
   template <typename SplitSolutionType>
@@ -213,14 +278,36 @@ private:
                                            const SplitSolutionType& s_next, 
                                            SplitKKTMatrix& kkt_matrix, 
                                            SplitKKTResidual& kkt_residual) {
+    if (integration_scheme_ == IntegrationScheme::Midpoint) {
+      // The acceleration enters Fq with 0.5 * dt^2 and Fv with dt. Therefore, 
+      // the Jacobians of Fq through the condensed acceleration are 0.5 * dt 
+      // times those of Fv.
+      assert(dt > 0);
+      const double coeff = 0.5 * dt;
+      kkt_matrix.Fqq().noalias() += coeff * kkt_matrix.Fvq();
+      kkt_matrix.Fqv().noalias() += coeff * kkt_matrix.Fvv();
+      kkt_matrix.Fqv().diagonal().array() -= coeff;
+      kkt_matrix.Fqu = coeff * kkt_matrix.Fvu;
+      Fv_tmp_ = s.v + dt * s.a - s_next.v;
+      kkt_residual.Fq().noalias() += coeff * kkt_residual.Fv();
+      kkt_residual.Fq().noalias() -= coeff * Fv_tmp_;
+    }
     if (has_floating_base_) {
       assert(dt > 0);
       se3_jac_inverse_.compute(kkt_matrix.Fqq_prev, Fqq_prev_inv_);
       robot.dSubtractConfiguration_dq0(s.q, s_next.q, kkt_matrix.Fqq_prev);
       se3_jac_inverse_.compute(kkt_matrix.Fqq_prev, Fqq_inv_);
-      Fqq_tmp_ = kkt_matrix.Fqq().template topLeftCorner<6, 6>();
-      kkt_matrix.Fqq().template topLeftCorner<6, 6>().noalias() = - Fqq_inv_ * Fqq_tmp_;
-      kkt_matrix.Fqv().template topLeftCorner<6, 6>() = - dt * Fqq_inv_;
+      if (integration_scheme_ == IntegrationScheme::Midpoint) {
+        Fqx_tmp_ = kkt_matrix.Fxx.template topRows<6>();
+        kkt_matrix.Fxx.template topRows<6>().noalias() = - Fqq_inv_ * Fqx_tmp_;
+        Fqu_tmp_ = kkt_matrix.Fqu.template topRows<6>();
+        kkt_matrix.Fqu.template topRows<6>().noalias() = - Fqq_inv_ * Fqu_tmp_;
+      }
+      else {
+        Fqq_tmp_ = kkt_matrix.Fqq().template topLeftCorner<6, 6>();
+        kkt_matrix.Fqq().template topLeftCorner<6, 6>().noalias() = - Fqq_inv_ * Fqq_tmp_;
+        kkt_matrix.Fqv().template topLeftCorner<6, 6>() = - dt * Fqq_inv_;
+      }
       Fq_tmp_  = kkt_residual.Fq().template head<6>();
       kkt_residual.Fq().template head<6>().noalias() = - Fqq_inv_ * Fq_tmp_;
       Fq_tmp_ = kkt_matrix.fq().template head<6>();
@@ -0,0 +1,27 @@
+#ifndef ROBOTOC_AUX_MAT_INITIALIZATION_HPP_ 
+#define ROBOTOC_AUX_MAT_INITIALIZATION_HPP_
+
+namespace robotoc {
+
+/// 
+/// @enum AuxMatInitialization
+/// @brief Initialization method of the auxiliary matrices of ParNMPC, which 
+/// approximate the Hessians of the cost-to-go functions.
+///
+enum class AuxMatInitialization {
+  /// The terminal cost Hessian at the current solution is used for all stages.
+  TerminalCostHessian,
+  /// The solution of the infinite-horizon LQR problem linearized around the 
+  /// end of the horizon is used for all stages.
+  TerminalLQR,
+  /// The exact cost-to-go Hessians of the current linearization are computed 
+  /// by a serial backward Riccati sweep.
+  Riccati,
+  /// The auxiliary matrices of the previous call are shifted by the number of 
+  /// the time stages the horizon moved forward.
+  Shift
+};
+
+} // namespace robotoc
+
+#endif // ROBOTOC_AUX_MAT_INITIALIZATION_HPP_ 
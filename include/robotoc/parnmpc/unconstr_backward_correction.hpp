@@ -17,6 +17,7 @@
 #include "robotoc/ocp/kkt_residual.hpp"
 #include "robotoc/unconstr/unconstr_parnmpc.hpp"
 #include "robotoc/parnmpc/unconstr_split_backward_correction.hpp"
+#include "robotoc/parnmpc/aux_mat_initialization.hpp"
 
 
 namespace robotoc {
@@ -33,8 +34,11 @@ public:
   /// @param[in] parnmpc Optimal control problem. 
   /// @param[in] nthreads Number of the threads used in solving the optimal 
   /// control problem. Must be positive. 
+  /// @param[in] num_blocks Number of the blocks into which the horizon is 
+  /// split. See UnconstrBackwardCorrection::setNumBlocks(). Default is 0.
   ///
-  UnconstrBackwardCorrection(const UnconstrParNMPC& parnmpc, const int nthreads);
+  UnconstrBackwardCorrection(const UnconstrParNMPC& parnmpc, const int nthreads,
+                             const int num_blocks=0);
 
   ///
   /// @brief Default constructor. 
@@ -67,18 +71,54 @@ public:
   UnconstrBackwardCorrection& operator=(UnconstrBackwardCorrection&&) noexcept = default;
 
   ///
-  /// @brief Initializes the auxiliary matrices by the terminal cost Hessian 
-  /// computed by the current solution. 
+  /// @brief Sets the number of the blocks into which the horizon is split. 
+  /// The coarse update is parallelized over the blocks, and within each block
+  /// the stages are solved serially backward with the exact cost-to-go 
+  /// Hessians, i.e., only the auxiliary matrices at the block boundaries are 
+  /// approximated. The serial parts of the backward and forward corrections
+  /// are also split into the blocks so that only the deviations at the 
+  /// block boundaries are propagated serially. 1 therefore uses the exact 
+  /// cost-to-go Hessians over the whole horizon and a single backward and 
+  /// forward pass as the Riccati recursion, and N yields the stage-wise 
+  /// ParNMPC.
+  /// @param[in] num_blocks Number of the blocks. Must be non-negative and not 
+  /// larger than N. If 0, it is set to N.
+  ///
+  void setNumBlocks(const int num_blocks);
+
+  ///
+  /// @brief Gets the number of the blocks into which the horizon is split. 
+  /// @return The number of the blocks.
+  ///
+  int numBlocks() const;
+
+  ///
+  /// @brief Initializes the auxiliary matrices. 
   /// @param[in] robots aligned_vector of Robot.
   /// @param[in] parnmpc Optimal control problem.
   /// @param[in] t Initial time of the horizon. 
   /// @param[in] s Solution. 
   /// @param[in, out] kkt_matrix KKT matrix. 
   /// @param[in, out] kkt_residual KKT residual. 
+  /// @param[in] method Initialization method. Default is 
+  /// AuxMatInitialization::TerminalCostHessian, that is, the terminal cost 
+  /// Hessian computed by the current solution.
+  /// @note AuxMatInitialization::Shift falls back to 
+  /// AuxMatInitialization::TerminalCostHessian at the first call or if the 
+  /// horizon moved beyond its length.
   ///
   void initAuxMat(aligned_vector<Robot>& robots, UnconstrParNMPC& parnmpc, 
                   const double t, const Solution& s, 
-                  KKTMatrix& kkt_matrix, KKTResidual& kkt_residual);
+                  KKTMatrix& kkt_matrix, KKTResidual& kkt_residual,
+                  const AuxMatInitialization method
+                      =AuxMatInitialization::TerminalCostHessian);
+
+  ///
+  /// @brief Gets the auxiliary matrix of a time stage. 
+  /// @param[in] stage Time stage of interest.
+  /// @return const reference to the auxiliary matrix. 
+  ///
+  const Eigen::MatrixXd& auxMat(const int stage) const;
 
   ///
   /// @brief Linearizes the optimal control problem and coarse updates the 
@@ -99,7 +139,9 @@ public:
 
   ///
   /// @brief Performs the backward correction for coarse updated solution and 
-  /// computes the Newton direction. 
+  /// computes the Newton direction. The serial backward and forward 
+  /// corrections are computed in parallel over the blocks, and only the 
+  /// deviations at the block boundaries are propagated serially. 
   /// @param[in] parnmpc Optimal control problem.
   /// @param[in] s Solution. 
   /// @param[in] kkt_matrix KKT matrix. 
@@ -123,12 +165,37 @@ public:
   double dualStepSize() const;
 
 private:
-  int N_, nthreads_;
+  int N_, nthreads_, num_blocks_, dimv_, dimx_;
+  std::vector<int> block_begin_;
   double T_, dt_;
   std::vector<UnconstrSplitBackwardCorrection> corrector_;
   Solution s_new_;
-  std::vector<Eigen::MatrixXd> aux_mat_;
+  std::vector<Eigen::MatrixXd> aux_mat_, block_mat_, block_mat_tmp_;
+  std::vector<Eigen::VectorXd> block_res_, block_res_local_, block_res_tmp_;
   Eigen::VectorXd primal_step_sizes_, dual_step_sizes_;
+  double t_prev_;
+  bool is_aux_mat_initialized_;
+
+  void initAuxMatByTerminalCostHessian(aligned_vector<Robot>& robots, 
+                                       UnconstrParNMPC& parnmpc, 
+                                       const Solution& s, 
+                                       KKTMatrix& kkt_matrix, 
+                                       KKTResidual& kkt_residual);
+
+  void initAuxMatByTerminalLQR(aligned_vector<Robot>& robots, 
+                               UnconstrParNMPC& parnmpc, const Solution& s, 
+                               KKTMatrix& kkt_matrix, 
+                               KKTResidual& kkt_residual);
+
+  void initAuxMatByRiccati(aligned_vector<Robot>& robots, 
+                           UnconstrParNMPC& parnmpc, const Solution& s, 
+                           KKTMatrix& kkt_matrix, KKTResidual& kkt_residual);
+
+  bool shiftAuxMat(const double t);
+
+  void computeBlockCostateResidual(const Solution& s, const int block);
+
+  void computeBlockStateResidual(const Solution& s, const int block);
 
 };
 
@@ -108,6 +108,22 @@ public:
   ///
   const Eigen::Block<const Eigen::MatrixXd> auxMat() const;
 
+  ///
+  /// @brief Sensitivity of the costates of this time stage to the deviation 
+  /// of the costates of the next time stage, which is subtracted in the 
+  /// serial part of the backward correction. 
+  /// @return const reference to the sensitivity matrix. 
+  ///
+  const Eigen::Block<const Eigen::MatrixXd> backwardCorrectionMat() const;
+
+  ///
+  /// @brief Sensitivity of the state of this time stage to the deviation 
+  /// of the state of the previous time stage, which is subtracted in the 
+  /// serial part of the forward correction. 
+  /// @return const reference to the sensitivity matrix. 
+  ///
+  const Eigen::Block<const Eigen::MatrixXd> forwardCorrectionMat() const;
+
   ///
   /// @brief Performs the serial part of the backward correction. 
   /// @param[in] s_next Split solution of the next time stage.
@@ -118,6 +134,16 @@ public:
                                 const SplitSolution& s_new_next,
                                 SplitSolution& s_new);
 
+  ///
+  /// @brief Performs the serial part of the backward correction with the 
+  /// given deviation of the costates of the next time stage. 
+  /// @param[in] x_res Deviation of the costates (lmd and gmm) of the next time
+  /// stage from the split solution. Size must be 2 * Robot::dimv().
+  /// @param[in, out] s_new Coarse updated split solution of this time stage.
+  ///
+  void backwardCorrectionSerial(const Eigen::VectorXd& x_res, 
+                                SplitSolution& s_new);
+
   ///
   /// @brief Performs the parallel part of the backward correction. 
   /// @param[in, out] s_new Coarse updated split solution of this time stage.
@@ -135,6 +161,16 @@ public:
                                const SplitSolution& s_new_prev,
                                SplitSolution& s_new);
 
+  ///
+  /// @brief Performs the serial part of the forward correction with the 
+  /// given deviation of the state of the previous time stage. 
+  /// @param[in] x_res Deviation of the state (q and v) of the previous time 
+  /// stage from the split solution. Size must be 2 * Robot::dimv().
+  /// @param[in, out] s_new Coarse updated split solution of this time stage.
+  ///
+  void forwardCorrectionSerial(const Eigen::VectorXd& x_res, 
+                               SplitSolution& s_new);
+
   ///
   /// @brief Performs the parallel part of the forward correction. 
   /// @param[in, out] s_new Coarse updated split solution of this time stage.
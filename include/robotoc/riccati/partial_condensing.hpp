@@ -0,0 +1,229 @@
+#ifndef ROBOTOC_PARTIAL_CONDENSING_HPP_
+#define ROBOTOC_PARTIAL_CONDENSING_HPP_
+
+#include <vector>
+
+#include "Eigen/Core"
+#include "Eigen/Cholesky"
+
+#include "robotoc/robot/robot.hpp"
+#include "robotoc/ocp/ocp.hpp"
+#include "robotoc/ocp/kkt_matrix.hpp"
+#include "robotoc/ocp/kkt_residual.hpp"
+#include "robotoc/ocp/direction.hpp"
+#include "robotoc/riccati/split_riccati_factorization.hpp"
+#include "robotoc/riccati/lqr_policy.hpp"
+
+
+namespace robotoc {
+
+///
+/// @class PartialCondensing
+/// @brief Partial condensing of the LQR subproblem. Merges blocks of
+/// consecutive regular time stages, i.e., the time stages that are not
+/// adjacent to any discrete event and that are not involved in the STO
+/// problem, into single stages whose control input is the stack of the
+/// control inputs of the block. The Riccati recursion then processes the
+/// condensed stages with larger matrices and the direction is expanded
+/// afterwards.
+/// @note The KKT matrix and KKT residual of the merged time stages are not
+/// modified.
+///
+class PartialCondensing {
+public:
+  ///
+  /// @brief Constructs the partial condensing.
+  /// @param[in] ocp Optimal control problem.
+  /// @param[in] block_size Number of the time stages merged into a block.
+  /// Must be non-negative. If 0, the block size is chosen by
+  /// PartialCondensing::defaultBlockSize(). If 1, the partial condensing is
+  /// disabled. Default is 1.
+  ///
+  PartialCondensing(const OCP& ocp, const int block_size=1);
+
+  ///
+  /// @brief Default constructor.
+  ///
+  PartialCondensing();
+
+  ///
+  /// @brief Destructor.
+  ///
+  ~PartialCondensing();
+
+  ///
+  /// @brief Default copy constructor.
+  ///
+  PartialCondensing(const PartialCondensing&) = default;
+
+  ///
+  /// @brief Default copy operator.
+  ///
+  PartialCondensing& operator=(const PartialCondensing&) = default;
+
+  ///
+  /// @brief Default move constructor.
+  ///
+  PartialCondensing(PartialCondensing&&) noexcept = default;
+
+  ///
+  /// @brief Default move assign operator.
+  ///
+  PartialCondensing& operator=(PartialCondensing&&) noexcept = default;
+
+  ///
+  /// @brief Sets the block size.
+  /// @param[in] block_size Number of the time stages merged into a block.
+  /// Must be non-negative. If 0, the block size is chosen by
+  /// PartialCondensing::defaultBlockSize(). If 1, the partial condensing is
+  /// disabled.
+  ///
+  void setBlockSize(const int block_size);
+
+  ///
+  /// @brief Returns the block size.
+  /// @return The block size.
+  ///
+  int blockSize() const;
+
+  ///
+  /// @brief Checks if the partial condensing is enabled.
+  /// @return true if the block size is larger than 1 and false if not.
+  ///
+  bool isEnabled() const;
+
+  ///
+  /// @brief Chooses the block size so that the dimension of the stacked
+  /// control input is comparable with the dimension of the state, i.e.,
+  /// 2 * Robot::dimv() / Robot::dimu() rounded to the nearest integer.
+  /// @param[in] robot Robot model.
+  /// @return The block size.
+  ///
+  static int defaultBlockSize(const Robot& robot);
+
+  ///
+  /// @brief Splits the regular time stages of the current discretization
+  /// into the blocks.
+  /// @param[in] ocp Optimal control problem.
+  ///
+  void partition(const OCP& ocp);
+
+  ///
+  /// @brief Returns the number of the blocks of the current partition.
+  /// @return The number of the blocks.
+  ///
+  int numBlocks() const;
+
+  ///
+  /// @brief Checks if the time stage is the first stage of a block.
+  /// @param[in] time_stage Time stage.
+  /// @return true if the time stage begins a block and false if not.
+  ///
+  bool isBlockBegin(const int time_stage) const;
+
+  ///
+  /// @brief Checks if the time stage is the last stage of a block.
+  /// @param[in] time_stage Time stage.
+  /// @return true if the time stage ends a block and false if not.
+  ///
+  bool isBlockEnd(const int time_stage) const;
+
+  ///
+  /// @brief Checks if the time stage is merged into a block and is not
+  /// the first stage of the block. The costate directions of such stages are
+  /// computed in PartialCondensing::expandDirection().
+  /// @param[in] time_stage Time stage.
+  /// @return true if the time stage is inside a block and false if not.
+  ///
+  bool isBlockInterior(const int time_stage) const;
+
+  ///
+  /// @brief Returns the first time stage of the block including the time
+  /// stage.
+  /// @param[in] time_stage Time stage merged into a block.
+  /// @return The first time stage of the block.
+  ///
+  int blockBegin(const int time_stage) const;
+
+  ///
+  /// @brief Returns the last time stage of the block including the time
+  /// stage.
+  /// @param[in] time_stage Time stage merged into a block.
+  /// @return The last time stage of the block.
+  ///
+  int blockEnd(const int time_stage) const;
+
+  ///
+  /// @brief Condenses the KKT systems of all the blocks in parallel.
+  /// @param[in] kkt_matrix KKT matrix.
+  /// @param[in] kkt_residual KKT residual.
+  /// @param[in] nthreads Number of the threads.
+  ///
+  void condense(const KKTMatrix& kkt_matrix, const KKTResidual& kkt_residual,
+                const int nthreads);
+
+  ///
+  /// @brief Performs the backward Riccati recursion over the condensed block
+  /// that ends at the time stage.
+  /// @param[in] time_stage The last time stage of the block.
+  /// @param[in] riccati_next Riccati factorization of the time stage after
+  /// the block.
+  /// @param[in, out] riccati Riccati factorization of the first time stage of
+  /// the block.
+  /// @param[in, out] lqr_policy LQR policy of the first time stage of the
+  /// block.
+  ///
+  void backwardRiccatiRecursion(const int time_stage,
+                                const SplitRiccatiFactorization& riccati_next,
+                                SplitRiccatiFactorization& riccati,
+                                LQRPolicy& lqr_policy);
+
+  ///
+  /// @brief Expands the direction of the block that begins at the time stage
+  /// from the state direction of the time stage, that is, computes the
+  /// control input directions and the state directions of the block, the
+  /// state direction of the time stage after the block, and the costate
+  /// directions of the interior stages of the block.
+  /// @param[in] time_stage The first time stage of the block.
+  /// @param[in] kkt_matrix KKT matrix.
+  /// @param[in] kkt_residual KKT residual.
+  /// @param[in, out] d Direction.
+  ///
+  void expandDirection(const int time_stage, const KKTMatrix& kkt_matrix,
+                       const KKTResidual& kkt_residual, Direction& d) const;
+
+private:
+  // Condensed stage whose state is the state of the first time stage of the
+  // block and whose control input is the stack of the control inputs of the
+  // block. The work space is also held so that the blocks can be condensed
+  // in parallel.
+  struct CondensedStage {
+    int begin = 0;
+    int size = 0;
+    Eigen::MatrixXd Fxx, Fxu, Qxx, Qxu, Quu, K, P_next;
+    Eigen::VectorXd Fx, lx, lu, k, s_next;
+    Eigen::MatrixXd QA, QB, FA, FB, BtP, GK;
+    Eigen::VectorXd g, Fc;
+    Eigen::LLT<Eigen::MatrixXd> llt;
+  };
+
+  int dimv_, dimx_, dimu_, block_size_, num_blocks_;
+  std::vector<CondensedStage> blocks_;
+  std::vector<int> block_index_;
+  Eigen::MatrixXd AtP_;
+
+  void resizeBlock(CondensedStage& block, const int size) const;
+
+  void condenseBlock(const KKTMatrix& kkt_matrix,
+                     const KKTResidual& kkt_residual,
+                     CondensedStage& block) const;
+
+  static int blockSizeHeuristic(const int dimx, const int dimu);
+
+  static bool isRegularTimeStage(const OCP& ocp, const int time_stage);
+
+};
+
+} // namespace robotoc
+
+#endif // ROBOTOC_PARTIAL_CONDENSING_HPP_
@@ -313,6 +313,9 @@ private:
     d_next.dx = kkt_residual.Fx;
     d_next.dx.noalias()   += kkt_matrix.Fxx * d.dx;
     d_next.dv().noalias() += kkt_matrix.Fvu * d.du;
+    if (kkt_matrix.Fqu.size() > 0) {
+      d_next.dq().noalias() += kkt_matrix.Fqu * d.du;
+    }
     if (sto) {
         d_next.dx.noalias() += kkt_matrix.fx * (d.dts_next-d.dts);
     }
@@ -10,6 +10,7 @@
 #include "robotoc/riccati/split_constrained_riccati_factorization.hpp"
 #include "robotoc/riccati/lqr_policy.hpp"
 #include "robotoc/riccati/riccati_factorizer.hpp"
+#include "robotoc/riccati/partial_condensing.hpp"
 #include "robotoc/ocp/ocp.hpp"
 #include "robotoc/ocp/direction.hpp"
 #include "robotoc/ocp/kkt_matrix.hpp"
@@ -34,9 +35,14 @@ public:
   /// @param[in] max_dts0 Maximum magnitude of the nominal direction of 
   /// the switching time. Used in a heuristic regularization on the dynamic 
   /// programming recursion. Must be positive. Default is 0.1.
+  /// @param[in] partial_condensing_block_size Number of the time stages 
+  /// merged into a block by the partial condensing. Must be non-negative. 
+  /// If 0, the block size is chosen by PartialCondensing::defaultBlockSize().
+  /// Default is 1, that is, the partial condensing is disabled.
   ///
   RiccatiRecursion(const OCP& ocp, const int nthreads, 
-                   const double max_dts0=0.1);
+                   const double max_dts0=0.1, 
+                   const int partial_condensing_block_size=1);
 
   ///
   /// @brief Default constructor. 
@@ -76,6 +82,21 @@ public:
   ///
   void setRegularization(const double max_dts0);
 
+  ///
+  /// @brief Sets the block size of the partial condensing.
+  /// @param[in] block_size Number of the time stages merged into a block. 
+  /// Must be non-negative. If 0, the block size is chosen by 
+  /// PartialCondensing::defaultBlockSize(). If 1, the partial condensing is 
+  /// disabled.
+  ///
+  void setPartialCondensing(const int block_size);
+
+  ///
+  /// @brief Gets the partial condensing. 
+  /// @return const reference to the partial condensing.
+  ///
+  const PartialCondensing& getPartialCondensing() const;
+
   ///
   /// @brief Reserve the internal data. 
   /// @param[in] ocp Optimal control problem.
@@ -133,6 +154,8 @@ public:
   ///
   /// @brief Gets of the LQR policies over the horizon. 
   /// @return const reference to the LQR policies.
+  /// @note If the partial condensing is enabled, the policies of the time 
+  /// stages inside the blocks except for the first stages are not updated.
   ///
   const hybrid_container<LQRPolicy>& getLQRPolicy() const;
 
@@ -142,6 +165,7 @@ private:
   hybrid_container<LQRPolicy> lqr_policy_;
   aligned_vector<STOPolicy> sto_policy_;
   SplitRiccatiFactorization factorization_m_;
+  PartialCondensing partial_condensing_;
   Eigen::VectorXd max_primal_step_sizes_, max_dual_step_sizes_;
 
 };
@@ -522,6 +522,14 @@ public:
   template <typename MatrixType>
   void getCoMJacobian(const Eigen::MatrixBase<MatrixType>& J) const;
 
+  ///
+  /// @brief Returns the Jacobian of the position of the center of mass 
+  /// without copying. Before calling this function, updateKinematics() must 
+  /// be called.
+  /// @return Const reference to the Jacobian of size 3 x Robot::dimv().
+  ///
+  const pinocchio::Data::Matrix3x& CoMJacobian() const;
+
   ///
   /// @brief Transforms 3D quantity from local frame to the world frame. 
   /// @param[in] frame_id Index of the frame whose local coordinate is of 
@@ -735,6 +743,17 @@ public:
       const Eigen::MatrixBase<MatrixType1>& dRNEA_partial_dq, 
       const Eigen::MatrixBase<MatrixType2>& dRNEA_partial_ddv);
 
+  ///
+  /// @brief Computes the joint inertia matrix M by the composite rigid body 
+  /// algorithm. 
+  /// @param[in] q Configuration. Size must be Robot::dimq().
+  /// @param[out] M Joint inertia matrix. Size must be 
+  /// Robot::dimv() x Robot::dimv().
+  ///   
+  template <typename ConfigVectorType, typename MatrixType>
+  void CRBA(const Eigen::MatrixBase<ConfigVectorType>& q, 
+            const Eigen::MatrixBase<MatrixType>& M);
+
   ///
   /// @brief Computes the inverse of the joint inertia matrix M.
   /// @param[in] M Joint inertia matrix. Size must be 
@@ -761,6 +780,26 @@ public:
                       const Eigen::MatrixBase<MatrixType2>& J,
                       const Eigen::MatrixBase<MatrixType3>& MJtJinv);
 
+  ///
+  /// @brief Solves the contact dynamics system [[M J^T], [J O]] x = b without 
+  /// forming the inverse of the matrix, i.e., by the sparse Cholesky 
+  /// factorization of M and the dense Cholesky factorization of J M^{-1} J^T.
+  /// @param[in] M Joint inertia matrix. Size must be 
+  /// Robot::dimv() x Robot::dimv().
+  /// @param[in] J Contact Jacobian. Size must be 
+  /// ContactStatus::dimf() x Robot::dimv().
+  /// @param[in] b Right-hand side. Size must be 
+  /// Robot::dimv() + ContactStatus::dimf().
+  /// @param[out] x Solution. Size must be 
+  /// Robot::dimv() + ContactStatus::dimf(). Must not be aliased with b.
+  ///   
+  template <typename MatrixType1, typename MatrixType2, typename VectorType1, 
+            typename VectorType2>
+  void solveMJtJ(const Eigen::MatrixBase<MatrixType1>& M, 
+                 const Eigen::MatrixBase<MatrixType2>& J,
+                 const Eigen::MatrixBase<VectorType1>& b,
+                 const Eigen::MatrixBase<VectorType2>& x);
+
   ///
   /// @brief Generates feasible configuration randomly.
   /// @return The random and feasible configuration. Size is Robot::dimq().
@@ -327,6 +327,11 @@ inline void Robot::getCoMJacobian(const Eigen::MatrixBase<MatrixType>& J) const
 }
 
 
+inline const pinocchio::Data::Matrix3x& Robot::CoMJacobian() const {
+  return data_.Jcom;
+}
+
+
 template <typename Vector3dType>
 inline void Robot::transformFromLocalToWorld(
     const int frame_id, const Eigen::Vector3d& vec_local, 
@@ -776,6 +781,19 @@ inline void Robot::RNEAImpulseDerivatives(
 }
 
 
+template <typename ConfigVectorType, typename MatrixType>
+inline void Robot::CRBA(const Eigen::MatrixBase<ConfigVectorType>& q, 
+                        const Eigen::MatrixBase<MatrixType>& M) {
+  assert(q.size() == dimq_);
+  assert(M.rows() == dimv_);
+  assert(M.cols() == dimv_);
+  pinocchio::crba(model_, data_, q);
+  data_.M.template triangularView<Eigen::StrictlyLower>() 
+      = data_.M.transpose().template triangularView<Eigen::StrictlyLower>();
+  const_cast<Eigen::MatrixBase<MatrixType>&>(M) = data_.M;
+}
+
+
 template <typename MatrixType1, typename MatrixType2>
 inline void Robot::computeMinv(const Eigen::MatrixBase<MatrixType1>& M, 
                                const Eigen::MatrixBase<MatrixType2>& Minv) {
@@ -836,6 +854,57 @@ inline void Robot::computeMJtJinv(
 }
 
 
+template <typename MatrixType1, typename MatrixType2, typename VectorType1, 
+          typename VectorType2>
+inline void Robot::solveMJtJ(const Eigen::MatrixBase<MatrixType1>& M, 
+                             const Eigen::MatrixBase<MatrixType2>& J,
+                             const Eigen::MatrixBase<VectorType1>& b,
+                             const Eigen::MatrixBase<VectorType2>& x) {
+  assert(M.rows() == dimv_);
+  assert(M.cols() == dimv_);
+  assert(J.rows() <= max_dimf_);
+  assert(J.cols() == dimv_);
+  assert(b.size() == M.rows()+J.rows());
+  assert(x.size() == M.rows()+J.rows());
+  const int dimf = J.rows();
+  data_.M = M;
+  pinocchio::cholesky::decompose(model_, data_);
+  Eigen::MatrixBase<VectorType2>& x_ 
+      = const_cast<Eigen::MatrixBase<VectorType2>&>(x);
+  if (dimf == 0) {
+    x_ = b;
+    pinocchio::cholesky::solve(model_, data_, x_);
+    return;
+  }
+  // sDUiJt = D^{-1/2} U^{-1} J^T with M = U D U^T
+  data_.sDUiJt.leftCols(dimf) = J.transpose();
+  pinocchio::cholesky::Uiv(model_, data_, data_.sDUiJt.leftCols(dimf));
+  x_.head(dimv_) = b.head(dimv_);
+  pinocchio::cholesky::Uiv(model_, data_, x_.head(dimv_));
+  for (Eigen::DenseIndex k=0; k<dimv_; ++k) {
+    const double sqrt_D_inv = 1.0 / std::sqrt(data_.D[k]);
+    data_.sDUiJt.leftCols(dimf).row(k) *= sqrt_D_inv;
+    x_.coeffRef(k) *= sqrt_D_inv;
+  }
+  data_.JMinvJt.topLeftCorner(dimf, dimf).noalias() 
+      = data_.sDUiJt.leftCols(dimf).transpose() * data_.sDUiJt.leftCols(dimf);
+  if (contact_inv_damping_ > 0.) {
+    data_.JMinvJt.diagonal().array() += contact_inv_damping_;
+  }
+  data_.llt_JMinvJt.compute(data_.JMinvJt.topLeftCorner(dimf, dimf));
+  assert(data_.llt_JMinvJt.info() == Eigen::Success);
+  // x_f = (J M^{-1} J^T)^{-1} (J M^{-1} b_a - b_f)
+  x_.tail(dimf).noalias() 
+      = data_.sDUiJt.leftCols(dimf).transpose() * x_.head(dimv_);
+  x_.tail(dimf) -= b.tail(dimf);
+  data_.llt_JMinvJt.solveInPlace(x_.tail(dimf));
+  // x_a = M^{-1} (b_a - J^T x_f)
+  x_.head(dimv_) = b.head(dimv_);
+  x_.head(dimv_).noalias() -= J.transpose() * x_.tail(dimf);
+  pinocchio::cholesky::solve(model_, data_, x_.head(dimv_));
+}
+
+
 inline Eigen::VectorXd Robot::generateFeasibleConfiguration() const {
   Eigen::VectorXd q_min(dimq_), q_max(dimq_);
   if (has_floating_base_) {
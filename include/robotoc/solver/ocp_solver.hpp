@@ -19,6 +19,7 @@
 #include "robotoc/ocp/kkt_matrix.hpp"
 #include "robotoc/ocp/kkt_residual.hpp"
 #include "robotoc/ocp/direct_multiple_shooting.hpp"
+#include "robotoc/ocp/nonlinear_rollout.hpp"
 #include "robotoc/riccati/riccati_recursion.hpp"
 #include "robotoc/riccati/riccati_factorization.hpp"
 #include "robotoc/line_search/line_search.hpp"
@@ -29,6 +30,7 @@
 #include "robotoc/solver/solver_options.hpp"
 #include "robotoc/solver/solver_statistics.hpp"
 #include "robotoc/utils/timer.hpp"
+#include "robotoc/utils/performance_counter.hpp"
 
 
 namespace robotoc {
@@ -158,6 +160,8 @@ public:
   /// returned. if option is set to other values, these expressed in the local
   /// frame are returned.
   /// @return Solution vector.
+  /// @remark The robot models used to compute the world-frame contact forces 
+  /// are copied once at the first such call and reused afterwards.
   ///
   std::vector<Eigen::VectorXd> getSolution(const std::string& name,
                                            const std::string& option="") const;
@@ -196,6 +200,28 @@ public:
   ///
   void extrapolateSolutionLastPhase(const double t);
 
+  ///
+  /// @brief Extrapolates the solution over the grids on the last contact phase
+  /// from the solution of a periodic gait one period earlier, i.e., from the 
+  /// contact phase num_phases_in_period phases before the last contact phase.
+  /// The floating base pose of the extrapolated solution is displaced by the 
+  /// rigid transformation (R, p), i.e., the base position x and orientation 
+  /// R_base are mapped to R * x + p and R * R_base, respectively. The other 
+  /// variables are copied as they are. Also initializes the slack and dual 
+  /// variables of the inequality constraints on such stages. If the contact 
+  /// phase one period earlier does not start within the horizon, this falls 
+  /// back to OCPSolver::extrapolateSolutionLastPhase().
+  /// @param[in] t Initial time of the horizon. 
+  /// @param[in] num_phases_in_period Number of the contact phases in a gait 
+  /// period. Must be positive.
+  /// @param[in] R Rotation of the displacement over a period. 
+  /// @param[in] p Translation of the displacement over a period. 
+  ///
+  void extrapolateSolutionPeriodic(const double t, 
+                                   const int num_phases_in_period,
+                                   const Eigen::Matrix3d& R, 
+                                   const Eigen::Vector3d& p);
+
   ///
   /// @brief Extrapolates the solution over the grids on the initial contact 
   /// phase. Also initializes the slack and dual variables of the inequality 
@@ -207,6 +233,10 @@ public:
   ///
   /// @brief Computes the KKT residual of the optimal control problem and 
   /// returns the KKT error, that is, the l2-norm of the KKT residual. 
+  /// This re-evaluates the KKT residual over the whole horizon and is 
+  /// intended as a diagnostic. Use OCPSolver::KKTError() or 
+  /// OCPSolver::getSolverStatistics() to get the KKT error of the last 
+  /// iteration without additional computation.
   /// @param[in] t Initial time of the horizon. 
   /// @param[in] q Initial configuration. Size must be Robot::dimq().
   /// @param[in] v Initial velocity. Size must be Robot::dimv().
@@ -263,23 +293,40 @@ public:
 
 private:
   aligned_vector<Robot> robots_;
+  mutable aligned_vector<Robot> robots_kinematics_;
   std::shared_ptr<ContactSequence> contact_sequence_;
   DirectMultipleShooting dms_;
   SwitchingTimeOptimization sto_;
   RiccatiRecursion riccati_recursion_;
   LineSearch line_search_;
+  NonlinearRollout nonlinear_rollout_;
   OCP ocp_;
   KKTMatrix kkt_matrix_;
   KKTResidual kkt_residual_;
-  Solution s_;
+  Solution s_, s_linear_;
   Direction d_;
+  Eigen::VectorXd u0_prev_;
   RiccatiFactorization riccati_factorization_;
   SolverOptions solver_options_;
   SolverStatistics solver_statistics_;
   Timer timer_;
+  PerformanceCounter performance_counter_;
+  int nthreads_;
 
   void reserveData();
+  void setLowerTriangularHessian();
+  void startPhase();
+  void stopPhase(const SolverPhase phase);
   void discretizeSolution();
+  void recordKKTErrorComponents();
+  bool isConverged(const double kkt_error);
+
+  std::vector<const SplitSolution*> timeOrderedSplitSolutions(
+      const int last_time_stage) const;
+
+  template <typename SplitFunc, typename ImpulseSplitFunc>
+  void parallelForEachSplitSolution(const SplitFunc& split_func, 
+                                    const ImpulseSplitFunc& impulse_split_func);
 
 };
 
@@ -0,0 +1,327 @@
+#ifndef ROBOTOC_OCP_SOLVER_POOL_HPP_
+#define ROBOTOC_OCP_SOLVER_POOL_HPP_
+
+#include <vector>
+#include <map>
+#include <queue>
+#include <string>
+#include <memory>
+#include <future>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+#include "Eigen/Core"
+
+#include "robotoc/robot/robot.hpp"
+#include "robotoc/robot/contact_status.hpp"
+#include "robotoc/ocp/ocp.hpp"
+#include "robotoc/ocp/solution.hpp"
+#include "robotoc/hybrid/time_discretization.hpp"
+#include "robotoc/solver/ocp_solver.hpp"
+#include "robotoc/solver/solver_options.hpp"
+#include "robotoc/solver/solver_statistics.hpp"
+#include "robotoc/utils/timer.hpp"
+
+
+namespace robotoc {
+
+///
+/// @class OCPSignature
+/// @brief Signature of an optimal control problem, i.e., the data that
+/// determines the memory layout of OCPSolver. Two optimal control problems
+/// with the same signature can be solved by the same OCPSolver instance
+/// after copying the contact sequence. The cost function and constraints
+/// are identified by their addresses.
+///
+struct OCPSignature {
+  ///
+  /// @brief Constructs the signature of an optimal control problem.
+  /// @param[in] ocp Optimal control problem.
+  ///
+  OCPSignature(const OCP& ocp);
+
+  ///
+  /// @brief Default constructor.
+  ///
+  OCPSignature();
+
+  int dimq, dimv, dimu;
+  std::vector<int> contact_frames;
+  std::vector<ContactType> contact_types;
+  double T;
+  int N, reserved_num_discrete_events, reserved_num_impulse_events, 
+      reserved_num_lift_events;
+  bool is_sto_enabled;
+  DiscretizationMethod discretization_method;
+  const CostFunction* cost;
+  const Constraints* constraints;
+  const STOCostFunction* sto_cost;
+  const STOConstraints* sto_constraints;
+
+  bool operator<(const OCPSignature& other) const;
+
+  bool operator==(const OCPSignature& other) const;
+};
+
+
+///
+/// @class OCPSolverRequest
+/// @brief A request to OCPSolverPool.
+///
+struct OCPSolverRequest {
+  ///
+  /// @brief Optimal control problem. The contact sequence is copied at the
+  /// dispatch, while the cost function and constraints are shared with the
+  /// pooled solvers and must not be modified until the request is solved.
+  ///
+  OCP ocp;
+
+  ///
+  /// @brief Solver options. Default is SolverOptions::defaultOptions().
+  ///
+  SolverOptions solver_options = SolverOptions::defaultOptions();
+
+  ///
+  /// @brief Initial time of the horizon.
+  ///
+  double t = 0;
+
+  ///
+  /// @brief Initial configuration. Size must be Robot::dimq().
+  ///
+  Eigen::VectorXd q;
+
+  ///
+  /// @brief Initial velocity. Size must be Robot::dimv().
+  ///
+  Eigen::VectorXd v;
+
+  ///
+  /// @brief Priority of the request. Requests with larger priorities are
+  /// dispatched first, and requests with the same priority are dispatched
+  /// in the submitted order. Default is 0.
+  ///
+  int priority = 0;
+
+  ///
+  /// @brief If true, the solution of the last converged request with the
+  /// same signature is used as the initial guess if it exists. Default is
+  /// true.
+  ///
+  bool use_warm_start = true;
+
+  ///
+  /// @brief If true, the solution of this request replaces the warm start of 
+  /// its signature if it converges. Set false to solve many perturbed 
+  /// problems from the same warm start, e.g., the solution of the nominal 
+  /// problem set by OCPSolverPool::setWarmStart(), so that the results do not 
+  /// depend on the order of the dispatch. Default is true.
+  ///
+  bool update_warm_start = true;
+
+  ///
+  /// @brief Initial guess used if the warm start is not applied, passed to
+  /// OCPSolver::setSolution(name, value). "q" and "v" are set to q and v
+  /// if they are not specified.
+  ///
+  std::map<std::string, Eigen::VectorXd> initial_guess;
+};
+
+
+///
+/// @class OCPSolverResult
+/// @brief A result of OCPSolverPool.
+///
+struct OCPSolverResult {
+  ///
+  /// @brief Solution over the horizon.
+  ///
+  Solution solution;
+
+  ///
+  /// @brief Solver statistics.
+  ///
+  SolverStatistics statistics;
+
+  ///
+  /// @brief The l2-norm of the KKT residual at the last iteration.
+  ///
+  double kkt_error = 0;
+
+  ///
+  /// @brief Flags whether the warm start is applied.
+  ///
+  bool warm_started = false;
+
+  ///
+  /// @brief Time from the submission until the dispatch [ms].
+  ///
+  double wait_time = 0;
+
+  ///
+  /// @brief Time from the dispatch until the completion [ms].
+  ///
+  double solve_time = 0;
+};
+
+
+///
+/// @class OCPSolverPool
+/// @brief A long-lived service that solves many independent optimal control
+/// problems. The requests are stored in a priority queue and are dispatched
+/// to the worker threads. Each worker takes an idle OCPSolver with the same
+/// signature (OCPSignature) as the request from the pool, or constructs a
+/// new one if there is none, so the solvers are constructed only once per
+/// signature and worker. The solution of the last converged request is kept
+/// for each signature as the warm start of the subsequent requests.
+///
+class OCPSolverPool {
+public:
+  ///
+  /// @brief Constructs the pool and launches the worker threads.
+  /// @param[in] nworkers Number of the worker threads, i.e., the number of
+  /// the requests solved concurrently. Must be positive.
+  /// @param[in] nthreads Number of the threads of each pooled OCPSolver.
+  /// Must be positive. Default is 1.
+  ///
+  OCPSolverPool(const int nworkers, const int nthreads=1);
+
+  ///
+  /// @brief Destructor. Solves all the submitted requests and joins the
+  /// worker threads.
+  ///
+  ~OCPSolverPool();
+
+  ///
+  /// @brief The pool is not copyable.
+  ///
+  OCPSolverPool(const OCPSolverPool&) = delete;
+
+  ///
+  /// @brief The pool is not copyable.
+  ///
+  OCPSolverPool& operator=(const OCPSolverPool&) = delete;
+
+  ///
+  /// @brief The pool is not movable.
+  ///
+  OCPSolverPool(OCPSolverPool&&) = delete;
+
+  ///
+  /// @brief The pool is not movable.
+  ///
+  OCPSolverPool& operator=(OCPSolverPool&&) = delete;
+
+  ///
+  /// @brief Submits a request.
+  /// @param[in] request Request.
+  /// @return Future of the result.
+  ///
+  std::future<OCPSolverResult> submit(const OCPSolverRequest& request);
+
+  ///
+  /// @brief Submits the requests and waits for all the results.
+  /// @param[in] requests Requests.
+  /// @return Results in the same order as the requests.
+  ///
+  std::vector<OCPSolverResult> solve(
+      const std::vector<OCPSolverRequest>& requests);
+
+  ///
+  /// @brief Constructs the solvers of the signature of an optimal control
+  /// problem in advance so that the first requests do not pay for the
+  /// construction.
+  /// @param[in] ocp Optimal control problem.
+  /// @param[in] num_solvers Number of the solvers. Must be non-negative and
+  /// is capped by the number of the workers.
+  ///
+  void reserve(const OCP& ocp, const int num_solvers);
+
+  ///
+  /// @brief Sets the warm start of the signature of an optimal control 
+  /// problem, e.g., the solution of the nominal problem from which many 
+  /// perturbed problems are solved.
+  /// @param[in] ocp Optimal control problem.
+  /// @param[in] solution Solution used as the initial guess of the subsequent 
+  /// requests with the same signature.
+  ///
+  void setWarmStart(const OCP& ocp, const Solution& solution);
+
+  ///
+  /// @brief Discards the warm starts of all the signatures.
+  ///
+  void clearWarmStarts();
+
+  ///
+  /// @return Number of the solvers constructed by the pool.
+  ///
+  int numSolvers() const;
+
+  ///
+  /// @return Number of the signatures that have a warm start.
+  ///
+  int numWarmStarts() const;
+
+  ///
+  /// @return Number of the requests waiting for the dispatch.
+  ///
+  int numPendingRequests() const;
+
+  ///
+  /// @return Number of the worker threads.
+  ///
+  int nworkers() const { return nworkers_; }
+
+private:
+  struct Job {
+    std::shared_ptr<OCPSolverRequest> request;
+    std::shared_ptr<std::promise<OCPSolverResult>> promise;
+    unsigned long long sequence;
+    Timer timer;
+
+    bool operator<(const Job& other) const {
+      if (request->priority != other.request->priority) {
+        return (request->priority < other.request->priority);
+      }
+      return (sequence > other.sequence);
+    }
+  };
+
+  struct PooledSolver {
+    std::unique_ptr<OCPSolver> solver;
+    std::shared_ptr<ContactSequence> contact_sequence;
+  };
+
+  int nworkers_, nthreads_;
+  std::vector<std::thread> workers_;
+  mutable std::mutex mtx_;
+  std::condition_variable cv_;
+  std::priority_queue<Job> queue_;
+  std::map<OCPSignature, std::vector<PooledSolver>> idle_solvers_;
+  std::map<OCPSignature, Solution> warm_starts_;
+  unsigned long long sequence_;
+  int num_solvers_;
+  bool terminate_;
+
+  void run();
+
+  void process(Job& job);
+
+  void solveRequest(const OCPSolverRequest& request, 
+                    const OCPSignature& signature, PooledSolver& pooled_solver, 
+                    OCPSolverResult& result);
+
+  static void resetSolution(const Robot& robot, OCPSolver& solver);
+
+  PooledSolver acquire(const OCPSignature& signature, const OCP& ocp);
+
+  void release(const OCPSignature& signature, PooledSolver&& pooled_solver);
+
+  PooledSolver createSolver(const OCP& ocp);
+
+};
+
+} // namespace robotoc
+
+#endif // ROBOTOC_OCP_SOLVER_POOL_HPP_
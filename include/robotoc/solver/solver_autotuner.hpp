@@ -0,0 +1,169 @@
+#ifndef ROBOTOC_SOLVER_AUTOTUNER_HPP_
+#define ROBOTOC_SOLVER_AUTOTUNER_HPP_
+
+#include <string>
+#include <vector>
+#include <iostream>
+
+#include "Eigen/Core"
+
+#include "robotoc/ocp/ocp.hpp"
+#include "robotoc/ocp/solution.hpp"
+#include "robotoc/solver/solver_options.hpp"
+
+
+namespace robotoc {
+
+///
+/// @class SolverAutotuner
+/// @brief Chooses the number of threads of OCPSolver by short calibration
+/// solves on the actual optimal control problem. The decision is cached per
+/// machine and problem signature so that later runs can skip the calibration.
+/// @note The only selectable parameter at runtime is the number of threads.
+/// Compile options such as OPTIMIZE_FOR_NATIVE cannot be changed after build.
+///
+class SolverAutotuner {
+public:
+  ///
+  /// @brief Construct the autotuner.
+  /// @param[in] cache_file Path to the cache file of the tuning results. If
+  /// empty, the results are not cached. Default is "".
+  /// @param[in] max_threads Maximum number of threads considered in the
+  /// calibration. If non-positive, the number of processors is used.
+  /// Default is 0.
+  /// @param[in] num_calibration_solves Number of the calibration solves for
+  /// each candidate number of threads. The minimum CPU time among them is
+  /// used. Must be positive. Default is 3.
+  /// @param[in] max_calibration_iter Maximum number of iterations in each
+  /// calibration solve. Must be positive. Default is 5.
+  ///
+  SolverAutotuner(const std::string& cache_file="", const int max_threads=0,
+                  const int num_calibration_solves=3,
+                  const int max_calibration_iter=5);
+
+  ///
+  /// @brief Destructor.
+  ///
+  ~SolverAutotuner();
+
+  ///
+  /// @brief Default copy constructor.
+  ///
+  SolverAutotuner(const SolverAutotuner&) = default;
+
+  ///
+  /// @brief Default copy assign operator.
+  ///
+  SolverAutotuner& operator=(const SolverAutotuner&) = default;
+
+  ///
+  /// @brief Default move constructor.
+  ///
+  SolverAutotuner(SolverAutotuner&&) noexcept = default;
+
+  ///
+  /// @brief Default move assign operator.
+  ///
+  SolverAutotuner& operator=(SolverAutotuner&&) noexcept = default;
+
+  ///
+  /// @brief Determines the number of threads of OCPSolver. If the cache file
+  /// contains an entry of the same machine and problem signatures, the cached
+  /// value is returned without calibration. Otherwise, the calibration solves
+  /// are carried out for the candidate numbers of threads (1, 2, 4, ...,
+  /// max_threads) and the fastest one is chosen and cached.
+  /// @param[in] ocp Optimal control problem. The contact sequence of ocp is
+  /// restored after each calibration solve.
+  /// @param[in] solver_options Solver options used in the calibration.
+  /// max_iter and enable_benchmark are overwritten.
+  /// @param[in] t Initial time of the horizon.
+  /// @param[in] q Initial configuration. Size must be Robot::dimq().
+  /// @param[in] v Initial velocity. Size must be Robot::dimv().
+  /// @return The number of threads.
+  ///
+  int tune(const OCP& ocp, const SolverOptions& solver_options,
+           const double t, const Eigen::VectorXd& q, const Eigen::VectorXd& v);
+
+  ///
+  /// @brief Determines the number of threads of OCPSolver with the initial
+  /// guess of the solution. See also SolverAutotuner::tune().
+  /// @param[in] ocp Optimal control problem.
+  /// @param[in] solver_options Solver options used in the calibration.
+  /// @param[in] t Initial time of the horizon.
+  /// @param[in] q Initial configuration. Size must be Robot::dimq().
+  /// @param[in] v Initial velocity. Size must be Robot::dimv().
+  /// @param[in] s Initial guess of the solution.
+  /// @return The number of threads.
+  ///
+  int tune(const OCP& ocp, const SolverOptions& solver_options,
+           const double t, const Eigen::VectorXd& q, const Eigen::VectorXd& v,
+           const Solution& s);
+
+  ///
+  /// @brief Returns the number of threads determined by the last tune().
+  /// @return The number of threads.
+  ///
+  int nthreads() const;
+
+  ///
+  /// @brief Returns true if the result of the last tune() was read from the
+  /// cache file.
+  ///
+  bool isCached() const;
+
+  ///
+  /// @brief Returns the candidate numbers of threads in the last calibration.
+  /// Empty if the last result was read from the cache file.
+  ///
+  const std::vector<int>& candidateNumThreads() const;
+
+  ///
+  /// @brief Returns the CPU time (milli seconds) of each candidate in the last
+  /// calibration. Empty if the last result was read from the cache file.
+  ///
+  const std::vector<double>& cpuTimes() const;
+
+  ///
+  /// @brief Returns the signature of the problem, which consists of the
+  /// dimensions of the robot, the number of the grids, the reserved number
+  /// of the discrete events, and whether the STO problem is enabled.
+  /// @param[in] ocp Optimal control problem.
+  /// @return The problem signature.
+  ///
+  static std::string problemSignature(const OCP& ocp);
+
+  ///
+  /// @brief Returns the signature of the machine, which consists of the host
+  /// name and the number of processors.
+  /// @return The machine signature.
+  ///
+  static std::string machineSignature();
+
+  ///
+  /// @brief Displays the tuning results onto a ostream.
+  ///
+  void disp(std::ostream& os) const;
+
+  friend std::ostream& operator<<(std::ostream& os,
+                                  const SolverAutotuner& autotuner);
+
+private:
+  std::string cache_file_;
+  int max_threads_, num_calibration_solves_, max_calibration_iter_, nthreads_;
+  bool is_cached_;
+  std::vector<int> candidate_nthreads_;
+  std::vector<double> cpu_times_;
+
+  int tune_impl(const OCP& ocp, const SolverOptions& solver_options,
+                const double t, const Eigen::VectorXd& q,
+                const Eigen::VectorXd& v, const Solution* s);
+
+  bool readCache(const std::string& key, int& nthreads) const;
+
+  void writeCache(const std::string& key, const int nthreads) const;
+
+};
+
+} // namespace robotoc
+
+#endif // ROBOTOC_SOLVER_AUTOTUNER_HPP_
@@ -4,7 +4,10 @@
 #include <iostream>
 
 #include "robotoc/hybrid/discretization_method.hpp"
+#include "robotoc/ocp/integration_scheme.hpp"
+#include "robotoc/ocp/forward_pass_method.hpp"
 #include "robotoc/line_search/line_search_settings.hpp"
+#include "robotoc/parnmpc/aux_mat_initialization.hpp"
 
 
 namespace robotoc {
@@ -57,6 +60,40 @@ public:
   ///
   double kkt_tol = 1.0e-07;
 
+  ///
+  /// @brief Number of the leading time stages of the stage-weighted 
+  /// convergence criterion. If positive, the solver also terminates when the 
+  /// l2-norm of the KKT residual of the leading time stages (and of the 
+  /// discrete events on them) is less than kkt_tol_leading and that of the 
+  /// remaining stages (including the STO problem) is less than kkt_tol_tail.
+  /// This is useful in MPC since only the leading part of the solution is 
+  /// applied. Default is 0, i.e., the criterion is disabled.
+  ///
+  int num_leading_stages = 0;
+
+  ///
+  /// @brief Tolerance of the l2-norm of the KKT residual of the leading time
+  /// stages in the stage-weighted convergence criterion. Default is 1.0e-07.
+  ///
+  double kkt_tol_leading = 1.0e-07;
+
+  ///
+  /// @brief Tolerance of the l2-norm of the KKT residual of the remaining 
+  /// time stages in the stage-weighted convergence criterion. Default is 
+  /// 1.0e-03.
+  ///
+  double kkt_tol_tail = 1.0e-03;
+
+  ///
+  /// @brief Tolerance of the first-input stagnation test. If positive, the 
+  /// solver also terminates when the l-infinity norm of the update of the 
+  /// control input at the initial time stage is less than this value and 
+  /// the primal step size is 1, i.e., the step is not truncated by the 
+  /// fraction-to-boundary rule or the line search. Default is 0, i.e., the 
+  /// test is disabled.
+  ///
+  double initial_input_tol = 0.0;
+
   ///
   /// @brief Initial barrier parameter. Must be positive. Default is 1.0e-03.
   ///
@@ -108,6 +145,37 @@ public:
   ///
   DiscretizationMethod discretization_method = DiscretizationMethod::GridBased;
 
+  ///
+  /// @brief Integration scheme of the state equation. Only used in OCPSolver. 
+  /// Default is IntegrationScheme::ForwardEuler.
+  /// @note IntegrationScheme::Midpoint integrates the configuration with the 
+  /// second-order accuracy, which allows a coarser time step, i.e., a 
+  /// smaller number of the time stages for the same trajectory accuracy.
+  ///
+  IntegrationScheme integration_scheme = IntegrationScheme::ForwardEuler;
+
+  ///
+  /// @brief If true, only the lower triangular parts of the symmetric Hessian 
+  /// blocks of the time stages (Qxx, Quu, and Qff) are accumulated and the 
+  /// Riccati recursion reads them in the symmetric form. Only used in 
+  /// OCPSolver. Default is false.
+  ///
+  bool enable_lower_triangular_hessian = false;
+
+  ///
+  /// @brief Update of the primal solution after the Newton-type direction 
+  /// is computed. Used in OCPSolver and UnconstrOCPSolver. Default is 
+  /// ForwardPassMethod::LinearStep.
+  /// @note ForwardPassMethod::NonlinearRollout rolls out the dynamics of the 
+  /// time stages before the first discrete event in OCPSolver. It falls back
+  /// to the linear step if the switching time optimization or the partial 
+  /// condensing is enabled. The rolled-out solution is also discarded if its 
+  /// merit function, i.e., the costs plus the penalized constraint 
+  /// violations, is larger than that of the linear step. This check costs 
+  /// two additional evaluations of the costs and constraints per iteration.
+  ///
+  ForwardPassMethod forward_pass_method = ForwardPassMethod::LinearStep;
+
   ///
   /// @brief Number of initial inner iterations in which a large regularization 
   /// for the STO problem is added, where the inner iteration means the 
@@ -157,11 +225,56 @@ public:
   ///
   double max_dts_riccati = 0.1;
 
+  ///
+  /// @brief Number of the time stages merged into a block by the partial 
+  /// condensing of the Riccati recursion in OCPSolver. Must be non-negative. 
+  /// If 0, the block size is chosen by PartialCondensing::defaultBlockSize(). 
+  /// If 1, the partial condensing is disabled. Default is 1.
+  /// @note The partial condensing merges only the time stages that are not 
+  /// adjacent to the discrete events and are not involved in the STO problem.
+  /// It is effective when Robot::dimu() is small relative to Robot::dimv(). 
+  ///
+  int partial_condensing_block_size = 1;
+
+  ///
+  /// @brief Initialization method of the auxiliary matrices of ParNMPC, 
+  /// which is used in UnconstrParNMPCSolver::initBackwardCorrection(). 
+  /// Default is AuxMatInitialization::TerminalCostHessian.
+  /// @note AuxMatInitialization::Shift is suitable for MPC in which 
+  /// the horizon moves forward by multiples of the time step. It is applied 
+  /// at the beginning of every solve, including the warm-started ones. 
+  /// AuxMatInitialization::Riccati gives the best approximation, e.g., after 
+  /// large state jumps, at the cost of a serial sweep over the horizon.
+  ///
+  AuxMatInitialization aux_mat_initialization 
+      = AuxMatInitialization::TerminalCostHessian;
+
+  ///
+  /// @brief Number of the blocks into which the horizon of ParNMPC is split. 
+  /// Must be non-negative and not larger than N. If 0, it is set to N, i.e., 
+  /// the stage-wise ParNMPC. If 1, the exact cost-to-go Hessians are used 
+  /// over the whole horizon as the Riccati recursion. Should be chosen to 
+  /// match the number of the threads.
+  /// Default is 0.
+  ///
+  int num_blocks_parnmpc = 0;
+
   ///
   /// @brief If true, the CPU time is measured at each solve().
   ///
   bool enable_benchmark = false;
 
+  ///
+  /// @brief If true, the CPU time and the hardware performance counters 
+  /// (cycles, instructions, cache misses, and branch misses) of each phase 
+  /// of the solver and each thread are measured and stored in 
+  /// SolverStatistics. The hardware counters are measured via Linux 
+  /// perf_event_open and are skipped if unavailable. The measurements are 
+  /// reset at each OCPSolver::solve() and accumulated over 
+  /// OCPSolver::updateSolution(). Default is false.
+  ///
+  bool enable_performance_counter = false;
+
   ///
   /// @brief Returns options with default parameters.
   ///
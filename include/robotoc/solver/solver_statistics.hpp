@@ -5,6 +5,8 @@
 #include <deque>
 #include <iostream>
 
+#include "robotoc/utils/performance_counter.hpp"
+
 
 namespace robotoc {
 
@@ -79,11 +81,84 @@ public:
   ///
   std::vector<int> mesh_refinement_iter;
 
+  ///
+  /// @brief l2-norm of the residual in the stationarity conditions, state 
+  /// equations, contact dynamics, and switching constraints at the last 
+  /// iteration.
+  /// @remark This and the other components below are recorded when the KKT 
+  /// system of the last iteration is computed, i.e., they describe the 
+  /// iterate before the last step is applied, as kkt_error.back() does, and 
+  /// not the returned solution. Their squared sum equals the square of 
+  /// kkt_error.back(). The KKT error of the returned solution is obtained by
+  /// OCPSolver::KKTError(t, q, v) at the cost of an additional evaluation.
+  /// The components are only recorded by OCPSolver and remain zero otherwise.
+  ///
+  double kkt_error_dynamics;
+
+  ///
+  /// @brief l2-norm of the primal residual of the inequality constraints at 
+  /// the last iteration.
+  ///
+  double kkt_error_constraints;
+
+  ///
+  /// @brief l2-norm of the complementary slackness of the inequality 
+  /// constraints at the last iteration.
+  ///
+  double kkt_error_complementarity;
+
+  ///
+  /// @brief l2-norm of the KKT residual of the switching time optimization 
+  /// (STO) problem at the last iteration.
+  ///
+  double kkt_error_sto;
+
+  ///
+  /// @brief l2-norm of the KKT residual of the leading time stages at the 
+  /// last iteration. Stored if SolverOptions::num_leading_stages is positive.
+  ///
+  double kkt_error_leading;
+
+  ///
+  /// @brief l2-norm of the KKT residual of the remaining time stages 
+  /// (including the STO problem) at the last iteration. Stored if 
+  /// SolverOptions::num_leading_stages is positive.
+  ///
+  double kkt_error_tail;
+
   ///
   /// @brief CPU time is stored if SolverOptions::enable_benchmark is true.
   ///
   double cpu_time;
 
+  ///
+  /// @brief CPU time [ms] of each solver phase accumulated over the 
+  /// iterations, indexed by SolverPhase. Stored if 
+  /// SolverOptions::enable_performance_counter is true.
+  ///
+  std::vector<double> phase_cpu_time;
+
+  ///
+  /// @brief Hardware performance counts of each solver phase and each thread
+  /// accumulated over the iterations, i.e., 
+  /// performance_counts[phase][thread]. Stored if 
+  /// SolverOptions::enable_performance_counter is true and the hardware 
+  /// counters are available.
+  ///
+  std::vector<std::vector<PerformanceCounts>> performance_counts;
+
+  ///
+  /// @brief Flags whether the hardware performance counters are available.
+  ///
+  bool performance_counter_available;
+
+  ///
+  /// @brief Stores the CPU times and the hardware performance counts of the 
+  /// solver phases.
+  /// @param[in] performance_counter Performance counter.
+  ///
+  void setPerformanceCounts(const PerformanceCounter& performance_counter);
+
   ///
   /// @brief Clear the all elements.
   ///
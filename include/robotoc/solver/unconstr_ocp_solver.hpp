@@ -142,6 +142,19 @@ public:
   ///
   void setSolution(const std::string& name, const Eigen::VectorXd& value);
 
+  ///
+  /// @brief Shifts the solution over the horizon forward in time to 
+  /// warm-start the next receding-horizon problem. The solution of each time 
+  /// stage is linearly interpolated from the previous solution at the time 
+  /// shifted by shift_time and the stages beyond the horizon are filled with 
+  /// those of the terminal stage. The slack and dual variables of the 
+  /// constraints are reinitialized from the shifted solution so that the 
+  /// solver can be warm-started without the initialization of the 
+  /// constraints. Does not reallocate any memory. 
+  /// @param[in] shift_time Shift time. Must be non-negative.
+  ///
+  void shiftSolution(const double shift_time);
+
   ///
   /// @brief Computes the KKT residual of the optimal control problem and 
   /// returns the KKT error, that is, the l2-norm of the KKT residual. 
@@ -188,16 +201,20 @@ private:
   UnconstrOCP ocp_;
   KKTMatrix kkt_matrix_;
   KKTResidual kkt_residual_;
-  Solution s_;
+  Solution s_, s_linear_;
   Direction d_;
   UnconstrRiccatiFactorization riccati_factorization_;
   int N_, nthreads_;
   double T_, dt_;
   Eigen::VectorXd primal_step_size_, dual_step_size_ ;
+  Eigen::VectorXd rollout_dx_, rollout_x_;
   SolverOptions solver_options_;
   SolverStatistics solver_statistics_;
   Timer timer_;
 
+  void rolloutSolution(const double t, const Eigen::VectorXd& q, 
+                       const Eigen::VectorXd& v, const double primal_step_size);
+
 };
 
 } // namespace robotoc 
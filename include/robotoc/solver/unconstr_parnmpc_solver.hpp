@@ -88,7 +88,8 @@ public:
   void initConstraints();
 
   ///
-  /// @brief Initializes the backward correction solver.
+  /// @brief Initializes the backward correction solver. The auxiliary 
+  /// matrices are initialized by SolverOptions::aux_mat_initialization.
   /// @param[in] t Initial time of the horizon. 
   ///
   void initBackwardCorrection(const double t);
@@ -111,7 +112,9 @@ public:
   /// @param[in] v Initial velocity. Size must be Robot::dimv().
   /// @param[in] init_solver If true, initializes the solver, that is, calls
   /// initConstraints(), initBackwardCorrection(), and clears the line search 
-  /// filter. Default is true.
+  /// filter. Default is true. If false and 
+  /// SolverOptions::aux_mat_initialization is AuxMatInitialization::Shift, 
+  /// only initBackwardCorrection() is called to shift the auxiliary matrices.
   ///
   void solve(const double t, const Eigen::VectorXd& q, const Eigen::VectorXd& v,
              const bool init_solver=true);
@@ -85,6 +85,14 @@ public:
   void initConstraints(Robot& robot, const int time_stage, 
                        const SplitSolution& s);
 
+  ///
+  /// @brief Reinitializes the slack and dual variables of the constraints 
+  /// from the solution without reallocating the constraints data. 
+  /// @param[in] robot Robot model. 
+  /// @param[in] s Split solution of this time stage.
+  ///
+  void initConstraints(Robot& robot, const SplitSolution& s);
+
   ///
   /// @brief Computes the stage cost and constraint violation.
   /// Used in the line search.
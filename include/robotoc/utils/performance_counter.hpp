@@ -0,0 +1,209 @@
+#ifndef ROBOTOC_UTILS_PERFORMANCE_COUNTER_HPP_
+#define ROBOTOC_UTILS_PERFORMANCE_COUNTER_HPP_
+
+#include <vector>
+#include <string>
+#include <iostream>
+
+#include "robotoc/utils/timer.hpp"
+
+
+namespace robotoc {
+
+///
+/// @enum SolverPhase
+/// @brief Phases of an iteration of the optimal control solvers that are
+/// instrumented by PerformanceCounter.
+///
+enum class SolverPhase {
+  KKTSystem = 0,
+  BackwardRiccati,
+  ForwardRiccati,
+  LineSearch,
+  Integration
+};
+
+///
+/// @brief Number of the solver phases.
+///
+constexpr int kNumSolverPhases = 5;
+
+///
+/// @brief Returns the name of the solver phase.
+/// @param[in] phase Solver phase.
+/// @return Name of the solver phase.
+///
+std::string solverPhaseName(const SolverPhase phase);
+
+///
+/// @class PerformanceCounts
+/// @brief Hardware performance counts of a thread. Counts are measured in
+/// the user space and are scaled if the kernel multiplexes the counters.
+///
+struct PerformanceCounts {
+  ///
+  /// @brief CPU cycles.
+  ///
+  long long cycles = 0;
+
+  ///
+  /// @brief Retired instructions.
+  ///
+  long long instructions = 0;
+
+  ///
+  /// @brief Last-level cache misses.
+  ///
+  long long cache_misses = 0;
+
+  ///
+  /// @brief Mispredicted branches.
+  ///
+  long long branch_misses = 0;
+
+  ///
+  /// @brief Returns instructions per cycle. Returns 0 if no cycles are
+  /// counted.
+  ///
+  double ipc() const {
+    return (cycles > 0) ? static_cast<double>(instructions) / cycles : 0.0;
+  }
+
+  ///
+  /// @brief Sets all the counts zero.
+  ///
+  void setZero() {
+    cycles = 0;
+    instructions = 0;
+    cache_misses = 0;
+    branch_misses = 0;
+  }
+
+  PerformanceCounts& operator+=(const PerformanceCounts& other) {
+    cycles += other.cycles;
+    instructions += other.instructions;
+    cache_misses += other.cache_misses;
+    branch_misses += other.branch_misses;
+    return *this;
+  }
+};
+
+
+///
+/// @class PerformanceCounter
+/// @brief Measures CPU time and hardware performance counters (cycles,
+/// instructions, cache misses, and branch misses) of each solver phase and
+/// each OpenMP thread via Linux perf_event_open. The counters of each thread
+/// are opened by the thread itself in an OpenMP parallel region, so they
+/// follow the worker threads of the persistent OpenMP thread pool.
+/// If perf_event_open is unavailable (non-Linux platforms or restricted by
+/// /proc/sys/kernel/perf_event_paranoid), only the CPU time is measured.
+///
+class PerformanceCounter {
+public:
+  ///
+  /// @brief Constructs the counter. The hardware counters are not opened
+  /// until open() is called.
+  /// @param[in] nthreads Number of the threads.
+  ///
+  PerformanceCounter(const int nthreads);
+
+  ///
+  /// @brief Default constructor.
+  ///
+  PerformanceCounter();
+
+  ///
+  /// @brief Destructor. Closes the hardware counters.
+  ///
+  ~PerformanceCounter();
+
+  ///
+  /// @brief Copy constructor. The hardware counters are not shared: the
+  /// copied counter is closed and must be opened again.
+  ///
+  PerformanceCounter(const PerformanceCounter& other);
+
+  ///
+  /// @brief Copy assign operator. The hardware counters are not shared: the
+  /// copied counter is closed and must be opened again.
+  ///
+  PerformanceCounter& operator=(const PerformanceCounter& other);
+
+  ///
+  /// @brief Opens the hardware counters of all the threads. Does nothing if
+  /// they are already opened.
+  /// @return true if the hardware counters are available. false otherwise.
+  ///
+  bool open();
+
+  ///
+  /// @brief Closes the hardware counters.
+  ///
+  void close();
+
+  ///
+  /// @brief Checks whether the counters are opened.
+  ///
+  bool isOpen() const { return is_open_; }
+
+  ///
+  /// @brief Checks whether the hardware counters are available.
+  ///
+  bool isAvailable() const { return is_available_; }
+
+  ///
+  /// @brief Starts measuring a phase.
+  ///
+  void start();
+
+  ///
+  /// @brief Stops measuring and accumulates the counts into a phase.
+  /// @param[in] phase Solver phase.
+  ///
+  void stop(const SolverPhase phase);
+
+  ///
+  /// @brief Sets all the accumulated counts and CPU times zero.
+  ///
+  void reset();
+
+  ///
+  /// @brief Returns the accumulated counts of a phase.
+  /// @param[in] phase Solver phase.
+  /// @return Accumulated counts of each thread.
+  ///
+  const std::vector<PerformanceCounts>& counts(const SolverPhase phase) const {
+    return counts_[static_cast<int>(phase)];
+  }
+
+  ///
+  /// @brief Returns the accumulated CPU time of a phase.
+  /// @param[in] phase Solver phase.
+  /// @return Accumulated CPU time [ms].
+  ///
+  double cpuTime(const SolverPhase phase) const {
+    return cpu_time_[static_cast<int>(phase)];
+  }
+
+  ///
+  /// @brief Returns the number of the threads.
+  ///
+  int nthreads() const { return nthreads_; }
+
+private:
+  int nthreads_;
+  bool is_open_, is_available_;
+  std::vector<std::vector<int>> fds_;
+  std::vector<PerformanceCounts> start_counts_;
+  std::vector<std::vector<PerformanceCounts>> counts_;
+  std::vector<double> cpu_time_;
+  Timer timer_;
+
+  bool readCounts(const int thread, PerformanceCounts& counts) const;
+
+};
+
+} // namespace robotoc
+
+#endif // ROBOTOC_UTILS_PERFORMANCE_COUNTER_HPP_
@@ -0,0 +1,496 @@
+#include "robotoc/constraints/collision_avoidance.hpp"
+
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <iostream>
+#include <algorithm>
+#include <numeric>
+
+#include "Eigen/Geometry"
+
+
+namespace robotoc {
+
+CollisionAvoidance::CollisionAvoidance(const Robot& robot,
+                                       const double min_distance,
+                                       const double activation_distance)
+  : ConstraintComponentBase(),
+    dimv_(robot.dimv()),
+    min_distance_(min_distance),
+    activation_distance_(activation_distance),
+    sphere_frames_(),
+    sphere_frame_slots_(),
+    unique_frames_(),
+    sphere_offsets_(),
+    sphere_radii_(),
+    pairs_(),
+    pair_index_() {
+  try {
+    if (activation_distance <= min_distance) {
+      throw std::out_of_range(
+          "Invalid argument: activation_distance must be larger than min_distance!");
+    }
+  }
+  catch(const std::exception& e) {
+    std::cerr << e.what() << '\n';
+    std::exit(EXIT_FAILURE);
+  }
+}
+
+
+CollisionAvoidance::CollisionAvoidance()
+  : ConstraintComponentBase(),
+    dimv_(0),
+    min_distance_(0),
+    activation_distance_(0),
+    sphere_frames_(),
+    sphere_frame_slots_(),
+    unique_frames_(),
+    sphere_offsets_(),
+    sphere_radii_(),
+    pairs_(),
+    pair_index_() {
+}
+
+
+CollisionAvoidance::~CollisionAvoidance() {
+}
+
+
+int CollisionAvoidance::addCollisionSphere(const int frame_id,
+                                           const Eigen::Vector3d& offset,
+                                           const double radius) {
+  try {
+    if (frame_id < 0) {
+      throw std::out_of_range(
+          "Invalid argument: frame_id must be non-negative!");
+    }
+    if (radius < 0) {
+      throw std::out_of_range(
+          "Invalid argument: radius must be non-negative!");
+    }
+  }
+  catch(const std::exception& e) {
+    std::cerr << e.what() << '\n';
+    std::exit(EXIT_FAILURE);
+  }
+  const auto it = std::find(unique_frames_.begin(), unique_frames_.end(),
+                            frame_id);
+  if (it == unique_frames_.end()) {
+    sphere_frame_slots_.push_back(unique_frames_.size());
+    unique_frames_.push_back(frame_id);
+  }
+  else {
+    sphere_frame_slots_.push_back(it-unique_frames_.begin());
+  }
+  sphere_frames_.push_back(frame_id);
+  sphere_offsets_.push_back(offset);
+  sphere_radii_.push_back(radius);
+  const int num_spheres = sphere_frames_.size();
+  pair_index_.conservativeResize(num_spheres, num_spheres);
+  pair_index_.row(num_spheres-1).fill(-1);
+  pair_index_.col(num_spheres-1).fill(-1);
+  return num_spheres - 1;
+}
+
+
+int CollisionAvoidance::addObstacleSphere(const Eigen::Vector3d& center,
+                                          const double radius) {
+  try {
+    if (radius < 0) {
+      throw std::out_of_range(
+          "Invalid argument: radius must be non-negative!");
+    }
+  }
+  catch(const std::exception& e) {
+    std::cerr << e.what() << '\n';
+    std::exit(EXIT_FAILURE);
+  }
+  sphere_frames_.push_back(-1);
+  sphere_frame_slots_.push_back(-1);
+  sphere_offsets_.push_back(center);
+  sphere_radii_.push_back(radius);
+  const int num_spheres = sphere_frames_.size();
+  pair_index_.conservativeResize(num_spheres, num_spheres);
+  pair_index_.row(num_spheres-1).fill(-1);
+  pair_index_.col(num_spheres-1).fill(-1);
+  return num_spheres - 1;
+}
+
+
+void CollisionAvoidance::setObstaclePosition(const int sphere,
+                                             const Eigen::Vector3d& center) {
+  try {
+    if (sphere < 0 || sphere >= numSpheres()) {
+      throw std::out_of_range(
+          "Invalid argument: sphere must be in [0, " + std::to_string(numSpheres()) + ")!");
+    }
+    if (sphere_frames_[sphere] >= 0) {
+      throw std::out_of_range(
+          "Invalid argument: sphere " + std::to_string(sphere) + " is not an obstacle!");
+    }
+  }
+  catch(const std::exception& e) {
+    std::cerr << e.what() << '\n';
+    std::exit(EXIT_FAILURE);
+  }
+  sphere_offsets_[sphere] = center;
+}
+
+
+void CollisionAvoidance::addCollisionPair(const int sphere1,
+                                          const int sphere2) {
+  try {
+    if (sphere1 < 0 || sphere1 >= numSpheres()) {
+      throw std::out_of_range(
+          "Invalid argument: sphere1 must be in [0, " + std::to_string(numSpheres()) + ")!");
+    }
+    if (sphere2 < 0 || sphere2 >= numSpheres()) {
+      throw std::out_of_range(
+          "Invalid argument: sphere2 must be in [0, " + std::to_string(numSpheres()) + ")!");
+    }
+    if (sphere1 == sphere2) {
+      throw std::out_of_range(
+          "Invalid argument: sphere1 and sphere2 must be different!");
+    }
+    if (sphere_frames_[sphere1] < 0 && sphere_frames_[sphere2] < 0) {
+      throw std::out_of_range(
+          "Invalid argument: sphere1 or sphere2 must be attached to the robot!");
+    }
+  }
+  catch(const std::exception& e) {
+    std::cerr << e.what() << '\n';
+    std::exit(EXIT_FAILURE);
+  }
+  if (pair_index_.coeff(sphere1, sphere2) >= 0) {
+    return;
+  }
+  const int pair = pairs_.size();
+  pairs_.push_back(std::make_pair(sphere1, sphere2));
+  pair_index_.coeffRef(sphere1, sphere2) = pair;
+  pair_index_.coeffRef(sphere2, sphere1) = pair;
+}
+
+
+void CollisionAvoidance::addEnvironmentCollisionPairs() {
+  for (int i=0; i<numSpheres(); ++i) {
+    if (sphere_frames_[i] < 0) continue;
+    for (int j=0; j<numSpheres(); ++j) {
+      if (sphere_frames_[j] >= 0) continue;
+      addCollisionPair(i, j);
+    }
+  }
+}
+
+
+int CollisionAvoidance::numSpheres() const {
+  return sphere_frames_.size();
+}
+
+
+int CollisionAvoidance::numCollisionPairs() const {
+  return pairs_.size();
+}
+
+
+bool CollisionAvoidance::isActive(const ConstraintComponentData& data,
+                                  const int pair) const {
+  return (activeFlags(data).coeff(pair) > 0.5);
+}
+
+
+double CollisionAvoidance::distance(const ConstraintComponentData& data,
+                                    const int pair) const {
+  return distances(data).coeff(pair);
+}
+
+
+bool CollisionAvoidance::useKinematics() const {
+  return true;
+}
+
+
+KinematicsLevel CollisionAvoidance::kinematicsLevel() const {
+  return KinematicsLevel::PositionLevel;
+}
+
+
+void CollisionAvoidance::allocateExtraData(
+    ConstraintComponentData& data) const {
+  const int num_spheres = numSpheres();
+  const int num_pairs = numCollisionPairs();
+  const int num_frames = unique_frames_.size();
+  data.r.clear();
+  data.r.push_back(Eigen::VectorXd::Zero(3*num_spheres));
+  data.r.push_back(Eigen::VectorXd::Zero(num_pairs));
+  data.r.push_back(Eigen::VectorXd::Zero(num_pairs));
+  data.r.push_back(Eigen::VectorXd::Ones(num_pairs));
+  data.r.push_back(Eigen::VectorXd::Zero(num_frames));
+  data.J.clear();
+  data.J.push_back(Eigen::MatrixXd::Zero(num_pairs, dimv_));
+  for (int i=0; i<num_frames; ++i) {
+    data.J.push_back(Eigen::MatrixXd::Zero(6, dimv_));
+  }
+  data.index.resize(num_spheres);
+  std::iota(data.index.begin(), data.index.end(), 0);
+}
+
+
+bool CollisionAvoidance::isFeasible(Robot& robot,
+                                    const ContactStatus& contact_status,
+                                    ConstraintComponentData& data,
+                                    const SplitSolution& s) const {
+  robot.updateFrameKinematics(s.q);
+  computeSpherePositions(robot, data);
+  // The pairs pruned in the broad phase are farther than the activation
+  // distance and hence feasible.
+  computeDistances(data, true);
+  for (int i=0; i<numCollisionPairs(); ++i) {
+    if (isActive(data, i) && distances(data).coeff(i) < min_distance_) {
+      return false;
+    }
+  }
+  return true;
+}
+
+
+void CollisionAvoidance::setSlack(Robot& robot,
+                                  const ContactStatus& contact_status,
+                                  ConstraintComponentData& data,
+                                  const SplitSolution& s) const {
+  robot.updateFrameKinematics(s.q);
+  computeSpherePositions(robot, data);
+  computeDistances(data, false);
+  data.slack.array() = distances(data).array() - min_distance_;
+  linearizedFlags(data).fill(1.0);
+}
+
+
+void CollisionAvoidance::evalConstraint(Robot& robot,
+                                        const ContactStatus& contact_status,
+                                        ConstraintComponentData& data,
+                                        const SplitSolution& s) const {
+  computeSpherePositions(robot, data);
+  computeDistances(data, true);
+  for (int i=0; i<numCollisionPairs(); ++i) {
+    if (isActive(data, i)) {
+      data.residual.coeffRef(i) = min_distance_ - distances(data).coeff(i)
+                                    + data.slack.coeff(i);
+    }
+    else {
+      data.residual.coeffRef(i) = 0.0;
+    }
+  }
+  computeComplementarySlackness(data);
+  data.log_barrier = logBarrier(data.slack);
+}
+
+
+void CollisionAvoidance::evalDerivatives(Robot& robot,
+                                         const ContactStatus& contact_status,
+                                         ConstraintComponentData& data,
+                                         const SplitSolution& s,
+                                         SplitKKTResidual& kkt_residual) const {
+  frameJacobianFlags(data).setZero();
+  bool reset = false;
+  for (int i=0; i<numCollisionPairs(); ++i) {
+    if (isActive(data, i)) {
+      if (linearizedFlags(data).coeff(i) < 0.5) {
+        // The slack and dual of the inactive pair are not updated consistently
+        // with its distance, so they are reset on the activation.
+        resetSlackAndDual(data, i);
+        reset = true;
+      }
+      computeDistanceJacobian(robot, data, i);
+      kkt_residual.lq().noalias()
+          -= data.dual.coeff(i) * distanceJacobian(data).row(i).transpose();
+    }
+  }
+  linearizedFlags(data) = activeFlags(data);
+  if (reset) {
+    data.log_barrier = logBarrier(data.slack);
+  }
+}
+
+
+void CollisionAvoidance::condenseSlackAndDual(
+    const ContactStatus& contact_status, ConstraintComponentData& data,
+    SplitKKTMatrix& kkt_matrix, SplitKKTResidual& kkt_residual) const {
+  computeCondensingCoeffcient(data);
+  for (int i=0; i<numCollisionPairs(); ++i) {
+    if (linearizedFlags(data).coeff(i) > 0.5) {
+      if (kkt_matrix.isLowerTriangularHessian()) {
+        kkt_matrix.Qqq().selfadjointView<Eigen::Lower>().rankUpdate(
+            distanceJacobian(data).row(i).transpose(), 
+            data.dual.coeff(i) / data.slack.coeff(i));
+      }
+      else {
+        kkt_matrix.Qqq().noalias()
+            += (data.dual.coeff(i) / data.slack.coeff(i))
+                * distanceJacobian(data).row(i).transpose()
+                * distanceJacobian(data).row(i);
+      }
+      kkt_residual.lq().noalias()
+          -= data.cond.coeff(i) * distanceJacobian(data).row(i).transpose();
+    }
+  }
+}
+
+
+void CollisionAvoidance::expandSlackAndDual(
+    const ContactStatus& contact_status, ConstraintComponentData& data,
+    const SplitDirection& d) const {
+  for (int i=0; i<numCollisionPairs(); ++i) {
+    if (linearizedFlags(data).coeff(i) > 0.5) {
+      data.dslack.coeffRef(i) = distanceJacobian(data).row(i).dot(d.dq())
+                                  - data.residual.coeff(i);
+    }
+    else {
+      data.dslack.coeffRef(i) = - data.residual.coeff(i);
+    }
+  }
+  computeDualDirection(data);
+}
+
+
+int CollisionAvoidance::dimc() const {
+  return numCollisionPairs();
+}
+
+
+void CollisionAvoidance::computeSpherePositions(
+    const Robot& robot, ConstraintComponentData& data) const {
+  for (int i=0; i<numSpheres(); ++i) {
+    const int frame = sphere_frames_[i];
+    if (frame >= 0) {
+      spherePositions(data).template segment<3>(3*i)
+          = robot.framePosition(frame);
+      spherePositions(data).template segment<3>(3*i).noalias()
+          += robot.frameRotation(frame) * sphere_offsets_[i];
+    }
+    else {
+      spherePositions(data).template segment<3>(3*i) = sphere_offsets_[i];
+    }
+  }
+}
+
+
+void CollisionAvoidance::computeDistances(ConstraintComponentData& data,
+                                          const bool use_broad_phase) const {
+  const int num_spheres = numSpheres();
+  const Eigen::VectorXd& p = spherePositions(data);
+  activeFlags(data).setZero();
+  auto computeDistance = [&](const int pair) {
+    const int a = pairs_[pair].first;
+    const int b = pairs_[pair].second;
+    const double d = (p.template segment<3>(3*a)
+                        -p.template segment<3>(3*b)).norm()
+                      - sphere_radii_[a] - sphere_radii_[b];
+    distances(data).coeffRef(pair) = d;
+    if (d < activation_distance_) {
+      activeFlags(data).coeffRef(pair) = 1.0;
+    }
+  };
+  if (!use_broad_phase) {
+    for (int i=0; i<numCollisionPairs(); ++i) {
+      computeDistance(i);
+    }
+    return;
+  }
+  // Sweep-and-prune along the x-axis. The interval of each sphere is
+  // inflated by the half of the activation distance so that the pairs whose
+  // intervals do not overlap are farther than the activation distance.
+  const double margin = 0.5 * activation_distance_;
+  auto lower = [&](const int sphere) {
+    return p.coeff(3*sphere) - sphere_radii_[sphere] - margin;
+  };
+  auto upper = [&](const int sphere) {
+    return p.coeff(3*sphere) + sphere_radii_[sphere] + margin;
+  };
+  // The order of the previous evaluation is almost sorted, so the insertion
+  // sort runs in nearly linear time.
+  std::vector<int>& order = sweepOrder(data);
+  for (int i=1; i<num_spheres; ++i) {
+    const int sphere = order[i];
+    const double key = lower(sphere);
+    int j = i - 1;
+    while (j >= 0 && lower(order[j]) > key) {
+      order[j+1] = order[j];
+      --j;
+    }
+    order[j+1] = sphere;
+  }
+  for (int i=0; i<num_spheres; ++i) {
+    const int a = order[i];
+    const double upper_a = upper(a);
+    for (int j=i+1; j<num_spheres; ++j) {
+      const int b = order[j];
+      if (lower(b) > upper_a) break;
+      const int pair = pair_index_.coeff(a, b);
+      if (pair >= 0) {
+        computeDistance(pair);
+      }
+    }
+  }
+}
+
+
+void CollisionAvoidance::resetSlackAndDual(ConstraintComponentData& data,
+                                           const int pair) const {
+  const double sqrt_barrier = std::sqrt(barrier());
+  const double slack = distances(data).coeff(pair) - min_distance_;
+  data.slack.coeffRef(pair) = (slack > sqrt_barrier) ? slack : sqrt_barrier;
+  data.dual.coeffRef(pair) = barrier() / data.slack.coeff(pair);
+  data.residual.coeffRef(pair) = min_distance_ - distances(data).coeff(pair)
+                                  + data.slack.coeff(pair);
+  data.cmpl.coeffRef(pair) = computeComplementarySlackness(
+      data.slack.coeff(pair), data.dual.coeff(pair));
+}
+
+
+void CollisionAvoidance::computeDistanceJacobian(
+    Robot& robot, ConstraintComponentData& data, const int pair) const {
+  const int a = pairs_[pair].first;
+  const int b = pairs_[pair].second;
+  const Eigen::VectorXd& p = spherePositions(data);
+  Eigen::Vector3d n = p.template segment<3>(3*a) - p.template segment<3>(3*b);
+  const double norm = n.norm();
+  if (norm > std::numeric_limits<double>::epsilon()) {
+    n.array() /= norm;
+  }
+  else {
+    // The direction is arbitrary if the centers coincide.
+    n << 0, 0, 1;
+  }
+  distanceJacobian(data).row(pair).setZero();
+  addSphereJacobian(robot, data, a, n, pair);
+  addSphereJacobian(robot, data, b, -n, pair);
+}
+
+
+void CollisionAvoidance::addSphereJacobian(Robot& robot,
+                                           ConstraintComponentData& data,
+                                           const int sphere,
+                                           const Eigen::Vector3d& n,
+                                           const int pair) const {
+  const int frame = sphere_frames_[sphere];
+  if (frame < 0) return;
+  const int slot = sphere_frame_slots_[sphere];
+  if (frameJacobianFlags(data).coeff(slot) < 0.5) {
+    robot.getFrameJacobian(frame, frameJacobian(data, slot));
+    frameJacobianFlags(data).coeffRef(slot) = 1.0;
+  }
+  // The velocity of the center in the local coordinate is
+  // Jv * v + (Jw * v) x offset, and n^T R (Jv - [offset]x Jw) is
+  // m^T Jv - (m x offset)^T Jw with m = R^T n.
+  const Eigen::Vector3d m = robot.frameRotation(frame).transpose() * n;
+  const Eigen::Vector3d mo = m.cross(sphere_offsets_[sphere]);
+  const Eigen::MatrixXd& J = frameJacobian(data, slot);
+  distanceJacobian(data).row(pair).noalias()
+      += m.transpose() * J.template topRows<3>();
+  distanceJacobian(data).row(pair).noalias()
+      -= mo.transpose() * J.template bottomRows<3>();
+}
+
+} // namespace robotoc
@@ -267,12 +267,21 @@ void FrictionCone::condenseSlackAndDual(const ContactStatus& contact_status,
                     / data.slack.template segment<5>(idx).array();
       dfWi_dq.template topRows<5>().noalias() = ri.asDiagonal() * dgi_dq;
       r_dgi_df.noalias() = ri.asDiagonal() * dgi_df;
-      kkt_matrix.Qqq().noalias()
-          += dgi_dq.transpose() * dfWi_dq.template topRows<5>();
+      if (kkt_matrix.isLowerTriangularHessian()) {
+        kkt_matrix.Qqq().template triangularView<Eigen::Lower>()
+            += dgi_dq.transpose() * dfWi_dq.template topRows<5>();
+        kkt_matrix.Qff().template block<3, 3>(dimf_stack, dimf_stack)
+            .template triangularView<Eigen::Lower>() 
+                += dgi_df.transpose() * r_dgi_df;
+      }
+      else {
+        kkt_matrix.Qqq().noalias()
+            += dgi_dq.transpose() * dfWi_dq.template topRows<5>();
+        kkt_matrix.Qff().template block<3, 3>(dimf_stack, dimf_stack).noalias()
+            += dgi_df.transpose() * r_dgi_df;
+      }
       kkt_matrix.Qqf().template middleCols<3>(dimf_stack).noalias()
           += dgi_dq.transpose() * r_dgi_df; 
-      kkt_matrix.Qff().template block<3, 3>(dimf_stack, dimf_stack).noalias()
-          += dgi_df.transpose() * r_dgi_df;
       switch (contact_types_[i]) {
         case ContactType::PointContact:
           dimf_stack += 3;
@@ -0,0 +1,363 @@
+#include "robotoc/constraints/soc_friction_cone.hpp"
+#include "robotoc/constraints/soc_pdipm.hpp"
+
+#include <stdexcept>
+#include <iostream>
+
+
+namespace robotoc {
+
+SOCFrictionCone::SOCFrictionCone(const Robot& robot, const double mu)
+  : SOCFrictionCone(robot, std::vector<double>(robot.maxNumContacts(), mu)) {
+}
+
+
+SOCFrictionCone::SOCFrictionCone(const Robot& robot,
+                                 const std::vector<double>& mu)
+  : ConstraintComponentBase(),
+    dimv_(robot.dimv()),
+    dimc_(3*robot.maxNumContacts()),
+    max_num_contacts_(robot.maxNumContacts()),
+    contact_frame_(robot.contactFrames()),
+    contact_types_(robot.contactTypes()),
+    mu_(mu),
+    cone_(robot.maxNumContacts(), Eigen::MatrixXd::Zero(3, 3)) {
+  try {
+    if (robot.maxNumContacts() == 0) {
+      throw std::out_of_range(
+          "Invalid argument: robot.maxNumContacts() must be positive!");
+    }
+    if (mu.size() != robot.maxNumContacts()) {
+      throw std::out_of_range(
+          "Invalid argument: mu.size() must be" + std::to_string(robot.maxNumContacts()) + "!");
+    }
+    for (int i=0; i<robot.maxNumContacts(); ++i) {
+      if (mu[i] <= 0) {
+        throw std::out_of_range(
+            "Invalid argument: mu[" + std::to_string(i) + "] must be positive!");
+      }
+    }
+  }
+  catch(const std::exception& e) {
+    std::cerr << e.what() << '\n';
+    std::exit(EXIT_FAILURE);
+  }
+  for (int i=0; i<robot.maxNumContacts(); ++i) {
+    cone_[i] <<  0,  0, -mu[i],
+                -1,  0,  0,
+                 0, -1,  0;
+  }
+}
+
+
+SOCFrictionCone::SOCFrictionCone()
+  : ConstraintComponentBase(),
+    dimc_(0),
+    max_num_contacts_(0),
+    dimv_(0),
+    contact_frame_(),
+    contact_types_(),
+    mu_(),
+    cone_() {
+}
+
+
+SOCFrictionCone::~SOCFrictionCone() {
+}
+
+
+void SOCFrictionCone::setFrictionCoefficient(const double mu) {
+  setFrictionCoefficient(std::vector<double>(max_num_contacts_, mu));
+}
+
+
+void SOCFrictionCone::setFrictionCoefficient(const std::vector<double>& mu) {
+  try {
+    if (mu.size() != max_num_contacts_) {
+      throw std::out_of_range(
+          "Invalid argument: mu.size() must be" + std::to_string(max_num_contacts_) + "!");
+    }
+    for (int i=0; i<max_num_contacts_; ++i) {
+      if (mu[i] <= 0) {
+        throw std::out_of_range(
+            "Invalid argument: mu[" + std::to_string(i) + "] must be positive!");
+      }
+    }
+  }
+  catch(const std::exception& e) {
+    std::cerr << e.what() << '\n';
+    std::exit(EXIT_FAILURE);
+  }
+  for (int i=0; i<max_num_contacts_; ++i) {
+    mu_[i]  = mu[i];
+    cone_[i] <<  0,  0, -mu[i],
+                -1,  0,  0,
+                 0, -1,  0;
+  }
+}
+
+
+bool SOCFrictionCone::useKinematics() const {
+  return true;
+}
+
+
+KinematicsLevel SOCFrictionCone::kinematicsLevel() const {
+  return KinematicsLevel::AccelerationLevel;
+}
+
+
+void SOCFrictionCone::allocateExtraData(ConstraintComponentData& data) const {
+  data.r.clear();
+  for (int i=0; i<max_num_contacts_; ++i) {
+    data.r.push_back(Eigen::VectorXd::Zero(3)); // fWi
+  }
+  for (int i=0; i<max_num_contacts_; ++i) {
+    data.r.push_back(Eigen::VectorXd::Zero(3)); // dz0i
+  }
+  data.J.clear();
+  for (int i=0; i<max_num_contacts_; ++i) {
+    data.J.push_back(Eigen::MatrixXd::Zero(3, dimv_)); // dgi_dq
+  }
+  for (int i=0; i<max_num_contacts_; ++i) {
+    data.J.push_back(Eigen::MatrixXd::Zero(3, 3)); // dgi_df
+  }
+  for (int i=0; i<max_num_contacts_; ++i) {
+    data.J.push_back(Eigen::MatrixXd::Zero(6, dimv_)); // dfWi_dq
+  }
+  for (int i=0; i<max_num_contacts_; ++i) {
+    data.J.push_back(Eigen::MatrixXd::Zero(3, 3)); // r_dgi_df
+  }
+  for (int i=0; i<max_num_contacts_; ++i) {
+    data.J.push_back(Eigen::MatrixXd::Zero(3, 3)); // cone_local
+  }
+  for (int i=0; i<max_num_contacts_; ++i) {
+    data.J.push_back(Eigen::MatrixXd::Zero(3, 3)); // Hi
+  }
+  // ConstraintComponentData initializes all the elements of the slack and
+  // dual by the same value, which is not in the interior of the cones.
+  data.slack.setZero();
+  data.dual.setZero();
+  for (int i=0; i<max_num_contacts_; ++i) {
+    socpdipm::setSlackAndDualInterior(barrier(), data, 3*i);
+  }
+}
+
+
+void SOCFrictionCone::setSlackAndDualPositive(
+    ConstraintComponentData& data) const {
+  for (int i=0; i<max_num_contacts_; ++i) {
+    socpdipm::setSlackAndDualInterior(barrier(), data, 3*i);
+  }
+}
+
+
+double SOCFrictionCone::maxSlackStepSize(
+    const ConstraintComponentData& data) const {
+  return socpdipm::fractionToBoundarySlack(fractionToBoundaryRule(), data);
+}
+
+
+double SOCFrictionCone::maxDualStepSize(
+    const ConstraintComponentData& data) const {
+  return socpdipm::fractionToBoundaryDual(fractionToBoundaryRule(), data);
+}
+
+
+bool SOCFrictionCone::isFeasible(Robot& robot,
+                                 const ContactStatus& contact_status,
+                                 ConstraintComponentData& data,
+                                 const SplitSolution& s) const {
+  robot.updateFrameKinematics(s.q);
+  for (int i=0; i<max_num_contacts_; ++i) {
+    if (contact_status.isContactActive(i)) {
+      const int idx = 3*i;
+      Eigen::VectorXd& fWi = fW(data, i);
+      robot.transformFromLocalToWorld(contact_frame_[i],
+                                      s.f[i].template head<3>(), fWi);
+      frictionConeResidual(mu_[i], fWi, contact_status.contactRotation(i),
+                           data.residual.template segment<3>(idx));
+      if (data.residual.template segment<2>(idx+1).norm()
+            > - data.residual.coeff(idx)) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+
+void SOCFrictionCone::setSlack(Robot& robot,
+                               const ContactStatus& contact_status,
+                               ConstraintComponentData& data,
+                               const SplitSolution& s) const {
+  robot.updateFrameKinematics(s.q);
+  for (int i=0; i<max_num_contacts_; ++i) {
+    const int idx = 3*i;
+    Eigen::VectorXd& fWi = fW(data, i);
+    robot.transformFromLocalToWorld(contact_frame_[i],
+                                    s.f[i].template head<3>(), fWi);
+    frictionConeResidual(mu_[i], fWi, contact_status.contactRotation(i),
+                         data.residual.template segment<3>(idx));
+    data.slack.template segment<3>(idx)
+        = - data.residual.template segment<3>(idx);
+  }
+}
+
+
+void SOCFrictionCone::evalConstraint(Robot& robot,
+                                     const ContactStatus& contact_status,
+                                     ConstraintComponentData& data,
+                                     const SplitSolution& s) const {
+  data.residual.setZero();
+  data.cmpl.setZero();
+  data.log_barrier = 0;
+  for (int i=0; i<max_num_contacts_; ++i) {
+    if (contact_status.isContactActive(i)) {
+      const int idx = 3*i;
+      // Contact force expressed in the world frame.
+      Eigen::VectorXd& fWi = fW(data, i);
+      robot.transformFromLocalToWorld(contact_frame_[i],
+                                      s.f[i].template head<3>(), fWi);
+      frictionConeResidual(mu_[i], fWi, contact_status.contactRotation(i),
+                           data.residual.template segment<3>(idx));
+      data.residual.template segment<3>(idx).noalias()
+          += data.slack.template segment<3>(idx);
+      socpdipm::computeComplementarySlackness(barrier(), data, idx);
+      data.log_barrier
+          += socpdipm::logBarrier(barrier(), data.slack.template segment<3>(idx));
+    }
+  }
+}
+
+
+void SOCFrictionCone::evalDerivatives(Robot& robot,
+                                      const ContactStatus& contact_status,
+                                      ConstraintComponentData& data,
+                                      const SplitSolution& s,
+                                      SplitKKTResidual& kkt_residual) const {
+  int dimf_stack = 0;
+  for (int i=0; i<max_num_contacts_; ++i) {
+    if (contact_status.isContactActive(i)) {
+      const int idx = 3*i;
+      // Contact force expressed in the world frame.
+      const Eigen::VectorXd& fWi = fW(data, i);
+      // Friction cone in the local frame of the contact surface.
+      Eigen::MatrixXd& cone_local_i = cone_local(data, i);
+      cone_local_i.noalias() = cone_[i] * contact_status.contactRotation(i).transpose();
+      // Jacobian of the contact force expressed in the world frame fWi
+      // with respect to the configuration q.
+      Eigen::MatrixXd& dfWi_dq = dfW_dq(data, i);
+      robot.getJacobianTransformFromLocalToWorld(contact_frame_[i], fWi, dfWi_dq);
+      // Jacobian of the frition cone constraint with respect to the
+      // configuration, i.e., s.q.
+      Eigen::MatrixXd& dgi_dq = dg_dq(data, i);
+      dgi_dq.noalias() = cone_local_i * dfWi_dq.template topRows<3>();
+      kkt_residual.lq().noalias()
+          += dgi_dq.transpose() * data.dual.template segment<3>(idx);
+      // Jacobian of the frition cone constraint with respect to the contact
+      // force expressed in the local frame, i.e., s.f[i].
+      Eigen::MatrixXd& dgi_df = dg_df(data, i);
+      dgi_df.noalias() = cone_local_i * robot.frameRotation(contact_frame_[i]);
+      kkt_residual.lf().template segment<3>(dimf_stack).noalias()
+          += dgi_df.transpose() * data.dual.template segment<3>(idx);
+      switch (contact_types_[i]) {
+        case ContactType::PointContact:
+          dimf_stack += 3;
+          break;
+        case ContactType::SurfaceContact:
+          dimf_stack += 6;
+          break;
+        default:
+          break;
+      }
+    }
+  }
+}
+
+
+void SOCFrictionCone::condenseSlackAndDual(const ContactStatus& contact_status,
+                                           ConstraintComponentData& data,
+                                           SplitKKTMatrix& kkt_matrix,
+                                           SplitKKTResidual& kkt_residual) const {
+  data.cond.setZero();
+  int dimf_stack = 0;
+  for (int i=0; i<max_num_contacts_; ++i) {
+    if (contact_status.isContactActive(i)) {
+      const int idx = 3*i;
+      // Nesterov-Todd scaled Hessian Hi and the constant term of the dual
+      // direction dz0i.
+      Eigen::MatrixXd& Hi = H(data, i);
+      socpdipm::computeCondensingCoeffcient(barrier(), data, idx, Hi, dz0(data, i));
+      const Eigen::Vector3d& condi = data.cond.template segment<3>(idx);
+      const Eigen::MatrixXd& dgi_dq = dg_dq(data, i);
+      const Eigen::MatrixXd& dgi_df = dg_df(data, i);
+      kkt_residual.lq().noalias() += dgi_dq.transpose() * condi;
+      kkt_residual.lf().template segment<3>(dimf_stack).noalias()
+          += dgi_df.transpose() * condi;
+      Eigen::MatrixXd& dfWi_dq = dfW_dq(data, i);
+      Eigen::MatrixXd& r_dgi_df = r_dg_df(data, i);
+      dfWi_dq.template topRows<3>().noalias() = Hi * dgi_dq;
+      r_dgi_df.noalias() = Hi * dgi_df;
+      kkt_matrix.Qqq().noalias()
+          += dgi_dq.transpose() * dfWi_dq.template topRows<3>();
+      kkt_matrix.Qqf().template middleCols<3>(dimf_stack).noalias()
+          += dgi_dq.transpose() * r_dgi_df;
+      kkt_matrix.Qff().template block<3, 3>(dimf_stack, dimf_stack).noalias()
+          += dgi_df.transpose() * r_dgi_df;
+      switch (contact_types_[i]) {
+        case ContactType::PointContact:
+          dimf_stack += 3;
+          break;
+        case ContactType::SurfaceContact:
+          dimf_stack += 6;
+          break;
+        default:
+          break;
+      }
+    }
+  }
+}
+
+
+void SOCFrictionCone::expandSlackAndDual(const ContactStatus& contact_status,
+                                         ConstraintComponentData& data,
+                                         const SplitDirection& d) const {
+  // The direction (1, 0, 0) lies in the interior of the cone. Therefore,
+  // it does not affect the step size determined by the
+  // fraction-to-boundary-rule.
+  for (int i=0; i<max_num_contacts_; ++i) {
+    const int idx = 3*i;
+    data.dslack.template segment<3>(idx) << 1.0, 0.0, 0.0;
+    data.ddual.template segment<3>(idx) << 1.0, 0.0, 0.0;
+  }
+  int dimf_stack = 0;
+  for (int i=0; i<max_num_contacts_; ++i) {
+    if (contact_status.isContactActive(i)) {
+      const int idx = 3*i;
+      Eigen::MatrixXd& dgi_dq = dg_dq(data, i);
+      Eigen::MatrixXd& dgi_df = dg_df(data, i);
+      data.dslack.template segment<3>(idx).noalias()
+          = - dgi_dq * d.dq() - dgi_df * d.df().template segment<3>(dimf_stack)
+            - data.residual.template segment<3>(idx);
+      socpdipm::computeDualDirection(data, idx, H(data, i), dz0(data, i));
+      switch (contact_types_[i]) {
+        case ContactType::PointContact:
+          dimf_stack += 3;
+          break;
+        case ContactType::SurfaceContact:
+          dimf_stack += 6;
+          break;
+        default:
+          break;
+      }
+    }
+  }
+}
+
+
+int SOCFrictionCone::dimc() const {
+  return dimc_;
+}
+
+} // namespace robotoc
\ No newline at end of file
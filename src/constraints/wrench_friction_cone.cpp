@@ -243,8 +243,15 @@ void WrenchFrictionCone::condenseSlackAndDual(const ContactStatus& contact_statu
         if (contact_status.isContactActive(i)) {
           data.r[0].array() = data.dual.template segment<17>(c_begin).array() 
                                 / data.slack.template segment<17>(c_begin).array();
-          kkt_matrix.Qff().template block<6, 6>(dimf_stack, dimf_stack).noalias()
-              += cone_.transpose() * data.r[0].asDiagonal() * cone_;
+          if (kkt_matrix.isLowerTriangularHessian()) {
+            kkt_matrix.Qff().template block<6, 6>(dimf_stack, dimf_stack)
+                .template triangularView<Eigen::Lower>()
+                    += cone_.transpose() * data.r[0].asDiagonal() * cone_;
+          }
+          else {
+            kkt_matrix.Qff().template block<6, 6>(dimf_stack, dimf_stack).noalias()
+                += cone_.transpose() * data.r[0].asDiagonal() * cone_;
+          }
           computeCondensingCoeffcient<17>(data, c_begin);
           kkt_residual.lf().template segment<6>(dimf_stack).noalias()
               += cone_.transpose() * data.cond.template segment<17>(c_begin);
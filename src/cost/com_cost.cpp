@@ -117,8 +117,7 @@ double CoMCost::evalStageCost(Robot& robot, const ContactStatus& contact_status,
                               const SplitSolution& s) const {
   if (enable_cost_ && isCostActive(grid_info)) {
     evalDiff(robot, data, grid_info);
-    const double l = (weight_.array()*data.diff_3d.array()*data.diff_3d.array()).sum();
-    return 0.5 * grid_info.dt * l;
+    return 0.5 * grid_info.dt * evalCost_impl(weight_, data);
   }
   else {
     return 0.0;
@@ -133,10 +132,8 @@ void CoMCost::evalStageCostDerivatives(Robot& robot,
                                        const SplitSolution& s,
                                        SplitKKTResidual& kkt_residual) const {
   if (enable_cost_ && isCostActive(grid_info)) {
-    data.J_3d.setZero();
-    robot.getCoMJacobian(data.J_3d);
-    kkt_residual.lq().noalias() 
-        += grid_info.dt * data.J_3d.transpose() * weight_.asDiagonal() * data.diff_3d;
+    evalCostDerivatives_impl(robot, weight_, grid_info.dt, data, 
+                             kkt_residual.lq());
   }
 }
 
@@ -148,8 +145,8 @@ void CoMCost::evalStageCostHessian(Robot& robot,
                                    const SplitSolution& s, 
                                    SplitKKTMatrix& kkt_matrix) const {
   if (enable_cost_ && isCostActive(grid_info)) {
-    kkt_matrix.Qqq().noalias()
-        += grid_info.dt * data.J_3d.transpose() * weight_.asDiagonal() * data.J_3d;
+    evalCostHessian_impl(robot, weight_, grid_info.dt, data, kkt_matrix.Qqq(),
+                         kkt_matrix.isLowerTriangularHessian());
   }
 }
 
@@ -159,8 +156,7 @@ double CoMCost::evalTerminalCost(Robot& robot, CostFunctionData& data,
                                  const SplitSolution& s) const {
   if (enable_cost_terminal_ && isCostActive(grid_info)) {
     evalDiff(robot, data, grid_info);
-    const double l = (weight_terminal_.array()*data.diff_3d.array()*data.diff_3d.array()).sum();
-    return 0.5 * l;
+    return 0.5 * evalCost_impl(weight_terminal_, data);
   }
   else {
     return 0.0;
@@ -173,10 +169,8 @@ void CoMCost::evalTerminalCostDerivatives(Robot& robot, CostFunctionData& data,
                                           const SplitSolution& s, 
                                           SplitKKTResidual& kkt_residual) const {
   if (enable_cost_terminal_ && isCostActive(grid_info)) {
-    data.J_3d.setZero();
-    robot.getCoMJacobian(data.J_3d);
-    kkt_residual.lq().noalias() 
-        += data.J_3d.transpose() * weight_terminal_.asDiagonal() * data.diff_3d;
+    evalCostDerivatives_impl(robot, weight_terminal_, 1.0, data, 
+                             kkt_residual.lq());
   }
 }
 
@@ -186,10 +180,8 @@ void CoMCost::evalTerminalCostHessian(Robot& robot, CostFunctionData& data,
                                       const SplitSolution& s, 
                                       SplitKKTMatrix& kkt_matrix) const {
   if (enable_cost_terminal_ && isCostActive(grid_info)) {
-    data.J_3d.setZero();
-    robot.getCoMJacobian(data.J_3d);
-    kkt_matrix.Qqq().noalias()
-        += data.J_3d.transpose() * weight_terminal_.asDiagonal() * data.J_3d;
+    evalCostHessian_impl(robot, weight_terminal_, 1.0, data, kkt_matrix.Qqq(),
+                         kkt_matrix.isLowerTriangularHessian());
   }
 }
 
@@ -200,8 +192,7 @@ double CoMCost::evalImpulseCost(Robot& robot, const ImpulseStatus& impulse_statu
                                 const ImpulseSplitSolution& s) const {
   if (enable_cost_impulse_ && isCostActive(grid_info)) {
     evalDiff(robot, data, grid_info);
-    const double l = (weight_impulse_.array()*data.diff_3d.array()*data.diff_3d.array()).sum();
-    return 0.5 * l;
+    return 0.5 * evalCost_impl(weight_impulse_, data);
   }
   else {
     return 0.0;
@@ -214,10 +205,8 @@ void CoMCost::evalImpulseCostDerivatives(
     const GridInfo& grid_info, const ImpulseSplitSolution& s, 
     ImpulseSplitKKTResidual& kkt_residual) const {
   if (enable_cost_impulse_ && isCostActive(grid_info)) {
-    data.J_3d.setZero();
-    robot.getCoMJacobian(data.J_3d);
-    kkt_residual.lq().noalias() 
-        += data.J_3d.transpose() * weight_impulse_.asDiagonal() * data.diff_3d;
+    evalCostDerivatives_impl(robot, weight_impulse_, 1.0, data, 
+                             kkt_residual.lq());
   }
 }
 
@@ -229,8 +218,7 @@ void CoMCost::evalImpulseCostHessian(Robot& robot,
                                      const ImpulseSplitSolution& s, 
                                      ImpulseSplitKKTMatrix& kkt_matrix) const {
   if (enable_cost_impulse_ && isCostActive(grid_info)) {
-    kkt_matrix.Qqq().noalias()
-        += data.J_3d.transpose() * weight_impulse_.asDiagonal() * data.J_3d;
+    evalCostHessian_impl(robot, weight_impulse_, 1.0, data, kkt_matrix.Qqq());
   }
 }
 
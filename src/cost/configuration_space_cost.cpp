@@ -2,6 +2,7 @@
 
 #include <iostream>
 #include <stdexcept>
+#include <atomic>
 
 
 namespace robotoc {
@@ -24,6 +25,8 @@ ConfigurationSpaceCost::ConfigurationSpaceCost(const Robot& robot)
     v_weight_impulse_(Eigen::VectorXd::Zero(robot.dimv())),
     dv_weight_impulse_(Eigen::VectorXd::Zero(robot.dimv())),
     ref_(),
+    q_ref_base_(SE3(Eigen::Matrix3d::Identity(), Eigen::Vector3d::Zero())),
+    ref_id_(newRefId()),
     use_nonconst_ref_(false),
     enable_q_cost_(false), 
     enable_v_cost_(false), 
@@ -33,10 +36,16 @@ ConfigurationSpaceCost::ConfigurationSpaceCost(const Robot& robot)
     enable_v_cost_terminal_(false),
     enable_q_cost_impulse_(false), 
     enable_v_cost_impulse_(false), 
-    enable_dv_cost_impulse_(false) {
+    enable_dv_cost_impulse_(false),
+    split_base_diff_(robot.hasFloatingBase() 
+                      && (robot.dimq() == robot.dimv()+1)),
+    small_angle_approximation_(false) {
   if (robot.hasFloatingBase()) {
     robot.normalizeConfiguration(q_ref_);
   }
+  if (split_base_diff_) {
+    q_ref_base_ = baseSE3(q_ref_);
+  }
 }
 
 
@@ -65,6 +74,8 @@ ConfigurationSpaceCost::ConfigurationSpaceCost()
     v_weight_impulse_(),
     dv_weight_impulse_(),
     ref_(),
+    q_ref_base_(),
+    ref_id_(0),
     use_nonconst_ref_(false),
     enable_q_cost_(false), 
     enable_v_cost_(false), 
@@ -74,7 +85,9 @@ ConfigurationSpaceCost::ConfigurationSpaceCost()
     enable_v_cost_terminal_(false),
     enable_q_cost_impulse_(false), 
     enable_v_cost_impulse_(false), 
-    enable_dv_cost_impulse_(false) {
+    enable_dv_cost_impulse_(false),
+    split_base_diff_(false),
+    small_angle_approximation_(false) {
 }
 
 
@@ -85,6 +98,7 @@ ConfigurationSpaceCost::~ConfigurationSpaceCost() {
 void ConfigurationSpaceCost::set_ref(
     const std::shared_ptr<ConfigurationSpaceRefBase>& ref) {
   ref_ = ref;
+  ref_id_ = newRefId();
   use_nonconst_ref_ = true;
 }
 
@@ -101,6 +115,9 @@ void ConfigurationSpaceCost::set_q_ref(const Eigen::VectorXd& q_ref) {
     std::exit(EXIT_FAILURE);
   }
   q_ref_ = q_ref;
+  if (split_base_diff_) {
+    q_ref_base_ = baseSE3(q_ref_);
+  }
   use_nonconst_ref_ = false;
 }
 
@@ -320,6 +337,111 @@ void ConfigurationSpaceCost::set_dv_weight_impulse(
 }
 
 
+void ConfigurationSpaceCost::set_small_angle_approximation(
+    const bool small_angle_approximation) {
+  small_angle_approximation_ = small_angle_approximation;
+}
+
+
+void ConfigurationSpaceCost::evalConfigDiff(const Robot& robot, 
+                                            CostFunctionData& data, 
+                                            const GridInfo& grid_info, 
+                                            const Eigen::VectorXd& q) const {
+  if (use_nonconst_ref_) {
+    if (ref_->isActive(grid_info)) {
+      updateRefCache(robot, data, grid_info);
+      computeConfigDiff(robot, data, q, data.q_ref, data.q_ref_base);
+    }
+  }
+  else {
+    computeConfigDiff(robot, data, q, q_ref_, q_ref_base_);
+  }
+}
+
+
+void ConfigurationSpaceCost::evalConfigDiffJac(const Robot& robot, 
+                                               CostFunctionData& data, 
+                                               const GridInfo& grid_info, 
+                                               const Eigen::VectorXd& q) const {
+  if (use_nonconst_ref_) {
+    if (ref_->isActive(grid_info)) {
+      computeConfigDiffJac(robot, data, q, data.q_ref);
+    }
+  }
+  else {
+    computeConfigDiffJac(robot, data, q, q_ref_);
+  }
+}
+
+
+void ConfigurationSpaceCost::updateRefCache(const Robot& robot, 
+                                            CostFunctionData& data, 
+                                            const GridInfo& grid_info) const {
+  const unsigned long version = ref_->version();
+  if (version == 0 || data.q_ref_id != ref_id_ 
+      || data.q_ref_version != version || data.q_ref_time != grid_info.t 
+      || data.q_ref_phase != grid_info.contact_phase) {
+    ref_->updateRef(robot, grid_info, data.q_ref);
+    if (split_base_diff_) {
+      data.q_ref_base = baseSE3(data.q_ref);
+    }
+    data.q_ref_time = grid_info.t;
+    data.q_ref_phase = grid_info.contact_phase;
+    data.q_ref_id = ref_id_;
+    data.q_ref_version = version;
+  }
+}
+
+
+void ConfigurationSpaceCost::computeConfigDiff(
+    const Robot& robot, CostFunctionData& data, const Eigen::VectorXd& q, 
+    const Eigen::VectorXd& q_ref, const SE3& q_ref_base) const {
+  if (!split_base_diff_) {
+    robot.subtractConfiguration(q, q_ref, data.qdiff);
+    return;
+  }
+  // The floating base is on SE3 and the other joints are on the vector space.
+  // The relative SE3 of the base is kept in data for the Jacobian.
+  data.qdiff_base = q_ref_base.actInv(baseSE3(q));
+  if (small_angle_approximation_) {
+    const Eigen::Matrix3d& R = data.qdiff_base.rotation();
+    data.qdiff.template head<3>() = data.qdiff_base.translation();
+    data.qdiff.coeffRef(3) = 0.5 * (R.coeff(2, 1) - R.coeff(1, 2));
+    data.qdiff.coeffRef(4) = 0.5 * (R.coeff(0, 2) - R.coeff(2, 0));
+    data.qdiff.coeffRef(5) = 0.5 * (R.coeff(1, 0) - R.coeff(0, 1));
+  }
+  else {
+    data.qdiff.template head<6>() = Log6Map(data.qdiff_base);
+  }
+  data.qdiff.tail(dimv_-6) = q.tail(dimq_-7) - q_ref.tail(dimq_-7);
+}
+
+
+void ConfigurationSpaceCost::computeConfigDiffJac(
+    const Robot& robot, CostFunctionData& data, const Eigen::VectorXd& q, 
+    const Eigen::VectorXd& q_ref) const {
+  if (!split_base_diff_) {
+    robot.dSubtractConfiguration_dqf(q, q_ref, data.J_qdiff);
+    return;
+  }
+  if (small_angle_approximation_) {
+    data.J_qdiff.template topLeftCorner<6, 6>().setIdentity();
+  }
+  else {
+    computeJLog6Map(data.qdiff_base, data.J_qdiff.template topLeftCorner<6, 6>());
+  }
+  data.J_qdiff.topRightCorner(6, dimv_-6).setZero();
+  data.J_qdiff.bottomLeftCorner(dimv_-6, 6).setZero();
+  data.J_qdiff.bottomRightCorner(dimv_-6, dimv_-6).setIdentity();
+}
+
+
+unsigned long ConfigurationSpaceCost::newRefId() {
+  static std::atomic<unsigned long> ref_id(0);
+  return ++ref_id;
+}
+
+
 bool ConfigurationSpaceCost::useKinematics() const {
   return false;
 }
@@ -382,8 +504,14 @@ void ConfigurationSpaceCost::evalStageCostHessian(
     SplitKKTMatrix& kkt_matrix) const {
   if (enable_q_cost_ && isCostConfigActive(grid_info)) {
     if (robot.hasFloatingBase()) {
-      kkt_matrix.Qqq().noalias()
-          += grid_info.dt * data.J_qdiff.transpose() * q_weight_.asDiagonal() * data.J_qdiff;
+      if (kkt_matrix.isLowerTriangularHessian()) {
+        kkt_matrix.Qqq().triangularView<Eigen::Lower>()
+            += grid_info.dt * data.J_qdiff.transpose() * q_weight_.asDiagonal() * data.J_qdiff;
+      }
+      else {
+        kkt_matrix.Qqq().noalias()
+            += grid_info.dt * data.J_qdiff.transpose() * q_weight_.asDiagonal() * data.J_qdiff;
+      }
     }
     else {
       kkt_matrix.Qqq().diagonal().noalias() += grid_info.dt * q_weight_;
@@ -442,8 +570,14 @@ void ConfigurationSpaceCost::evalTerminalCostHessian(
     const SplitSolution& s, SplitKKTMatrix& kkt_matrix) const {
   if (enable_q_cost_terminal_ && isCostConfigActive(grid_info)) {
     if (robot.hasFloatingBase()) {
-      kkt_matrix.Qqq().noalias()
-          += data.J_qdiff.transpose() * q_weight_terminal_.asDiagonal() * data.J_qdiff;
+      if (kkt_matrix.isLowerTriangularHessian()) {
+        kkt_matrix.Qqq().triangularView<Eigen::Lower>()
+            += data.J_qdiff.transpose() * q_weight_terminal_.asDiagonal() * data.J_qdiff;
+      }
+      else {
+        kkt_matrix.Qqq().noalias()
+            += data.J_qdiff.transpose() * q_weight_terminal_.asDiagonal() * data.J_qdiff;
+      }
     }
     else {
       kkt_matrix.Qqq().diagonal().noalias() += q_weight_terminal_;
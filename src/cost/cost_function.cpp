@@ -3,6 +3,7 @@
 #include <cassert>
 #include <stdexcept>
 #include <iostream>
+#include <atomic>
 
 
 namespace robotoc {
@@ -10,9 +11,13 @@ namespace robotoc {
 CostFunction::CostFunction(const double discount_factor, 
                            const double discount_time_step)
   : costs_(),
+    weight_times_(),
+    weight_values_(),
     discount_factor_(discount_factor),
     discount_time_step_(discount_time_step),
-    discounted_cost_(true) {
+    weight_id_(newWeightId()),
+    discounted_cost_(true),
+    time_varying_weight_(false) {
   try {
     if (discount_factor <= 0.0) {
       throw std::out_of_range("invalid argument: discount_factor must be positive!");
@@ -33,9 +38,13 @@ CostFunction::CostFunction(const double discount_factor,
 
 CostFunction::CostFunction()
   : costs_(),
+    weight_times_(),
+    weight_values_(),
     discount_factor_(1.0),
     discount_time_step_(0.0),
-    discounted_cost_(false) {
+    weight_id_(newWeightId()),
+    discounted_cost_(false),
+    time_varying_weight_(false) {
 }
 
 
@@ -55,6 +64,7 @@ void CostFunction::setDiscountFactor(const double discount_factor,
     discount_time_step_ = 0.0;
     discounted_cost_ = false;
   }
+  weight_id_ = newWeightId();
 }
 
 
@@ -78,6 +88,59 @@ double CostFunction::discountTimeStep() const {
 }
 
 
+void CostFunction::setTimeVaryingWeight(const std::vector<double>& elapsed_times, 
+                                        const std::vector<double>& weights) {
+  try {
+    if (elapsed_times.empty()) {
+      throw std::out_of_range("invalid argument: elapsed_times must not be empty!");
+    }
+    if (elapsed_times.size() != weights.size()) {
+      throw std::out_of_range(
+          "invalid argument: elapsed_times.size() must be the same as weights.size()!");
+    }
+    for (std::size_t i=1; i<elapsed_times.size(); ++i) {
+      if (elapsed_times[i] <= elapsed_times[i-1]) {
+        throw std::out_of_range(
+            "invalid argument: elapsed_times must be strictly increasing!");
+      }
+    }
+    for (const auto e : weights) {
+      if (e < 0.0) {
+        throw std::out_of_range("invalid argument: weights must be non-negative!");
+      }
+    }
+  }
+  catch(const std::exception& e) {
+    std::cerr << e.what() << '\n';
+    std::exit(EXIT_FAILURE);
+  }
+  weight_times_ = elapsed_times;
+  weight_values_ = weights;
+  time_varying_weight_ = true;
+  weight_id_ = newWeightId();
+}
+
+
+void CostFunction::clearTimeVaryingWeight() {
+  weight_times_.clear();
+  weight_values_.clear();
+  time_varying_weight_ = false;
+  weight_id_ = newWeightId();
+}
+
+
+double CostFunction::weight(const double t0, const double t) const {
+  double w = 1.0;
+  if (discounted_cost_) {
+    w *= discount(t0, t);
+  }
+  if (time_varying_weight_) {
+    w *= timeVaryingWeight(t-t0);
+  }
+  return w;
+}
+
+
 void CostFunction::push_back(const CostFunctionComponentBasePtr& cost) {
   costs_.push_back(cost);
 }
@@ -114,8 +177,8 @@ double CostFunction::evalStageCost(Robot& robot,
   for (const auto e : costs_) {
     l += e->evalStageCost(robot, contact_status, data, grid_info, s);
   }
-  if (discounted_cost_) {
-    const double f = std::pow(discount_factor_, grid_info.time_stage);
+  if (isWeighted()) {
+    const double f = stageWeight(data, grid_info);
     l *= f;
   }
   return l;
@@ -135,8 +198,8 @@ double CostFunction::linearizeStageCost(Robot& robot,
     e->evalStageCostDerivatives(robot, contact_status, data, grid_info, s,
                                 kkt_residual);
   }
-  if (discounted_cost_) {
-    const double f = discount(grid_info.t0, grid_info.t);
+  if (isWeighted()) {
+    const double f = stageWeight(data, grid_info);
     l *= f;
     kkt_residual.lx.array() *= f;
     kkt_residual.lu.array() *= f;
@@ -165,8 +228,8 @@ double CostFunction::quadratizeStageCost(Robot& robot,
     e->evalStageCostHessian(robot, contact_status, data, grid_info, s,
                             kkt_matrix);
   }
-  if (discounted_cost_) {
-    const double f = discount(grid_info.t0, grid_info.t);
+  if (isWeighted()) {
+    const double f = stageWeight(data, grid_info);
     l *= f;
     kkt_residual.lx.array() *= f;
     kkt_residual.lu.array() *= f;
@@ -192,8 +255,8 @@ double CostFunction::evalTerminalCost(Robot& robot, CostFunctionData& data,
   for (const auto e : costs_) {
     l += e->evalTerminalCost(robot, data, grid_info, s);
   }
-  if (discounted_cost_) {
-    const double f = discount(grid_info.t0, grid_info.t);
+  if (isWeighted()) {
+    const double f = stageWeight(data, grid_info);
     l *= f;
   }
   return l;
@@ -209,8 +272,8 @@ double CostFunction::linearizeTerminalCost(Robot& robot, CostFunctionData& data,
     l += e->evalTerminalCost(robot, data, grid_info, s);
     e->evalTerminalCostDerivatives(robot, data, grid_info, s, kkt_residual);
   }
-  if (discounted_cost_) {
-    const double f = discount(grid_info.t0, grid_info.t);
+  if (isWeighted()) {
+    const double f = stageWeight(data, grid_info);
     l *= f;
     kkt_residual.lx.array() *= f;
   }
@@ -230,8 +293,8 @@ double CostFunction::quadratizeTerminalCost(Robot& robot,
     e->evalTerminalCostDerivatives(robot, data, grid_info, s, kkt_residual);
     e->evalTerminalCostHessian(robot, data, grid_info, s, kkt_matrix);
   }
-  if (discounted_cost_) {
-    const double f = discount(grid_info.t0, grid_info.t);
+  if (isWeighted()) {
+    const double f = stageWeight(data, grid_info);
     l *= f;
     kkt_residual.lx.array() *= f;
     kkt_matrix.Qxx.array() *= f;
@@ -249,8 +312,8 @@ double CostFunction::evalImpulseCost(Robot& robot,
   for (const auto e : costs_) {
     l += e->evalImpulseCost(robot, impulse_status, data, grid_info, s);
   }
-  if (discounted_cost_) {
-    const double f = discount(grid_info.t0, grid_info.t);
+  if (isWeighted()) {
+    const double f = stageWeight(data, grid_info);
     l *= f;
   }
   return l;
@@ -269,8 +332,8 @@ double CostFunction::linearizeImpulseCost(Robot& robot,
     e->evalImpulseCostDerivatives(robot, impulse_status, data, grid_info, s, 
                                   kkt_residual);
   }
-  if (discounted_cost_) {
-    const double f = discount(grid_info.t0, grid_info.t);
+  if (isWeighted()) {
+    const double f = stageWeight(data, grid_info);
     l *= f;
     kkt_residual.lx.array() *= f;
     kkt_residual.ldv.array() *= f;
@@ -297,8 +360,8 @@ double CostFunction::quadratizeImpulseCost(Robot& robot,
     e->evalImpulseCostHessian(robot, impulse_status, data, grid_info, s, 
                               kkt_matrix);
   }
-  if (discounted_cost_) {
-    const double f = discount(grid_info.t0, grid_info.t);
+  if (isWeighted()) {
+    const double f = stageWeight(data, grid_info);
     l *= f;
     kkt_residual.lx.array() *= f;
     kkt_residual.ldv.array() *= f;
@@ -313,4 +376,28 @@ double CostFunction::quadratizeImpulseCost(Robot& robot,
   return l;
 }
 
+
+double CostFunction::timeVaryingWeight(const double elapsed_time) const {
+  assert(!weight_times_.empty());
+  if (elapsed_time <= weight_times_.front()) {
+    return weight_values_.front();
+  }
+  if (elapsed_time >= weight_times_.back()) {
+    return weight_values_.back();
+  }
+  int i = 1;
+  while (weight_times_[i] < elapsed_time) {
+    ++i;
+  }
+  const double ratio = (elapsed_time-weight_times_[i-1]) 
+                        / (weight_times_[i]-weight_times_[i-1]);
+  return (1.0-ratio) * weight_values_[i-1] + ratio * weight_values_[i];
+}
+
+
+unsigned long CostFunction::newWeightId() {
+  static std::atomic<unsigned long> weight_id(0);
+  return ++weight_id;
+}
+
 } // namespace robotoc
\ No newline at end of file
@@ -14,7 +14,24 @@ LocalContactForceCost::LocalContactForceCost(const Robot& robot)
     f_ref_(robot.maxNumContacts(), Eigen::Vector3d::Zero()),
     f_weight_(robot.maxNumContacts(), Eigen::Vector3d::Zero()),
     fi_ref_(robot.maxNumContacts(), Eigen::Vector3d::Zero()),
-    fi_weight_(robot.maxNumContacts(), Eigen::Vector3d::Zero()) {
+    fi_weight_(robot.maxNumContacts(), Eigen::Vector3d::Zero()),
+    f_ref_stack_(),
+    f_weight_stack_(),
+    fi_ref_stack_(),
+    fi_weight_stack_() {
+  try {
+    if (robot.maxNumContacts() > kMaxNumContacts) {
+      throw std::out_of_range(
+          "invalid argument: robot.maxNumContacts() must not be larger than " 
+          + std::to_string(kMaxNumContacts) + "!");
+    }
+  }
+  catch(const std::exception& e) {
+    std::cerr << e.what() << '\n';
+    std::exit(EXIT_FAILURE);
+  }
+  setStack(f_ref_, f_weight_, f_ref_stack_, f_weight_stack_);
+  setStack(fi_ref_, fi_weight_, fi_ref_stack_, fi_weight_stack_);
 }
 
 
@@ -26,7 +43,13 @@ LocalContactForceCost::LocalContactForceCost()
     f_ref_(),
     f_weight_(),
     fi_ref_(),
-    fi_weight_() {
+    fi_weight_(),
+    f_ref_stack_(),
+    f_weight_stack_(),
+    fi_ref_stack_(),
+    fi_weight_stack_() {
+  setStack(f_ref_, f_weight_, f_ref_stack_, f_weight_stack_);
+  setStack(fi_ref_, fi_weight_, fi_ref_stack_, fi_weight_stack_);
 }
 
 
@@ -48,6 +71,7 @@ void LocalContactForceCost::set_f_ref(
     std::exit(EXIT_FAILURE);
   }
   f_ref_ = f_ref;
+  setStack(f_ref_, f_weight_, f_ref_stack_, f_weight_stack_);
 }
 
 
@@ -65,6 +89,7 @@ void LocalContactForceCost::set_f_weight(
     std::exit(EXIT_FAILURE);
   }
   f_weight_ = f_weight;
+  setStack(f_ref_, f_weight_, f_ref_stack_, f_weight_stack_);
 }
 
 
@@ -82,6 +107,7 @@ void LocalContactForceCost::set_fi_ref(
     std::exit(EXIT_FAILURE);
   }
   fi_ref_ = fi_ref;
+  setStack(fi_ref_, fi_weight_, fi_ref_stack_, fi_weight_stack_);
 }
 
 
@@ -99,6 +125,37 @@ void LocalContactForceCost::set_fi_weight(
     std::exit(EXIT_FAILURE);
   }
   fi_weight_ = fi_weight;
+  setStack(fi_ref_, fi_weight_, fi_ref_stack_, fi_weight_stack_);
+}
+
+
+void LocalContactForceCost::setStack(
+    const std::vector<Eigen::Vector3d>& ref, 
+    const std::vector<Eigen::Vector3d>& weight, 
+    std::vector<Eigen::VectorXd>& ref_stack, 
+    std::vector<Eigen::VectorXd>& weight_stack) const {
+  const int num_combinations = (1 << max_num_contacts_);
+  ref_stack.resize(num_combinations);
+  weight_stack.resize(num_combinations);
+  for (int index=0; index<num_combinations; ++index) {
+    int dimf = 0;
+    for (int i=0; i<max_num_contacts_; ++i) {
+      if (index & (1 << i)) {
+        dimf += (contact_types_[i] == ContactType::SurfaceContact) ? 6 : 3;
+      }
+    }
+    // The moments of the surface contacts are not penalized.
+    ref_stack[index].setZero(dimf);
+    weight_stack[index].setZero(dimf);
+    int dimf_stack = 0;
+    for (int i=0; i<max_num_contacts_; ++i) {
+      if (index & (1 << i)) {
+        ref_stack[index].template segment<3>(dimf_stack) = ref[i];
+        weight_stack[index].template segment<3>(dimf_stack) = weight[i];
+        dimf_stack += (contact_types_[i] == ContactType::SurfaceContact) ? 6 : 3;
+      }
+    }
+  }
 }
 
 
@@ -112,14 +169,9 @@ double LocalContactForceCost::evalStageCost(Robot& robot,
                                             CostFunctionData& data, 
                                             const GridInfo& grid_info,
                                             const SplitSolution& s) const {
-  double l = 0;
-  for (int i=0; i<max_num_contacts_; ++i) {
-    if (contact_status.isContactActive(i)) {
-      const auto& fl = s.f[i].template head<3>();
-      l += (f_weight_[i].array() * (fl.array()-f_ref_[i].array()) 
-                                 * (fl.array()-f_ref_[i].array())).sum();
-    }
-  }
+  const int index = activeContactsIndex(contact_status.isContactActive());
+  const double l = evalCost_impl(f_ref_stack_[index], f_weight_stack_[index], 
+                                 s.f_stack());
   return 0.5 * grid_info.dt * l;
 }
 
@@ -128,24 +180,9 @@ void LocalContactForceCost::evalStageCostDerivatives(
     Robot& robot, const ContactStatus& contact_status, CostFunctionData& data, 
     const GridInfo& grid_info, const SplitSolution& s, 
     SplitKKTResidual& kkt_residual) const {
-  int dimf_stack = 0;
-  for (int i=0; i<max_num_contacts_; ++i) {
-    if (contact_status.isContactActive(i)) {
-      const auto& fl = s.f[i].template head<3>();
-      kkt_residual.lf().template segment<3>(dimf_stack).array()
-          += grid_info.dt * f_weight_[i].array() * (fl.array()-f_ref_[i].array());
-      switch (contact_types_[i]) {
-        case ContactType::PointContact:
-          dimf_stack += 3;
-          break;
-        case ContactType::SurfaceContact:
-          dimf_stack += 6;
-          break;
-        default:
-          break;
-      }
-    }
-  }
+  const int index = activeContactsIndex(contact_status.isContactActive());
+  evalCostDerivatives_impl(f_ref_stack_[index], f_weight_stack_[index], 
+                           grid_info.dt, s.f_stack(), kkt_residual.lf());
 }
 
 
@@ -153,23 +190,8 @@ void LocalContactForceCost::evalStageCostHessian(
     Robot& robot, const ContactStatus& contact_status, CostFunctionData& data, 
     const GridInfo& grid_info, const SplitSolution& s, 
     SplitKKTMatrix& kkt_matrix) const {
-  int dimf_stack = 0;
-  for (int i=0; i<max_num_contacts_; ++i) {
-    if (contact_status.isContactActive(i)) {
-      kkt_matrix.Qff().diagonal().template segment<3>(dimf_stack).noalias() 
-          += grid_info.dt * f_weight_[i];
-      switch (contact_types_[i]) {
-        case ContactType::PointContact:
-          dimf_stack += 3;
-          break;
-        case ContactType::SurfaceContact:
-          dimf_stack += 6;
-          break;
-        default:
-          break;
-      }
-    }
-  }
+  const int index = activeContactsIndex(contact_status.isContactActive());
+  evalCostHessian_impl(f_weight_stack_[index], grid_info.dt, kkt_matrix.Qff());
 }
 
 
@@ -198,14 +220,9 @@ void LocalContactForceCost::evalTerminalCostHessian(
 double LocalContactForceCost::evalImpulseCost(
     Robot& robot, const ImpulseStatus& impulse_status, CostFunctionData& data, 
     const GridInfo& grid_info, const ImpulseSplitSolution& s) const {
-  double l = 0;
-  for (int i=0; i<max_num_contacts_; ++i) {
-    if (impulse_status.isImpulseActive(i)) {
-      const auto& fl = s.f[i].template head<3>();
-      l += (fi_weight_[i].array() * (fl.array()-fi_ref_[i].array()) 
-                                  * (fl.array()-fi_ref_[i].array())).sum();
-    }
-  }
+  const int index = activeContactsIndex(impulse_status.isImpulseActive());
+  const double l = evalCost_impl(fi_ref_stack_[index], fi_weight_stack_[index], 
+                                 s.f_stack());
   return 0.5 * l;
 }
 
@@ -214,24 +231,9 @@ void LocalContactForceCost::evalImpulseCostDerivatives(
     Robot& robot, const ImpulseStatus& impulse_status, CostFunctionData& data, 
     const GridInfo& grid_info, const ImpulseSplitSolution& s, 
     ImpulseSplitKKTResidual& kkt_residual) const {
-  int dimf_stack = 0;
-  for (int i=0; i<max_num_contacts_; ++i) {
-    if (impulse_status.isImpulseActive(i)) {
-      const auto& fl = s.f[i].template head<3>();
-      kkt_residual.lf().template segment<3>(dimf_stack).array()
-          += fi_weight_[i].array() * (fl.array()-fi_ref_[i].array());
-      switch (contact_types_[i]) {
-        case ContactType::PointContact:
-          dimf_stack += 3;
-          break;
-        case ContactType::SurfaceContact:
-          dimf_stack += 6;
-          break;
-        default:
-          break;
-      }
-    }
-  }
+  const int index = activeContactsIndex(impulse_status.isImpulseActive());
+  evalCostDerivatives_impl(fi_ref_stack_[index], fi_weight_stack_[index], 
+                           1.0, s.f_stack(), kkt_residual.lf());
 }
 
 
@@ -239,23 +241,8 @@ void LocalContactForceCost::evalImpulseCostHessian(
     Robot& robot, const ImpulseStatus& impulse_status, CostFunctionData& data, 
     const GridInfo& grid_info, const ImpulseSplitSolution& s, 
     ImpulseSplitKKTMatrix& kkt_matrix) const {
-  int dimf_stack = 0;
-  for (int i=0; i<max_num_contacts_; ++i) {
-    if (impulse_status.isImpulseActive(i)) {
-      kkt_matrix.Qff().diagonal().template segment<3>(dimf_stack).noalias() 
-          += fi_weight_[i];
-      switch (contact_types_[i]) {
-        case ContactType::PointContact:
-          dimf_stack += 3;
-          break;
-        case ContactType::SurfaceContact:
-          dimf_stack += 6;
-          break;
-        default:
-          break;
-      }
-    }
-  }
+  const int index = activeContactsIndex(impulse_status.isImpulseActive());
+  evalCostHessian_impl(fi_weight_stack_[index], 1.0, kkt_matrix.Qff());
 }
 
 } // namespace robotoc
\ No newline at end of file
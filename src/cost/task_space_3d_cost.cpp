@@ -176,8 +176,14 @@ void TaskSpace3DCost::evalStageCostHessian(Robot& robot,
                                            const SplitSolution& s, 
                                            SplitKKTMatrix& kkt_matrix) const {
   if (enable_cost_ && isCostActive(grid_info)) {
-    kkt_matrix.Qqq().noalias()
-        += grid_info.dt * data.J_3d.transpose() * weight_.asDiagonal() * data.J_3d;
+    if (kkt_matrix.isLowerTriangularHessian()) {
+      kkt_matrix.Qqq().triangularView<Eigen::Lower>()
+          += grid_info.dt * data.J_3d.transpose() * weight_.asDiagonal() * data.J_3d;
+    }
+    else {
+      kkt_matrix.Qqq().noalias()
+          += grid_info.dt * data.J_3d.transpose() * weight_.asDiagonal() * data.J_3d;
+    }
   }
 }
 
@@ -214,8 +220,14 @@ void TaskSpace3DCost::evalTerminalCostHessian(
     Robot& robot, CostFunctionData& data, const GridInfo& grid_info, 
     const SplitSolution& s, SplitKKTMatrix& kkt_matrix) const {
   if (enable_cost_terminal_ && isCostActive(grid_info)) {
-    kkt_matrix.Qqq().noalias()
-        += data.J_3d.transpose() * weight_terminal_.asDiagonal() * data.J_3d;
+    if (kkt_matrix.isLowerTriangularHessian()) {
+      kkt_matrix.Qqq().triangularView<Eigen::Lower>()
+          += data.J_3d.transpose() * weight_terminal_.asDiagonal() * data.J_3d;
+    }
+    else {
+      kkt_matrix.Qqq().noalias()
+          += data.J_3d.transpose() * weight_terminal_.asDiagonal() * data.J_3d;
+    }
   }
 }
 
@@ -223,8 +223,14 @@ void TaskSpace6DCost::evalStageCostHessian(Robot& robot,
                                            const SplitSolution& s, 
                                            SplitKKTMatrix& kkt_matrix) const {
   if (enable_cost_ && isCostActive(grid_info)) {
-    kkt_matrix.Qqq().noalias()
-        += grid_info.dt * data.JJ_6d.transpose() * weight_.asDiagonal() * data.JJ_6d;
+    if (kkt_matrix.isLowerTriangularHessian()) {
+      kkt_matrix.Qqq().triangularView<Eigen::Lower>()
+          += grid_info.dt * data.JJ_6d.transpose() * weight_.asDiagonal() * data.JJ_6d;
+    }
+    else {
+      kkt_matrix.Qqq().noalias()
+          += grid_info.dt * data.JJ_6d.transpose() * weight_.asDiagonal() * data.JJ_6d;
+    }
   }
 }
 
@@ -262,8 +268,14 @@ void TaskSpace6DCost::evalTerminalCostHessian(
     Robot& robot, CostFunctionData& data, const GridInfo& grid_info, 
     const SplitSolution& s, SplitKKTMatrix& kkt_matrix) const {
   if (enable_cost_terminal_ && isCostActive(grid_info)) {
-    kkt_matrix.Qqq().noalias()
-        += data.JJ_6d.transpose() * weight_terminal_.asDiagonal() * data.JJ_6d;
+    if (kkt_matrix.isLowerTriangularHessian()) {
+      kkt_matrix.Qqq().triangularView<Eigen::Lower>()
+          += data.JJ_6d.transpose() * weight_terminal_.asDiagonal() * data.JJ_6d;
+    }
+    else {
+      kkt_matrix.Qqq().noalias()
+          += data.JJ_6d.transpose() * weight_terminal_.asDiagonal() * data.JJ_6d;
+    }
   }
 }
 
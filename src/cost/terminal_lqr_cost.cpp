@@ -0,0 +1,418 @@
+#include "robotoc/cost/terminal_lqr_cost.hpp"
+#include "robotoc/ocp/split_ocp.hpp"
+#include "robotoc/riccati/riccati_factorizer.hpp"
+#include "robotoc/riccati/split_riccati_factorization.hpp"
+#include "robotoc/riccati/lqr_policy.hpp"
+#include "robotoc/hybrid/grid_info.hpp"
+
+#include <cmath>
+#include <chrono>
+#include <stdexcept>
+#include <iostream>
+
+
+namespace robotoc {
+
+TerminalLQRCost::TerminalLQRCost(const Robot& robot)
+  : CostFunctionComponentBase(),
+    dimq_(robot.dimq()),
+    dimv_(robot.dimv()),
+    max_iter_(10000),
+    num_iterations_(0),
+    tol_(1.0e-08),
+    refresh_tol_(0.0),
+    P_(Eigen::MatrixXd::Zero(2*robot.dimv(), 2*robot.dimv())),
+    q_ref_(Eigen::VectorXd::Zero(robot.dimq())),
+    v_ref_(Eigen::VectorXd::Zero(robot.dimv())),
+    robot_op_(1, robot),
+    s_op_(robot),
+    kkt_matrix_op_(robot),
+    kkt_residual_op_(robot),
+    future_() {
+  if (robot.hasFloatingBase()) {
+    robot.normalizeConfiguration(q_ref_);
+  }
+}
+
+
+TerminalLQRCost::TerminalLQRCost()
+  : CostFunctionComponentBase(),
+    dimq_(0),
+    dimv_(0),
+    max_iter_(10000),
+    num_iterations_(0),
+    tol_(1.0e-08),
+    refresh_tol_(0.0),
+    P_(),
+    q_ref_(),
+    v_ref_(),
+    robot_op_(),
+    s_op_(),
+    kkt_matrix_op_(),
+    kkt_residual_op_(),
+    future_() {
+}
+
+
+TerminalLQRCost::~TerminalLQRCost() {
+  if (future_.valid()) {
+    future_.wait();
+  }
+}
+
+
+void TerminalLQRCost::setRiccatiIterationOptions(const int max_iter,
+                                                 const double tol) {
+  try {
+    if (max_iter <= 0) {
+      throw std::out_of_range("invalid argument: max_iter must be positive!");
+    }
+    if (tol <= 0) {
+      throw std::out_of_range("invalid argument: tol must be positive!");
+    }
+  }
+  catch(const std::exception& e) {
+    std::cerr << e.what() << '\n';
+    std::exit(EXIT_FAILURE);
+  }
+  max_iter_ = max_iter;
+  tol_ = tol;
+}
+
+
+void TerminalLQRCost::setRefreshTolerance(const double refresh_tol) {
+  try {
+    if (refresh_tol < 0) {
+      throw std::out_of_range("invalid argument: refresh_tol must be non-negative!");
+    }
+  }
+  catch(const std::exception& e) {
+    std::cerr << e.what() << '\n';
+    std::exit(EXIT_FAILURE);
+  }
+  refresh_tol_ = refresh_tol;
+}
+
+
+void TerminalLQRCost::setCostToGo(const Eigen::MatrixXd& P,
+                                  const Eigen::VectorXd& q_ref,
+                                  const Eigen::VectorXd& v_ref) {
+  try {
+    if (P.rows() != 2*dimv_ || P.cols() != 2*dimv_) {
+      throw std::out_of_range(
+          "invalid argument: P must be " + std::to_string(2*dimv_) + "x"
+          + std::to_string(2*dimv_) + "!");
+    }
+    if (q_ref.size() != dimq_) {
+      throw std::out_of_range(
+          "invalid argument: q_ref.size() must be " + std::to_string(dimq_) + "!");
+    }
+    if (v_ref.size() != dimv_) {
+      throw std::out_of_range(
+          "invalid argument: v_ref.size() must be " + std::to_string(dimv_) + "!");
+    }
+  }
+  catch(const std::exception& e) {
+    std::cerr << e.what() << '\n';
+    std::exit(EXIT_FAILURE);
+  }
+  P_ = P;
+  q_ref_ = q_ref;
+  v_ref_ = v_ref;
+}
+
+
+bool TerminalLQRCost::computeCostToGo(
+    const Robot& robot, const std::shared_ptr<CostFunction>& cost,
+    const std::shared_ptr<Constraints>& constraints,
+    const ContactStatus& contact_status, const double dt,
+    const SplitSolution& s) {
+  try {
+    if (dt <= 0) {
+      throw std::out_of_range("invalid argument: dt must be positive!");
+    }
+  }
+  catch(const std::exception& e) {
+    std::cerr << e.what() << '\n';
+    std::exit(EXIT_FAILURE);
+  }
+  synchronize(true);
+  Robot robot_tmp = robot;
+  SplitKKTMatrix kkt_matrix(robot);
+  SplitKKTResidual kkt_residual(robot);
+  linearizeKKTSystem(robot_tmp, cost, constraints, contact_status, dt, s, 
+                     kkt_matrix, kkt_residual);
+  const auto cost_to_go = solveRiccatiFixedPoint(robot_tmp, kkt_matrix, 
+                                                 kkt_residual, s, max_iter_, 
+                                                 tol_);
+  applyCostToGo(cost_to_go);
+  return cost_to_go.converged;
+}
+
+
+bool TerminalLQRCost::requestCostToGoUpdate(
+    const Robot& robot, const std::shared_ptr<CostFunction>& cost,
+    const std::shared_ptr<Constraints>& constraints,
+    const ContactStatus& contact_status, const double dt,
+    const SplitSolution& s) {
+  try {
+    if (dt <= 0) {
+      throw std::out_of_range("invalid argument: dt must be positive!");
+    }
+  }
+  catch(const std::exception& e) {
+    std::cerr << e.what() << '\n';
+    std::exit(EXIT_FAILURE);
+  }
+  if (isUpdating()) {
+    return false;
+  }
+  // The finished but not yet applied result is applied here instead of being
+  // discarded by the new update.
+  synchronize();
+  if (num_iterations_ > 0 && operatingPointDistance(robot, s) <= refresh_tol_) {
+    return false;
+  }
+  // The cost and constraints are evaluated only here, on the calling thread.
+  // The update in the background works on the snapshot of the linearization,
+  // which is not accessed by this thread until the update finishes.
+  robot_op_[0] = robot;
+  s_op_ = s;
+  linearizeKKTSystem(robot_op_[0], cost, constraints, contact_status, dt, s_op_,
+                     kkt_matrix_op_, kkt_residual_op_);
+  const int max_iter = max_iter_;
+  const double tol = tol_;
+  future_ = std::async(std::launch::async, [this, max_iter, tol]() {
+    return solveRiccatiFixedPoint(robot_op_[0], kkt_matrix_op_, 
+                                  kkt_residual_op_, s_op_, max_iter, tol);
+  });
+  return true;
+}
+
+
+bool TerminalLQRCost::synchronize(const bool wait) {
+  if (!future_.valid()) {
+    return false;
+  }
+  if (!wait && (future_.wait_for(std::chrono::seconds(0))
+                  != std::future_status::ready)) {
+    return false;
+  }
+  applyCostToGo(future_.get());
+  return true;
+}
+
+
+bool TerminalLQRCost::isUpdating() const {
+  return (future_.valid() && (future_.wait_for(std::chrono::seconds(0))
+                                != std::future_status::ready));
+}
+
+
+const Eigen::MatrixXd& TerminalLQRCost::costToGoHessian() const {
+  return P_;
+}
+
+
+const Eigen::VectorXd& TerminalLQRCost::q_ref() const {
+  return q_ref_;
+}
+
+
+const Eigen::VectorXd& TerminalLQRCost::v_ref() const {
+  return v_ref_;
+}
+
+
+int TerminalLQRCost::numRiccatiIterations() const {
+  return num_iterations_;
+}
+
+
+bool TerminalLQRCost::useKinematics() const {
+  return false;
+}
+
+
+double TerminalLQRCost::evalStageCost(Robot& robot,
+                                      const ContactStatus& contact_status,
+                                      CostFunctionData& data,
+                                      const GridInfo& grid_info,
+                                      const SplitSolution& s) const {
+  return 0;
+}
+
+
+void TerminalLQRCost::evalStageCostDerivatives(
+    Robot& robot, const ContactStatus& contact_status, CostFunctionData& data,
+    const GridInfo& grid_info, const SplitSolution& s,
+    SplitKKTResidual& kkt_residual) const {
+  // Do nothing.
+}
+
+
+void TerminalLQRCost::evalStageCostHessian(
+    Robot& robot, const ContactStatus& contact_status, CostFunctionData& data,
+    const GridInfo& grid_info, const SplitSolution& s,
+    SplitKKTMatrix& kkt_matrix) const {
+  // Do nothing.
+}
+
+
+double TerminalLQRCost::evalTerminalCost(Robot& robot,
+                                         CostFunctionData& data,
+                                         const GridInfo& grid_info,
+                                         const SplitSolution& s) const {
+  robot.subtractConfiguration(s.q, q_ref_, data.qdiff);
+  const auto Pqq = P_.topLeftCorner(dimv_, dimv_);
+  const auto Pqv = P_.topRightCorner(dimv_, dimv_);
+  const auto Pvv = P_.bottomRightCorner(dimv_, dimv_);
+  const Eigen::VectorXd vdiff = s.v - v_ref_;
+  double l = 0;
+  l += data.qdiff.dot(Pqq*data.qdiff);
+  l += 2.0 * data.qdiff.dot(Pqv*vdiff);
+  l += vdiff.dot(Pvv*vdiff);
+  return 0.5 * l;
+}
+
+
+void TerminalLQRCost::evalTerminalCostDerivatives(
+    Robot& robot, CostFunctionData& data, const GridInfo& grid_info,
+    const SplitSolution& s, SplitKKTResidual& kkt_residual) const {
+  robot.subtractConfiguration(s.q, q_ref_, data.qdiff);
+  const auto Pqq = P_.topLeftCorner(dimv_, dimv_);
+  const auto Pqv = P_.topRightCorner(dimv_, dimv_);
+  const auto Pvq = P_.bottomLeftCorner(dimv_, dimv_);
+  const auto Pvv = P_.bottomRightCorner(dimv_, dimv_);
+  const Eigen::VectorXd vdiff = s.v - v_ref_;
+  if (robot.hasFloatingBase()) {
+    robot.dSubtractConfiguration_dqf(s.q, q_ref_, data.J_qdiff);
+    kkt_residual.lq().noalias()
+        += data.J_qdiff.transpose() * (Pqq * data.qdiff + Pqv * vdiff);
+  }
+  else {
+    kkt_residual.lq().noalias() += Pqq * data.qdiff;
+    kkt_residual.lq().noalias() += Pqv * vdiff;
+  }
+  kkt_residual.lv().noalias() += Pvq * data.qdiff;
+  kkt_residual.lv().noalias() += Pvv * vdiff;
+}
+
+
+void TerminalLQRCost::evalTerminalCostHessian(
+    Robot& robot, CostFunctionData& data, const GridInfo& grid_info,
+    const SplitSolution& s, SplitKKTMatrix& kkt_matrix) const {
+  const auto Pqq = P_.topLeftCorner(dimv_, dimv_);
+  const auto Pqv = P_.topRightCorner(dimv_, dimv_);
+  const auto Pvq = P_.bottomLeftCorner(dimv_, dimv_);
+  const auto Pvv = P_.bottomRightCorner(dimv_, dimv_);
+  if (robot.hasFloatingBase()) {
+    robot.dSubtractConfiguration_dqf(s.q, q_ref_, data.J_qdiff);
+    kkt_matrix.Qqq().noalias()
+        += data.J_qdiff.transpose() * Pqq * data.J_qdiff;
+    kkt_matrix.Qqv().noalias() += data.J_qdiff.transpose() * Pqv;
+    kkt_matrix.Qvq().noalias() += Pvq * data.J_qdiff;
+  }
+  else {
+    kkt_matrix.Qqq().noalias() += Pqq;
+    kkt_matrix.Qqv().noalias() += Pqv;
+    kkt_matrix.Qvq().noalias() += Pvq;
+  }
+  kkt_matrix.Qvv().noalias() += Pvv;
+}
+
+
+double TerminalLQRCost::evalImpulseCost(
+    Robot& robot, const ImpulseStatus& impulse_status, CostFunctionData& data,
+    const GridInfo& grid_info, const ImpulseSplitSolution& s) const {
+  return 0;
+}
+
+
+void TerminalLQRCost::evalImpulseCostDerivatives(
+    Robot& robot, const ImpulseStatus& impulse_status, CostFunctionData& data,
+    const GridInfo& grid_info, const ImpulseSplitSolution& s,
+    ImpulseSplitKKTResidual& kkt_residual) const {
+  // Do nothing.
+}
+
+
+void TerminalLQRCost::evalImpulseCostHessian(
+    Robot& robot, const ImpulseStatus& impulse_status, CostFunctionData& data,
+    const GridInfo& grid_info, const ImpulseSplitSolution& s,
+    ImpulseSplitKKTMatrix& kkt_matrix) const {
+  // Do nothing.
+}
+
+
+void TerminalLQRCost::linearizeKKTSystem(
+    Robot& robot, const std::shared_ptr<CostFunction>& cost,
+    const std::shared_ptr<Constraints>& constraints,
+    const ContactStatus& contact_status, const double dt,
+    const SplitSolution& s, SplitKKTMatrix& kkt_matrix, 
+    SplitKKTResidual& kkt_residual) {
+  // Linearizes a stage at the operating point. The operating point is used
+  // as both the current and next stages so that the dynamics is linearized
+  // around the equilibrium.
+  SplitOCP ocp(robot, cost, constraints);
+  ocp.initConstraints(robot, contact_status, 1, s);
+  GridInfo grid_info;
+  grid_info.dt = dt;
+  ocp.computeKKTSystem(robot, contact_status, grid_info, s.q, s, s,
+                       kkt_matrix, kkt_residual);
+}
+
+
+TerminalLQRCost::CostToGo TerminalLQRCost::solveRiccatiFixedPoint(
+    const Robot& robot, const SplitKKTMatrix& kkt_matrix,
+    const SplitKKTResidual& kkt_residual, const SplitSolution& s, 
+    const int max_iter, const double tol) {
+  // Fixed-point iteration of the Riccati recursion, i.e., the value
+  // iteration of the infinite-horizon LQR problem, starting from the Hessian
+  // of the stage cost.
+  RiccatiFactorizer factorizer(robot);
+  SplitRiccatiFactorization riccati(robot), riccati_next(robot);
+  LQRPolicy lqr_policy(robot);
+  riccati_next.P = kkt_matrix.Qxx;
+  SplitKKTMatrix kkt_matrix_tmp(kkt_matrix);
+  SplitKKTResidual kkt_residual_tmp(kkt_residual);
+  CostToGo cost_to_go;
+  cost_to_go.converged = false;
+  cost_to_go.num_iterations = max_iter;
+  for (int iter=0; iter<max_iter; ++iter) {
+    kkt_matrix_tmp = kkt_matrix;
+    kkt_residual_tmp = kkt_residual;
+    factorizer.backwardRiccatiRecursion(riccati_next, kkt_matrix_tmp,
+                                        kkt_residual_tmp, riccati, lqr_policy);
+    const double diff = (riccati.P-riccati_next.P).norm();
+    riccati_next.P = riccati.P;
+    if (diff <= tol * (1.0+riccati.P.norm())) {
+      cost_to_go.converged = true;
+      cost_to_go.num_iterations = iter + 1;
+      break;
+    }
+  }
+  // Symmetrizes to remove the round-off errors.
+  cost_to_go.P = 0.5 * (riccati_next.P + riccati_next.P.transpose());
+  cost_to_go.q_ref = s.q;
+  cost_to_go.v_ref = s.v;
+  return cost_to_go;
+}
+
+
+void TerminalLQRCost::applyCostToGo(const CostToGo& cost_to_go) {
+  P_ = cost_to_go.P;
+  q_ref_ = cost_to_go.q_ref;
+  v_ref_ = cost_to_go.v_ref;
+  num_iterations_ = cost_to_go.num_iterations;
+}
+
+
+double TerminalLQRCost::operatingPointDistance(const Robot& robot,
+                                               const SplitSolution& s) const {
+  Eigen::VectorXd qdiff(dimv_);
+  robot.subtractConfiguration(s.q, q_ref_, qdiff);
+  return std::sqrt(qdiff.squaredNorm() + (s.v-v_ref_).squaredNorm());
+}
+
+} // namespace robotoc
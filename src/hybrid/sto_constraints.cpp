@@ -472,6 +472,15 @@ double STOConstraints::KKTError() const {
 }
 
 
+double STOConstraints::constraintViolation() const {
+  double vio = 0;
+  for (int i=0; i<num_switches_+1; ++i) {
+    vio += dtlb_[i].constraintViolation();
+  }
+  return vio;
+}
+
+
 void STOConstraints::setMinimumDwellTimes(const double min_dt) {
   try {
     if (min_dt < 0) {
@@ -20,8 +20,15 @@ LineSearch::LineSearch(const OCP& ocp, const int nthreads,
     violations_impulse_(Eigen::VectorXd::Zero(ocp.reservedNumDiscreteEvents())), 
     violations_aux_(Eigen::VectorXd::Zero(ocp.reservedNumDiscreteEvents())), 
     violations_lift_(Eigen::VectorXd::Zero(ocp.reservedNumDiscreteEvents())),
-    s_trial_(ocp.robot(), ocp.N(), ocp.reservedNumDiscreteEvents()), 
-    kkt_residual_(ocp.robot(), ocp.N(), ocp.reservedNumDiscreteEvents()) {
+    s_trial_(ocp.robot(), ocp.N(), ocp.reservedNumImpulseEvents(), 
+             ocp.reservedNumLiftEvents()), 
+    discretization_trial_(ocp.discrete()),
+    impulse_times_trial_(Eigen::VectorXd::Zero(ocp.reservedNumDiscreteEvents())),
+    lift_times_trial_(Eigen::VectorXd::Zero(ocp.reservedNumDiscreteEvents())),
+    cost_sto_(0),
+    violation_sto_(0),
+    kkt_residual_(ocp.robot(), ocp.N(), ocp.reservedNumImpulseEvents(), 
+                  ocp.reservedNumLiftEvents()) {
 }
 
 
@@ -38,6 +45,11 @@ LineSearch::LineSearch()
     violations_aux_(), 
     violations_lift_(),
     s_trial_(), 
+    discretization_trial_(),
+    impulse_times_trial_(),
+    lift_times_trial_(),
+    cost_sto_(0),
+    violation_sto_(0),
     kkt_residual_() {
 }
 
@@ -55,6 +67,9 @@ double LineSearch::computeStepSize(
   assert(max_primal_step_size <= 1);
   double primal_step_size = max_primal_step_size;
   reserve(ocp);
+  if (ocp.isSTOEnabled()) {
+    discretization_trial_ = ocp.discrete();
+  }
   if (settings_.line_search_method == LineSearchMethod::Filter) {
     primal_step_size = lineSearchFilterMethod(ocp, robots, contact_sequence, 
                                                 q, v, s, d, primal_step_size);
@@ -72,6 +87,17 @@ double LineSearch::computeStepSize(
 }
 
 
+double LineSearch::computeMerit(
+    OCP& ocp, aligned_vector<Robot>& robots, 
+    const std::shared_ptr<ContactSequence>& contact_sequence, 
+    const Eigen::VectorXd& q, const Eigen::VectorXd& v, const Solution& s) {
+  reserve(ocp);
+  computeCostAndViolation(ocp, ocp.discrete(), robots, contact_sequence, 
+                          q, v, s);
+  return merit(penaltyParam(ocp, s));
+}
+
+
 void LineSearch::clearFilter() {
   filter_.clear();
 }
@@ -82,50 +108,54 @@ bool LineSearch::isFilterEmpty() const {
 }
 
 void LineSearch::computeCostAndViolation(
-    OCP& ocp, aligned_vector<Robot>& robots, 
+    OCP& ocp, const TimeDiscretization& discretization,
+    aligned_vector<Robot>& robots, 
     const std::shared_ptr<ContactSequence>& contact_sequence, 
     const Eigen::VectorXd& q, const Eigen::VectorXd& v, const Solution& s) {
   assert(robots.size() == nthreads_);
   assert(q.size() == robots[0].dimq());
   assert(v.size() == robots[0].dimv());
-  const int N = ocp.discrete().N();
-  const int N_impulse = ocp.discrete().N_impulse();
-  const int N_lift = ocp.discrete().N_lift();
+  const int N = discretization.N();
+  const int N_impulse = discretization.N_impulse();
+  const int N_lift = discretization.N_lift();
   const int N_all = N + 1 + 2*N_impulse + N_lift;
+  // The STO cost and constraints are evaluated in the extra iteration, i.e., 
+  // concurrently with the costs and constraints of the time stages.
+  const int N_all_sto = ocp.isSTOEnabled() ? N_all+1 : N_all;
   clearCosts();
   clearViolations();
   #pragma omp parallel for num_threads(nthreads_)
-  for (int i=0; i<N_all; ++i) {
+  for (int i=0; i<N_all_sto; ++i) {
     if (i < N) {
-      if (ocp.discrete().isTimeStageBeforeImpulse(i)) {
+      if (discretization.isTimeStageBeforeImpulse(i)) {
         ocp[i].evalOCP(robots[omp_get_thread_num()], 
-                       contact_sequence->contactStatus(ocp.discrete().contactPhase(i)),
-                       ocp.discrete().gridInfo(i), s[i], 
-                       s.impulse[ocp.discrete().impulseIndexAfterTimeStage(i)].q,
-                       s.impulse[ocp.discrete().impulseIndexAfterTimeStage(i)].v,
+                       contact_sequence->contactStatus(discretization.contactPhase(i)),
+                       discretization.gridInfo(i), s[i], 
+                       s.impulse[discretization.impulseIndexAfterTimeStage(i)].q,
+                       s.impulse[discretization.impulseIndexAfterTimeStage(i)].v,
                        kkt_residual_[i]);
         costs_.coeffRef(i) = ocp[i].stageCost();
         violations_.coeffRef(i) = ocp[i].constraintViolation(kkt_residual_[i]);
       }
-      else if (ocp.discrete().isTimeStageBeforeLift(i)) {
+      else if (discretization.isTimeStageBeforeLift(i)) {
         ocp[i].evalOCP(robots[omp_get_thread_num()], 
-                       contact_sequence->contactStatus(ocp.discrete().contactPhase(i)),
-                       ocp.discrete().gridInfo(i), s[i], 
-                       s.lift[ocp.discrete().liftIndexAfterTimeStage(i)].q,
-                       s.lift[ocp.discrete().liftIndexAfterTimeStage(i)].v,
+                       contact_sequence->contactStatus(discretization.contactPhase(i)),
+                       discretization.gridInfo(i), s[i], 
+                       s.lift[discretization.liftIndexAfterTimeStage(i)].q,
+                       s.lift[discretization.liftIndexAfterTimeStage(i)].v,
                        kkt_residual_[i]);
         costs_.coeffRef(i) = ocp[i].stageCost();
         violations_.coeffRef(i) = ocp[i].constraintViolation(kkt_residual_[i]);
       }
-      if (ocp.discrete().isTimeStageBeforeImpulse(i+1)) {
+      if (discretization.isTimeStageBeforeImpulse(i+1)) {
         const int impulse_index  
-            = ocp.discrete().impulseIndexAfterTimeStage(i+1);
+            = discretization.impulseIndexAfterTimeStage(i+1);
         ocp[i].evalOCP(robots[omp_get_thread_num()], 
-                       contact_sequence->contactStatus(ocp.discrete().contactPhase(i)),
-                       ocp.discrete().gridInfo(i), s[i], 
+                       contact_sequence->contactStatus(discretization.contactPhase(i)),
+                       discretization.gridInfo(i), s[i], 
                        s[i+1].q, s[i+1].v, kkt_residual_[i], 
                        contact_sequence->impulseStatus(impulse_index), 
-                       ocp.discrete().gridInfoAux(impulse_index), 
+                       discretization.gridInfoAux(impulse_index), 
                        kkt_residual_.switching[impulse_index]);
         costs_.coeffRef(i) = ocp[i].stageCost();
         violations_.coeffRef(i) = ocp[i].constraintViolation(kkt_residual_[i], 
@@ -133,8 +163,8 @@ void LineSearch::computeCostAndViolation(
       }
       else {
         ocp[i].evalOCP(robots[omp_get_thread_num()], 
-                       contact_sequence->contactStatus(ocp.discrete().contactPhase(i)),
-                       ocp.discrete().gridInfo(i), s[i], 
+                       contact_sequence->contactStatus(discretization.contactPhase(i)),
+                       discretization.gridInfo(i), s[i], 
                        s[i+1].q, s[i+1].v, kkt_residual_[i]);
         costs_.coeffRef(i) = ocp[i].stageCost();
         violations_.coeffRef(i) = ocp[i].constraintViolation(kkt_residual_[i]);
@@ -142,16 +172,16 @@ void LineSearch::computeCostAndViolation(
     }
     else if (i == N) {
       ocp.terminal.evalOCP(robots[omp_get_thread_num()], 
-                           ocp.discrete().gridInfo(i), s[i], kkt_residual_[i]);
+                           discretization.gridInfo(i), s[i], kkt_residual_[i]);
       costs_.coeffRef(i) = ocp.terminal.terminalCost();
     }
     else if (i < N+1+N_impulse) {
       const int impulse_index = i - (N+1);
       const int time_stage_before_impulse 
-          = ocp.discrete().timeStageBeforeImpulse(impulse_index);
+          = discretization.timeStageBeforeImpulse(impulse_index);
       ocp.impulse[impulse_index].evalOCP(robots[omp_get_thread_num()], 
                                          contact_sequence->impulseStatus(impulse_index), 
-                                         ocp.discrete().gridInfoImpulse(impulse_index), 
+                                         discretization.gridInfoImpulse(impulse_index), 
                                          s.impulse[impulse_index], 
                                          s.aux[impulse_index].q, 
                                          s.aux[impulse_index].v,
@@ -163,11 +193,11 @@ void LineSearch::computeCostAndViolation(
     else if (i < N+1+2*N_impulse) {
       const int impulse_index  = i - (N+1+N_impulse);
       const int time_stage_after_impulse 
-          = ocp.discrete().timeStageAfterImpulse(impulse_index);
+          = discretization.timeStageAfterImpulse(impulse_index);
       ocp.aux[impulse_index].evalOCP(robots[omp_get_thread_num()], 
                                      contact_sequence->contactStatus(
-                                        ocp.discrete().contactPhaseAfterImpulse(impulse_index)), 
-                                     ocp.discrete().gridInfoAux(impulse_index), 
+                                        discretization.contactPhaseAfterImpulse(impulse_index)), 
+                                     discretization.gridInfoAux(impulse_index), 
                                      s.aux[impulse_index],
                                      s[time_stage_after_impulse].q, 
                                      s[time_stage_after_impulse].v,
@@ -176,14 +206,14 @@ void LineSearch::computeCostAndViolation(
       violations_aux_.coeffRef(impulse_index) 
           = ocp.aux[impulse_index].constraintViolation(kkt_residual_.aux[impulse_index]);
     }
-    else {
+    else if (i < N_all) {
       const int lift_index = i - (N+1+2*N_impulse);
       const int time_stage_after_lift
-          = ocp.discrete().timeStageAfterLift(lift_index);
+          = discretization.timeStageAfterLift(lift_index);
       ocp.lift[lift_index].evalOCP(robots[omp_get_thread_num()], 
                                    contact_sequence->contactStatus(
-                                       ocp.discrete().contactPhaseAfterLift(lift_index)), 
-                                   ocp.discrete().gridInfoLift(lift_index), 
+                                       discretization.contactPhaseAfterLift(lift_index)), 
+                                   discretization.gridInfoLift(lift_index), 
                                    s.lift[lift_index],
                                    s[time_stage_after_lift].q, 
                                    s[time_stage_after_lift].v,
@@ -192,6 +222,11 @@ void LineSearch::computeCostAndViolation(
           = ocp.lift[lift_index].constraintViolation(kkt_residual_.lift[lift_index]);
       costs_lift_.coeffRef(lift_index) = ocp.lift[lift_index].stageCost();
     }
+    else {
+      cost_sto_ = ocp.sto_cost()->evalCost(discretization);
+      ocp.sto_constraints()->evalConstraint(discretization);
+      violation_sto_ = ocp.sto_constraints()->constraintViolation();
+    }
   }
 }
 
@@ -207,6 +242,9 @@ void LineSearch::computeSolutionTrial(const OCP& ocp,
   const int N_impulse = ocp.discrete().N_impulse();
   const int N_lift = ocp.discrete().N_lift();
   const int N_all = N + 1 + 2*N_impulse + N_lift;
+  if (ocp.isSTOEnabled()) {
+    computeSwitchingTimesTrial(ocp, d, step_size);
+  }
   #pragma omp parallel for num_threads(nthreads_)
   for (int i=0; i<N_all; ++i) {
     if (i <= N) {
@@ -236,19 +274,46 @@ void LineSearch::computeSolutionTrial(const OCP& ocp,
 }
 
 
+void LineSearch::computeSwitchingTimesTrial(const OCP& ocp, 
+                                            const Direction& d, 
+                                            const double step_size) {
+  const int N_impulse = ocp.discrete().N_impulse();
+  for (int impulse_index=0; impulse_index<N_impulse; ++impulse_index) {
+    impulse_times_trial_.coeffRef(impulse_index) 
+        = ocp.discrete().impulseTime(impulse_index);
+    if (ocp.discrete().isSTOEnabledImpulse(impulse_index)) {
+      impulse_times_trial_.coeffRef(impulse_index) 
+          += step_size * d.aux[impulse_index].dts;
+    }
+  }
+  const int N_lift = ocp.discrete().N_lift();
+  for (int lift_index=0; lift_index<N_lift; ++lift_index) {
+    lift_times_trial_.coeffRef(lift_index) = ocp.discrete().liftTime(lift_index);
+    if (ocp.discrete().isSTOEnabledLift(lift_index)) {
+      lift_times_trial_.coeffRef(lift_index) 
+          += step_size * d.lift[lift_index].dts;
+    }
+  }
+  discretization_trial_.setSwitchingTimes(impulse_times_trial_, 
+                                          lift_times_trial_);
+}
+
+
 double LineSearch::lineSearchFilterMethod(
     OCP& ocp, aligned_vector<Robot>& robots, 
     const std::shared_ptr<ContactSequence>& contact_sequence, 
     const Eigen::VectorXd& q, const Eigen::VectorXd& v, const Solution& s, 
     const Direction& d, const double initial_primal_step_size) {
   if (filter_.isEmpty()) {
-    computeCostAndViolation(ocp, robots, contact_sequence, q, v, s);
+    computeCostAndViolation(ocp, ocp.discrete(), robots, contact_sequence, 
+                            q, v, s);
     filter_.augment(totalCosts(), totalViolations());
   }
   double primal_step_size = initial_primal_step_size;
   while (primal_step_size > settings_.min_step_size) {
     computeSolutionTrial(ocp, robots, s, d, primal_step_size);
-    computeCostAndViolation(ocp, robots, contact_sequence, q, v, s_trial_);
+    computeCostAndViolation(ocp, discretizationTrial(ocp), robots, 
+                            contact_sequence, q, v, s_trial_);
     const double total_costs = totalCosts();
     const double total_violations = totalViolations();
     if (filter_.isAccepted(total_costs, total_violations)) {
@@ -266,17 +331,20 @@ double LineSearch::meritBacktrackingLineSearch(
     const std::shared_ptr<ContactSequence>& contact_sequence, 
     const Eigen::VectorXd& q, const Eigen::VectorXd& v, const Solution& s, 
     const Direction& d, const double initial_primal_step_size) {
-  computeCostAndViolation(ocp, robots, contact_sequence, q, v, s);
+  computeCostAndViolation(ocp, ocp.discrete(), robots, contact_sequence, 
+                          q, v, s);
   const double penalty_param = penaltyParam(ocp, s);
   const double merit_now = merit(penalty_param);
   computeSolutionTrial(ocp, robots, s, d, settings_.eps);
-  computeCostAndViolation(ocp, robots, contact_sequence, q, v, s_trial_);
+  computeCostAndViolation(ocp, discretizationTrial(ocp), robots, 
+                          contact_sequence, q, v, s_trial_);
   const double merit_eps = merit(penalty_param);
   const double directional_derivative =  (1.0 / settings_.eps) * (merit_eps - merit_now);
   double primal_step_size = initial_primal_step_size;
   while (primal_step_size > settings_.min_step_size) {
     computeSolutionTrial(ocp, robots, s, d, primal_step_size);
-    computeCostAndViolation(ocp, robots, contact_sequence, q, v, s_trial_);
+    computeCostAndViolation(ocp, discretizationTrial(ocp), robots, 
+                            contact_sequence, q, v, s_trial_);
     const double merit_next = merit(penalty_param);
     const bool armijoHolds = armijoCond(merit_now, merit_next, directional_derivative, 
                                         primal_step_size, settings_.armijo_control_rate);
@@ -330,7 +398,8 @@ double LineSearch::merit(const double penalty_param) const {
   const double res_impulse = (costs_impulse_ + penalty_param * violations_impulse_).sum();
   const double res_aux = (costs_aux_ + penalty_param * violations_aux_).sum();
   const double res_lift = (costs_lift_ + penalty_param * violations_lift_).sum();                                       
-  return res + res_impulse + res_aux + res_lift;
+  const double res_sto = cost_sto_ + penalty_param * violation_sto_;
+  return res + res_impulse + res_aux + res_lift + res_sto;
 }
 
 
@@ -352,8 +421,14 @@ void LineSearch::reserve(const OCP& ocp) {
   violations_aux_.setZero();
   violations_lift_.resize(ocp.reservedNumDiscreteEvents());
   violations_lift_.setZero();
-  s_trial_.reserve(ocp.robot(), ocp.reservedNumDiscreteEvents());
-  kkt_residual_.reserve(ocp.robot(), ocp.reservedNumDiscreteEvents());
+  impulse_times_trial_.resize(ocp.reservedNumDiscreteEvents());
+  impulse_times_trial_.setZero();
+  lift_times_trial_.resize(ocp.reservedNumDiscreteEvents());
+  lift_times_trial_.setZero();
+  s_trial_.reserve(ocp.robot(), ocp.reservedNumImpulseEvents(), 
+                   ocp.reservedNumLiftEvents());
+  kkt_residual_.reserve(ocp.robot(), ocp.reservedNumImpulseEvents(), 
+                        ocp.reservedNumLiftEvents());
 }
 
 } // namespace robotoc
\ No newline at end of file
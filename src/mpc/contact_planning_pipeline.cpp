@@ -0,0 +1,134 @@
+#include "robotoc/mpc/contact_planning_pipeline.hpp"
+
+#include <cassert>
+
+
+namespace robotoc {
+
+ContactPlanningPipeline::ContactPlanningPipeline()
+  : worker_(),
+    mtx_(),
+    cv_(),
+    has_task_(false),
+    is_in_flight_(false),
+    terminate_(false),
+    planner_(),
+    t_(0),
+    q_(),
+    v_(),
+    contact_status_(),
+    planning_steps_(0) {
+}
+
+
+ContactPlanningPipeline::~ContactPlanningPipeline() {
+  terminate();
+}
+
+
+ContactPlanningPipeline::ContactPlanningPipeline(const ContactPlanningPipeline&)
+  : ContactPlanningPipeline() {
+}
+
+
+ContactPlanningPipeline& ContactPlanningPipeline::operator=(
+    const ContactPlanningPipeline& other) {
+  if (this != &other) {
+    cancel();
+  }
+  return *this;
+}
+
+
+ContactPlanningPipeline::ContactPlanningPipeline(
+    ContactPlanningPipeline&&) noexcept
+  : ContactPlanningPipeline() {
+}
+
+
+ContactPlanningPipeline& ContactPlanningPipeline::operator=(
+    ContactPlanningPipeline&& other) noexcept {
+  if (this != &other) {
+    cancel();
+  }
+  return *this;
+}
+
+
+void ContactPlanningPipeline::launch(
+    const std::shared_ptr<ContactPlannerBase>& planner, const double t,
+    const Eigen::VectorXd& q, const Eigen::VectorXd& v,
+    const ContactStatus& contact_status, const int planning_steps) {
+  assert(planning_steps >= 0);
+  cancel();
+  if (!worker_.joinable()) {
+    terminate_ = false;
+    worker_ = std::thread(&ContactPlanningPipeline::run, this);
+  }
+  {
+    std::lock_guard<std::mutex> lock(mtx_);
+    planner_ = planner;
+    t_ = t;
+    q_ = q;
+    v_ = v;
+    contact_status_ = contact_status;
+    planning_steps_ = planning_steps;
+    has_task_ = true;
+    is_in_flight_ = true;
+  }
+  cv_.notify_all();
+}
+
+
+bool ContactPlanningPipeline::synchronize(const ContactStatus& contact_status,
+                                          const int planning_steps) {
+  if (!is_in_flight_) return false;
+  wait();
+  is_in_flight_ = false;
+  return ((planning_steps == planning_steps_)
+            && (contact_status.isContactActive() 
+                  == contact_status_.isContactActive()));
+}
+
+
+void ContactPlanningPipeline::cancel() {
+  if (is_in_flight_) {
+    wait();
+    is_in_flight_ = false;
+  }
+}
+
+
+void ContactPlanningPipeline::run() {
+  std::unique_lock<std::mutex> lock(mtx_);
+  while (true) {
+    cv_.wait(lock, [this] { return has_task_ || terminate_; });
+    if (terminate_) return;
+    lock.unlock();
+    planner_->plan(t_, q_, v_, contact_status_, planning_steps_);
+    lock.lock();
+    has_task_ = false;
+    cv_.notify_all();
+  }
+}
+
+
+void ContactPlanningPipeline::wait() {
+  std::unique_lock<std::mutex> lock(mtx_);
+  cv_.wait(lock, [this] { return !has_task_; });
+}
+
+
+void ContactPlanningPipeline::terminate() {
+  cancel();
+  if (worker_.joinable()) {
+    {
+      std::lock_guard<std::mutex> lock(mtx_);
+      terminate_ = true;
+    }
+    cv_.notify_all();
+    worker_.join();
+  }
+}
+
+} // namespace robotoc
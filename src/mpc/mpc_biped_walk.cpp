@@ -34,7 +34,9 @@ MPCBipedWalk::MPCBipedWalk(const Robot& robot, const double T, const int N,
     N_(N),
     current_step_(0),
     predict_step_(0),
-    enable_double_support_phase_(false) {
+    enable_double_support_phase_(false),
+    contact_planning_pipeline_(),
+    enable_pipelined_tick_(false) {
   try {
     if (robot.maxNumSurfaceContacts() < 2) {
       throw std::out_of_range(
@@ -166,9 +168,13 @@ void MPCBipedWalk::init(const double t, const Eigen::VectorXd& q,
     std::cerr << e.what() << '\n';
     std::exit(EXIT_FAILURE);
   }
+  contact_planning_pipeline_.cancel();
   current_step_ = 0;
   predict_step_ = 0;
-  contact_sequence_->reserve(std::floor(T_/(swing_time_+double_support_time_)));
+  // Without the double support phases, all the discrete events but the first lift-off 
+  // are impulse events.
+  const int num_steps = std::floor(T_/(swing_time_+double_support_time_));
+  contact_sequence_->reserve(num_steps, enable_double_support_phase_ ? num_steps : 1);
   contact_sequence_->init(cs_standing_);
   bool add_step = addStep(t);
   while (add_step) {
@@ -189,11 +195,13 @@ void MPCBipedWalk::init(const double t, const Eigen::VectorXd& q,
 
 
 void MPCBipedWalk::reset() {
+  contact_planning_pipeline_.cancel();
   ocp_solver_.setSolution(s_);
 }
 
 
 void MPCBipedWalk::reset(const Eigen::VectorXd& q, const Eigen::VectorXd& v) {
+  contact_planning_pipeline_.cancel();
   ocp_solver_.setSolution(s_);
   ocp_solver_.setSolution("q", q);
   ocp_solver_.setSolution("v", v);
@@ -205,6 +213,14 @@ void MPCBipedWalk::setSolverOptions(const SolverOptions& solver_options) {
 }
 
 
+void MPCBipedWalk::setPipelinedTick(const bool enable) {
+  if (!enable) {
+    contact_planning_pipeline_.cancel();
+  }
+  enable_pipelined_tick_ = enable;
+}
+
+
 void MPCBipedWalk::updateSolution(const double t, const double dt,
                                  const Eigen::VectorXd& q, 
                                  const Eigen::VectorXd& v) {
@@ -221,7 +237,23 @@ void MPCBipedWalk::updateSolution(const double t, const double dt,
       ++current_step_;
     }
   }
-  resetContactPlacements(t, q, v);
+  if (enable_pipelined_tick_) {
+    const bool planned 
+        = contact_planning_pipeline_.synchronize(contact_sequence_->contactStatus(0),
+                                                 contact_sequence_->numContactPhases());
+    if (planned && !add_step && !remove_step) {
+      commitContactPlacements();
+    }
+    else {
+      resetContactPlacements(t, q, v);
+    }
+    contact_planning_pipeline_.launch(foot_step_planner_, t+dt, q, v, 
+                                      contact_sequence_->contactStatus(0),
+                                      contact_sequence_->numContactPhases());
+  }
+  else {
+    resetContactPlacements(t, q, v);
+  }
   ocp_solver_.solve(t, q, v, true);
 }
 
@@ -252,6 +284,11 @@ double MPCBipedWalk::KKTError() const {
 }
 
 
+const SolverStatistics& MPCBipedWalk::getSolverStatistics() const {
+  return ocp_solver_.getSolverStatistics();
+}
+
+
 std::shared_ptr<CostFunction> MPCBipedWalk::getCostHandle() {
   return cost_;
 }
@@ -365,6 +402,11 @@ void MPCBipedWalk::resetContactPlacements(const double t, const Eigen::VectorXd&
                                           const Eigen::VectorXd& v) {
   const bool success = foot_step_planner_->plan(t, q, v, contact_sequence_->contactStatus(0),
                                                 contact_sequence_->numContactPhases());
+  commitContactPlacements();
+}
+
+
+void MPCBipedWalk::commitContactPlacements() {
   for (int phase=0; phase<contact_sequence_->numContactPhases(); ++phase) {
     contact_sequence_->setContactPlacements(phase, 
                                             foot_step_planner_->contactPlacements(phase+1));
@@ -34,7 +34,10 @@ MPCFlyingTrot::MPCFlyingTrot(const Robot& robot, const double T, const int N,
     eps_(std::sqrt(std::numeric_limits<double>::epsilon())),
     N_(N),
     current_step_(0),
-    predict_step_(0) {
+    predict_step_(0),
+    contact_planning_pipeline_(),
+    enable_pipelined_tick_(false),
+    enable_periodic_warm_start_(false) {
   try {
     if (robot.maxNumPointContacts() < 4) {
       throw std::out_of_range(
@@ -187,9 +190,11 @@ void MPCFlyingTrot::init(const double t, const Eigen::VectorXd& q,
     std::cerr << e.what() << '\n';
     std::exit(EXIT_FAILURE);
   }
+  contact_planning_pipeline_.cancel();
   current_step_ = 0;
   predict_step_ = 0;
-  contact_sequence_->reserve(std::floor(T_/(flying_time_+stance_time_)));
+  const int num_steps = std::floor(T_/(flying_time_+stance_time_));
+  contact_sequence_->reserve(num_steps, num_steps);
   contact_sequence_->init(cs_standing_);
   bool add_step = addStep(t);
   while (add_step) {
@@ -212,11 +217,13 @@ void MPCFlyingTrot::init(const double t, const Eigen::VectorXd& q,
 
 
 void MPCFlyingTrot::reset() {
+  contact_planning_pipeline_.cancel();
   ocp_solver_.setSolution(s_);
 }
 
 
 void MPCFlyingTrot::reset(const Eigen::VectorXd& q, const Eigen::VectorXd& v) {
+  contact_planning_pipeline_.cancel();
   ocp_solver_.setSolution(s_);
   ocp_solver_.setSolution("q", q);
   ocp_solver_.setSolution("v", v);
@@ -228,6 +235,19 @@ void MPCFlyingTrot::setSolverOptions(const SolverOptions& solver_options) {
 }
 
 
+void MPCFlyingTrot::setPipelinedTick(const bool enable) {
+  if (!enable) {
+    contact_planning_pipeline_.cancel();
+  }
+  enable_pipelined_tick_ = enable;
+}
+
+
+void MPCFlyingTrot::setPeriodicWarmStart(const bool enable) {
+  enable_periodic_warm_start_ = enable;
+}
+
+
 void MPCFlyingTrot::updateSolution(const double t, const double dt,
                                    const Eigen::VectorXd& q, 
                                    const Eigen::VectorXd& v) {
@@ -244,7 +264,30 @@ void MPCFlyingTrot::updateSolution(const double t, const double dt,
       ++current_step_;
     }
   }
-  resetContactPlacements(t, q, v);
+  if (enable_pipelined_tick_) {
+    const bool planned 
+        = contact_planning_pipeline_.synchronize(contact_sequence_->contactStatus(0),
+                                                 contact_sequence_->numContactPhases()+1);
+    if (planned && !add_step && !remove_step) {
+      commitContactPlacements();
+    }
+    else {
+      resetContactPlacements(t, q, v);
+    }
+  }
+  else {
+    resetContactPlacements(t, q, v);
+  }
+  // The periodic warm start reads the plan of the foot step planner, so it
+  // precedes the launch of the next planning on the background thread.
+  if (add_step && enable_periodic_warm_start_) {
+    extrapolateSolutionPeriodic(t);
+  }
+  if (enable_pipelined_tick_) {
+    contact_planning_pipeline_.launch(foot_step_planner_, t+dt, q, v, 
+                                      contact_sequence_->contactStatus(0),
+                                      contact_sequence_->numContactPhases()+1);
+  }
   ocp_solver_.solve(t, q, v, true);
 }
 
@@ -275,6 +318,11 @@ double MPCFlyingTrot::KKTError() const {
 }
 
 
+const SolverStatistics& MPCFlyingTrot::getSolverStatistics() const {
+  return ocp_solver_.getSolverStatistics();
+}
+
+
 std::shared_ptr<CostFunction> MPCFlyingTrot::getCostHandle() {
   return cost_;
 }
@@ -370,6 +418,11 @@ void MPCFlyingTrot::resetContactPlacements(const double t,
                                            const Eigen::VectorXd& v) {
   const bool success = foot_step_planner_->plan(t, q, v, contact_sequence_->contactStatus(0),
                                                 contact_sequence_->numContactPhases()+1);
+  commitContactPlacements();
+}
+
+
+void MPCFlyingTrot::commitContactPlacements() {
   for (int phase=0; phase<contact_sequence_->numContactPhases(); ++phase) {
     contact_sequence_->setContactPlacements(phase, 
                                             foot_step_planner_->contactPositions(phase+1),
@@ -383,4 +436,23 @@ void MPCFlyingTrot::resetContactPlacements(const double t,
   com_ref_->setCoMRef(contact_sequence_, foot_step_planner_);
 }
 
+
+void MPCFlyingTrot::extrapolateSolutionPeriodic(const double t) {
+  const int num_phases_in_period = 4;
+  const int last_phase = contact_sequence_->numContactPhases() - 1;
+  const int periodic_phase = last_phase - num_phases_in_period;
+  if (periodic_phase < 1 || last_phase+1 >= foot_step_planner_->size()) {
+    return;
+  }
+  // Planned displacement of the base over a gait period. Step (phase+1) of 
+  // the foot step planner corresponds to the contact phase phase.
+  const Eigen::Matrix3d R 
+      = foot_step_planner_->R(last_phase+1) 
+          * foot_step_planner_->R(periodic_phase+1).transpose();
+  const Eigen::Vector3d p 
+      = foot_step_planner_->CoM(last_phase+1) 
+          - R * foot_step_planner_->CoM(periodic_phase+1);
+  ocp_solver_.extrapolateSolutionPeriodic(t, num_phases_in_period, R, p);
+}
+
 } // namespace robotoc 
\ No newline at end of file
@@ -13,7 +13,7 @@ namespace robotoc {
 MPCJump::MPCJump(const Robot& robot, const double T, const int N, 
                  const int nthreads)
   : foot_step_planner_(),
-    contact_sequence_(std::make_shared<robotoc::ContactSequence>(robot, 1)),
+    contact_sequence_(std::make_shared<robotoc::ContactSequence>(robot, 1, 1)),
     cost_(std::make_shared<CostFunction>()),
     constraints_(std::make_shared<Constraints>(1.0e-03, 0.995)),
     sto_cost_(std::make_shared<STOCostFunction>()),
@@ -125,7 +125,7 @@ void MPCJump::init(const double t, const Eigen::VectorXd& q,
   contact_sequence_->init(cs_ground_);
   const double t_lift_off   = t + T_ - ground_time_ - flying_time_;
   const double t_touch_down = t + T_ - ground_time_;
-  contact_sequence_->reserve(1);
+  contact_sequence_->reserve(1, 1);
   contact_sequence_->push_back(cs_flying_, t_lift_off, sto);
   contact_sequence_->push_back(cs_ground_, t_touch_down, sto);
   resetMinimumDwellTimes(t, dtm_);
@@ -242,6 +242,11 @@ double MPCJump::KKTError() const {
 }
 
 
+const SolverStatistics& MPCJump::getSolverStatistics() const {
+  return ocp_solver_.getSolverStatistics();
+}
+
+
 std::shared_ptr<CostFunction> MPCJump::getCostHandle() {
   return cost_;
 }
@@ -0,0 +1,206 @@
+#include "robotoc/mpc/mpc_manipulator.hpp"
+
+#include <stdexcept>
+#include <iostream>
+#include <cassert>
+
+
+namespace robotoc {
+
+MPCManipulator::MPCManipulator(const Robot& robot, const double T,
+                               const int N, const int nthreads)
+  : robot_(robot),
+    cost_(std::make_shared<CostFunction>()),
+    constraints_(std::make_shared<Constraints>(1.0e-03, 0.995)),
+    config_cost_(std::make_shared<ConfigurationSpaceCost>(robot)),
+    task_cost_(),
+    ocp_solver_(UnconstrOCP(robot, cost_, constraints_, T, N),
+                SolverOptions::defaultOptions(), nthreads),
+    dRNEA_dq_(Eigen::MatrixXd::Zero(robot.dimv(), robot.dimv())),
+    dRNEA_dv_(Eigen::MatrixXd::Zero(robot.dimv(), robot.dimv())),
+    dRNEA_da_(Eigen::MatrixXd::Zero(robot.dimv(), robot.dimv())),
+    K_(Eigen::MatrixXd::Zero(robot.dimu(), 2*robot.dimv())) {
+  try {
+    if (robot.hasFloatingBase()) {
+      throw std::out_of_range(
+          "invalid argument: robot must not have a floating base!");
+    }
+    if (robot.maxNumContacts() > 0) {
+      throw std::out_of_range(
+          "invalid argument: robot must not have contacts!");
+    }
+  }
+  catch(const std::exception& e) {
+    std::cerr << e.what() << '\n';
+    std::exit(EXIT_FAILURE);
+  }
+  // create costs
+  config_cost_->set_q_weight(Eigen::VectorXd::Constant(robot.dimv(), 10));
+  config_cost_->set_q_weight_terminal(Eigen::VectorXd::Constant(robot.dimv(), 10));
+  config_cost_->set_v_weight(Eigen::VectorXd::Constant(robot.dimv(), 0.01));
+  config_cost_->set_v_weight_terminal(Eigen::VectorXd::Constant(robot.dimv(), 0.01));
+  config_cost_->set_a_weight(Eigen::VectorXd::Constant(robot.dimv(), 0.01));
+  cost_->push_back(config_cost_);
+  // create constraints
+  auto joint_position_lower = std::make_shared<robotoc::JointPositionLowerLimit>(robot);
+  auto joint_position_upper = std::make_shared<robotoc::JointPositionUpperLimit>(robot);
+  auto joint_velocity_lower = std::make_shared<robotoc::JointVelocityLowerLimit>(robot);
+  auto joint_velocity_upper = std::make_shared<robotoc::JointVelocityUpperLimit>(robot);
+  auto joint_torques_lower  = std::make_shared<robotoc::JointTorquesLowerLimit>(robot);
+  auto joint_torques_upper  = std::make_shared<robotoc::JointTorquesUpperLimit>(robot);
+  constraints_->push_back(joint_position_lower);
+  constraints_->push_back(joint_position_upper);
+  constraints_->push_back(joint_velocity_lower);
+  constraints_->push_back(joint_velocity_upper);
+  constraints_->push_back(joint_torques_lower);
+  constraints_->push_back(joint_torques_upper);
+}
+
+
+MPCManipulator::MPCManipulator(const Robot& robot,
+                               const std::string& end_effector_frame,
+                               const double T, const int N, const int nthreads)
+  : MPCManipulator(robot, T, N, nthreads) {
+  task_cost_ = std::make_shared<TaskSpace6DCost>(robot, end_effector_frame);
+  task_cost_->set_weight(Eigen::Vector3d::Constant(1000),
+                         Eigen::Vector3d::Constant(100));
+  task_cost_->set_weight_terminal(Eigen::Vector3d::Constant(1000),
+                                  Eigen::Vector3d::Constant(100));
+  cost_->push_back(task_cost_);
+  // The joint-space target only regularizes the posture.
+  config_cost_->set_q_weight(Eigen::VectorXd::Constant(robot.dimv(), 0.1));
+  config_cost_->set_q_weight_terminal(Eigen::VectorXd::Constant(robot.dimv(), 0.1));
+}
+
+
+MPCManipulator::MPCManipulator() {
+}
+
+
+MPCManipulator::~MPCManipulator() {
+}
+
+
+void MPCManipulator::setJointSpaceTarget(const Eigen::VectorXd& q_ref) {
+  config_cost_->set_q_ref(q_ref);
+}
+
+
+void MPCManipulator::setTaskSpaceTarget(const Eigen::Vector3d& position_ref,
+                                        const Eigen::Matrix3d& rotation_ref) {
+  try {
+    if (!task_cost_) {
+      throw std::out_of_range(
+          "invalid argument: end-effector frame is not given in the constructor!");
+    }
+  }
+  catch(const std::exception& e) {
+    std::cerr << e.what() << '\n';
+    std::exit(EXIT_FAILURE);
+  }
+  task_cost_->set_const_ref(position_ref, rotation_ref);
+}
+
+
+void MPCManipulator::init(const double t, const Eigen::VectorXd& q,
+                          const Eigen::VectorXd& v,
+                          const SolverOptions& solver_options) {
+  ocp_solver_.setSolution("q", q);
+  ocp_solver_.setSolution("v", v);
+  ocp_solver_.setSolution("a", Eigen::VectorXd::Zero(robot_.dimv()));
+  ocp_solver_.setSolverOptions(solver_options);
+  ocp_solver_.solve(t, q, v, true);
+  computeInitialFeedbackGain();
+}
+
+
+void MPCManipulator::setSolverOptions(const SolverOptions& solver_options) {
+  ocp_solver_.setSolverOptions(solver_options);
+}
+
+
+void MPCManipulator::updateSolution(const double t, const double dt,
+                                    const Eigen::VectorXd& q,
+                                    const Eigen::VectorXd& v) {
+  assert(dt > 0);
+  ocp_solver_.shiftSolution(dt);
+  ocp_solver_.solve(t, q, v, false);
+  computeInitialFeedbackGain();
+}
+
+
+const Eigen::VectorXd& MPCManipulator::getInitialControlInput() const {
+  return ocp_solver_.getSolution(0).u;
+}
+
+
+const Eigen::MatrixXd& MPCManipulator::getInitialFeedbackGain() const {
+  return K_;
+}
+
+
+const SplitSolution& MPCManipulator::getSolution(const int stage) const {
+  return ocp_solver_.getSolution(stage);
+}
+
+
+const std::vector<LQRPolicy>& MPCManipulator::getLQRPolicy() const {
+  return ocp_solver_.getLQRPolicy();
+}
+
+
+double MPCManipulator::KKTError(const double t, const Eigen::VectorXd& q,
+                                const Eigen::VectorXd& v) {
+  return ocp_solver_.KKTError(t, q, v);
+}
+
+
+double MPCManipulator::KKTError() const {
+  return ocp_solver_.KKTError();
+}
+
+
+const SolverStatistics& MPCManipulator::getSolverStatistics() const {
+  return ocp_solver_.getSolverStatistics();
+}
+
+
+std::shared_ptr<CostFunction> MPCManipulator::getCostHandle() {
+  return cost_;
+}
+
+
+std::shared_ptr<ConfigurationSpaceCost> MPCManipulator::getConfigCostHandle() {
+  return config_cost_;
+}
+
+
+std::shared_ptr<TaskSpace6DCost> MPCManipulator::getTaskSpaceCostHandle() {
+  return task_cost_;
+}
+
+
+std::shared_ptr<Constraints> MPCManipulator::getConstraintsHandle() {
+  return constraints_;
+}
+
+
+void MPCManipulator::setRobotProperties(const RobotProperties& properties) {
+  robot_.setRobotProperties(properties);
+  ocp_solver_.setRobotProperties(properties);
+}
+
+
+void MPCManipulator::computeInitialFeedbackGain() {
+  // The control input is given by the inverse dynamics of the acceleration,
+  // whose LQR policy is computed by the Riccati recursion. The feedback gain
+  // of the torques is therefore given by the chain rule.
+  const auto& s = ocp_solver_.getSolution(0);
+  robot_.RNEADerivatives(s.q, s.v, s.a, dRNEA_dq_, dRNEA_dv_, dRNEA_da_);
+  const int dimv = robot_.dimv();
+  K_.leftCols(dimv) = dRNEA_dq_;
+  K_.rightCols(dimv) = dRNEA_dv_;
+  K_.noalias() += dRNEA_da_ * ocp_solver_.getLQRPolicy()[0].K;
+}
+
+} // namespace robotoc
@@ -20,7 +20,8 @@ MPCPeriodicConfigurationRef::MPCPeriodicConfigurationRef(const Eigen::VectorXd&
     period_active_(period_active), 
     period_inactive_(period_inactive), 
     period_(period_active+period_inactive),
-    num_phases_in_period_(num_phases_in_period) {
+    num_phases_in_period_(num_phases_in_period),
+    version_(1) {
   try {
     if (period_active < 0.0) {
       throw std::out_of_range(
@@ -73,6 +74,7 @@ void MPCPeriodicConfigurationRef::setPeriod(const double swing_start_time,
   period_inactive_ = period_inactive;
   period_ = period_active + period_inactive;
   num_phases_in_period_ = num_phases_in_period;
+  ++version_;
 }
 
 
@@ -98,6 +100,7 @@ void MPCPeriodicConfigurationRef::setConfigurationRef(
   for (int i=0; i<size; ++i) {
     quat_[i] = Eigen::Quaterniond(foot_step_planner->R(i));
   }
+  ++version_;
 }
 
 
@@ -34,7 +34,10 @@ MPCTrot::MPCTrot(const Robot& robot, const double T, const int N,
     N_(N),
     current_step_(0),
     predict_step_(0),
-    enable_stance_phase_(false) {
+    enable_stance_phase_(false),
+    contact_planning_pipeline_(),
+    enable_pipelined_tick_(false),
+    enable_periodic_warm_start_(false) {
   try {
     if (robot.maxNumPointContacts() < 4) {
       throw std::out_of_range(
@@ -180,9 +183,13 @@ void MPCTrot::init(const double t, const Eigen::VectorXd& q,
     std::cerr << e.what() << '\n';
     std::exit(EXIT_FAILURE);
   }
+  contact_planning_pipeline_.cancel();
   current_step_ = 0;
   predict_step_ = 0;
-  contact_sequence_->reserve(std::floor(T_/(swing_time_+stance_time_)));
+  // Without the stance phases, all the discrete events but the first lift-off 
+  // are impulse events.
+  const int num_steps = std::floor(T_/(swing_time_+stance_time_));
+  contact_sequence_->reserve(num_steps, enable_stance_phase_ ? num_steps : 1);
   contact_sequence_->init(cs_standing_);
   bool add_step = addStep(t);
   while (add_step) {
@@ -204,11 +211,13 @@ void MPCTrot::init(const double t, const Eigen::VectorXd& q,
 
 
 void MPCTrot::reset() {
+  contact_planning_pipeline_.cancel();
   ocp_solver_.setSolution(s_);
 }
 
 
 void MPCTrot::reset(const Eigen::VectorXd& q, const Eigen::VectorXd& v) {
+  contact_planning_pipeline_.cancel();
   ocp_solver_.setSolution(s_);
   ocp_solver_.setSolution("q", q);
   ocp_solver_.setSolution("v", v);
@@ -220,6 +229,19 @@ void MPCTrot::setSolverOptions(const SolverOptions& solver_options) {
 }
 
 
+void MPCTrot::setPipelinedTick(const bool enable) {
+  if (!enable) {
+    contact_planning_pipeline_.cancel();
+  }
+  enable_pipelined_tick_ = enable;
+}
+
+
+void MPCTrot::setPeriodicWarmStart(const bool enable) {
+  enable_periodic_warm_start_ = enable;
+}
+
+
 void MPCTrot::updateSolution(const double t, const double dt,
                              const Eigen::VectorXd& q, 
                              const Eigen::VectorXd& v) {
@@ -236,7 +258,30 @@ void MPCTrot::updateSolution(const double t, const double dt,
       ++current_step_;
     }
   }
-  resetContactPlacements(t, q, v);
+  if (enable_pipelined_tick_) {
+    const bool planned 
+        = contact_planning_pipeline_.synchronize(contact_sequence_->contactStatus(0),
+                                                 contact_sequence_->numContactPhases());
+    if (planned && !add_step && !remove_step) {
+      commitContactPlacements();
+    }
+    else {
+      resetContactPlacements(t, q, v);
+    }
+  }
+  else {
+    resetContactPlacements(t, q, v);
+  }
+  // The periodic warm start reads the plan of the foot step planner, so it
+  // precedes the launch of the next planning on the background thread.
+  if (add_step && enable_periodic_warm_start_) {
+    extrapolateSolutionPeriodic(t);
+  }
+  if (enable_pipelined_tick_) {
+    contact_planning_pipeline_.launch(foot_step_planner_, t+dt, q, v, 
+                                      contact_sequence_->contactStatus(0),
+                                      contact_sequence_->numContactPhases());
+  }
   ocp_solver_.solve(t, q, v, true);
 }
 
@@ -267,6 +312,11 @@ double MPCTrot::KKTError() const {
 }
 
 
+const SolverStatistics& MPCTrot::getSolverStatistics() const {
+  return ocp_solver_.getSolverStatistics();
+}
+
+
 std::shared_ptr<CostFunction> MPCTrot::getCostHandle() {
   return cost_;
 }
@@ -375,6 +425,11 @@ void MPCTrot::resetContactPlacements(const double t, const Eigen::VectorXd& q,
                                      const Eigen::VectorXd& v) {
   const bool success = foot_step_planner_->plan(t, q, v, contact_sequence_->contactStatus(0),
                                                 contact_sequence_->numContactPhases());
+  commitContactPlacements();
+}
+
+
+void MPCTrot::commitContactPlacements() {
   for (int phase=0; phase<contact_sequence_->numContactPhases(); ++phase) {
     contact_sequence_->setContactPlacements(phase, 
                                             foot_step_planner_->contactPositions(phase+1),
@@ -388,4 +443,23 @@ void MPCTrot::resetContactPlacements(const double t, const Eigen::VectorXd& q,
   com_ref_->setCoMRef(contact_sequence_, foot_step_planner_);
 }
 
+
+void MPCTrot::extrapolateSolutionPeriodic(const double t) {
+  const int num_phases_in_period = (enable_stance_phase_ ? 4 : 2);
+  const int last_phase = contact_sequence_->numContactPhases() - 1;
+  const int periodic_phase = last_phase - num_phases_in_period;
+  if (periodic_phase < 1 || last_phase+1 >= foot_step_planner_->size()) {
+    return;
+  }
+  // Planned displacement of the base over a gait period. Step (phase+1) of 
+  // the foot step planner corresponds to the contact phase phase.
+  const Eigen::Matrix3d R 
+      = foot_step_planner_->R(last_phase+1) 
+          * foot_step_planner_->R(periodic_phase+1).transpose();
+  const Eigen::Vector3d p 
+      = foot_step_planner_->CoM(last_phase+1) 
+          - R * foot_step_planner_->CoM(periodic_phase+1);
+  ocp_solver_.extrapolateSolutionPeriodic(t, num_phases_in_period, R, p);
+}
+
 } // namespace robotoc 
\ No newline at end of file
@@ -72,6 +72,31 @@ void ContactDynamics::linearizeContactDynamics(
 }
 
 
+void ContactDynamics::computeForwardDynamics(
+    Robot& robot, const ContactStatus& contact_status, 
+    ContactDynamicsData& data, SplitSolution& s) {
+  const int dimv = robot.dimv();
+  const int dimf = contact_status.dimf();
+  robot.updateKinematics(s.q, s.v, s.a);
+  data.setContactStatus(contact_status);
+  robot.setContactForces(contact_status, s.f);
+  robot.RNEA(s.q, s.v, s.a, data.ID_full());
+  data.ID().noalias() -= s.u;
+  robot.computeBaumgarteResidual(contact_status, data.C());
+  robot.CRBA(s.q, data.dIDda);
+  if (contact_status.hasActiveContacts()) {
+    robot.computeBaumgarteDerivatives(contact_status, data.dCdq(), 
+                                      data.dCdv(), data.dCda());
+  }
+  robot.solveMJtJ(data.dIDda, data.dCda(), data.IDC(), data.MJtJinv_IDC());
+  s.a.noalias() -= data.MJtJinv_IDC().head(dimv);
+  if (contact_status.hasActiveContacts()) {
+    s.f_stack().noalias() += data.MJtJinv_IDC().tail(dimf);
+    s.set_f_vector();
+  }
+}
+
+
 void ContactDynamics::condenseContactDynamics(
     Robot& robot, const ContactStatus& contact_status, const double dt,
     SplitKKTMatrix& kkt_matrix, SplitKKTResidual& kkt_residual) {
@@ -87,22 +112,39 @@ void ContactDynamics::condenseContactDynamics(
   data_.Qafqv().topRows(dimv).noalias() 
       = (- kkt_matrix.Qaa.diagonal()).asDiagonal() 
           * data_.MJtJinv_dIDCdqv().topRows(dimv);
-  data_.Qafqv().bottomRows(dimf).noalias() 
-      = - kkt_matrix.Qff() * data_.MJtJinv_dIDCdqv().bottomRows(dimf);
+  if (kkt_matrix.isLowerTriangularHessian()) {
+    data_.Qafqv().bottomRows(dimf).noalias() 
+        = kkt_matrix.Qff().selfadjointView<Eigen::Lower>() 
+            * (- data_.MJtJinv_dIDCdqv().bottomRows(dimf));
+  }
+  else {
+    data_.Qafqv().bottomRows(dimf).noalias() 
+        = - kkt_matrix.Qff() * data_.MJtJinv_dIDCdqv().bottomRows(dimf);
+  }
   data_.Qafqv().bottomLeftCorner(dimf, dimv).noalias()
       -= kkt_matrix.Qqf().transpose();
   data_.Qafu_full().topRows(dimv).noalias() 
       = kkt_matrix.Qaa.diagonal().asDiagonal() 
           * data_.MJtJinv().topLeftCorner(dimv, dimv);
-  data_.Qafu_full().bottomRows(dimf).noalias() 
-      = kkt_matrix.Qff() * data_.MJtJinv().bottomLeftCorner(dimf, dimv);
   data_.la() = kkt_residual.la;
   data_.lf() = - kkt_residual.lf();
   data_.la().noalias() 
       -= kkt_matrix.Qaa.diagonal().asDiagonal() 
           * data_.MJtJinv_IDC().head(dimv);
-  data_.lf().noalias() 
-      -= kkt_matrix.Qff() * data_.MJtJinv_IDC().tail(dimf);
+  if (kkt_matrix.isLowerTriangularHessian()) {
+    data_.Qafu_full().bottomRows(dimf).noalias() 
+        = kkt_matrix.Qff().selfadjointView<Eigen::Lower>() 
+            * data_.MJtJinv().bottomLeftCorner(dimf, dimv);
+    data_.lf().noalias() 
+        -= kkt_matrix.Qff().selfadjointView<Eigen::Lower>() 
+            * data_.MJtJinv_IDC().tail(dimf);
+  }
+  else {
+    data_.Qafu_full().bottomRows(dimf).noalias() 
+        = kkt_matrix.Qff() * data_.MJtJinv().bottomLeftCorner(dimf, dimv);
+    data_.lf().noalias() 
+        -= kkt_matrix.Qff() * data_.MJtJinv_IDC().tail(dimf);
+  }
 
   kkt_matrix.Qxx.noalias() 
       -= data_.MJtJinv_dIDCdqv().transpose() * data_.Qafqv();
@@ -132,12 +174,18 @@ void ContactDynamics::condenseContactDynamics(
   if (has_floating_base_) {
     data_.Quu_passive_topRight.noalias() 
         = data_.MJtJinv().topRows(dim_passive) * data_.Qafu_full().rightCols(dimu);
-    kkt_matrix.Quu.noalias() 
-        += data_.MJtJinv().middleRows(dim_passive, dimu) * data_.Qafu_full().rightCols(dimu);
+  }
+  // The condensed Quu is symmetric since MJtJinv() and the Hessian w.r.t. 
+  // (a, f) are symmetric.
+  if (kkt_matrix.isLowerTriangularHessian()) {
+    kkt_matrix.Quu.triangularView<Eigen::Lower>()
+        += data_.MJtJinv().middleRows(dim_passive, dimu) 
+            * data_.Qafu_full().rightCols(dimu);
   }
   else {
     kkt_matrix.Quu.noalias() 
-        += data_.MJtJinv().topRows(dimv) * data_.Qafu_full();
+        += data_.MJtJinv().middleRows(dim_passive, dimu) 
+            * data_.Qafu_full().rightCols(dimu);
   }
   if (has_floating_base_) {
     data_.lu_passive.noalias() 
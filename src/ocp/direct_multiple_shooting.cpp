@@ -4,6 +4,7 @@
 #include <stdexcept>
 #include <iostream>
 #include <cassert>
+#include <algorithm>
 
 
 namespace robotoc{
@@ -165,6 +166,61 @@ double DirectMultipleShooting::KKTError(const OCP& ocp,
 }
 
 
+double DirectMultipleShooting::KKTErrorLeadingStages(
+    const OCP& ocp, const KKTResidual& kkt_residual, 
+    const int num_leading_stages) {
+  const int N_leading = std::min(num_leading_stages, ocp.discrete().N()+1);
+  double kkt_error = 0;
+  for (int i=0; i<N_leading; ++i) {
+    kkt_error += kkt_residual[i].kkt_error;
+  }
+  for (int i=0; i<ocp.discrete().N_impulse(); ++i) {
+    if (ocp.discrete().timeStageBeforeImpulse(i) < N_leading) {
+      kkt_error += kkt_residual.impulse[i].kkt_error;
+      kkt_error += kkt_residual.aux[i].kkt_error;
+    }
+  }
+  for (int i=0; i<ocp.discrete().N_lift(); ++i) {
+    if (ocp.discrete().timeStageBeforeLift(i) < N_leading) {
+      kkt_error += kkt_residual.lift[i].kkt_error;
+    }
+  }
+  return kkt_error;
+}
+
+
+double DirectMultipleShooting::constraintsPrimalResidualError(const OCP& ocp) {
+  double err = 0;
+  for (int i=0; i<ocp.discrete().N(); ++i) {
+    err += ocp[i].constraintsData().primalResidualError();
+  }
+  for (int i=0; i<ocp.discrete().N_impulse(); ++i) {
+    err += ocp.impulse[i].constraintsData().primalResidualError();
+    err += ocp.aux[i].constraintsData().primalResidualError();
+  }
+  for (int i=0; i<ocp.discrete().N_lift(); ++i) {
+    err += ocp.lift[i].constraintsData().primalResidualError();
+  }
+  return err;
+}
+
+
+double DirectMultipleShooting::constraintsComplementarityError(const OCP& ocp) {
+  double err = 0;
+  for (int i=0; i<ocp.discrete().N(); ++i) {
+    err += ocp[i].constraintsData().complementarityError();
+  }
+  for (int i=0; i<ocp.discrete().N_impulse(); ++i) {
+    err += ocp.impulse[i].constraintsData().complementarityError();
+    err += ocp.aux[i].constraintsData().complementarityError();
+  }
+  for (int i=0; i<ocp.discrete().N_lift(); ++i) {
+    err += ocp.lift[i].constraintsData().complementarityError();
+  }
+  return err;
+}
+
+
 double DirectMultipleShooting::totalCost(const OCP& ocp, 
                                          const bool include_cost_barrier) {
   double total_cost = 0;
@@ -200,6 +256,40 @@ void DirectMultipleShooting::integrateSolution(
   const int N_impulse = ocp.discrete().N_impulse();
   const int N_lift = ocp.discrete().N_lift();
   const int N_all = N + 1 + 2*N_impulse + N_lift;
+  if (ocp.integrationScheme() == IntegrationScheme::Midpoint) {
+    // The costate directions of the next time stages are stored before they 
+    // are corrected in the expansion of the dual directions below.
+    #pragma omp parallel for num_threads(nthreads_)
+    for (int i=0; i<N+N_impulse+N_lift; ++i) {
+      if (i < N) {
+        if (ocp.discrete().isTimeStageBeforeImpulse(i)) {
+          const int impulse_index = ocp.discrete().impulseIndexAfterTimeStage(i);
+          ocp[i].setCostateDirectionNext(ocp.discrete().gridInfo(i), 
+                                         d.impulse[impulse_index]);
+        }
+        else if (ocp.discrete().isTimeStageBeforeLift(i)) {
+          const int lift_index = ocp.discrete().liftIndexAfterTimeStage(i);
+          ocp[i].setCostateDirectionNext(ocp.discrete().gridInfo(i), 
+                                         d.lift[lift_index]);
+        }
+        else {
+          ocp[i].setCostateDirectionNext(ocp.discrete().gridInfo(i), d[i+1]);
+        }
+      }
+      else if (i < N+N_impulse) {
+        const int impulse_index  = i - N;
+        ocp.aux[impulse_index].setCostateDirectionNext(
+            ocp.discrete().gridInfoAux(impulse_index), 
+            d[ocp.discrete().timeStageAfterImpulse(impulse_index)]);
+      }
+      else {
+        const int lift_index = i - (N+N_impulse);
+        ocp.lift[lift_index].setCostateDirectionNext(
+            ocp.discrete().gridInfoLift(lift_index), 
+            d[ocp.discrete().timeStageAfterLift(lift_index)]);
+      }
+    }
+  }
   #pragma omp parallel for num_threads(nthreads_)
   for (int i=0; i<N_all; ++i) {
     if (i < N) {
@@ -0,0 +1,103 @@
+#include "robotoc/ocp/nonlinear_rollout.hpp"
+
+#include <cassert>
+
+#include "robotoc/ocp/contact_dynamics.hpp"
+
+
+namespace robotoc {
+
+NonlinearRollout::NonlinearRollout(const OCP& ocp)
+  : defects_(ocp.N(), Eigen::VectorXd::Zero(2*ocp.robot().dimv())),
+    data_(ocp.robot()),
+    dx_(Eigen::VectorXd::Zero(2*ocp.robot().dimv())),
+    dq_(Eigen::VectorXd::Zero(ocp.robot().dimv())),
+    q_next_(Eigen::VectorXd::Zero(ocp.robot().dimq())),
+    v_next_(Eigen::VectorXd::Zero(ocp.robot().dimv())),
+    dimv_(ocp.robot().dimv()) {
+}
+
+
+NonlinearRollout::NonlinearRollout()
+  : defects_(),
+    data_(),
+    dx_(),
+    dq_(),
+    q_next_(),
+    v_next_(),
+    dimv_(0) {
+}
+
+
+NonlinearRollout::~NonlinearRollout() {
+}
+
+
+int NonlinearRollout::rolloutHorizon(const OCP& ocp) {
+  if (ocp.isSTOEnabled()) {
+    return 0;
+  }
+  const int N = ocp.discrete().N();
+  for (int i=0; i<N; ++i) {
+    if (ocp.discrete().isTimeStageBeforeImpulse(i)
+        || ocp.discrete().isTimeStageBeforeLift(i)) {
+      return i;
+    }
+  }
+  return N;
+}
+
+
+void NonlinearRollout::computeDefects(const OCP& ocp, const Robot& robot,
+                                      const Solution& s) {
+  const int N = rolloutHorizon(ocp);
+  while (static_cast<int>(defects_.size()) < N) {
+    defects_.push_back(Eigen::VectorXd::Zero(2*dimv_));
+  }
+  const bool midpoint
+      = (ocp.integrationScheme() == IntegrationScheme::Midpoint);
+  for (int i=0; i<N; ++i) {
+    const double dt = ocp.discrete().gridInfo(i).dt;
+    auto Fq = defects_[i].head(dimv_);
+    robot.subtractConfiguration(s[i].q, s[i+1].q, Fq);
+    Fq.noalias() += dt * s[i].v;
+    if (midpoint) {
+      Fq.noalias() += (0.5*dt*dt) * s[i].a;
+    }
+    defects_[i].tail(dimv_) = s[i].v + dt * s[i].a - s[i+1].v;
+  }
+}
+
+
+void NonlinearRollout::rollout(const OCP& ocp, Robot& robot,
+                               const hybrid_container<LQRPolicy>& lqr_policy,
+                               const double primal_step_size, Solution& s) {
+  assert(primal_step_size > 0);
+  assert(primal_step_size <= 1);
+  const int N = rolloutHorizon(ocp);
+  const bool midpoint
+      = (ocp.integrationScheme() == IntegrationScheme::Midpoint);
+  const double defect_scale = 1.0 - primal_step_size;
+  // The initial state is given by the linear step.
+  dx_.setZero();
+  for (int i=0; i<N; ++i) {
+    const double dt = ocp.discrete().gridInfo(i).dt;
+    const auto& contact_status
+        = ocp.contact_sequence()->contactStatus(ocp.discrete().contactPhase(i));
+    s[i].u.noalias() += lqr_policy[i].K * dx_;
+    ContactDynamics::computeForwardDynamics(robot, contact_status, data_, s[i]);
+    dq_ = dt * s[i].v - defect_scale * defects_[i].head(dimv_);
+    if (midpoint) {
+      dq_.noalias() += (0.5*dt*dt) * s[i].a;
+    }
+    robot.integrateConfiguration(s[i].q, dq_, 1.0, q_next_);
+    v_next_ = s[i].v + dt * s[i].a - defect_scale * defects_[i].tail(dimv_);
+    // Deviation from the linear step, which is fed back to the next stage.
+    robot.subtractConfiguration(q_next_, s[i+1].q, dx_.head(dimv_));
+    dx_.tail(dimv_) = v_next_ - s[i+1].v;
+    s[i+1].q = q_next_;
+    s[i+1].v = v_next_;
+  }
+}
+
+} // namespace robotoc
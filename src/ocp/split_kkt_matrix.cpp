@@ -7,6 +7,9 @@ void SplitKKTMatrix::disp(std::ostream& os) const {
   os << "split KKT matrix:" << std::endl;
   os << "  Fxx = " << Fxx << std::endl;
   os << "  Fvu = " << Fvu << std::endl;
+  if (Fqu.size() > 0) {
+    os << "  Fqu = " << Fqu << std::endl;
+  }
   os << "  Fqq_prev = " << Fqq_prev << std::endl;
   os << "  Qxx = " << Qxx << std::endl;
   os << "  Qxu = " << Qxu << std::endl;
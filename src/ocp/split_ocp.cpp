@@ -36,6 +36,16 @@ SplitOCP::~SplitOCP() {
 }
 
 
+void SplitOCP::setIntegrationScheme(const IntegrationScheme integration_scheme) {
+  state_equation_.setIntegrationScheme(integration_scheme);
+}
+
+
+IntegrationScheme SplitOCP::integrationScheme() const {
+  return state_equation_.integrationScheme();
+}
+
+
 bool SplitOCP::isFeasible(Robot& robot, const ContactStatus& contact_status, 
                           const SplitSolution& s) {
   return constraints_->isFeasible(robot, contact_status, constraints_data_, s);
@@ -232,6 +242,18 @@ void SplitOCP::expandPrimal(const ContactStatus& contact_status,
 }
 
 
+void SplitOCP::setCostateDirectionNext(const GridInfo& grid_info, 
+                                       const SplitDirection& d_next) {
+  state_equation_.setCostateDirectionNext(grid_info.dt, d_next);
+}
+
+
+void SplitOCP::setCostateDirectionNext(const GridInfo& grid_info, 
+                                       const ImpulseSplitDirection& d_next) {
+  state_equation_.setCostateDirectionNext(grid_info.dt, d_next);
+}
+
+
 void SplitOCP::expandDual(const GridInfo& grid_info, 
                           const SplitDirection& d_next, 
                           SplitDirection& d, const double dts) {
@@ -251,7 +273,13 @@ void SplitOCP::expandDual(const GridInfo& grid_info,
                           const SwitchingConstraintJacobian& sc_jacobian,
                           SplitDirection& d, const double dts) {
   assert(grid_info.dt > 0);
-  contact_dynamics_.expandDual(grid_info.dt, dts, d_next, sc_jacobian, d);
+  if (state_equation_.integrationScheme() == IntegrationScheme::Midpoint) {
+    contact_dynamics_.expandDual(grid_info.dt, dts, state_equation_.dgmmNext(), 
+                                 sc_jacobian, d);
+  }
+  else {
+    contact_dynamics_.expandDual(grid_info.dt, dts, d_next, sc_jacobian, d);
+  }
   state_equation_.correctCostateDirection(d);
 }
 
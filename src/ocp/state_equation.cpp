@@ -9,8 +9,13 @@ StateEquation::StateEquation(const Robot& robot)
   : Fqq_inv_(),
     Fqq_prev_inv_(),
     Fqq_tmp_(),
+    Fqx_tmp_(),
+    Fqu_tmp_(),
     Fq_tmp_(),
+    Fv_tmp_(Eigen::VectorXd::Zero(robot.dimv())),
+    dgmm_next_(Eigen::VectorXd::Zero(robot.dimv())),
     se3_jac_inverse_(),
+    integration_scheme_(IntegrationScheme::ForwardEuler),
     has_floating_base_(robot.hasFloatingBase()) {
   if (robot.hasFloatingBase()) {
     Fqq_inv_.resize(6, 6);
@@ -19,6 +24,10 @@ StateEquation::StateEquation(const Robot& robot)
     Fqq_prev_inv_.setZero();
     Fqq_tmp_.resize(6, 6);
     Fqq_tmp_.setZero();
+    Fqx_tmp_.resize(6, 2*robot.dimv());
+    Fqx_tmp_.setZero();
+    Fqu_tmp_.resize(6, robot.dimu());
+    Fqu_tmp_.setZero();
     Fq_tmp_.resize(6);
     Fq_tmp_.setZero();
   }
@@ -29,8 +38,13 @@ StateEquation::StateEquation()
   : Fqq_inv_(),
     Fqq_prev_inv_(),
     Fqq_tmp_(),
+    Fqx_tmp_(),
+    Fqu_tmp_(),
     Fq_tmp_(),
+    Fv_tmp_(),
+    dgmm_next_(),
     se3_jac_inverse_(),
+    integration_scheme_(IntegrationScheme::ForwardEuler),
     has_floating_base_(false) {
 }
 
@@ -39,16 +53,30 @@ StateEquation::~StateEquation() {
 }
 
 
+void StateEquation::setIntegrationScheme(
+    const IntegrationScheme integration_scheme) {
+  integration_scheme_ = integration_scheme;
+}
+
+
+IntegrationScheme StateEquation::integrationScheme() const {
+  return integration_scheme_;
+}
+
+
 void StateEquation::evalStateEquation(const Robot& robot, const double dt, 
                                       const SplitSolution& s, 
                                       const Eigen::VectorXd& q_next, 
                                       const Eigen::VectorXd& v_next, 
-                                      SplitKKTResidual& kkt_residual) {
+                                      SplitKKTResidual& kkt_residual) const {
   assert(dt > 0);
   assert(q_next.size() == robot.dimq());
   assert(v_next.size() == robot.dimv());
   robot.subtractConfiguration(s.q, q_next, kkt_residual.Fq());
   kkt_residual.Fq().noalias() += dt * s.v;
+  if (integration_scheme_ == IntegrationScheme::Midpoint) {
+    kkt_residual.Fq().noalias() += (0.5*dt*dt) * s.a;
+  }
   kkt_residual.Fv() = s.v + dt * s.a - v_next;
 }
 
@@ -58,7 +86,7 @@ void StateEquation::linearizeStateEquation(const Robot& robot, const double dt,
                                            const SplitSolution& s, 
                                            const SplitSolution& s_next, 
                                            SplitKKTMatrix& kkt_matrix, 
-                                           SplitKKTResidual& kkt_residual) {
+                                           SplitKKTResidual& kkt_residual) const {
   linearizeStateEquation_impl(robot, dt, q_prev, s, s_next, kkt_matrix, kkt_residual);
 }
 
@@ -68,7 +96,7 @@ void StateEquation::linearizeStateEquation(const Robot& robot, const double dt,
                                            const SplitSolution& s, 
                                            const ImpulseSplitSolution& s_next, 
                                            SplitKKTMatrix& kkt_matrix, 
-                                           SplitKKTResidual& kkt_residual) {
+                                           SplitKKTResidual& kkt_residual) const {
   linearizeStateEquation_impl(robot, dt, q_prev, s, s_next, kkt_matrix, kkt_residual);
 }
 
@@ -4,22 +4,34 @@
 #include <stdexcept>
 #include <iostream>
 #include <cassert>
+#include <cmath>
 
 
 namespace robotoc {
 
 UnconstrBackwardCorrection::UnconstrBackwardCorrection(
-    const UnconstrParNMPC& parnmpc, const int nthreads)
+    const UnconstrParNMPC& parnmpc, const int nthreads, const int num_blocks)
   : N_(parnmpc.N()),
     nthreads_(nthreads),
+    num_blocks_(0),
+    dimv_(parnmpc.robot().dimv()),
+    dimx_(2*parnmpc.robot().dimv()),
+    block_begin_(),
     T_(parnmpc.T()),
     dt_(parnmpc.T()/parnmpc.N()),
     corrector_(parnmpc.N(), UnconstrSplitBackwardCorrection(parnmpc.robot())),
     s_new_(parnmpc.robot(), parnmpc.N()),
     aux_mat_(parnmpc.N(), Eigen::MatrixXd::Zero(2*parnmpc.robot().dimv(), 
                                                 2*parnmpc.robot().dimv())),
+    block_mat_(),
+    block_mat_tmp_(),
+    block_res_(),
+    block_res_local_(),
+    block_res_tmp_(),
     primal_step_sizes_(Eigen::VectorXd::Zero(parnmpc.N())),
-    dual_step_sizes_(Eigen::VectorXd::Zero(parnmpc.N())) {
+    dual_step_sizes_(Eigen::VectorXd::Zero(parnmpc.N())),
+    t_prev_(0),
+    is_aux_mat_initialized_(false) {
   try {
     if (nthreads <= 0) {
       throw std::out_of_range("invalid value: nthreads must be positive!");
@@ -29,19 +41,31 @@ UnconstrBackwardCorrection::UnconstrBackwardCorrection(
     std::cerr << e.what() << '\n';
     std::exit(EXIT_FAILURE);
   }
+  setNumBlocks(num_blocks);
 }
 
 
 UnconstrBackwardCorrection::UnconstrBackwardCorrection()
   : N_(0),
     nthreads_(0),
+    num_blocks_(0),
+    dimv_(0),
+    dimx_(0),
+    block_begin_(),
     T_(0),
     dt_(0),
     corrector_(),
     s_new_(),
     aux_mat_(),
+    block_mat_(),
+    block_mat_tmp_(),
+    block_res_(),
+    block_res_local_(),
+    block_res_tmp_(),
     primal_step_sizes_(),
-    dual_step_sizes_() {
+    dual_step_sizes_(),
+    t_prev_(0),
+    is_aux_mat_initialized_(false) {
 }
 
 
@@ -49,21 +73,72 @@ UnconstrBackwardCorrection::~UnconstrBackwardCorrection() {
 }
 
 
+void UnconstrBackwardCorrection::setNumBlocks(const int num_blocks) {
+  try {
+    if (num_blocks < 0) {
+      throw std::out_of_range("invalid value: num_blocks must be non-negative!");
+    }
+    if (num_blocks > N_) {
+      throw std::out_of_range("invalid value: num_blocks must not be larger than N!");
+    }
+  }
+  catch(const std::exception& e) {
+    std::cerr << e.what() << '\n';
+    std::exit(EXIT_FAILURE);
+  }
+  num_blocks_ = (num_blocks > 0) ? num_blocks : N_;
+  block_begin_.resize(num_blocks_+1);
+  for (int i=0; i<=num_blocks_; ++i) {
+    block_begin_[i] = (i*N_) / num_blocks_;
+  }
+  block_mat_.resize(num_blocks_, Eigen::MatrixXd::Zero(dimx_, dimx_));
+  block_mat_tmp_.resize(num_blocks_, Eigen::MatrixXd::Zero(dimx_, dimx_));
+  block_res_.resize(num_blocks_+1, Eigen::VectorXd::Zero(dimx_));
+  block_res_local_.resize(num_blocks_, Eigen::VectorXd::Zero(dimx_));
+  block_res_tmp_.resize(num_blocks_, Eigen::VectorXd::Zero(dimx_));
+}
+
+
+int UnconstrBackwardCorrection::numBlocks() const {
+  return num_blocks_;
+}
+
+
 void UnconstrBackwardCorrection::initAuxMat(aligned_vector<Robot>& robots, 
                                             UnconstrParNMPC& parnmpc, 
                                             const double t, const Solution& s, 
                                             KKTMatrix& kkt_matrix,
-                                            KKTResidual& kkt_residual) {
+                                            KKTResidual& kkt_residual,
+                                            const AuxMatInitialization method) {
   parnmpc.discretize(t);
-  parnmpc.terminal.evalTerminalCostHessian(robots[0], parnmpc.gridInfo(N_), 
-                                           s[N_-1], kkt_matrix[0], 
-                                           kkt_residual[0]);
-  #pragma omp parallel for num_threads(nthreads_)
-  for (int i=0; i<N_; ++i) {
-    aux_mat_[i] = kkt_matrix[0].Qxx;
+  switch (method) {
+    case AuxMatInitialization::TerminalLQR:
+      initAuxMatByTerminalLQR(robots, parnmpc, s, kkt_matrix, kkt_residual);
+      break;
+    case AuxMatInitialization::Riccati:
+      initAuxMatByRiccati(robots, parnmpc, s, kkt_matrix, kkt_residual);
+      break;
+    case AuxMatInitialization::Shift:
+      if (!shiftAuxMat(t)) {
+        initAuxMatByTerminalCostHessian(robots, parnmpc, s, kkt_matrix, 
+                                        kkt_residual);
+      }
+      break;
+    default:
+      initAuxMatByTerminalCostHessian(robots, parnmpc, s, kkt_matrix, 
+                                      kkt_residual);
+      break;
   }
-  kkt_matrix[0].setZero();
-  kkt_residual[0].setZero();
+  t_prev_ = t;
+  is_aux_mat_initialized_ = true;
+}
+
+
+const Eigen::MatrixXd& UnconstrBackwardCorrection::auxMat(
+    const int stage) const {
+  assert(stage >= 0);
+  assert(stage < N_);
+  return aux_mat_[stage];
 }
 
 
@@ -77,66 +152,292 @@ void UnconstrBackwardCorrection::coarseUpdate(aligned_vector<Robot>& robots,
                                               const Solution& s) {
   parnmpc.discretize(t);
   #pragma omp parallel for num_threads(nthreads_)
+  for (int block=0; block<num_blocks_; ++block) {
+    // The stages in a block are solved serially backward so that the exact 
+    // cost-to-go Hessians are used except at the block boundary.
+    for (int i=block_begin_[block+1]-1; i>=block_begin_[block]; --i) {
+      if (i == 0) {
+        parnmpc[i].computeKKTSystem(robots[omp_get_thread_num()], 
+                                    parnmpc.gridInfo(i), q, v, s[i], s[i+1], 
+                                    kkt_matrix[i], kkt_residual[i]);
+        corrector_[i].coarseUpdate(aux_mat_[i+1], dt_, kkt_matrix[i], 
+                                   kkt_residual[i], s[i], s_new_[i]);
+      }
+      else if (i < N_-1) {
+        parnmpc[i].computeKKTSystem(robots[omp_get_thread_num()], 
+                                    parnmpc.gridInfo(i), s[i-1].q, s[i-1].v, 
+                                    s[i], s[i+1], kkt_matrix[i], kkt_residual[i]);
+        corrector_[i].coarseUpdate(aux_mat_[i+1], dt_, kkt_matrix[i], 
+                                   kkt_residual[i], s[i], s_new_[i]);
+      }
+      else {
+        parnmpc.terminal.computeKKTSystem(robots[omp_get_thread_num()], 
+                                          parnmpc.gridInfo(i), s[i-1].q, s[i-1].v, 
+                                          s[i], kkt_matrix[i], kkt_residual[i]);
+        corrector_[i].coarseUpdate(dt_, kkt_matrix[i], kkt_residual[i], 
+                                   s[i], s_new_[i]);
+      }
+      // The auxiliary matrix of the first stage of the block is read by the 
+      // previous block and is therefore updated in backwardCorrection().
+      if (i > block_begin_[block]) {
+        aux_mat_[i] = - corrector_[i].auxMat();
+      }
+    }
+  }
+}
+
+
+void UnconstrBackwardCorrection::backwardCorrection(UnconstrParNMPC& parnmpc, 
+                                                    const Solution& s, 
+                                                    const KKTMatrix& kkt_matrix, 
+                                                    const KKTResidual& kkt_residual,
+                                                    Direction& d) {
+  // The deviation of the costates at the beginning of each block is first 
+  // computed in parallel by assuming no deviation at the end of the block. 
+  // Only the deviations at the block boundaries are then propagated serially.
+  #pragma omp parallel for num_threads(nthreads_)
+  for (int block=1; block<num_blocks_; ++block) {
+    computeBlockCostateResidual(s, block);
+  }
+  block_res_[num_blocks_].setZero();
+  for (int block=num_blocks_-1; block>=1; --block) {
+    block_res_[block] = block_res_local_[block];
+    if (block < num_blocks_-1) {
+      block_res_[block].noalias() += block_mat_[block] * block_res_[block+1];
+    }
+  }
+  #pragma omp parallel for num_threads(nthreads_) 
+  for (int block=0; block<num_blocks_; ++block) {
+    for (int i=block_begin_[block+1]-1; i>=block_begin_[block]; --i) {
+      if (i < N_-1) {
+        if (i == block_begin_[block+1]-1) {
+          corrector_[i].backwardCorrectionSerial(block_res_[block+1], 
+                                                 s_new_[i]);
+        }
+        else {
+          corrector_[i].backwardCorrectionSerial(s[i+1], s_new_[i+1], 
+                                                 s_new_[i]);
+        }
+        corrector_[i].backwardCorrectionParallel(s_new_[i]);
+      }
+    }
+  }
+  // The forward correction is split into the blocks in the same way.
+  #pragma omp parallel for num_threads(nthreads_)
+  for (int block=0; block<num_blocks_-1; ++block) {
+    computeBlockStateResidual(s, block);
+  }
+  block_res_[0].setZero();
+  for (int block=0; block<num_blocks_-1; ++block) {
+    block_res_[block+1] = block_res_local_[block];
+    if (block > 0) {
+      block_res_[block+1].noalias() += block_mat_[block] * block_res_[block];
+    }
+  }
+  #pragma omp parallel for num_threads(nthreads_)
+  for (int block=0; block<num_blocks_; ++block) {
+    for (int i=block_begin_[block]; i<block_begin_[block+1]; ++i) {
+      if (i > 0) {
+        if (i == block_begin_[block]) {
+          corrector_[i].forwardCorrectionSerial(block_res_[block], s_new_[i]);
+        }
+        else {
+          corrector_[i].forwardCorrectionSerial(s[i-1], s_new_[i-1], 
+                                                s_new_[i]);
+        }
+        corrector_[i].forwardCorrectionParallel(s_new_[i]);
+        aux_mat_[i] = - corrector_[i].auxMat();
+      }
+      UnconstrSplitBackwardCorrection::computeDirection(s[i], s_new_[i], d[i]);
+      if (i < N_-1) {
+        parnmpc[i].expandPrimalAndDual(dt_, s[i], kkt_matrix[i], 
+                                       kkt_residual[i], d[i]);
+        primal_step_sizes_.coeffRef(i) = parnmpc[i].maxPrimalStepSize();
+        dual_step_sizes_.coeffRef(i)   = parnmpc[i].maxDualStepSize();
+      }
+      else {
+        parnmpc.terminal.expandPrimalAndDual(dt_, s[i], kkt_matrix[i], 
+                                             kkt_residual[i], d[i]);
+        primal_step_sizes_.coeffRef(i) = parnmpc.terminal.maxPrimalStepSize();
+        dual_step_sizes_.coeffRef(i)   = parnmpc.terminal.maxDualStepSize();
+      }
+    }
+  }
+}
+
+
+void UnconstrBackwardCorrection::initAuxMatByTerminalCostHessian(
+    aligned_vector<Robot>& robots, UnconstrParNMPC& parnmpc, 
+    const Solution& s, KKTMatrix& kkt_matrix, KKTResidual& kkt_residual) {
+  parnmpc.terminal.evalTerminalCostHessian(robots[0], parnmpc.gridInfo(N_), 
+                                           s[N_-1], kkt_matrix[0], 
+                                           kkt_residual[0]);
+  #pragma omp parallel for num_threads(nthreads_)
   for (int i=0; i<N_; ++i) {
-    if (i == 0) {
-      parnmpc[i].computeKKTSystem(robots[omp_get_thread_num()], 
-                                  parnmpc.gridInfo(i), q, v, s[i], s[i+1], 
-                                  kkt_matrix[i], kkt_residual[i]);
-      corrector_[i].coarseUpdate(aux_mat_[i+1], dt_, kkt_matrix[i], 
-                                 kkt_residual[i], s[i], s_new_[i]);
+    aux_mat_[i] = kkt_matrix[0].Qxx;
+  }
+  kkt_matrix[0].setZero();
+  kkt_residual[0].setZero();
+}
+
+
+void UnconstrBackwardCorrection::initAuxMatByTerminalLQR(
+    aligned_vector<Robot>& robots, UnconstrParNMPC& parnmpc, 
+    const Solution& s, KKTMatrix& kkt_matrix, KKTResidual& kkt_residual) {
+  // The stage before the terminal stage is used to linearize the dynamics 
+  // and the stage cost. The first stage is excluded since it depends on the 
+  // initial state.
+  if (N_ < 3) {
+    initAuxMatByTerminalCostHessian(robots, parnmpc, s, kkt_matrix, 
+                                    kkt_residual);
+    return;
+  }
+  parnmpc.terminal.evalTerminalCostHessian(robots[0], parnmpc.gridInfo(N_), 
+                                           s[N_-1], kkt_matrix[0], 
+                                           kkt_residual[0]);
+  Eigen::MatrixXd P = kkt_matrix[0].Qxx;
+  const int stage = N_ - 2;
+  parnmpc[stage].computeKKTSystem(robots[0], parnmpc.gridInfo(stage), 
+                                  s[stage-1].q, s[stage-1].v, s[stage], 
+                                  s[stage+1], kkt_matrix[stage], 
+                                  kkt_residual[stage]);
+  // Fixed-point iteration of the Riccati recursion, i.e., the value 
+  // iteration of the infinite-horizon LQR problem.
+  constexpr int max_iter = 100;
+  constexpr double tol = 1.0e-08;
+  for (int iter=0; iter<max_iter; ++iter) {
+    corrector_[stage].coarseUpdate(P, dt_, kkt_matrix[stage], 
+                                   kkt_residual[stage], s[stage], 
+                                   s_new_[stage]);
+    const double diff = (P+corrector_[stage].auxMat()).lpNorm<Eigen::Infinity>();
+    P = - corrector_[stage].auxMat();
+    if (diff < tol * (1.0+P.lpNorm<Eigen::Infinity>())) {
+      break;
     }
-    else if (i < N_-1) {
+  }
+  #pragma omp parallel for num_threads(nthreads_)
+  for (int i=0; i<N_; ++i) {
+    aux_mat_[i] = P;
+  }
+  kkt_matrix[0].setZero();
+  kkt_residual[0].setZero();
+}
+
+
+void UnconstrBackwardCorrection::initAuxMatByRiccati(
+    aligned_vector<Robot>& robots, UnconstrParNMPC& parnmpc, 
+    const Solution& s, KKTMatrix& kkt_matrix, KKTResidual& kkt_residual) {
+  // The auxiliary matrix of the first stage is not used in the coarse update 
+  // and hence the first stage, which depends on the initial state, is skipped.
+  #pragma omp parallel for num_threads(nthreads_)
+  for (int i=1; i<N_; ++i) {
+    if (i < N_-1) {
       parnmpc[i].computeKKTSystem(robots[omp_get_thread_num()], 
                                   parnmpc.gridInfo(i), s[i-1].q, s[i-1].v, 
                                   s[i], s[i+1], kkt_matrix[i], kkt_residual[i]);
-      corrector_[i].coarseUpdate(aux_mat_[i+1], dt_, kkt_matrix[i], 
-                                 kkt_residual[i], s[i], s_new_[i]);
     }
     else {
       parnmpc.terminal.computeKKTSystem(robots[omp_get_thread_num()], 
                                         parnmpc.gridInfo(i), s[i-1].q, s[i-1].v, 
                                         s[i], kkt_matrix[i], kkt_residual[i]);
-      corrector_[i].coarseUpdate(dt_, kkt_matrix[i], kkt_residual[i], 
-                                 s[i], s_new_[i]);
     }
   }
+  corrector_[N_-1].coarseUpdate(dt_, kkt_matrix[N_-1], kkt_residual[N_-1], 
+                                s[N_-1], s_new_[N_-1]);
+  aux_mat_[N_-1] = - corrector_[N_-1].auxMat();
+  for (int i=N_-2; i>=1; --i) {
+    corrector_[i].coarseUpdate(aux_mat_[i+1], dt_, kkt_matrix[i], 
+                               kkt_residual[i], s[i], s_new_[i]);
+    aux_mat_[i] = - corrector_[i].auxMat();
+  }
+  if (N_ > 1) {
+    aux_mat_[0] = aux_mat_[1];
+  }
 }
 
 
-void UnconstrBackwardCorrection::backwardCorrection(UnconstrParNMPC& parnmpc, 
-                                                    const Solution& s, 
-                                                    const KKTMatrix& kkt_matrix, 
-                                                    const KKTResidual& kkt_residual,
-                                                    Direction& d) {
-  for (int i=N_-2; i>=0; --i) {
-    corrector_[i].backwardCorrectionSerial(s[i+1], s_new_[i+1], s_new_[i]);
-  }
-  #pragma omp parallel for num_threads(nthreads_) 
-  for (int i=N_-2; i>=0; --i) {
-    corrector_[i].backwardCorrectionParallel(s_new_[i]);
+bool UnconstrBackwardCorrection::shiftAuxMat(const double t) {
+  if (!is_aux_mat_initialized_) {
+    return false;
   }
-  for (int i=1; i<N_; ++i) {
-    corrector_[i].forwardCorrectionSerial(s[i-1], s_new_[i-1], s_new_[i]);
+  const int shift = std::floor((t-t_prev_)/dt_+0.5);
+  if (shift < 0 || shift >= N_) {
+    return false;
   }
-  #pragma omp parallel for num_threads(nthreads_)
+  // The stages are shifted forward in place and the tail stages are filled 
+  // by the auxiliary matrix of the last stage.
   for (int i=0; i<N_; ++i) {
-    if (i > 0) {
-      corrector_[i].forwardCorrectionParallel(s_new_[i]);
-      aux_mat_[i] = - corrector_[i].auxMat();
+    if (i+shift < N_) {
+      aux_mat_[i] = aux_mat_[i+shift];
+    }
+    else {
+      aux_mat_[i] = aux_mat_[N_-1];
     }
-    UnconstrSplitBackwardCorrection::computeDirection(s[i], s_new_[i], d[i]);
+  }
+  return true;
+}
+
+
+void UnconstrBackwardCorrection::computeBlockCostateResidual(
+    const Solution& s, const int block) {
+  // Computes the deviation of the costates at the beginning of the block 
+  // with no deviation at the end of the block and the sensitivity of it to 
+  // the deviation at the end of the block. The sensitivity of the last block 
+  // is not needed since there is no deviation after the terminal stage.
+  const bool compute_mat = (block < num_blocks_-1);
+  Eigen::VectorXd& res = block_res_local_[block];
+  Eigen::VectorXd& res_tmp = block_res_tmp_[block];
+  Eigen::MatrixXd& mat = block_mat_[block];
+  Eigen::MatrixXd& mat_tmp = block_mat_tmp_[block];
+  res.setZero();
+  for (int i=block_begin_[block+1]-1; i>=block_begin_[block]; --i) {
+    res_tmp.head(dimv_) = s_new_[i].lmd - s[i].lmd;
+    res_tmp.tail(dimv_) = s_new_[i].gmm - s[i].gmm;
     if (i < N_-1) {
-      parnmpc[i].expandPrimalAndDual(dt_, s[i], kkt_matrix[i], 
-                                     kkt_residual[i], d[i]);
-      primal_step_sizes_.coeffRef(i) = parnmpc[i].maxPrimalStepSize();
-      dual_step_sizes_.coeffRef(i)   = parnmpc[i].maxDualStepSize();
+      res_tmp.noalias() -= corrector_[i].backwardCorrectionMat() * res;
+      if (compute_mat) {
+        if (i == block_begin_[block+1]-1) {
+          mat = - corrector_[i].backwardCorrectionMat();
+        }
+        else {
+          mat_tmp.noalias() = - corrector_[i].backwardCorrectionMat() * mat;
+          mat.swap(mat_tmp);
+        }
+      }
     }
-    else {
-      parnmpc.terminal.expandPrimalAndDual(dt_, s[i], kkt_matrix[i], 
-                                           kkt_residual[i], d[i]);
-      primal_step_sizes_.coeffRef(i) = parnmpc.terminal.maxPrimalStepSize();
-      dual_step_sizes_.coeffRef(i)   = parnmpc.terminal.maxDualStepSize();
+    res.swap(res_tmp);
+  }
+}
+
+
+void UnconstrBackwardCorrection::computeBlockStateResidual(
+    const Solution& s, const int block) {
+  // Computes the deviation of the state at the end of the block with no 
+  // deviation before the beginning of the block and the sensitivity of it to 
+  // the deviation before the beginning of the block. The sensitivity of the 
+  // first block is not needed since the initial state is fixed.
+  const bool compute_mat = (block > 0);
+  Eigen::VectorXd& res = block_res_local_[block];
+  Eigen::VectorXd& res_tmp = block_res_tmp_[block];
+  Eigen::MatrixXd& mat = block_mat_[block];
+  Eigen::MatrixXd& mat_tmp = block_mat_tmp_[block];
+  res.setZero();
+  for (int i=block_begin_[block]; i<block_begin_[block+1]; ++i) {
+    res_tmp.head(dimv_) = s_new_[i].q - s[i].q;
+    res_tmp.tail(dimv_) = s_new_[i].v - s[i].v;
+    if (i > 0) {
+      res_tmp.noalias() -= corrector_[i].forwardCorrectionMat() * res;
+      if (compute_mat) {
+        if (i == block_begin_[block]) {
+          mat = - corrector_[i].forwardCorrectionMat();
+        }
+        else {
+          mat_tmp.noalias() = - corrector_[i].forwardCorrectionMat() * mat;
+          mat.swap(mat_tmp);
+        }
+      }
     }
+    res.swap(res_tmp);
   }
 }
 
@@ -80,12 +80,34 @@ UnconstrSplitBackwardCorrection::auxMat() const {
 }
 
 
+const Eigen::Block<const Eigen::MatrixXd> 
+UnconstrSplitBackwardCorrection::backwardCorrectionMat() const {
+  return kkt_mat_inv_.block(0, dimkkt_-dimx_, dimx_, dimx_);
+}
+
+
+const Eigen::Block<const Eigen::MatrixXd> 
+UnconstrSplitBackwardCorrection::forwardCorrectionMat() const {
+  return kkt_mat_inv_.block(dimkkt_-dimx_, 0, dimx_, dimx_);
+}
+
+
 void UnconstrSplitBackwardCorrection::backwardCorrectionSerial(
     const SplitSolution& s_next, const SplitSolution& s_new_next,
     SplitSolution& s_new) {
   x_res_.head(dimv_) = s_new_next.lmd - s_next.lmd;
   x_res_.tail(dimv_) = s_new_next.gmm - s_next.gmm;
-  dx_.noalias() = kkt_mat_inv_.block(0, dimkkt_-dimx_, dimx_, dimx_) * x_res_;
+  dx_.noalias() = backwardCorrectionMat() * x_res_;
+  s_new.lmd.noalias() -= dx_.head(dimv_);
+  s_new.gmm.noalias() -= dx_.tail(dimv_);
+}
+
+
+void UnconstrSplitBackwardCorrection::backwardCorrectionSerial(
+    const Eigen::VectorXd& x_res, SplitSolution& s_new) {
+  assert(x_res.size() == dimx_);
+  x_res_ = x_res;
+  dx_.noalias() = backwardCorrectionMat() * x_res_;
   s_new.lmd.noalias() -= dx_.head(dimv_);
   s_new.gmm.noalias() -= dx_.tail(dimv_);
 }
@@ -106,7 +128,17 @@ void UnconstrSplitBackwardCorrection::forwardCorrectionSerial(
     SplitSolution& s_new) {
   x_res_.head(dimv_) = s_new_prev.q - s_prev.q;
   x_res_.tail(dimv_) = s_new_prev.v - s_prev.v;
-  dx_.noalias() = kkt_mat_inv_.block(dimkkt_-dimx_, 0, dimx_, dimx_) * x_res_;
+  dx_.noalias() = forwardCorrectionMat() * x_res_;
+  s_new.q.noalias() -= dx_.head(dimv_);
+  s_new.v.noalias() -= dx_.tail(dimv_);
+}
+
+
+void UnconstrSplitBackwardCorrection::forwardCorrectionSerial(
+    const Eigen::VectorXd& x_res, SplitSolution& s_new) {
+  assert(x_res.size() == dimx_);
+  x_res_ = x_res;
+  dx_.noalias() = forwardCorrectionMat() * x_res_;
   s_new.q.noalias() -= dx_.head(dimv_);
   s_new.v.noalias() -= dx_.tail(dimv_);
 }
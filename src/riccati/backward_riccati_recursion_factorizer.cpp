@@ -33,15 +33,41 @@ void BackwardRiccatiRecursionFactorizer::factorizeKKTMatrix(
     SplitKKTMatrix& kkt_matrix, SplitKKTResidual& kkt_residual) {
   AtP_.noalias() = kkt_matrix.Fxx.transpose() * riccati_next.P;
   BtP_.noalias() = kkt_matrix.Fvu.transpose() * riccati_next.P.bottomRows(dimv_);
-  // Factorize F
-  kkt_matrix.Qxx.noalias() += AtP_ * kkt_matrix.Fxx;
+  // Fqu is nonzero only under IntegrationScheme::Midpoint.
+  const bool has_Fqu = (kkt_matrix.Fqu.size() > 0);
+  if (has_Fqu) {
+    BtP_.noalias() += kkt_matrix.Fqu.transpose() * riccati_next.P.topRows(dimv_);
+  }
+  if (kkt_matrix.isLowerTriangularHessian()) {
+    // Only the lower triangular parts of F and G are updated.
+    kkt_matrix.Qxx.triangularView<Eigen::Lower>() += AtP_ * kkt_matrix.Fxx;
+    kkt_matrix.Quu.triangularView<Eigen::Lower>() 
+        += BtP_.rightCols(dimv_) * kkt_matrix.Fvu;
+    if (has_Fqu) {
+      kkt_matrix.Quu.triangularView<Eigen::Lower>() 
+          += BtP_.leftCols(dimv_) * kkt_matrix.Fqu;
+    }
+  }
+  else {
+    // Factorize F
+    kkt_matrix.Qxx.noalias() += AtP_ * kkt_matrix.Fxx;
+    // Factorize G
+    kkt_matrix.Quu.noalias() += BtP_.rightCols(dimv_) * kkt_matrix.Fvu;
+    if (has_Fqu) {
+      kkt_matrix.Quu.noalias() += BtP_.leftCols(dimv_) * kkt_matrix.Fqu;
+    }
+  }
   // Factorize H
   kkt_matrix.Qxu.noalias() += AtP_.rightCols(dimv_) * kkt_matrix.Fvu;
-  // Factorize G
-  kkt_matrix.Quu.noalias() += BtP_.rightCols(dimv_) * kkt_matrix.Fvu;
+  if (has_Fqu) {
+    kkt_matrix.Qxu.noalias() += AtP_.leftCols(dimv_) * kkt_matrix.Fqu;
+  }
   // Factorize vector term
   kkt_residual.lu.noalias() += BtP_ * kkt_residual.Fx;
   kkt_residual.lu.noalias() -= kkt_matrix.Fvu.transpose() * riccati_next.sv();
+  if (has_Fqu) {
+    kkt_residual.lu.noalias() -= kkt_matrix.Fqu.transpose() * riccati_next.sq();
+  }
 }
 
 
@@ -55,9 +81,16 @@ void BackwardRiccatiRecursionFactorizer::factorizeHamiltonian(
   riccati.psi_u.noalias() += kkt_matrix.hu;
   riccati.psi_x.noalias() += kkt_matrix.Fxx.transpose() * riccati_next.Psi;
   riccati.psi_u.noalias() += kkt_matrix.Fvu.transpose() * riccati_next.Psi.tail(dimv_);
+  const bool has_Fqu = (kkt_matrix.Fqu.size() > 0);
+  if (has_Fqu) {
+    riccati.psi_u.noalias() += kkt_matrix.Fqu.transpose() * riccati_next.Psi.head(dimv_);
+  }
   if (has_next_sto_phase) {
     riccati.phi_x.noalias() = kkt_matrix.Fxx.transpose() * riccati_next.Phi;
     riccati.phi_u.noalias() = kkt_matrix.Fvu.transpose() * riccati_next.Phi.tail(dimv_);
+    if (has_Fqu) {
+      riccati.phi_u.noalias() += kkt_matrix.Fqu.transpose() * riccati_next.Phi.head(dimv_);
+    }
   }
   else {
     riccati.phi_x.setZero();
@@ -79,10 +112,19 @@ void BackwardRiccatiRecursionFactorizer::factorizeRiccatiFactorization(
     const SplitRiccatiFactorization& riccati_next, SplitKKTMatrix& kkt_matrix, 
     const SplitKKTResidual& kkt_residual, const LQRPolicy& lqr_policy, 
     SplitRiccatiFactorization& riccati) {
-  GK_.noalias() = kkt_matrix.Quu * lqr_policy.K; 
-  kkt_matrix.Qxx.noalias() -= lqr_policy.K.transpose() * GK_;
-  // Riccati factorization matrix with preserving the symmetry
-  riccati.P = 0.5 * (kkt_matrix.Qxx + kkt_matrix.Qxx.transpose());
+  if (kkt_matrix.isLowerTriangularHessian()) {
+    GK_.noalias() = kkt_matrix.Quu.selfadjointView<Eigen::Lower>() * lqr_policy.K; 
+    kkt_matrix.Qxx.triangularView<Eigen::Lower>() 
+        -= lqr_policy.K.transpose() * GK_;
+    // The symmetry is preserved by the lower triangular storage
+    riccati.P = kkt_matrix.Qxx.selfadjointView<Eigen::Lower>();
+  }
+  else {
+    GK_.noalias() = kkt_matrix.Quu * lqr_policy.K; 
+    kkt_matrix.Qxx.noalias() -= lqr_policy.K.transpose() * GK_;
+    // Riccati factorization matrix with preserving the symmetry
+    riccati.P = 0.5 * (kkt_matrix.Qxx + kkt_matrix.Qxx.transpose());
+  }
   // Riccati factorization vector
   riccati.s.noalias()  = kkt_matrix.Fxx.transpose() * riccati_next.s;
   riccati.s.noalias() -= AtP_ * kkt_residual.Fx;
@@ -0,0 +1,382 @@
+#include "robotoc/riccati/partial_condensing.hpp"
+
+#include <omp.h>
+#include <stdexcept>
+#include <iostream>
+#include <cassert>
+#include <cmath>
+#include <algorithm>
+
+
+namespace robotoc {
+
+PartialCondensing::PartialCondensing(const OCP& ocp, const int block_size)
+  : dimv_(ocp.robot().dimv()),
+    dimx_(2*ocp.robot().dimv()),
+    dimu_(ocp.robot().dimu()),
+    block_size_(1),
+    num_blocks_(0),
+    blocks_(),
+    block_index_(ocp.N(), -1),
+    AtP_(Eigen::MatrixXd::Zero(2*ocp.robot().dimv(), 2*ocp.robot().dimv())) {
+  try {
+    if (block_size < 0) {
+      throw std::out_of_range("invalid argument: block_size must be non-negative!");
+    }
+  }
+  catch(const std::exception& e) {
+    std::cerr << e.what() << '\n';
+    std::exit(EXIT_FAILURE);
+  }
+  block_size_ = (block_size == 0) ? blockSizeHeuristic(dimx_, dimu_)
+                                  : block_size;
+}
+
+
+PartialCondensing::PartialCondensing()
+  : dimv_(0),
+    dimx_(0),
+    dimu_(0),
+    block_size_(1),
+    num_blocks_(0),
+    blocks_(),
+    block_index_(),
+    AtP_() {
+}
+
+
+PartialCondensing::~PartialCondensing() {
+}
+
+
+void PartialCondensing::setBlockSize(const int block_size) {
+  try {
+    if (block_size < 0) {
+      throw std::out_of_range("invalid argument: block_size must be non-negative!");
+    }
+  }
+  catch(const std::exception& e) {
+    std::cerr << e.what() << '\n';
+    std::exit(EXIT_FAILURE);
+  }
+  block_size_ = (block_size == 0) ? blockSizeHeuristic(dimx_, dimu_)
+                                  : block_size;
+  num_blocks_ = 0;
+  std::fill(block_index_.begin(), block_index_.end(), -1);
+}
+
+
+int PartialCondensing::blockSize() const {
+  return block_size_;
+}
+
+
+bool PartialCondensing::isEnabled() const {
+  return (block_size_ > 1);
+}
+
+
+int PartialCondensing::defaultBlockSize(const Robot& robot) {
+  return blockSizeHeuristic(2*robot.dimv(), robot.dimu());
+}
+
+
+void PartialCondensing::partition(const OCP& ocp) {
+  const int N = ocp.discrete().N();
+  if (static_cast<int>(block_index_.size()) < N) {
+    block_index_.resize(N, -1);
+  }
+  std::fill(block_index_.begin(), block_index_.end(), -1);
+  num_blocks_ = 0;
+  if (!isEnabled()) return;
+  int i = 0;
+  while (i < N) {
+    if (!isRegularTimeStage(ocp, i)) {
+      ++i;
+      continue;
+    }
+    int size = 1;
+    while (size < block_size_ && i+size < N && isRegularTimeStage(ocp, i+size)) {
+      ++size;
+    }
+    if (size > 1) {
+      if (static_cast<int>(blocks_.size()) <= num_blocks_) {
+        blocks_.emplace_back();
+      }
+      CondensedStage& block = blocks_[num_blocks_];
+      if (block.size != size || block.Fxu.cols() != size*dimu_) {
+        resizeBlock(block, size);
+      }
+      block.begin = i;
+      for (int j=0; j<size; ++j) {
+        block_index_[i+j] = num_blocks_;
+      }
+      ++num_blocks_;
+    }
+    i += size;
+  }
+}
+
+
+int PartialCondensing::numBlocks() const {
+  return num_blocks_;
+}
+
+
+bool PartialCondensing::isBlockBegin(const int time_stage) const {
+  if (time_stage < 0 || time_stage >= static_cast<int>(block_index_.size())) return false;
+  const int block_index = block_index_[time_stage];
+  return (block_index >= 0 && blocks_[block_index].begin == time_stage);
+}
+
+
+bool PartialCondensing::isBlockEnd(const int time_stage) const {
+  if (time_stage < 0 || time_stage >= static_cast<int>(block_index_.size())) return false;
+  const int block_index = block_index_[time_stage];
+  return (block_index >= 0 && blocks_[block_index].begin
+                                + blocks_[block_index].size - 1 == time_stage);
+}
+
+
+bool PartialCondensing::isBlockInterior(const int time_stage) const {
+  if (time_stage < 0 || time_stage >= static_cast<int>(block_index_.size())) return false;
+  const int block_index = block_index_[time_stage];
+  return (block_index >= 0 && blocks_[block_index].begin != time_stage);
+}
+
+
+int PartialCondensing::blockBegin(const int time_stage) const {
+  assert(time_stage >= 0);
+  assert(time_stage < static_cast<int>(block_index_.size()));
+  assert(block_index_[time_stage] >= 0);
+  return blocks_[block_index_[time_stage]].begin;
+}
+
+
+int PartialCondensing::blockEnd(const int time_stage) const {
+  assert(time_stage >= 0);
+  assert(time_stage < static_cast<int>(block_index_.size()));
+  assert(block_index_[time_stage] >= 0);
+  const CondensedStage& block = blocks_[block_index_[time_stage]];
+  return block.begin + block.size - 1;
+}
+
+
+void PartialCondensing::condense(const KKTMatrix& kkt_matrix,
+                                 const KKTResidual& kkt_residual,
+                                 const int nthreads) {
+  #pragma omp parallel for num_threads(nthreads)
+  for (int i=0; i<num_blocks_; ++i) {
+    condenseBlock(kkt_matrix, kkt_residual, blocks_[i]);
+  }
+}
+
+
+void PartialCondensing::backwardRiccatiRecursion(
+    const int time_stage, const SplitRiccatiFactorization& riccati_next,
+    SplitRiccatiFactorization& riccati, LQRPolicy& lqr_policy) {
+  assert(isBlockEnd(time_stage));
+  CondensedStage& block = blocks_[block_index_[time_stage]];
+  block.P_next = riccati_next.P;
+  block.s_next = riccati_next.s;
+  AtP_.noalias() = block.Fxx.transpose() * riccati_next.P;
+  block.BtP.noalias() = block.Fxu.transpose() * riccati_next.P;
+  block.Qxx.noalias() += AtP_ * block.Fxx;
+  block.Qxu.noalias() += AtP_ * block.Fxu;
+  block.Quu.noalias() += block.BtP * block.Fxu;
+  block.lu.noalias() += block.BtP * block.Fx;
+  block.lu.noalias() -= block.Fxu.transpose() * riccati_next.s;
+  block.llt.compute(block.Quu);
+  assert(block.llt.info() == Eigen::Success);
+  block.K.noalias() = - block.llt.solve(block.Qxu.transpose());
+  block.k.noalias() = - block.llt.solve(block.lu);
+  assert(!block.K.hasNaN());
+  assert(!block.k.hasNaN());
+  block.GK.noalias() = block.Quu * block.K;
+  block.Qxx.noalias() -= block.K.transpose() * block.GK;
+  riccati.P = 0.5 * (block.Qxx + block.Qxx.transpose());
+  riccati.s.noalias()  = block.Fxx.transpose() * riccati_next.s;
+  riccati.s.noalias() -= AtP_ * block.Fx;
+  riccati.s.noalias() -= block.lx;
+  riccati.s.noalias() -= block.Qxu * block.k;
+  riccati.Psi.setZero();
+  riccati.xi = 0.;
+  riccati.chi = 0.;
+  riccati.eta = 0.;
+  // The policy of the first stage of the block is exact. The other stages of
+  // the block have no state feedback policy w.r.t. their own states.
+  lqr_policy.K = block.K.topRows(dimu_);
+  lqr_policy.k = block.k.head(dimu_);
+  lqr_policy.T.setZero();
+  lqr_policy.W.setZero();
+}
+
+
+void PartialCondensing::expandDirection(const int time_stage,
+                                        const KKTMatrix& kkt_matrix,
+                                        const KKTResidual& kkt_residual,
+                                        Direction& d) const {
+  assert(isBlockBegin(time_stage));
+  const CondensedStage& block = blocks_[block_index_[time_stage]];
+  const int begin = block.begin;
+  const int end = block.begin + block.size;
+  const Eigen::VectorXd& dx0 = d[begin].dx;
+  for (int j=0; j<block.size; ++j) {
+    const int i = begin + j;
+    d[i].du.noalias()  = block.K.middleRows(j*dimu_, dimu_) * dx0;
+    d[i].du.noalias() += block.k.segment(j*dimu_, dimu_);
+    d[i+1].dx = kkt_residual[i].Fx;
+    d[i+1].dx.noalias()   += kkt_matrix[i].Fxx * d[i].dx;
+    d[i+1].dv().noalias() += kkt_matrix[i].Fvu * d[i].du;
+    if (kkt_matrix[i].Fqu.size() > 0) {
+      d[i+1].dq().noalias() += kkt_matrix[i].Fqu * d[i].du;
+    }
+    d[i+1].dts = d[i].dts;
+    d[i+1].dts_next = d[i].dts_next;
+  }
+  // Costate directions of the interior stages by the adjoint recursion. The
+  // costate direction of the stage after the block is the same as that
+  // computed in RiccatiRecursion::computeDirection().
+  d[end].dlmdgmm.noalias() = block.P_next * d[end].dx - block.s_next;
+  for (int i=end-1; i>begin; --i) {
+    d[i].dlmdgmm = kkt_residual[i].lx;
+    if (kkt_matrix[i].isLowerTriangularHessian()) {
+      d[i].dlmdgmm.noalias() 
+          += kkt_matrix[i].Qxx.selfadjointView<Eigen::Lower>() * d[i].dx;
+    }
+    else {
+      d[i].dlmdgmm.noalias() += kkt_matrix[i].Qxx * d[i].dx;
+    }
+    d[i].dlmdgmm.noalias() += kkt_matrix[i].Qxu * d[i].du;
+    d[i].dlmdgmm.noalias() += kkt_matrix[i].Fxx.transpose() * d[i+1].dlmdgmm;
+  }
+}
+
+
+void PartialCondensing::resizeBlock(CondensedStage& block,
+                                    const int size) const {
+  const int dimU = size * dimu_;
+  block.size = size;
+  block.Fxx.setZero(dimx_, dimx_);
+  block.Fxu.setZero(dimx_, dimU);
+  block.Qxx.setZero(dimx_, dimx_);
+  block.Qxu.setZero(dimx_, dimU);
+  block.Quu.setZero(dimU, dimU);
+  block.K.setZero(dimU, dimx_);
+  block.P_next.setZero(dimx_, dimx_);
+  block.Fx.setZero(dimx_);
+  block.lx.setZero(dimx_);
+  block.lu.setZero(dimU);
+  block.k.setZero(dimU);
+  block.s_next.setZero(dimx_);
+  block.QA.setZero(dimx_, dimx_);
+  block.QB.setZero(dimx_, dimU);
+  block.FA.setZero(dimx_, dimx_);
+  block.FB.setZero(dimx_, dimU);
+  block.BtP.setZero(dimU, dimx_);
+  block.GK.setZero(dimU, dimx_);
+  block.g.setZero(dimx_);
+  block.Fc.setZero(dimx_);
+  block.llt = Eigen::LLT<Eigen::MatrixXd>(dimU);
+}
+
+
+void PartialCondensing::condenseBlock(const KKTMatrix& kkt_matrix,
+                                      const KKTResidual& kkt_residual,
+                                      CondensedStage& block) const {
+  // The state of the j-th stage of the block is expressed as
+  // dx_j = A_j * dx_0 + B_j * dU + c_j, where dU is the stacked control input.
+  // A_j, B_j, and c_j are stored in Fxx, Fxu, and Fx, respectively, and
+  // become the dynamics of the condensed stage at the end of the block.
+  block.Fxx.setIdentity();
+  block.Fxu.setZero();
+  block.Fx.setZero();
+  block.Qxx.setZero();
+  block.Qxu.setZero();
+  block.Quu.setZero();
+  block.lx.setZero();
+  block.lu.setZero();
+  for (int j=0; j<block.size; ++j) {
+    const int i = block.begin + j;
+    const int dimU = j * dimu_;
+    const SplitKKTMatrix& kkt_mat = kkt_matrix[i];
+    const SplitKKTResidual& kkt_res = kkt_residual[i];
+    // Cost
+    block.g = kkt_res.lx;
+    if (kkt_mat.isLowerTriangularHessian()) {
+      block.QA.noalias() 
+          = kkt_mat.Qxx.selfadjointView<Eigen::Lower>() * block.Fxx;
+      block.QB.leftCols(dimU).noalias() 
+          = kkt_mat.Qxx.selfadjointView<Eigen::Lower>() * block.Fxu.leftCols(dimU);
+      block.g.noalias() 
+          += kkt_mat.Qxx.selfadjointView<Eigen::Lower>() * block.Fx;
+    }
+    else {
+      block.QA.noalias() = kkt_mat.Qxx * block.Fxx;
+      block.QB.leftCols(dimU).noalias() = kkt_mat.Qxx * block.Fxu.leftCols(dimU);
+      block.g.noalias() += kkt_mat.Qxx * block.Fx;
+    }
+    block.Qxx.noalias() += block.Fxx.transpose() * block.QA;
+    block.Qxu.leftCols(dimU).noalias()
+        += block.Fxx.transpose() * block.QB.leftCols(dimU);
+    block.Qxu.middleCols(dimU, dimu_).noalias()
+        += block.Fxx.transpose() * kkt_mat.Qxu;
+    block.Quu.topLeftCorner(dimU, dimU).noalias()
+        += block.Fxu.leftCols(dimU).transpose() * block.QB.leftCols(dimU);
+    block.Quu.block(0, dimU, dimU, dimu_).noalias()
+        += block.Fxu.leftCols(dimU).transpose() * kkt_mat.Qxu;
+    block.Quu.block(dimU, 0, dimu_, dimU).noalias()
+        += kkt_mat.Qxu.transpose() * block.Fxu.leftCols(dimU);
+    if (kkt_mat.isLowerTriangularHessian()) {
+      // Only the lower triangle of kkt_mat.Quu is valid. It is accumulated 
+      // and mirrored without forming a dense temporary.
+      block.Quu.block(dimU, dimU, dimu_, dimu_).triangularView<Eigen::Lower>() 
+          += kkt_mat.Quu;
+      block.Quu.block(dimU, dimU, dimu_, dimu_).triangularView<Eigen::StrictlyUpper>() 
+          += kkt_mat.Quu.transpose();
+    }
+    else {
+      block.Quu.block(dimU, dimU, dimu_, dimu_) += kkt_mat.Quu;
+    }
+    block.lx.noalias() += block.Fxx.transpose() * block.g;
+    block.lu.head(dimU).noalias() += block.Fxu.leftCols(dimU).transpose() * block.g;
+    block.lu.segment(dimU, dimu_) += kkt_res.lu;
+    block.lu.segment(dimU, dimu_).noalias() += kkt_mat.Qxu.transpose() * block.Fx;
+    // Dynamics
+    block.FA.noalias() = kkt_mat.Fxx * block.Fxx;
+    block.FB.leftCols(dimU).noalias() = kkt_mat.Fxx * block.Fxu.leftCols(dimU);
+    block.Fc = kkt_res.Fx;
+    block.Fc.noalias() += kkt_mat.Fxx * block.Fx;
+    block.Fxx = block.FA;
+    block.Fxu.leftCols(dimU) = block.FB.leftCols(dimU);
+    block.Fxu.block(dimv_, dimU, dimv_, dimu_) = kkt_mat.Fvu;
+    if (kkt_mat.Fqu.size() > 0) {
+      block.Fxu.block(0, dimU, dimv_, dimu_) = kkt_mat.Fqu;
+    }
+    block.Fx = block.Fc;
+  }
+}
+
+
+int PartialCondensing::blockSizeHeuristic(const int dimx, const int dimu) {
+  if (dimu <= 0) {
+    return 1;
+  }
+  const double ratio = static_cast<double>(dimx) / dimu;
+  return std::max(static_cast<int>(std::round(ratio)), 1);
+}
+
+
+bool PartialCondensing::isRegularTimeStage(const OCP& ocp,
+                                           const int time_stage) {
+  const auto& discrete = ocp.discrete();
+  if (discrete.isTimeStageBeforeImpulse(time_stage)) return false;
+  if (discrete.isTimeStageBeforeLift(time_stage)) return false;
+  if (discrete.isTimeStageBeforeImpulse(time_stage+1)) return false;
+  const int phase = discrete.contactPhase(time_stage);
+  if (discrete.isSTOEnabledPhase(phase)) return false;
+  if (discrete.isSTOEnabledNextPhase(phase)) return false;
+  return true;
+}
+
+} // namespace robotoc
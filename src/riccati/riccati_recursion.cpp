@@ -8,14 +8,17 @@
 namespace robotoc {
 
 RiccatiRecursion::RiccatiRecursion(const OCP& ocp, const int nthreads, 
-                                   const double max_dts0)
+                                   const double max_dts0, 
+                                   const int partial_condensing_block_size)
   : nthreads_(nthreads),
     N_all_(ocp.N()+1),
     factorizer_(ocp.robot(), max_dts0),
-    lqr_policy_(ocp.robot(), ocp.N(), ocp.reservedNumDiscreteEvents()),
+    lqr_policy_(ocp.robot(), ocp.N(), ocp.reservedNumImpulseEvents(), 
+                ocp.reservedNumLiftEvents()),
     sto_policy_(2*ocp.reservedNumDiscreteEvents()+1, 
                 STOPolicy(ocp.robot())),
     factorization_m_(ocp.robot()),
+    partial_condensing_(ocp, partial_condensing_block_size),
     max_primal_step_sizes_(
         Eigen::VectorXd::Zero(ocp.N()+1+3*ocp.reservedNumDiscreteEvents())), 
     max_dual_step_sizes_(
@@ -39,6 +42,7 @@ RiccatiRecursion::RiccatiRecursion()
     lqr_policy_(),
     sto_policy_(),
     factorization_m_(),
+    partial_condensing_(),
     max_primal_step_sizes_(), 
     max_dual_step_sizes_() {
 }
@@ -54,9 +58,20 @@ void RiccatiRecursion::setRegularization(const double max_dts0) {
 }
 
 
+void RiccatiRecursion::setPartialCondensing(const int block_size) {
+  partial_condensing_.setBlockSize(block_size);
+}
+
+
+const PartialCondensing& RiccatiRecursion::getPartialCondensing() const {
+  return partial_condensing_;
+}
+
+
 void RiccatiRecursion::reserve(const OCP& ocp) {
   const int reserved_num_discrete_events = ocp.reservedNumDiscreteEvents();
-  lqr_policy_.reserve(ocp.robot(), reserved_num_discrete_events);
+  lqr_policy_.reserve(ocp.robot(), ocp.reservedNumImpulseEvents(), 
+                      ocp.reservedNumLiftEvents());
   while (sto_policy_.size() < 2*reserved_num_discrete_events+1) {
     sto_policy_.emplace_back(ocp.robot());
   }
@@ -73,7 +88,16 @@ void RiccatiRecursion::backwardRiccatiRecursion(
     const OCP& ocp, KKTMatrix& kkt_matrix, KKTResidual& kkt_residual, 
     RiccatiFactorization& factorization) {
   const int N = ocp.discrete().N();
-  factorization[N].P = kkt_matrix[N].Qxx;
+  partial_condensing_.partition(ocp);
+  if (partial_condensing_.numBlocks() > 0) {
+    partial_condensing_.condense(kkt_matrix, kkt_residual, nthreads_);
+  }
+  if (kkt_matrix[N].isLowerTriangularHessian()) {
+    factorization[N].P = kkt_matrix[N].Qxx.selfadjointView<Eigen::Lower>();
+  }
+  else {
+    factorization[N].P = kkt_matrix[N].Qxx;
+  }
   factorization[N].s = - kkt_residual[N].lx;
   for (int i=N-1; i>=0; --i) {
     if (ocp.discrete().isTimeStageBeforeImpulse(i)) {
@@ -150,6 +174,13 @@ void RiccatiRecursion::backwardRiccatiRecursion(
                                              sto, sto_next);
       }
     }
+    else if (partial_condensing_.isBlockEnd(i)) {
+      const int block_begin = partial_condensing_.blockBegin(i);
+      partial_condensing_.backwardRiccatiRecursion(i, factorization[i+1], 
+                                                   factorization[block_begin], 
+                                                   lqr_policy_[block_begin]);
+      i = block_begin;
+    }
     else if (!ocp.discrete().isTimeStageBeforeImpulse(i+1)) {
       const int phase = ocp.discrete().contactPhase(i);
       const bool sto = ocp.discrete().isSTOEnabledPhase(phase);
@@ -240,6 +271,10 @@ void RiccatiRecursion::forwardRiccatiRecursion(
                                           d.lift[lift_index], d[i+1], 
                                           sto_next, sto_next_next);
     }
+    else if (partial_condensing_.isBlockBegin(i)) {
+      partial_condensing_.expandDirection(i, kkt_matrix, kkt_residual, d);
+      i = partial_condensing_.blockEnd(i);
+    }
     else if (!ocp.discrete().isTimeStageBeforeImpulse(i+1)) {
       const int phase = ocp.discrete().contactPhase(i);
       const bool sto = ocp.discrete().isSTOEnabledPhase(phase);
@@ -265,8 +300,12 @@ void RiccatiRecursion::computeDirection(
       const int phase = ocp.discrete().contactPhase(i);
       const bool sto = ocp.discrete().isSTOEnabledPhase(phase);
       const bool sto_next = ocp.discrete().isSTOEnabledNextPhase(phase);
-      RiccatiFactorizer::computeCostateDirection(factorization[i], d[i], 
-                                                 sto, sto_next);
+      // The costate directions inside the condensed blocks are computed in 
+      // the forward recursion.
+      if (!partial_condensing_.isBlockInterior(i)) {
+        RiccatiFactorizer::computeCostateDirection(factorization[i], d[i], 
+                                                   sto, sto_next);
+      }
       ocp[i].expandPrimal(contact_sequence->contactStatus(phase), d[i]);
       if (ocp.discrete().isTimeStageBeforeImpulse(i+1)) {
         const int impulse_index = ocp.discrete().impulseIndexAfterTimeStage(i+1);
@@ -1,28 +1,45 @@
 #include "robotoc/solver/ocp_solver.hpp"
 
+#include <omp.h>
 #include <stdexcept>
 #include <cassert>
 #include <algorithm>
 
+#include "Eigen/Geometry"
+
 
 namespace robotoc {
 
 OCPSolver::OCPSolver(const OCP& ocp, 
                      const SolverOptions& solver_options, const int nthreads)
   : robots_(nthreads, ocp.robot()),
+    robots_kinematics_(),
     contact_sequence_(ocp.contact_sequence()),
     dms_(nthreads),
     sto_(ocp),
-    riccati_recursion_(ocp, nthreads, solver_options.max_dts_riccati),
+    riccati_recursion_(ocp, nthreads, solver_options.max_dts_riccati, 
+                       solver_options.partial_condensing_block_size),
     line_search_(ocp, nthreads),
+    nonlinear_rollout_(ocp),
     ocp_(ocp),
-    riccati_factorization_(ocp.robot(), ocp.N(), ocp.reservedNumDiscreteEvents()),
-    kkt_matrix_(ocp.robot(), ocp.N(), ocp.reservedNumDiscreteEvents()),
-    kkt_residual_(ocp.robot(), ocp.N(), ocp.reservedNumDiscreteEvents()),
-    s_(ocp.robot(), ocp.N(), ocp.reservedNumDiscreteEvents()),
-    d_(ocp.robot(), ocp.N(), ocp.reservedNumDiscreteEvents()),
+    riccati_factorization_(ocp.robot(), ocp.N(), ocp.reservedNumImpulseEvents(), 
+                           ocp.reservedNumLiftEvents()),
+    kkt_matrix_(ocp.robot(), ocp.N(), ocp.reservedNumImpulseEvents(), 
+                ocp.reservedNumLiftEvents()),
+    kkt_residual_(ocp.robot(), ocp.N(), ocp.reservedNumImpulseEvents(), 
+                  ocp.reservedNumLiftEvents()),
+    s_(ocp.robot(), ocp.N(), ocp.reservedNumImpulseEvents(), 
+       ocp.reservedNumLiftEvents()),
+    s_linear_(ocp.robot(), ocp.N(), ocp.reservedNumImpulseEvents(), 
+              ocp.reservedNumLiftEvents()),
+    d_(ocp.robot(), ocp.N(), ocp.reservedNumImpulseEvents(), 
+       ocp.reservedNumLiftEvents()),
+    u0_prev_(Eigen::VectorXd::Zero(ocp.robot().dimu())),
     solver_options_(solver_options),
-    solver_statistics_() {
+    solver_statistics_(),
+    timer_(),
+    performance_counter_(nthreads),
+    nthreads_(nthreads) {
   try {
     if (nthreads <= 0) {
       throw std::out_of_range("invalid value: nthreads must be positive!");
@@ -32,14 +49,17 @@ OCPSolver::OCPSolver(const OCP& ocp,
     std::cerr << e.what() << '\n';
     std::exit(EXIT_FAILURE);
   }
+  ocp_.setIntegrationScheme(solver_options.integration_scheme);
   for (auto& e : s_.data)    { ocp.robot().normalizeConfiguration(e.q); }
   for (auto& e : s_.impulse) { ocp.robot().normalizeConfiguration(e.q); }
   for (auto& e : s_.aux)     { ocp.robot().normalizeConfiguration(e.q); }
   for (auto& e : s_.lift)    { ocp.robot().normalizeConfiguration(e.q); }
+  setLowerTriangularHessian();
 }
 
 
-OCPSolver::OCPSolver() {
+OCPSolver::OCPSolver() 
+  : nthreads_(0) {
 }
 
 
@@ -50,6 +70,10 @@ OCPSolver::~OCPSolver() {
 void OCPSolver::setSolverOptions(const SolverOptions& solver_options) {
   solver_options_ = solver_options;
   riccati_recursion_.setRegularization(solver_options.max_dts_riccati);
+  riccati_recursion_.setPartialCondensing(
+      solver_options.partial_condensing_block_size);
+  ocp_.setIntegrationScheme(solver_options.integration_scheme);
+  setLowerTriangularHessian();
 }
 
 
@@ -77,37 +101,77 @@ void OCPSolver::updateSolution(const double t, const Eigen::VectorXd& q,
                                const Eigen::VectorXd& v) {
   assert(q.size() == robots_[0].dimq());
   assert(v.size() == robots_[0].dimv());
+  if (solver_options_.enable_performance_counter 
+        && !performance_counter_.isOpen()) {
+    performance_counter_.open();
+  }
+  startPhase();
   ocp_.discretize(t);
   reserveData();
   discretizeSolution();
   dms_.computeKKTSystem(ocp_, robots_, contact_sequence_, q, v, s_, 
                         kkt_matrix_, kkt_residual_);
   sto_.computeKKTSystem(ocp_, kkt_matrix_, kkt_residual_);
+  recordKKTErrorComponents();
   sto_.applyRegularization(ocp_, kkt_matrix_);
+  stopPhase(SolverPhase::KKTSystem);
+  startPhase();
   riccati_recursion_.backwardRiccatiRecursion(ocp_, kkt_matrix_, kkt_residual_, 
                                               riccati_factorization_);
+  stopPhase(SolverPhase::BackwardRiccati);
+  startPhase();
   dms_.computeInitialStateDirection(ocp_, robots_, q, v, s_, d_);
   riccati_recursion_.forwardRiccatiRecursion(ocp_, kkt_matrix_, kkt_residual_, d_);
   riccati_recursion_.computeDirection(ocp_, contact_sequence_, 
                                       riccati_factorization_, d_);
   sto_.computeDirection(ocp_, d_);
+  stopPhase(SolverPhase::ForwardRiccati);
   double primal_step_size = std::min(riccati_recursion_.maxPrimalStepSize(), 
                                      sto_.maxPrimalStepSize());
   const double dual_step_size = std::min(riccati_recursion_.maxDualStepSize(),
                                          sto_.maxDualStepSize());
   if (solver_options_.enable_line_search) {
+    startPhase();
     const double max_primal_step_size = primal_step_size;
     primal_step_size = line_search_.computeStepSize(ocp_, robots_, 
                                                     contact_sequence_, 
                                                     q, v, s_, d_, 
                                                     max_primal_step_size);
+    stopPhase(SolverPhase::LineSearch);
   }
   solver_statistics_.primal_step_size.push_back(primal_step_size);
   solver_statistics_.dual_step_size.push_back(dual_step_size);
+  startPhase();
+  const bool nonlinear_rollout 
+      = (solver_options_.forward_pass_method 
+          == ForwardPassMethod::NonlinearRollout)
+        && !riccati_recursion_.getPartialCondensing().isEnabled();
+  if (nonlinear_rollout) {
+    nonlinear_rollout_.computeDefects(ocp_, robots_[0], s_);
+  }
   dms_.integrateSolution(ocp_, robots_, primal_step_size, dual_step_size, 
                          kkt_matrix_, d_, s_);
   sto_.integrateSolution(ocp_, contact_sequence_, primal_step_size, 
                          dual_step_size, d_);
+  if (nonlinear_rollout && NonlinearRollout::rolloutHorizon(ocp_) > 0) {
+    // The rollout is discarded if it does not improve the merit function 
+    // over the linear update, e.g., far from the solution.
+    s_linear_ = s_;
+    const double merit_linear = line_search_.computeMerit(
+        ocp_, robots_, contact_sequence_, q, v, s_linear_);
+    nonlinear_rollout_.rollout(ocp_, robots_[0], 
+                               riccati_recursion_.getLQRPolicy(), 
+                               primal_step_size, s_);
+    const double merit_rollout = line_search_.computeMerit(
+        ocp_, robots_, contact_sequence_, q, v, s_);
+    if (merit_rollout > merit_linear) {
+      s_ = s_linear_;
+    }
+  }
+  stopPhase(SolverPhase::Integration);
+  if (solver_options_.enable_performance_counter) {
+    solver_statistics_.setPerformanceCounts(performance_counter_);
+  }
 } 
 
 
@@ -122,6 +186,7 @@ void OCPSolver::solve(const double t, const Eigen::VectorXd& q,
     line_search_.clearFilter();
   }
   solver_statistics_.clear(); 
+  performance_counter_.reset();
   int inner_iter = 0;
   for (int iter=0; iter<solver_options_.max_iter; ++iter, ++inner_iter) {
     if (ocp_.isSTOEnabled()) {
@@ -133,6 +198,9 @@ void OCPSolver::solve(const double t, const Eigen::VectorXd& q,
       }
       solver_statistics_.ts.emplace_back(contact_sequence_->eventTimes());
     } 
+    if (solver_options_.initial_input_tol > 0) {
+      u0_prev_ = s_[0].u;
+    }
     updateSolution(t, q, v);
     const double kkt_error = KKTError();
     solver_statistics_.kkt_error.push_back(kkt_error); 
@@ -142,13 +210,13 @@ void OCPSolver::solve(const double t, const Eigen::VectorXd& q,
         inner_iter = 0;
         solver_statistics_.mesh_refinement_iter.push_back(iter+1); 
       }
-      else if (kkt_error < solver_options_.kkt_tol) {
+      else if (isConverged(kkt_error)) {
         solver_statistics_.convergence = true;
         solver_statistics_.iter = iter+1;
         break;
       }
     }
-    else if (kkt_error < solver_options_.kkt_tol) {
+    else if (isConverged(kkt_error)) {
       solver_statistics_.convergence = true;
       solver_statistics_.iter = iter+1;
       break;
@@ -184,131 +252,77 @@ const SplitSolution& OCPSolver::getSolution(const int stage) const {
 std::vector<Eigen::VectorXd> OCPSolver::getSolution(
     const std::string& name, const std::string& option) const {
   std::vector<Eigen::VectorXd> sol;
-  if (name == "q") {
-    for (int i=0; i<=ocp_.discrete().N(); ++i) {
-      sol.push_back(s_[i].q);
-      if (ocp_.discrete().isTimeStageBeforeImpulse(i)) {
-        const int impulse_index = ocp_.discrete().impulseIndexAfterTimeStage(i);
-        sol.push_back(s_.aux[impulse_index].q);
-      }
-      else if (ocp_.discrete().isTimeStageBeforeLift(i)) {
-        const int lift_index = ocp_.discrete().liftIndexAfterTimeStage(i);
-        sol.push_back(s_.lift[lift_index].q);
+  if (name == "q" || name == "v") {
+    const auto split_solutions 
+        = timeOrderedSplitSolutions(ocp_.discrete().N());
+    const int size = split_solutions.size();
+    sol.resize(size);
+    if (name == "q") {
+      #pragma omp parallel for num_threads(nthreads_)
+      for (int i=0; i<size; ++i) {
+        sol[i] = split_solutions[i]->q;
       }
     }
-  }
-  else if (name == "v") {
-    for (int i=0; i<=ocp_.discrete().N(); ++i) {
-      sol.push_back(s_[i].v);
-      if (ocp_.discrete().isTimeStageBeforeImpulse(i)) {
-        const int impulse_index = ocp_.discrete().impulseIndexAfterTimeStage(i);
-        sol.push_back(s_.aux[impulse_index].v);
-      }
-      else if (ocp_.discrete().isTimeStageBeforeLift(i)) {
-        const int lift_index = ocp_.discrete().liftIndexAfterTimeStage(i);
-        sol.push_back(s_.lift[lift_index].v);
+    else {
+      #pragma omp parallel for num_threads(nthreads_)
+      for (int i=0; i<size; ++i) {
+        sol[i] = split_solutions[i]->v;
       }
     }
   }
-  else if (name == "a") {
-    for (int i=0; i<ocp_.discrete().N(); ++i) {
-      sol.push_back(s_[i].a);
-      if (ocp_.discrete().isTimeStageBeforeImpulse(i)) {
-        const int impulse_index = ocp_.discrete().impulseIndexAfterTimeStage(i);
-        sol.push_back(s_.aux[impulse_index].a);
+  else if (name == "a" || name == "u") {
+    const auto split_solutions 
+        = timeOrderedSplitSolutions(ocp_.discrete().N()-1);
+    const int size = split_solutions.size();
+    sol.resize(size);
+    if (name == "a") {
+      #pragma omp parallel for num_threads(nthreads_)
+      for (int i=0; i<size; ++i) {
+        sol[i] = split_solutions[i]->a;
       }
-      else if (ocp_.discrete().isTimeStageBeforeLift(i)) {
-        const int lift_index = ocp_.discrete().liftIndexAfterTimeStage(i);
-        sol.push_back(s_.lift[lift_index].a);
+    }
+    else {
+      #pragma omp parallel for num_threads(nthreads_)
+      for (int i=0; i<size; ++i) {
+        sol[i] = split_solutions[i]->u;
       }
     }
   }
-  else if (name == "f" && option == "WORLD") {
-    Robot robot = robots_[0];
-    for (int i=0; i<ocp_.discrete().N(); ++i) {
-      Eigen::VectorXd f(Eigen::VectorXd::Zero(robot.max_dimf()));
-      robot.updateFrameKinematics(s_[i].q);
-      for (int j=0; j<robot.maxNumContacts(); ++j) {
-        if (s_[i].isContactActive(j)) {
-          const int contact_frame = robot.contactFrames()[j];
-          robot.transformFromLocalToWorld(contact_frame, s_[i].f[j].template head<3>(),
-                                          f.template segment<3>(3*j));
-        }
-      }
-      sol.push_back(f);
-      if (ocp_.discrete().isTimeStageBeforeImpulse(i)) {
-        const int impulse_index = ocp_.discrete().impulseIndexAfterTimeStage(i);
-        Eigen::VectorXd f(Eigen::VectorXd::Zero(robot.max_dimf()));
-        robot.updateFrameKinematics(s_.aux[impulse_index].q);
-        for (int j=0; j<robot.maxNumContacts(); ++j) {
-          if (s_.aux[impulse_index].isContactActive(j)) {
-            const int contact_frame = robot.contactFrames()[j];
-            robot.transformFromLocalToWorld(contact_frame, 
-                                            s_.aux[impulse_index].f[j].template head<3>(),
-                                            f.template segment<3>(3*j));
-          }
-        }
-        sol.push_back(f);
-      }
-      else if (ocp_.discrete().isTimeStageBeforeLift(i)) {
-        const int lift_index = ocp_.discrete().liftIndexAfterTimeStage(i);
-        Eigen::VectorXd f(Eigen::VectorXd::Zero(robot.max_dimf()));
-        robot.updateFrameKinematics(s_.lift[lift_index].q);
-        for (int j=0; j<robot.maxNumContacts(); ++j) {
-          if (s_.lift[lift_index].isContactActive(j)) {
+  else if (name == "f") {
+    const auto split_solutions 
+        = timeOrderedSplitSolutions(ocp_.discrete().N()-1);
+    const int size = split_solutions.size();
+    sol.resize(size);
+    const bool world_frame = (option == "WORLD");
+    if (world_frame && robots_kinematics_.empty()) {
+      robots_kinematics_ = robots_;
+    }
+    const int max_dimf = robots_[0].max_dimf();
+    const int max_num_contacts = robots_[0].maxNumContacts();
+    #pragma omp parallel for num_threads(nthreads_)
+    for (int i=0; i<size; ++i) {
+      const SplitSolution& split_solution = *split_solutions[i];
+      Eigen::VectorXd f(Eigen::VectorXd::Zero(max_dimf));
+      if (world_frame) {
+        Robot& robot = robots_kinematics_[omp_get_thread_num()];
+        robot.updateFrameKinematics(split_solution.q);
+        for (int j=0; j<max_num_contacts; ++j) {
+          if (split_solution.isContactActive(j)) {
             const int contact_frame = robot.contactFrames()[j];
             robot.transformFromLocalToWorld(contact_frame, 
-                                            s_.lift[lift_index].f[j].template head<3>(), 
+                                            split_solution.f[j].template head<3>(),
                                             f.template segment<3>(3*j));
           }
         }
-        sol.push_back(f);
-      }
-    }
-  }
-  else if (name == "f") {
-    Robot robot = robots_[0];
-    for (int i=0; i<ocp_.discrete().N(); ++i) {
-      Eigen::VectorXd f(Eigen::VectorXd::Zero(robot.max_dimf()));
-      for (int j=0; j<robot.maxNumContacts(); ++j) {
-        if (s_[i].isContactActive(j)) {
-          f.template segment<3>(3*j) = s_[i].f[j].template head<3>();
-        }
       }
-      sol.push_back(f);
-      if (ocp_.discrete().isTimeStageBeforeImpulse(i)) {
-        const int impulse_index = ocp_.discrete().impulseIndexAfterTimeStage(i);
-        Eigen::VectorXd f(Eigen::VectorXd::Zero(robot.max_dimf()));
-        for (int j=0; j<robot.maxNumContacts(); ++j) {
-          if (s_.aux[impulse_index].isContactActive(j)) {
-            f.template segment<3>(3*j) = s_.aux[impulse_index].f[j].template head<3>();
-          }
-        }
-        sol.push_back(f);
-      }
-      else if (ocp_.discrete().isTimeStageBeforeLift(i)) {
-        const int lift_index = ocp_.discrete().liftIndexAfterTimeStage(i);
-        Eigen::VectorXd f(Eigen::VectorXd::Zero(robot.max_dimf()));
-        for (int j=0; j<robot.maxNumContacts(); ++j) {
-          if (s_.lift[lift_index].isContactActive(j)) {
-            f.template segment<3>(3*j) = s_.lift[lift_index].f[j].template head<3>();
+      else {
+        for (int j=0; j<max_num_contacts; ++j) {
+          if (split_solution.isContactActive(j)) {
+            f.template segment<3>(3*j) = split_solution.f[j].template head<3>();
           }
         }
-        sol.push_back(f);
-      }
-    }
-  }
-  else if (name == "u") {
-    for (int i=0; i<ocp_.discrete().N(); ++i) {
-      sol.push_back(s_[i].u);
-      if (ocp_.discrete().isTimeStageBeforeImpulse(i)) {
-        const int impulse_index = ocp_.discrete().impulseIndexAfterTimeStage(i);
-        sol.push_back(s_.aux[impulse_index].u);
-      }
-      else if (ocp_.discrete().isTimeStageBeforeLift(i)) {
-        const int lift_index = ocp_.discrete().liftIndexAfterTimeStage(i);
-        sol.push_back(s_.lift[lift_index].u);
       }
+      sol[i] = f;
     }
   }
   else if (name == "ts") {
@@ -351,6 +365,32 @@ void OCPSolver::setSolution(const Solution& s) {
 }
 
 
+template <typename SplitFunc, typename ImpulseSplitFunc>
+void OCPSolver::parallelForEachSplitSolution(
+    const SplitFunc& split_func, const ImpulseSplitFunc& impulse_split_func) {
+  const int N_data = s_.data.size();
+  const int N_impulse = s_.impulse.size();
+  const int N_aux = s_.aux.size();
+  const int N_lift = s_.lift.size();
+  const int N_all = N_data + N_impulse + N_aux + N_lift;
+  #pragma omp parallel for num_threads(nthreads_)
+  for (int i=0; i<N_all; ++i) {
+    if (i < N_data) {
+      split_func(s_.data[i]);
+    }
+    else if (i < N_data+N_impulse) {
+      impulse_split_func(s_.impulse[i-N_data]);
+    }
+    else if (i < N_data+N_impulse+N_aux) {
+      split_func(s_.aux[i-N_data-N_impulse]);
+    }
+    else {
+      split_func(s_.lift[i-N_data-N_impulse-N_aux]);
+    }
+  }
+}
+
+
 void OCPSolver::setSolution(const std::string& name, 
                             const Eigen::VectorXd& value) {
   try {
@@ -359,79 +399,68 @@ void OCPSolver::setSolution(const std::string& name,
         throw std::out_of_range(
             "invalid value: q.size() must be " + std::to_string(robots_[0].dimq()) + "!");
       }
-      for (auto& e : s_.data)    { e.q = value; }
-      for (auto& e : s_.impulse) { e.q = value; }
-      for (auto& e : s_.aux)     { e.q = value; }
-      for (auto& e : s_.lift)    { e.q = value; }
+      parallelForEachSplitSolution(
+          [&value](SplitSolution& e) { e.q = value; },
+          [&value](ImpulseSplitSolution& e) { e.q = value; });
     }
     else if (name == "v") {
       if (value.size() != robots_[0].dimv()) {
         throw std::out_of_range(
             "invalid value: v.size() must be " + std::to_string(robots_[0].dimv()) + "!");
       }
-      for (auto& e : s_.data)    { e.v = value; }
-      for (auto& e : s_.impulse) { e.v = value; }
-      for (auto& e : s_.aux)     { e.v = value; }
-      for (auto& e : s_.lift)    { e.v = value; }
+      parallelForEachSplitSolution(
+          [&value](SplitSolution& e) { e.v = value; },
+          [&value](ImpulseSplitSolution& e) { e.v = value; });
     }
     else if (name == "a") {
       if (value.size() != robots_[0].dimv()) {
         throw std::out_of_range(
             "invalid value: a.size() must be " + std::to_string(robots_[0].dimv()) + "!");
       }
-      for (auto& e : s_.data)    { e.a  = value; }
-      for (auto& e : s_.impulse) { e.dv = value; }
-      for (auto& e : s_.aux)     { e.a  = value; }
-      for (auto& e : s_.lift)    { e.a  = value; }
+      parallelForEachSplitSolution(
+          [&value](SplitSolution& e) { e.a = value; },
+          [&value](ImpulseSplitSolution& e) { e.dv = value; });
     }
     else if (name == "f") {
       if (value.size() == 6) {
-        for (auto& e : s_.data) { 
-          for (auto& ef : e.f) { ef = value.template head<6>(); } 
-          e.set_f_stack(); 
-        }
-        for (auto& e : s_.aux) { 
-          for (auto& ef : e.f) { ef = value.template head<6>(); } 
-          e.set_f_stack(); 
-        }
-        for (auto& e : s_.lift) { 
-          for (auto& ef : e.f) { ef = value.template head<6>(); } 
-          e.set_f_stack(); 
-        }
+        parallelForEachSplitSolution(
+            [&value](SplitSolution& e) { 
+              for (auto& ef : e.f) { ef = value.template head<6>(); } 
+              e.set_f_stack(); 
+            },
+            [](ImpulseSplitSolution& e) {});
       }
       else if (value.size() == 3) {
-        for (auto& e : s_.data) { 
-          for (auto& ef : e.f) { ef.template head<3>() = value.template head<3>(); } 
-          e.set_f_stack(); 
-        }
-        for (auto& e : s_.aux) { 
-          for (auto& ef : e.f) { ef.template head<3>() = value.template head<3>(); } 
-          e.set_f_stack(); 
-        }
-        for (auto& e : s_.lift) { 
-          for (auto& ef : e.f) { ef.template head<3>() = value.template head<3>(); } 
-          e.set_f_stack(); 
-        }
+        parallelForEachSplitSolution(
+            [&value](SplitSolution& e) { 
+              for (auto& ef : e.f) { ef.template head<3>() = value.template head<3>(); } 
+              e.set_f_stack(); 
+            },
+            [](ImpulseSplitSolution& e) {});
       }
       else {
         throw std::out_of_range("invalid value: f.size() must be 3 or 6!");
       }
     }
     else if (name == "lmd") {
-      if (value.size() != 6) {
-        for (auto& e : s_.impulse) { 
-          for (auto& ef : e.f) { ef = value.template head<6>(); } 
-          e.set_f_stack(); 
-        }
+      if (value.size() == 6) {
+        parallelForEachSplitSolution(
+            [](SplitSolution& e) {},
+            [&value](ImpulseSplitSolution& e) { 
+              for (auto& ef : e.f) { ef = value.template head<6>(); } 
+              e.set_f_stack(); 
+            });
       }
-      else if (value.size() != 3) {
-        for (auto& e : s_.impulse) { 
-          for (auto& ef : e.f) { ef.template head<3>() = value.template head<3>(); } 
-          e.set_f_stack(); 
-        }
+      else if (value.size() == 3) {
+        parallelForEachSplitSolution(
+            [](SplitSolution& e) {},
+            [&value](ImpulseSplitSolution& e) { 
+              for (auto& ef : e.f) { ef.template head<3>() = value.template head<3>(); } 
+              e.set_f_stack(); 
+            });
       }
       else {
-        throw std::out_of_range("invalid value: f.size() must be 3 or 6!");
+        throw std::out_of_range("invalid value: lmd.size() must be 3 or 6!");
       }
     }
     else if (name == "u") {
@@ -439,12 +468,12 @@ void OCPSolver::setSolution(const std::string& name,
         throw std::out_of_range(
             "invalid value: u.size() must be " + std::to_string(robots_[0].dimu()) + "!");
       }
-      for (auto& e : s_.data)    { e.u = value; }
-      for (auto& e : s_.aux)     { e.u = value; }
-      for (auto& e : s_.lift)    { e.u = value; }
+      parallelForEachSplitSolution(
+          [&value](SplitSolution& e) { e.u = value; },
+          [](ImpulseSplitSolution& e) {});
     }
     else {
-      throw std::invalid_argument("invalid arugment: name must be q, v, a, f, or u!");
+      throw std::invalid_argument("invalid arugment: name must be q, v, a, f, lmd, or u!");
     }
   }
   catch(const std::exception& e) {
@@ -468,6 +497,7 @@ void OCPSolver::extrapolateSolutionLastPhase(const double t) {
       time_stage_after_last_event 
           = ocp_.discrete().timeStageAfterLift(ocp_.discrete().N_lift()-1);
     }
+    #pragma omp parallel for num_threads(nthreads_)
     for (int i=time_stage_after_last_event; i<=ocp_.discrete().N(); ++i) {
       s_[i].copyPrimal(s_[time_stage_after_last_event-1]);
       s_[i].copyDual(s_[time_stage_after_last_event-1]);
@@ -477,6 +507,82 @@ void OCPSolver::extrapolateSolutionLastPhase(const double t) {
 }
 
 
+void OCPSolver::extrapolateSolutionPeriodic(const double t, 
+                                            const int num_phases_in_period,
+                                            const Eigen::Matrix3d& R, 
+                                            const Eigen::Vector3d& p) {
+  try {
+    if (num_phases_in_period <= 0) {
+      throw std::out_of_range(
+          "invalid argument: num_phases_in_period must be positive!");
+    }
+  }
+  catch(const std::exception& e) {
+    std::cerr << e.what() << '\n';
+    std::exit(EXIT_FAILURE);
+  }
+  const int num_discrete_events = contact_sequence_->numDiscreteEvents();
+  const int last_phase = num_discrete_events;
+  const int periodic_phase = last_phase - num_phases_in_period;
+  // The contact phase one period earlier must start within the horizon.
+  if (periodic_phase < 1) {
+    extrapolateSolutionLastPhase(t);
+    return;
+  }
+  ocp_.discretize(t);
+  const auto& event_times = contact_sequence_->eventTimes();
+  const double period = event_times[last_phase-1] - event_times[periodic_phase-1];
+  int time_stage_after_last_event, periodic_phase_begin, periodic_phase_end;
+  if (contact_sequence_->eventType(last_phase-1) == DiscreteEventType::Impulse) {
+    time_stage_after_last_event 
+        = ocp_.discrete().timeStageAfterImpulse(ocp_.discrete().N_impulse()-1);
+  }
+  else {
+    time_stage_after_last_event 
+        = ocp_.discrete().timeStageAfterLift(ocp_.discrete().N_lift()-1);
+  }
+  periodic_phase_begin = time_stage_after_last_event;
+  periodic_phase_end = 0;
+  for (int i=0; i<time_stage_after_last_event; ++i) {
+    if (ocp_.discrete().contactPhase(i) == periodic_phase) {
+      periodic_phase_begin = std::min(i, periodic_phase_begin);
+      periodic_phase_end = std::max(i, periodic_phase_end);
+    }
+  }
+  if (periodic_phase_begin > periodic_phase_end) {
+    extrapolateSolutionLastPhase(t);
+    return;
+  }
+  const bool has_floating_base = robots_[0].hasFloatingBase();
+  #pragma omp parallel for num_threads(nthreads_)
+  for (int i=time_stage_after_last_event; i<=ocp_.discrete().N(); ++i) {
+    // The grid one period earlier that is the closest to this grid.
+    const double t_periodic = ocp_.discrete().gridInfo(i).t - period;
+    int j = periodic_phase_begin;
+    while (j < periodic_phase_end 
+            && ocp_.discrete().gridInfo(j+1).t <= t_periodic) {
+      ++j;
+    }
+    if (j < periodic_phase_end 
+          && (ocp_.discrete().gridInfo(j+1).t-t_periodic) 
+              < (t_periodic-ocp_.discrete().gridInfo(j).t)) {
+      ++j;
+    }
+    s_[i].copyPrimal(s_[j]);
+    s_[i].copyDual(s_[j]);
+    if (has_floating_base) {
+      const Eigen::Quaterniond quat 
+          = Eigen::Quaterniond(R) 
+              * Eigen::Quaterniond(s_[j].q.template segment<4>(3));
+      s_[i].q.template head<3>().noalias() = R * s_[j].q.template head<3>();
+      s_[i].q.template head<3>() += p;
+      s_[i].q.template segment<4>(3) = quat.normalized().coeffs();
+    }
+    ocp_[i].initConstraints(ocp_[j]);
+  }
+}
+
+
 void OCPSolver::extrapolateSolutionInitialPhase(const double t) {
   const int num_discrete_events = contact_sequence_->numDiscreteEvents();
   if (num_discrete_events > 0) {
@@ -490,6 +596,7 @@ void OCPSolver::extrapolateSolutionInitialPhase(const double t) {
       time_stage_before_initial_event 
           = ocp_.discrete().timeStageBeforeLift(0);
     }
+    #pragma omp parallel for num_threads(nthreads_)
     for (int i=0; i<=time_stage_before_initial_event; ++i) {
       s_[i].copyPrimal(s_[time_stage_before_initial_event+1]);
       s_[i].copyDual(s_[time_stage_before_initial_event+1]);
@@ -516,6 +623,71 @@ double OCPSolver::KKTError() const {
 }
 
 
+void OCPSolver::startPhase() {
+  if (solver_options_.enable_performance_counter) {
+    performance_counter_.start();
+  }
+}
+
+
+void OCPSolver::stopPhase(const SolverPhase phase) {
+  if (solver_options_.enable_performance_counter) {
+    performance_counter_.stop(phase);
+  }
+}
+
+
+bool OCPSolver::isConverged(const double kkt_error) {
+  if (solver_options_.num_leading_stages > 0) {
+    // The leading-stage error is a partial sum of the per-stage errors that 
+    // are already computed in the KKT system.
+    const double leading_error 
+        = DirectMultipleShooting::KKTErrorLeadingStages(
+              ocp_, kkt_residual_, solver_options_.num_leading_stages);
+    const double tail_error = kkt_error * kkt_error - leading_error;
+    solver_statistics_.kkt_error_leading = std::sqrt(leading_error);
+    solver_statistics_.kkt_error_tail = std::sqrt(std::max(tail_error, 0.0));
+  }
+  if (kkt_error < solver_options_.kkt_tol) {
+    return true;
+  }
+  if (solver_options_.num_leading_stages > 0
+      && solver_statistics_.kkt_error_leading < solver_options_.kkt_tol_leading
+      && solver_statistics_.kkt_error_tail < solver_options_.kkt_tol_tail) {
+    return true;
+  }
+  // A small update of the initial input after a truncated step does not 
+  // imply the stagnation, e.g., near the boundary of the inequality 
+  // constraints. Therefore, the test is only applied after a full step.
+  if (solver_options_.initial_input_tol > 0
+      && solver_statistics_.primal_step_size.back() >= 1.0
+      && (s_[0].u-u0_prev_).lpNorm<Eigen::Infinity>() 
+          < solver_options_.initial_input_tol) {
+    return true;
+  }
+  return false;
+}
+
+
+void OCPSolver::recordKKTErrorComponents() {
+  // The squared errors are already computed in the KKT system and in the 
+  // constraints data. Therefore, no additional evaluation is needed. As 
+  // KKTError(), they describe the iterate before the step is applied.
+  const double constraints_error 
+      = DirectMultipleShooting::constraintsPrimalResidualError(ocp_);
+  const double complementarity_error 
+      = DirectMultipleShooting::constraintsComplementarityError(ocp_);
+  const double dynamics_error = dms_.KKTError(ocp_, kkt_residual_) 
+                                  - constraints_error - complementarity_error;
+  solver_statistics_.kkt_error_dynamics 
+      = std::sqrt(std::max(dynamics_error, 0.0));
+  solver_statistics_.kkt_error_constraints = std::sqrt(constraints_error);
+  solver_statistics_.kkt_error_complementarity 
+      = std::sqrt(complementarity_error);
+  solver_statistics_.kkt_error_sto = std::sqrt(sto_.KKTError());
+}
+
+
 double OCPSolver::cost(const bool include_cost_barrier) const {
   return dms_.totalCost(ocp_, include_cost_barrier);
 }
@@ -538,41 +710,81 @@ void OCPSolver::setRobotProperties(const RobotProperties& properties) {
   for (auto& e : robots_) {
     e.setRobotProperties(properties);
   }
+  for (auto& e : robots_kinematics_) {
+    e.setRobotProperties(properties);
+  }
 }
 
 
 void OCPSolver::reserveData() {
-  kkt_matrix_.reserve(ocp_.robot(), ocp_.reservedNumDiscreteEvents());
-  kkt_residual_.reserve(ocp_.robot(), ocp_.reservedNumDiscreteEvents());
-  s_.reserve(ocp_.robot(), ocp_.reservedNumDiscreteEvents());
-  d_.reserve(ocp_.robot(), ocp_.reservedNumDiscreteEvents());
-  riccati_factorization_.reserve(ocp_.robot(), ocp_.reservedNumDiscreteEvents());
+  const int reserved_num_impulse_events = kkt_matrix_.reservedNumImpulseEvents();
+  const int reserved_num_lift_events = kkt_matrix_.reservedNumLiftEvents();
+  kkt_matrix_.reserve(ocp_.robot(), ocp_.reservedNumImpulseEvents(), 
+                      ocp_.reservedNumLiftEvents());
+  // The newly reserved KKT matrices do not have the flag yet.
+  if (kkt_matrix_.reservedNumImpulseEvents() > reserved_num_impulse_events
+      || kkt_matrix_.reservedNumLiftEvents() > reserved_num_lift_events) {
+    setLowerTriangularHessian();
+  }
+  kkt_residual_.reserve(ocp_.robot(), ocp_.reservedNumImpulseEvents(), 
+                        ocp_.reservedNumLiftEvents());
+  s_.reserve(ocp_.robot(), ocp_.reservedNumImpulseEvents(), 
+             ocp_.reservedNumLiftEvents());
+  s_linear_.reserve(ocp_.robot(), ocp_.reservedNumImpulseEvents(), 
+                    ocp_.reservedNumLiftEvents());
+  d_.reserve(ocp_.robot(), ocp_.reservedNumImpulseEvents(), 
+             ocp_.reservedNumLiftEvents());
+  riccati_factorization_.reserve(ocp_.robot(), ocp_.reservedNumImpulseEvents(), 
+                                 ocp_.reservedNumLiftEvents());
   riccati_recursion_.reserve(ocp_);
   line_search_.reserve(ocp_);
 }
 
 
+void OCPSolver::setLowerTriangularHessian() {
+  const bool lower_triangular_hessian 
+      = solver_options_.enable_lower_triangular_hessian;
+  for (auto& e : kkt_matrix_.data) { e.setLowerTriangularHessian(lower_triangular_hessian); }
+  for (auto& e : kkt_matrix_.aux)  { e.setLowerTriangularHessian(lower_triangular_hessian); }
+  for (auto& e : kkt_matrix_.lift) { e.setLowerTriangularHessian(lower_triangular_hessian); }
+}
+
+
 void OCPSolver::discretizeSolution() {
-  for (int i=0; i<=ocp_.discrete().N(); ++i) {
-    s_[i].setContactStatus(
-        contact_sequence_->contactStatus(ocp_.discrete().contactPhase(i)));
-    s_[i].set_f_stack();
-    s_[i].setImpulseStatus();
-  }
-  for (int i=0; i<ocp_.discrete().N_lift(); ++i) {
-    s_.lift[i].setContactStatus(
-        contact_sequence_->contactStatus(
-            ocp_.discrete().contactPhaseAfterLift(i)));
-    s_.lift[i].set_f_stack();
-    s_.lift[i].setImpulseStatus();
-  }
-  for (int i=0; i<ocp_.discrete().N_impulse(); ++i) {
-    s_.impulse[i].setImpulseStatus(contact_sequence_->impulseStatus(i));
-    s_.impulse[i].set_f_stack();
-    s_.aux[i].setContactStatus(
-        contact_sequence_->contactStatus(
-            ocp_.discrete().contactPhaseAfterImpulse(i)));
-    s_.aux[i].set_f_stack();
+  const int N = ocp_.discrete().N();
+  const int N_impulse = ocp_.discrete().N_impulse();
+  const int N_lift = ocp_.discrete().N_lift();
+  const int N_all = N + 1 + N_impulse + N_lift;
+  #pragma omp parallel for num_threads(nthreads_)
+  for (int i=0; i<N_all; ++i) {
+    if (i <= N) {
+      s_[i].setContactStatus(
+          contact_sequence_->contactStatus(ocp_.discrete().contactPhase(i)));
+      s_[i].set_f_stack();
+      s_[i].setImpulseStatus();
+    }
+    else if (i < N+1+N_impulse) {
+      const int impulse_index = i - (N+1);
+      s_.impulse[impulse_index].setImpulseStatus(
+          contact_sequence_->impulseStatus(impulse_index));
+      s_.impulse[impulse_index].set_f_stack();
+      s_.aux[impulse_index].setContactStatus(
+          contact_sequence_->contactStatus(
+              ocp_.discrete().contactPhaseAfterImpulse(impulse_index)));
+      s_.aux[impulse_index].set_f_stack();
+    }
+    else {
+      const int lift_index = i - (N+1+N_impulse);
+      s_.lift[lift_index].setContactStatus(
+          contact_sequence_->contactStatus(
+              ocp_.discrete().contactPhaseAfterLift(lift_index)));
+      s_.lift[lift_index].set_f_stack();
+      s_.lift[lift_index].setImpulseStatus();
+    }
+  }
+  // The impulse status of the time stages before the impulses must be set 
+  // after the above loop because it resets the impulse status of all stages.
+  for (int i=0; i<N_impulse; ++i) {
     const int time_stage_before_impulse 
         = ocp_.discrete().timeStageBeforeImpulse(i);
     if (time_stage_before_impulse-1 >= 0) {
@@ -583,6 +795,26 @@ void OCPSolver::discretizeSolution() {
 }
 
 
+std::vector<const SplitSolution*> OCPSolver::timeOrderedSplitSolutions(
+    const int last_time_stage) const {
+  std::vector<const SplitSolution*> split_solutions;
+  split_solutions.reserve(last_time_stage+1+ocp_.discrete().N_impulse()
+                                           +ocp_.discrete().N_lift());
+  for (int i=0; i<=last_time_stage; ++i) {
+    split_solutions.push_back(&s_[i]);
+    if (ocp_.discrete().isTimeStageBeforeImpulse(i)) {
+      const int impulse_index = ocp_.discrete().impulseIndexAfterTimeStage(i);
+      split_solutions.push_back(&s_.aux[impulse_index]);
+    }
+    else if (ocp_.discrete().isTimeStageBeforeLift(i)) {
+      const int lift_index = ocp_.discrete().liftIndexAfterTimeStage(i);
+      split_solutions.push_back(&s_.lift[lift_index]);
+    }
+  }
+  return split_solutions;
+}
+
+
 void OCPSolver::disp(std::ostream& os) const {
   os << ocp_ << std::endl;
 }
@@ -0,0 +1,370 @@
+#include "robotoc/solver/ocp_solver_pool.hpp"
+
+#include <stdexcept>
+#include <iostream>
+#include <tuple>
+#include <algorithm>
+#include <cassert>
+
+
+namespace robotoc {
+
+OCPSignature::OCPSignature(const OCP& ocp)
+  : dimq(ocp.robot().dimq()),
+    dimv(ocp.robot().dimv()),
+    dimu(ocp.robot().dimu()),
+    contact_frames(ocp.robot().contactFrames()),
+    contact_types(ocp.robot().contactTypes()),
+    T(ocp.T()),
+    N(ocp.N()),
+    reserved_num_discrete_events(ocp.reservedNumDiscreteEvents()),
+    reserved_num_impulse_events(ocp.reservedNumImpulseEvents()),
+    reserved_num_lift_events(ocp.reservedNumLiftEvents()),
+    is_sto_enabled(ocp.isSTOEnabled()),
+    discretization_method(ocp.discrete().discretizationMethod()),
+    cost(ocp.cost().get()),
+    constraints(ocp.constraints().get()),
+    sto_cost(ocp.sto_cost().get()),
+    sto_constraints(ocp.sto_constraints().get()) {
+}
+
+
+OCPSignature::OCPSignature()
+  : dimq(0),
+    dimv(0),
+    dimu(0),
+    contact_frames(),
+    contact_types(),
+    T(0),
+    N(0),
+    reserved_num_discrete_events(0),
+    reserved_num_impulse_events(0),
+    reserved_num_lift_events(0),
+    is_sto_enabled(false),
+    discretization_method(DiscretizationMethod::GridBased),
+    cost(nullptr),
+    constraints(nullptr),
+    sto_cost(nullptr),
+    sto_constraints(nullptr) {
+}
+
+
+bool OCPSignature::operator<(const OCPSignature& other) const {
+  return std::tie(dimq, dimv, dimu, contact_frames, contact_types, T, N,
+                  reserved_num_discrete_events, reserved_num_impulse_events,
+                  reserved_num_lift_events, is_sto_enabled,
+                  discretization_method, cost, constraints, sto_cost,
+                  sto_constraints)
+          < std::tie(other.dimq, other.dimv, other.dimu, other.contact_frames,
+                     other.contact_types, other.T, other.N,
+                     other.reserved_num_discrete_events, 
+                     other.reserved_num_impulse_events,
+                     other.reserved_num_lift_events, other.is_sto_enabled,
+                     other.discretization_method, other.cost,
+                     other.constraints, other.sto_cost, other.sto_constraints);
+}
+
+
+bool OCPSignature::operator==(const OCPSignature& other) const {
+  return (!(*this < other) && !(other < *this));
+}
+
+
+OCPSolverPool::OCPSolverPool(const int nworkers, const int nthreads)
+  : nworkers_(nworkers),
+    nthreads_(nthreads),
+    workers_(),
+    mtx_(),
+    cv_(),
+    queue_(),
+    idle_solvers_(),
+    warm_starts_(),
+    sequence_(0),
+    num_solvers_(0),
+    terminate_(false) {
+  try {
+    if (nworkers <= 0) {
+      throw std::out_of_range("invalid argument: nworkers must be positive!");
+    }
+    if (nthreads <= 0) {
+      throw std::out_of_range("invalid argument: nthreads must be positive!");
+    }
+  }
+  catch(const std::exception& e) {
+    std::cerr << e.what() << '\n';
+    std::exit(EXIT_FAILURE);
+  }
+  for (int i=0; i<nworkers; ++i) {
+    workers_.emplace_back(&OCPSolverPool::run, this);
+  }
+}
+
+
+OCPSolverPool::~OCPSolverPool() {
+  {
+    std::lock_guard<std::mutex> lock(mtx_);
+    terminate_ = true;
+  }
+  cv_.notify_all();
+  for (auto& e : workers_) {
+    if (e.joinable()) {
+      e.join();
+    }
+  }
+}
+
+
+std::future<OCPSolverResult> OCPSolverPool::submit(
+    const OCPSolverRequest& request) {
+  assert(request.ocp.cost());
+  assert(request.ocp.constraints());
+  assert(request.ocp.contact_sequence());
+  assert(request.q.size() == request.ocp.robot().dimq());
+  assert(request.v.size() == request.ocp.robot().dimv());
+  Job job;
+  job.request = std::make_shared<OCPSolverRequest>(request);
+  job.promise = std::make_shared<std::promise<OCPSolverResult>>();
+  job.timer.tick();
+  std::future<OCPSolverResult> future = job.promise->get_future();
+  {
+    std::lock_guard<std::mutex> lock(mtx_);
+    job.sequence = sequence_++;
+    queue_.push(job);
+  }
+  cv_.notify_one();
+  return future;
+}
+
+
+std::vector<OCPSolverResult> OCPSolverPool::solve(
+    const std::vector<OCPSolverRequest>& requests) {
+  std::vector<std::future<OCPSolverResult>> futures;
+  futures.reserve(requests.size());
+  for (const auto& e : requests) {
+    futures.push_back(submit(e));
+  }
+  std::vector<OCPSolverResult> results;
+  results.reserve(requests.size());
+  for (auto& e : futures) {
+    results.push_back(e.get());
+  }
+  return results;
+}
+
+
+void OCPSolverPool::reserve(const OCP& ocp, const int num_solvers) {
+  try {
+    if (num_solvers < 0) {
+      throw std::out_of_range(
+          "invalid argument: num_solvers must be non-negative!");
+    }
+  }
+  catch(const std::exception& e) {
+    std::cerr << e.what() << '\n';
+    std::exit(EXIT_FAILURE);
+  }
+  const OCPSignature signature(ocp);
+  int num_existing_solvers = 0;
+  {
+    std::lock_guard<std::mutex> lock(mtx_);
+    num_existing_solvers = idle_solvers_[signature].size();
+  }
+  const int num_new_solvers
+      = std::min(num_solvers, nworkers_) - num_existing_solvers;
+  for (int i=0; i<num_new_solvers; ++i) {
+    release(signature, createSolver(ocp));
+  }
+}
+
+
+void OCPSolverPool::setWarmStart(const OCP& ocp, const Solution& solution) {
+  const OCPSignature signature(ocp);
+  std::lock_guard<std::mutex> lock(mtx_);
+  warm_starts_[signature] = solution;
+}
+
+
+void OCPSolverPool::clearWarmStarts() {
+  std::lock_guard<std::mutex> lock(mtx_);
+  warm_starts_.clear();
+}
+
+
+int OCPSolverPool::numSolvers() const {
+  std::lock_guard<std::mutex> lock(mtx_);
+  return num_solvers_;
+}
+
+
+int OCPSolverPool::numWarmStarts() const {
+  std::lock_guard<std::mutex> lock(mtx_);
+  return warm_starts_.size();
+}
+
+
+int OCPSolverPool::numPendingRequests() const {
+  std::lock_guard<std::mutex> lock(mtx_);
+  return queue_.size();
+}
+
+
+void OCPSolverPool::run() {
+  while (true) {
+    Job job;
+    {
+      std::unique_lock<std::mutex> lock(mtx_);
+      cv_.wait(lock, [this] { return terminate_ || !queue_.empty(); });
+      // The remaining requests are solved before the termination so that
+      // all the futures are satisfied.
+      if (queue_.empty()) return;
+      job = queue_.top();
+      queue_.pop();
+    }
+    process(job);
+  }
+}
+
+
+void OCPSolverPool::process(Job& job) {
+  job.timer.tock();
+  OCPSolverResult result;
+  result.wait_time = job.timer.ms();
+  Timer timer;
+  timer.tick();
+  try {
+    const OCPSolverRequest& request = *job.request;
+    const OCPSignature signature(request.ocp);
+    PooledSolver pooled_solver = acquire(signature, request.ocp);
+    try {
+      solveRequest(request, signature, pooled_solver, result);
+    }
+    catch(...) {
+      // The solver is returned to the pool also on failure. It is fully 
+      // reset by the next request that is not warm-started.
+      release(signature, std::move(pooled_solver));
+      throw;
+    }
+    release(signature, std::move(pooled_solver));
+  }
+  catch(...) {
+    job.promise->set_exception(std::current_exception());
+    return;
+  }
+  timer.tock();
+  result.solve_time = timer.ms();
+  job.promise->set_value(std::move(result));
+}
+
+
+void OCPSolverPool::solveRequest(const OCPSolverRequest& request, 
+                                 const OCPSignature& signature,
+                                 PooledSolver& pooled_solver, 
+                                 OCPSolverResult& result) {
+  OCPSolver& solver = *pooled_solver.solver;
+  *pooled_solver.contact_sequence = *request.ocp.contact_sequence();
+  solver.setSolverOptions(request.solver_options);
+  bool has_warm_start = false;
+  if (request.use_warm_start) {
+    std::lock_guard<std::mutex> lock(mtx_);
+    const auto warm_start = warm_starts_.find(signature);
+    if (warm_start != warm_starts_.end()) {
+      solver.setSolution(warm_start->second);
+      has_warm_start = true;
+    }
+  }
+  if (!has_warm_start) {
+    // The solution of the previous request is discarded so that the cold 
+    // start does not depend on which request used the pooled solver last. 
+    // The slacks and duals are re-initialized in OCPSolver::solve().
+    resetSolution(request.ocp.robot(), solver);
+    if (request.initial_guess.find("q") == request.initial_guess.end()) {
+      solver.setSolution("q", request.q);
+    }
+    if (request.initial_guess.find("v") == request.initial_guess.end()) {
+      solver.setSolution("v", request.v);
+    }
+    for (const auto& e : request.initial_guess) {
+      solver.setSolution(e.first, e.second);
+    }
+  }
+  solver.solve(request.t, request.q, request.v, true);
+  result.solution = solver.getSolution();
+  result.statistics = solver.getSolverStatistics();
+  result.kkt_error = solver.KKTError();
+  result.warm_started = has_warm_start;
+  if (result.statistics.convergence && request.update_warm_start) {
+    std::lock_guard<std::mutex> lock(mtx_);
+    warm_starts_[signature] = result.solution;
+  }
+}
+
+
+void OCPSolverPool::resetSolution(const Robot& robot, OCPSolver& solver) {
+  const Solution& s_prev = solver.getSolution();
+  Solution s(robot, s_prev.data.size()-1, s_prev.impulse.size(), 
+             s_prev.lift.size());
+  for (auto& e : s.data)    { robot.normalizeConfiguration(e.q); }
+  for (auto& e : s.impulse) { robot.normalizeConfiguration(e.q); }
+  for (auto& e : s.aux)     { robot.normalizeConfiguration(e.q); }
+  for (auto& e : s.lift)    { robot.normalizeConfiguration(e.q); }
+  solver.setSolution(s);
+}
+
+
+OCPSolverPool::PooledSolver OCPSolverPool::acquire(
+    const OCPSignature& signature, const OCP& ocp) {
+  {
+    std::lock_guard<std::mutex> lock(mtx_);
+    auto& idle_solvers = idle_solvers_[signature];
+    if (!idle_solvers.empty()) {
+      PooledSolver pooled_solver = std::move(idle_solvers.back());
+      idle_solvers.pop_back();
+      return pooled_solver;
+    }
+  }
+  // The construction of the solver is out of the lock since it is expensive.
+  return createSolver(ocp);
+}
+
+
+void OCPSolverPool::release(const OCPSignature& signature,
+                            PooledSolver&& pooled_solver) {
+  std::lock_guard<std::mutex> lock(mtx_);
+  idle_solvers_[signature].push_back(std::move(pooled_solver));
+}
+
+
+OCPSolverPool::PooledSolver OCPSolverPool::createSolver(const OCP& ocp) {
+  PooledSolver pooled_solver;
+  // The pooled solver owns its contact sequence so that the contact sequences
+  // of the requests can be copied into it without affecting the callers.
+  pooled_solver.contact_sequence
+      = std::make_shared<ContactSequence>(*ocp.contact_sequence());
+  if (ocp.isSTOEnabled()) {
+    // The STO constraints hold the slacks and duals, so they are not shared
+    // with the other pooled solvers running in parallel.
+    auto sto_constraints
+        = std::make_shared<STOConstraints>(*ocp.sto_constraints());
+    OCP pooled_ocp(ocp.robot(), ocp.cost(), ocp.constraints(), ocp.sto_cost(),
+                   sto_constraints, pooled_solver.contact_sequence,
+                   ocp.T(), ocp.N());
+    pooled_solver.solver.reset(new OCPSolver(pooled_ocp,
+                                             SolverOptions::defaultOptions(),
+                                             nthreads_));
+  }
+  else {
+    OCP pooled_ocp(ocp.robot(), ocp.cost(), ocp.constraints(),
+                   pooled_solver.contact_sequence, ocp.T(), ocp.N());
+    pooled_ocp.setDiscretizationMethod(ocp.discrete().discretizationMethod());
+    pooled_solver.solver.reset(new OCPSolver(pooled_ocp,
+                                             SolverOptions::defaultOptions(),
+                                             nthreads_));
+  }
+  {
+    std::lock_guard<std::mutex> lock(mtx_);
+    ++num_solvers_;
+  }
+  return pooled_solver;
+}
+
+} // namespace robotoc
@@ -0,0 +1,229 @@
+#include "robotoc/solver/solver_autotuner.hpp"
+#include "robotoc/solver/ocp_solver.hpp"
+#include "robotoc/hybrid/contact_sequence.hpp"
+
+#include <omp.h>
+#include <unistd.h>
+#include <stdexcept>
+#include <fstream>
+#include <sstream>
+#include <limits>
+#include <algorithm>
+
+
+namespace robotoc {
+
+SolverAutotuner::SolverAutotuner(const std::string& cache_file,
+                                 const int max_threads,
+                                 const int num_calibration_solves,
+                                 const int max_calibration_iter)
+  : cache_file_(cache_file),
+    max_threads_(max_threads),
+    num_calibration_solves_(num_calibration_solves),
+    max_calibration_iter_(max_calibration_iter),
+    nthreads_(1),
+    is_cached_(false),
+    candidate_nthreads_(),
+    cpu_times_() {
+  try {
+    if (num_calibration_solves <= 0) {
+      throw std::out_of_range(
+          "invalid value: num_calibration_solves must be positive!");
+    }
+    if (max_calibration_iter <= 0) {
+      throw std::out_of_range(
+          "invalid value: max_calibration_iter must be positive!");
+    }
+  }
+  catch(const std::exception& e) {
+    std::cerr << e.what() << '\n';
+    std::exit(EXIT_FAILURE);
+  }
+  if (max_threads_ <= 0) {
+    max_threads_ = omp_get_num_procs();
+  }
+}
+
+
+SolverAutotuner::~SolverAutotuner() {
+}
+
+
+int SolverAutotuner::tune(const OCP& ocp, const SolverOptions& solver_options,
+                          const double t, const Eigen::VectorXd& q,
+                          const Eigen::VectorXd& v) {
+  return tune_impl(ocp, solver_options, t, q, v, nullptr);
+}
+
+
+int SolverAutotuner::tune(const OCP& ocp, const SolverOptions& solver_options,
+                          const double t, const Eigen::VectorXd& q,
+                          const Eigen::VectorXd& v, const Solution& s) {
+  return tune_impl(ocp, solver_options, t, q, v, &s);
+}
+
+
+int SolverAutotuner::nthreads() const {
+  return nthreads_;
+}
+
+
+bool SolverAutotuner::isCached() const {
+  return is_cached_;
+}
+
+
+const std::vector<int>& SolverAutotuner::candidateNumThreads() const {
+  return candidate_nthreads_;
+}
+
+
+const std::vector<double>& SolverAutotuner::cpuTimes() const {
+  return cpu_times_;
+}
+
+
+std::string SolverAutotuner::problemSignature(const OCP& ocp) {
+  std::stringstream ss;
+  ss << "dimq=" << ocp.robot().dimq()
+     << ",dimv=" << ocp.robot().dimv()
+     << ",dimu=" << ocp.robot().dimu()
+     << ",max_dimf=" << ocp.robot().max_dimf()
+     << ",contacts=" << ocp.robot().maxNumContacts()
+     << ",N=" << ocp.N()
+     << ",events=" << ocp.reservedNumDiscreteEvents()
+     << ",sto=" << ocp.isSTOEnabled();
+  return ss.str();
+}
+
+
+std::string SolverAutotuner::machineSignature() {
+  char hostname[256] = {};
+  if (gethostname(hostname, sizeof(hostname)-1) != 0) {
+    hostname[0] = '\0';
+  }
+  std::stringstream ss;
+  ss << "host=" << hostname << ",procs=" << omp_get_num_procs();
+  return ss.str();
+}
+
+
+void SolverAutotuner::disp(std::ostream& os) const {
+  os << "Solver autotuner:" << std::endl;
+  os << "  nthreads: " << nthreads_ << std::endl;
+  os << "  cached: " << std::boolalpha << is_cached_ << std::endl;
+  for (std::size_t i=0; i<candidate_nthreads_.size(); ++i) {
+    os << "  nthreads = " << candidate_nthreads_[i] << ": "
+       << cpu_times_[i] << " [ms]" << std::endl;
+  }
+}
+
+
+std::ostream& operator<<(std::ostream& os, const SolverAutotuner& autotuner) {
+  autotuner.disp(os);
+  return os;
+}
+
+
+int SolverAutotuner::tune_impl(const OCP& ocp,
+                               const SolverOptions& solver_options,
+                               const double t, const Eigen::VectorXd& q,
+                               const Eigen::VectorXd& v, const Solution* s) {
+  candidate_nthreads_.clear();
+  cpu_times_.clear();
+  const std::string key = machineSignature() + ";" + problemSignature(ocp);
+  int cached_nthreads = 0;
+  if (readCache(key, cached_nthreads)) {
+    nthreads_ = cached_nthreads;
+    is_cached_ = true;
+    return nthreads_;
+  }
+  is_cached_ = false;
+  for (int nthreads=1; nthreads<max_threads_; nthreads*=2) {
+    candidate_nthreads_.push_back(nthreads);
+  }
+  candidate_nthreads_.push_back(max_threads_);
+  SolverOptions calibration_options = solver_options;
+  calibration_options.max_iter = max_calibration_iter_;
+  calibration_options.enable_benchmark = true;
+  // The calibration solves must not change the user's contact sequence, e.g.,
+  // by the switching time optimization.
+  const ContactSequence contact_sequence_backup = *ocp.contact_sequence();
+  double min_cpu_time = std::numeric_limits<double>::infinity();
+  for (const auto nthreads : candidate_nthreads_) {
+    OCPSolver ocp_solver(ocp, calibration_options, nthreads);
+    double cpu_time = std::numeric_limits<double>::infinity();
+    for (int i=0; i<num_calibration_solves_; ++i) {
+      *ocp.contact_sequence() = contact_sequence_backup;
+      if (s != nullptr) {
+        ocp_solver.setSolution(*s);
+      }
+      else {
+        ocp_solver.setSolution("q", q);
+        ocp_solver.setSolution("v", v);
+      }
+      ocp_solver.solve(t, q, v, true);
+      cpu_time = std::min(cpu_time, ocp_solver.getSolverStatistics().cpu_time);
+    }
+    cpu_times_.push_back(cpu_time);
+    if (cpu_time < min_cpu_time) {
+      min_cpu_time = cpu_time;
+      nthreads_ = nthreads;
+    }
+  }
+  *ocp.contact_sequence() = contact_sequence_backup;
+  writeCache(key, nthreads_);
+  return nthreads_;
+}
+
+
+bool SolverAutotuner::readCache(const std::string& key, int& nthreads) const {
+  if (cache_file_.empty()) {
+    return false;
+  }
+  std::ifstream ifs(cache_file_);
+  if (!ifs) {
+    return false;
+  }
+  std::string line;
+  bool found = false;
+  while (std::getline(ifs, line)) {
+    const auto pos = line.rfind(' ');
+    if (pos == std::string::npos) continue;
+    if (line.substr(0, pos) == key) {
+      // The latest entry overrides the former ones. A corrupted entry is 
+      // regarded as a cache miss so that the calibration overwrites it.
+      found = false;
+      const std::string value = line.substr(pos+1);
+      try {
+        std::size_t num_parsed = 0;
+        const int cached_nthreads = std::stoi(value, &num_parsed);
+        if (num_parsed == value.size() && cached_nthreads >= 1) {
+          nthreads = cached_nthreads;
+          found = true;
+        }
+      }
+      catch(const std::invalid_argument& e) {
+      }
+      catch(const std::out_of_range& e) {
+      }
+    }
+  }
+  return found;
+}
+
+
+void SolverAutotuner::writeCache(const std::string& key,
+                                 const int nthreads) const {
+  if (cache_file_.empty()) {
+    return;
+  }
+  std::ofstream ofs(cache_file_, std::ios::app);
+  if (!ofs) {
+    std::cerr << "warning: cannot open the cache file " << cache_file_ << '\n';
+    return;
+  }
+  ofs << key << " " << nthreads << '\n';
+}
+
+} // namespace robotoc
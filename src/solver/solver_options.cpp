@@ -6,6 +6,10 @@ namespace robotoc {
 SolverOptions::SolverOptions() {
   max_iter = 100;
   kkt_tol = 1.0e-07;
+  num_leading_stages = 0;
+  kkt_tol_leading = 1.0e-07;
+  kkt_tol_tail = 1.0e-03;
+  initial_input_tol = 0.0;
   mu_init = 1.0e-03;
   mu_min = 1.0e-03;
   kkt_tol_mu = 1.0e-07;
@@ -14,12 +18,19 @@ SolverOptions::SolverOptions() {
   enable_line_search = false;
   line_search_settings = LineSearchSettings::defaultSettings();
   discretization_method = DiscretizationMethod::GridBased;
+  integration_scheme = IntegrationScheme::ForwardEuler;
+  enable_lower_triangular_hessian = false;
+  forward_pass_method = ForwardPassMethod::LinearStep;
   initial_sto_reg_iter = 0;
   initial_sto_reg = 1.0e30;
   kkt_tol_mesh = 0.1;
   max_dt_mesh = 0;
   max_dts_riccati = 0.1;
+  partial_condensing_block_size = 1;
+  aux_mat_initialization = AuxMatInitialization::TerminalCostHessian;
+  num_blocks_parnmpc = 0;
   enable_benchmark = false;
+  enable_performance_counter = false;
 }
 
 
@@ -36,6 +47,10 @@ void SolverOptions::disp(std::ostream& os) const {
   os << "Solver options:" << std::endl;
   os << "  max_iter: " << max_iter << std::endl;
   os << "  kkt_tol: " << kkt_tol << std::endl;
+  os << "  num_leading_stages: " << num_leading_stages << std::endl;
+  os << "  kkt_tol_leading: " << kkt_tol_leading << std::endl;
+  os << "  kkt_tol_tail: " << kkt_tol_tail << std::endl;
+  os << "  initial_input_tol: " << initial_input_tol << std::endl;
   os << "  mu_init: " << mu_init << std::endl;
   os << "  mu_min: " << mu_min << std::endl;
   os << "  kkt_tol_mu: " << kkt_tol_mu << std::endl;
@@ -46,12 +61,27 @@ void SolverOptions::disp(std::ostream& os) const {
   os << "  discretization_method: ";
   if (discretization_method == DiscretizationMethod::GridBased) os << "grid-based" << std::endl;
   else os << "phase-based" << std::endl;
+  os << "  integration_scheme: ";
+  if (integration_scheme == IntegrationScheme::ForwardEuler) os << "forward-Euler" << std::endl;
+  else os << "midpoint" << std::endl;
+  os << "  enable_lower_triangular_hessian: " << std::boolalpha << enable_lower_triangular_hessian << std::endl;
+  os << "  forward_pass_method: ";
+  if (forward_pass_method == ForwardPassMethod::LinearStep) os << "linear step" << std::endl;
+  else os << "nonlinear rollout" << std::endl;
   os << "  initial_sto_reg_iter: " << initial_sto_reg_iter << std::endl;
   os << "  initial_sto_reg: " << initial_sto_reg << std::endl;
   os << "  kkt_tol_mesh: " << kkt_tol_mesh << std::endl;
   os << "  max_dt_mesh: " << max_dt_mesh << std::endl;
-  os << "  mex_dts_riccati: " << max_dts_riccati << std::flush;
+  os << "  mex_dts_riccati: " << max_dts_riccati << std::endl;
+  os << "  partial_condensing_block_size: " << partial_condensing_block_size << std::endl;
+  os << "  aux_mat_initialization: ";
+  if (aux_mat_initialization == AuxMatInitialization::TerminalCostHessian) os << "terminal-cost-Hessian" << std::endl;
+  else if (aux_mat_initialization == AuxMatInitialization::TerminalLQR) os << "terminal-LQR" << std::endl;
+  else if (aux_mat_initialization == AuxMatInitialization::Riccati) os << "Riccati" << std::endl;
+  else os << "shift" << std::endl;
+  os << "  num_blocks_parnmpc: " << num_blocks_parnmpc << std::endl;
   os << "  enable_benchmark: " << std::boolalpha << enable_benchmark << std::endl;
+  os << "  enable_performance_counter: " << std::boolalpha << enable_performance_counter << std::endl;
 }
 
 
@@ -14,7 +14,16 @@ SolverStatistics::SolverStatistics()
     dual_step_size(),
     ts(),
     mesh_refinement_iter(),
-    cpu_time(0.0) {
+    kkt_error_dynamics(0.0),
+    kkt_error_constraints(0.0),
+    kkt_error_complementarity(0.0),
+    kkt_error_sto(0.0),
+    kkt_error_leading(0.0),
+    kkt_error_tail(0.0),
+    cpu_time(0.0),
+    phase_cpu_time(),
+    performance_counts(),
+    performance_counter_available(false) {
 }
 
 
@@ -30,7 +39,29 @@ void SolverStatistics::clear() {
   dual_step_size.clear();
   ts.clear();
   mesh_refinement_iter.clear();
+  kkt_error_dynamics = 0.0;
+  kkt_error_constraints = 0.0;
+  kkt_error_complementarity = 0.0;
+  kkt_error_sto = 0.0;
+  kkt_error_leading = 0.0;
+  kkt_error_tail = 0.0;
   cpu_time = 0.0;
+  phase_cpu_time.clear();
+  performance_counts.clear();
+  performance_counter_available = false;
+}
+
+
+void SolverStatistics::setPerformanceCounts(
+    const PerformanceCounter& performance_counter) {
+  phase_cpu_time.resize(kNumSolverPhases);
+  performance_counts.resize(kNumSolverPhases);
+  for (int i=0; i<kNumSolverPhases; ++i) {
+    const auto phase = static_cast<SolverPhase>(i);
+    phase_cpu_time[i] = performance_counter.cpuTime(phase);
+    performance_counts[i] = performance_counter.counts(phase);
+  }
+  performance_counter_available = performance_counter.isAvailable();
 }
 
 
@@ -54,13 +85,51 @@ void SolverStatistics::disp(std::ostream& os) const {
     if (ts.size() > 0) {
       os << "  [";
       os << std::fixed << std::setprecision(4);
-      for (int j=0; j<ts[i].size()-1; ++j) {
+      for (std::size_t j=0; j<ts[i].size()-1; ++j) {
         os << std::setw(6) << ts[i][j] << ", ";
       }
       os << std::setw(6) << ts[i][ts[i].size()-1] << "]";
     }
     os << std::endl;
   }
+  os << "  ------------------------------------------------------------------------------------ " << std::endl;
+  os << std::scientific << std::setprecision(6);
+  if (kkt_error_dynamics > 0.0 || kkt_error_constraints > 0.0 
+      || kkt_error_complementarity > 0.0 || kkt_error_sto > 0.0) {
+    os << "  KKT error at the last iteration (before the step): dynamics = " << kkt_error_dynamics
+       << ", constraints = " << kkt_error_constraints 
+       << ", complementarity = " << kkt_error_complementarity 
+       << ", STO = " << kkt_error_sto << std::endl;
+  }
+  if (kkt_error_leading > 0.0 || kkt_error_tail > 0.0) {
+    os << "  KKT error at the last iteration: leading stages = " 
+       << kkt_error_leading << ", tail stages = " << kkt_error_tail 
+       << std::endl;
+  }
+  if (!phase_cpu_time.empty()) {
+    os << "  ------------------------------------------------------------------------------------ " << std::endl;
+    os << "         phase    | CPU time [ms] |       cycles | instructions |  IPC  | cache misses | branch misses " << std::endl;
+    os << "  ------------------------------------------------------------------------------------ " << std::endl;
+    for (std::size_t i=0; i<phase_cpu_time.size(); ++i) {
+      PerformanceCounts total;
+      for (const auto& e : performance_counts[i]) {
+        total += e;
+      }
+      os << "  " << std::setw(16) << solverPhaseName(static_cast<SolverPhase>(i)) << " | ";
+      os << std::scientific << std::setprecision(6) << phase_cpu_time[i];
+      if (performance_counter_available) {
+        os << " | " << std::setw(12) << total.cycles 
+           << " | " << std::setw(12) << total.instructions
+           << " | " << std::fixed << std::setprecision(3) << total.ipc()
+           << " | " << std::setw(12) << total.cache_misses
+           << " | " << std::setw(12) << total.branch_misses;
+      }
+      os << std::endl;
+    }
+    if (!performance_counter_available) {
+      os << "  (hardware performance counters are unavailable)" << std::endl;
+    }
+  }
   os << std::defaultfloat << std::flush;
 }
 
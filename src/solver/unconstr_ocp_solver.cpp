@@ -4,6 +4,7 @@
 #include <stdexcept>
 #include <iostream>
 #include <cassert>
+#include <cmath>
 
 
 namespace robotoc {
@@ -18,6 +19,7 @@ UnconstrOCPSolver::UnconstrOCPSolver(const UnconstrOCP& ocp,
     kkt_matrix_(ocp.robot(), ocp.N()),
     kkt_residual_(ocp.robot(), ocp.N()),
     s_(ocp.robot(), ocp.N()),
+    s_linear_(ocp.robot(), ocp.N()),
     d_(ocp.robot(), ocp.N()),
     riccati_factorization_(ocp.N()+1, SplitRiccatiFactorization(ocp.robot())),
     N_(ocp.N()),
@@ -26,6 +28,8 @@ UnconstrOCPSolver::UnconstrOCPSolver(const UnconstrOCP& ocp,
     dt_(ocp.T()/ocp.N()),
     primal_step_size_(Eigen::VectorXd::Zero(ocp.N())), 
     dual_step_size_(Eigen::VectorXd::Zero(ocp.N())),
+    rollout_dx_(Eigen::VectorXd::Zero(2*ocp.robot().dimv())),
+    rollout_x_(Eigen::VectorXd::Zero(2*ocp.robot().dimv())),
     solver_options_(solver_options),
     solver_statistics_() {
   try {
@@ -126,6 +130,10 @@ void UnconstrOCPSolver::updateSolution(const double t, const Eigen::VectorXd& q,
       ocp_.terminal.updateDual(dual_step_size);
     }
   }
+  if (solver_options_.forward_pass_method 
+        == ForwardPassMethod::NonlinearRollout) {
+    rolloutSolution(t, q, v, primal_step_size);
+  }
 } 
 
 
@@ -231,6 +239,45 @@ void UnconstrOCPSolver::setSolution(const std::string& name,
 }
 
 
+void UnconstrOCPSolver::shiftSolution(const double shift_time) {
+  assert(shift_time >= 0);
+  const double shift = shift_time / dt_;
+  // The stages are overwritten in the ascending order since the i-th stage 
+  // only refers to the stages after the i-th stage.
+  for (int i=0; i<N_; ++i) {
+    const double tau = i + shift;
+    const int j = static_cast<int>(std::floor(tau));
+    if (j >= N_) {
+      s_[i].q = s_[N_].q;
+      s_[i].v = s_[N_].v;
+      s_[i].a = s_[N_-1].a;
+      s_[i].u = s_[N_-1].u;
+      s_[i].beta = s_[N_-1].beta;
+      s_[i].lmd = s_[N_].lmd;
+      s_[i].gmm = s_[N_].gmm;
+    }
+    else {
+      const double r = tau - j;
+      const int jnext = (j+1 < N_) ? j+1 : j;
+      s_[i].q = (1.0-r) * s_[j].q + r * s_[j+1].q;
+      s_[i].v = (1.0-r) * s_[j].v + r * s_[j+1].v;
+      s_[i].a = (1.0-r) * s_[j].a + r * s_[jnext].a;
+      s_[i].u = (1.0-r) * s_[j].u + r * s_[jnext].u;
+      s_[i].beta = (1.0-r) * s_[j].beta + r * s_[jnext].beta;
+      s_[i].lmd = (1.0-r) * s_[j].lmd + r * s_[j+1].lmd;
+      s_[i].gmm = (1.0-r) * s_[j].gmm + r * s_[j+1].gmm;
+    }
+  }
+  // The slack and dual variables cannot be interpolated between the stages 
+  // since the valid constraints depend on the time stage. Therefore, they are 
+  // reinitialized from the shifted solution.
+  #pragma omp parallel for num_threads(nthreads_)
+  for (int i=0; i<N_; ++i) {
+    ocp_[i].initConstraints(robots_[omp_get_thread_num()], s_[i]);
+  }
+}
+
+
 double UnconstrOCPSolver::KKTError(const double t, const Eigen::VectorXd& q, 
                                    const Eigen::VectorXd& v) {
   assert(q.size() == robots_[0].dimq());
@@ -287,6 +334,43 @@ bool UnconstrOCPSolver::isCurrentSolutionFeasible() {
 }
 
 
+void UnconstrOCPSolver::rolloutSolution(const double t, 
+                                        const Eigen::VectorXd& q, 
+                                        const Eigen::VectorXd& v,
+                                        const double primal_step_size) {
+  // The state equation residuals of kkt_residual_ are the defects of the 
+  // solution before the linear step. They are reduced by the factor 
+  // (1 - primal_step_size) and the control input is given by the inverse 
+  // dynamics of the rolled-out accelerations.
+  s_linear_ = s_;
+  const double merit_linear 
+      = line_search_.computeMerit(ocp_, robots_, t, q, v, s_linear_);
+  const auto& lqr_policy = riccati_recursion_.getLQRPolicy();
+  const int dimv = robots_[0].dimv();
+  const double defect_scale = 1.0 - primal_step_size;
+  rollout_dx_.setZero();
+  for (int i=0; i<N_; ++i) {
+    s_[i].a.noalias() += lqr_policy[i].K * rollout_dx_;
+    robots_[0].RNEA(s_[i].q, s_[i].v, s_[i].a, s_[i].u);
+    rollout_x_.head(dimv) = s_[i].q + dt_ * s_[i].v 
+                              - defect_scale * kkt_residual_[i].Fq();
+    rollout_x_.tail(dimv) = s_[i].v + dt_ * s_[i].a 
+                              - defect_scale * kkt_residual_[i].Fv();
+    rollout_dx_.head(dimv) = rollout_x_.head(dimv) - s_[i+1].q;
+    rollout_dx_.tail(dimv) = rollout_x_.tail(dimv) - s_[i+1].v;
+    s_[i+1].q = rollout_x_.head(dimv);
+    s_[i+1].v = rollout_x_.tail(dimv);
+  }
+  // The rollout is discarded if it does not improve the merit function over 
+  // the linear update, e.g., far from the solution.
+  const double merit_rollout 
+      = line_search_.computeMerit(ocp_, robots_, t, q, v, s_);
+  if (merit_rollout > merit_linear) {
+    s_ = s_linear_;
+  }
+}
+
+
 void UnconstrOCPSolver::setRobotProperties(const RobotProperties& properties) {
   for (auto& e : robots_) {
     e.setRobotProperties(properties);
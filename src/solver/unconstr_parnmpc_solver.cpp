@@ -13,7 +13,7 @@ UnconstrParNMPCSolver::UnconstrParNMPCSolver(const UnconstrParNMPC& parnmpc,
                                              const int nthreads)
   : robots_(nthreads, parnmpc.robot()),
     parnmpc_(parnmpc),
-    backward_correction_(parnmpc, nthreads),
+    backward_correction_(parnmpc, nthreads, solver_options.num_blocks_parnmpc),
     line_search_(parnmpc, nthreads),
     kkt_matrix_(parnmpc.robot(), parnmpc.N()),
     kkt_residual_(parnmpc.robot(), parnmpc.N()),
@@ -48,6 +48,7 @@ UnconstrParNMPCSolver::~UnconstrParNMPCSolver() {
 
 void UnconstrParNMPCSolver::setSolverOptions(const SolverOptions& solver_options) {
   solver_options_ = solver_options;
+  backward_correction_.setNumBlocks(solver_options.num_blocks_parnmpc);
 }
 
 
@@ -67,7 +68,8 @@ void UnconstrParNMPCSolver::initConstraints() {
 
 void UnconstrParNMPCSolver::initBackwardCorrection(const double t) {
   backward_correction_.initAuxMat(robots_, parnmpc_, t, s_, 
-                                  kkt_matrix_, kkt_residual_);
+                                  kkt_matrix_, kkt_residual_,
+                                  solver_options_.aux_mat_initialization);
 }
 
 
@@ -116,6 +118,12 @@ void UnconstrParNMPCSolver::solve(const double t, const Eigen::VectorXd& q,
     initBackwardCorrection(t);
     line_search_.clearFilter();
   }
+  else if (solver_options_.aux_mat_initialization 
+              == AuxMatInitialization::Shift) {
+    // The auxiliary matrices of the previous solve are shifted to the current 
+    // horizon also in the warm-started solves.
+    initBackwardCorrection(t);
+  }
   solver_statistics_.clear(); 
   for (int iter=0; iter<solver_options_.max_iter; ++iter) {
     updateSolution(t, q, v);
@@ -66,6 +66,11 @@ void SplitUnconstrOCP::initConstraints(Robot& robot, const int time_step,
 }
 
 
+void SplitUnconstrOCP::initConstraints(Robot& robot, const SplitSolution& s) { 
+  constraints_->setSlackAndDual(robot, contact_status_, constraints_data_, s);
+}
+
+
 void SplitUnconstrOCP::evalOCP(Robot& robot, const GridInfo& grid_info,
                                const SplitSolution& s, 
                                const Eigen::VectorXd& q_next, 
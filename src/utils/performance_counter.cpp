@@ -0,0 +1,255 @@
+#include "robotoc/utils/performance_counter.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <cstdlib>
+#include <algorithm>
+
+#include <omp.h>
+
+#ifdef __linux__
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#endif
+
+
+namespace robotoc {
+
+namespace {
+
+#ifdef __linux__
+constexpr int kNumEvents = 4;
+
+const std::uint64_t kEventConfigs[kNumEvents] = {
+  PERF_COUNT_HW_CPU_CYCLES,
+  PERF_COUNT_HW_INSTRUCTIONS,
+  PERF_COUNT_HW_CACHE_MISSES,
+  PERF_COUNT_HW_BRANCH_MISSES
+};
+
+int openEvent(const std::uint64_t config, const int group_fd) {
+  perf_event_attr attr;
+  std::memset(&attr, 0, sizeof(attr));
+  attr.size = sizeof(attr);
+  attr.type = PERF_TYPE_HARDWARE;
+  attr.config = config;
+  attr.disabled = (group_fd == -1) ? 1 : 0;
+  attr.exclude_kernel = 1;
+  attr.exclude_hv = 1;
+  attr.read_format = PERF_FORMAT_GROUP
+                      | PERF_FORMAT_TOTAL_TIME_ENABLED
+                      | PERF_FORMAT_TOTAL_TIME_RUNNING;
+  // pid = 0 and cpu = -1: the calling thread on any CPU.
+  return static_cast<int>(syscall(__NR_perf_event_open, &attr, 0, -1,
+                                  group_fd, 0));
+}
+#endif
+
+} // namespace
+
+
+std::string solverPhaseName(const SolverPhase phase) {
+  switch (phase) {
+    case SolverPhase::KKTSystem:
+      return "KKT system";
+    case SolverPhase::BackwardRiccati:
+      return "backward Riccati";
+    case SolverPhase::ForwardRiccati:
+      return "forward Riccati";
+    case SolverPhase::LineSearch:
+      return "line search";
+    case SolverPhase::Integration:
+      return "integration";
+    default:
+      return "";
+  }
+}
+
+
+PerformanceCounter::PerformanceCounter(const int nthreads)
+  : nthreads_(nthreads),
+    is_open_(false),
+    is_available_(false),
+    fds_(),
+    start_counts_(nthreads),
+    counts_(kNumSolverPhases, std::vector<PerformanceCounts>(nthreads)),
+    cpu_time_(kNumSolverPhases, 0.0),
+    timer_() {
+  try {
+    if (nthreads <= 0) {
+      throw std::out_of_range("invalid argument: nthreads must be positive!");
+    }
+  }
+  catch(const std::exception& e) {
+    std::cerr << e.what() << '\n';
+    std::exit(EXIT_FAILURE);
+  }
+}
+
+
+PerformanceCounter::PerformanceCounter()
+  : nthreads_(0),
+    is_open_(false),
+    is_available_(false),
+    fds_(),
+    start_counts_(),
+    counts_(kNumSolverPhases),
+    cpu_time_(kNumSolverPhases, 0.0),
+    timer_() {
+}
+
+
+PerformanceCounter::~PerformanceCounter() {
+  close();
+}
+
+
+PerformanceCounter::PerformanceCounter(const PerformanceCounter& other)
+  : nthreads_(other.nthreads_),
+    is_open_(false),
+    is_available_(false),
+    fds_(),
+    start_counts_(other.start_counts_),
+    counts_(other.counts_),
+    cpu_time_(other.cpu_time_),
+    timer_(other.timer_) {
+}
+
+
+PerformanceCounter& PerformanceCounter::operator=(
+    const PerformanceCounter& other) {
+  if (this != &other) {
+    close();
+    nthreads_ = other.nthreads_;
+    start_counts_ = other.start_counts_;
+    counts_ = other.counts_;
+    cpu_time_ = other.cpu_time_;
+    timer_ = other.timer_;
+  }
+  return *this;
+}
+
+
+bool PerformanceCounter::open() {
+  if (is_open_) return is_available_;
+  is_open_ = true;
+  is_available_ = false;
+#ifdef __linux__
+  fds_.assign(nthreads_, std::vector<int>(kNumEvents, -1));
+  std::vector<int> succeeded(nthreads_, 0);
+  #pragma omp parallel num_threads(nthreads_)
+  {
+    const int thread = omp_get_thread_num();
+    if (thread < nthreads_) {
+      bool ok = true;
+      for (int i=0; i<kNumEvents && ok; ++i) {
+        const int group_fd = (i == 0) ? -1 : fds_[thread][0];
+        fds_[thread][i] = openEvent(kEventConfigs[i], group_fd);
+        ok = (fds_[thread][i] >= 0);
+      }
+      if (ok) {
+        ok = (ioctl(fds_[thread][0], PERF_EVENT_IOC_ENABLE,
+                    PERF_IOC_FLAG_GROUP) == 0);
+      }
+      succeeded[thread] = ok ? 1 : 0;
+    }
+  }
+  is_available_ = true;
+  for (int i=0; i<nthreads_; ++i) {
+    if (!succeeded[i]) is_available_ = false;
+  }
+  if (!is_available_) {
+    close();
+    is_open_ = true;
+  }
+#endif
+  return is_available_;
+}
+
+
+void PerformanceCounter::close() {
+#ifdef __linux__
+  for (auto& fds : fds_) {
+    for (auto& fd : fds) {
+      if (fd >= 0) {
+        ::close(fd);
+        fd = -1;
+      }
+    }
+  }
+#endif
+  fds_.clear();
+  is_open_ = false;
+  is_available_ = false;
+}
+
+
+void PerformanceCounter::start() {
+  if (is_available_) {
+    for (int i=0; i<nthreads_; ++i) {
+      readCounts(i, start_counts_[i]);
+    }
+  }
+  timer_.tick();
+}
+
+
+void PerformanceCounter::stop(const SolverPhase phase) {
+  timer_.tock();
+  const int p = static_cast<int>(phase);
+  cpu_time_[p] += timer_.ms();
+  if (is_available_) {
+    PerformanceCounts stop_counts;
+    for (int i=0; i<nthreads_; ++i) {
+      if (readCounts(i, stop_counts)) {
+        counts_[p][i].cycles += stop_counts.cycles - start_counts_[i].cycles;
+        counts_[p][i].instructions
+            += stop_counts.instructions - start_counts_[i].instructions;
+        counts_[p][i].cache_misses
+            += stop_counts.cache_misses - start_counts_[i].cache_misses;
+        counts_[p][i].branch_misses
+            += stop_counts.branch_misses - start_counts_[i].branch_misses;
+      }
+    }
+  }
+}
+
+
+void PerformanceCounter::reset() {
+  for (auto& phase_counts : counts_) {
+    for (auto& e : phase_counts) {
+      e.setZero();
+    }
+  }
+  std::fill(cpu_time_.begin(), cpu_time_.end(), 0.0);
+}
+
+
+bool PerformanceCounter::readCounts(const int thread,
+                                    PerformanceCounts& counts) const {
+#ifdef __linux__
+  // Layout of PERF_FORMAT_GROUP with the enabled and running times:
+  // { nr, time_enabled, time_running, value[nr] }.
+  std::uint64_t buf[3+kNumEvents];
+  const ssize_t size = ::read(fds_[thread][0], buf, sizeof(buf));
+  if (size != static_cast<ssize_t>(sizeof(buf)) || buf[0] != kNumEvents) {
+    return false;
+  }
+  double scale = 1.0;
+  if (buf[2] > 0 && buf[2] < buf[1]) {
+    scale = static_cast<double>(buf[1]) / static_cast<double>(buf[2]);
+  }
+  counts.cycles = static_cast<long long>(scale * buf[3]);
+  counts.instructions = static_cast<long long>(scale * buf[4]);
+  counts.cache_misses = static_cast<long long>(scale * buf[5]);
+  counts.branch_misses = static_cast<long long>(scale * buf[6]);
+  return true;
+#else
+  return false;
+#endif
+}
+
+} // namespace robotoc
@@ -0,0 +1,416 @@
+#include <memory>
+#include <vector>
+#include <cmath>
+#include <algorithm>
+
+#include <gtest/gtest.h>
+#include "Eigen/Core"
+
+#include "robotoc/robot/robot.hpp"
+#include "robotoc/ocp/split_solution.hpp"
+#include "robotoc/ocp/split_direction.hpp"
+#include "robotoc/ocp/split_kkt_matrix.hpp"
+#include "robotoc/ocp/split_kkt_residual.hpp"
+#include "robotoc/constraints/collision_avoidance.hpp"
+#include "robotoc/constraints/pdipm.hpp"
+
+#include "robot_factory.hpp"
+
+namespace robotoc {
+
+class CollisionAvoidanceTest : public ::testing::Test {
+protected:
+  virtual void SetUp() {
+    srand((unsigned int) time(0));
+    barrier = 1.0e-03;
+    dt = std::abs(Eigen::VectorXd::Random(1)[0]);
+    min_distance = 0.01;
+  }
+
+  virtual void TearDown() {
+  }
+
+  // Adds the spheres attached to the frames, the obstacles, and all the pairs.
+  void addSpheres(CollisionAvoidance& constr,
+                  const std::vector<int>& frames) const;
+  Eigen::VectorXd distances(Robot& robot, const CollisionAvoidance& constr,
+                            const std::vector<int>& frames,
+                            const Eigen::VectorXd& q) const;
+  Eigen::MatrixXd numericalJacobian(Robot& robot,
+                                    const CollisionAvoidance& constr,
+                                    const std::vector<int>& frames,
+                                    const Eigen::VectorXd& q) const;
+
+  void test_kinematics(Robot& robot, const std::vector<int>& frames) const;
+  void test_isFeasible(Robot& robot, const std::vector<int>& frames) const;
+  void test_setSlack(Robot& robot, const std::vector<int>& frames) const;
+  void test_evalConstraint(Robot& robot, const std::vector<int>& frames) const;
+  void test_broadPhase(Robot& robot, const std::vector<int>& frames) const;
+  void test_activation(Robot& robot, const std::vector<int>& frames) const;
+  void test_evalDerivatives(Robot& robot, const std::vector<int>& frames) const;
+  void test_condenseSlackAndDual(Robot& robot,
+                                 const std::vector<int>& frames) const;
+  void test_expandSlackAndDual(Robot& robot,
+                               const std::vector<int>& frames) const;
+
+  double barrier, dt, min_distance;
+};
+
+
+void CollisionAvoidanceTest::addSpheres(CollisionAvoidance& constr,
+                                        const std::vector<int>& frames) const {
+  for (const auto frame : frames) {
+    constr.addCollisionSphere(frame, Eigen::Vector3d(0.01, 0.02, 0.03), 0.05);
+  }
+  constr.addObstacleSphere(Eigen::Vector3d(0.5, 0.0, 0.5), 0.1);
+  constr.addObstacleSphere(Eigen::Vector3d(-0.3, 0.4, 0.2), 0.05);
+  for (int i=0; i<frames.size(); ++i) {
+    for (int j=i+1; j<frames.size(); ++j) {
+      constr.addCollisionPair(i, j);
+    }
+  }
+  constr.addEnvironmentCollisionPairs();
+}
+
+
+Eigen::VectorXd CollisionAvoidanceTest::distances(
+    Robot& robot, const CollisionAvoidance& constr,
+    const std::vector<int>& frames, const Eigen::VectorXd& q) const {
+  robot.updateFrameKinematics(q);
+  const int num_frames = frames.size();
+  std::vector<Eigen::Vector3d> p;
+  std::vector<double> r;
+  for (const auto frame : frames) {
+    p.push_back(robot.framePosition(frame)
+                  +robot.frameRotation(frame)*Eigen::Vector3d(0.01, 0.02, 0.03));
+    r.push_back(0.05);
+  }
+  p.push_back(Eigen::Vector3d(0.5, 0.0, 0.5));
+  r.push_back(0.1);
+  p.push_back(Eigen::Vector3d(-0.3, 0.4, 0.2));
+  r.push_back(0.05);
+  std::vector<std::pair<int, int>> pairs;
+  for (int i=0; i<num_frames; ++i) {
+    for (int j=i+1; j<num_frames; ++j) {
+      pairs.push_back(std::make_pair(i, j));
+    }
+  }
+  for (int i=0; i<num_frames; ++i) {
+    pairs.push_back(std::make_pair(i, num_frames));
+    pairs.push_back(std::make_pair(i, num_frames+1));
+  }
+  EXPECT_EQ(pairs.size(), constr.numCollisionPairs());
+  Eigen::VectorXd d(pairs.size());
+  for (int i=0; i<pairs.size(); ++i) {
+    const int a = pairs[i].first;
+    const int b = pairs[i].second;
+    d.coeffRef(i) = (p[a]-p[b]).norm() - r[a] - r[b];
+  }
+  return d;
+}
+
+
+Eigen::MatrixXd CollisionAvoidanceTest::numericalJacobian(
+    Robot& robot, const CollisionAvoidance& constr,
+    const std::vector<int>& frames, const Eigen::VectorXd& q) const {
+  const double eps = 1.0e-07;
+  const Eigen::VectorXd d0 = distances(robot, constr, frames, q);
+  Eigen::MatrixXd J(constr.numCollisionPairs(), robot.dimv());
+  Eigen::VectorXd q_plus(q.size());
+  for (int i=0; i<robot.dimv(); ++i) {
+    Eigen::VectorXd dv = Eigen::VectorXd::Zero(robot.dimv());
+    dv.coeffRef(i) = 1.0;
+    robot.integrateConfiguration(q, dv, eps, q_plus);
+    J.col(i) = (distances(robot, constr, frames, q_plus) - d0) / eps;
+  }
+  return J;
+}
+
+
+void CollisionAvoidanceTest::test_kinematics(
+    Robot& robot, const std::vector<int>& frames) const {
+  CollisionAvoidance constr(robot, min_distance);
+  addSpheres(constr, frames);
+  const int num_frames = frames.size();
+  EXPECT_TRUE(constr.useKinematics());
+  EXPECT_TRUE(constr.kinematicsLevel() == KinematicsLevel::PositionLevel);
+  EXPECT_EQ(constr.numSpheres(), num_frames+2);
+  EXPECT_EQ(constr.numCollisionPairs(), num_frames*(num_frames-1)/2+2*num_frames);
+  EXPECT_EQ(constr.dimc(), constr.numCollisionPairs());
+  // Duplicated pairs are ignored.
+  constr.addCollisionPair(1, 0);
+  EXPECT_EQ(constr.dimc(), num_frames*(num_frames-1)/2+2*num_frames);
+}
+
+
+void CollisionAvoidanceTest::test_isFeasible(
+    Robot& robot, const std::vector<int>& frames) const {
+  CollisionAvoidance constr(robot, min_distance);
+  addSpheres(constr, frames);
+  ConstraintComponentData data(constr.dimc(), constr.barrier());
+  constr.allocateExtraData(data);
+  const auto contact_status = robot.createContactStatus();
+  const auto s = SplitSolution::Random(robot);
+  const Eigen::VectorXd d = distances(robot, constr, frames, s.q);
+  const bool feasible = (d.minCoeff() >= min_distance);
+  EXPECT_EQ(constr.isFeasible(robot, contact_status, data, s), feasible);
+  // An obstacle on the first sphere makes the solution infeasible.
+  robot.updateFrameKinematics(s.q);
+  const Eigen::Vector3d p = robot.framePosition(frames[0])
+      + robot.frameRotation(frames[0]) * Eigen::Vector3d(0.01, 0.02, 0.03);
+  constr.setObstaclePosition(frames.size(), p);
+  EXPECT_FALSE(constr.isFeasible(robot, contact_status, data, s));
+}
+
+
+void CollisionAvoidanceTest::test_setSlack(
+    Robot& robot, const std::vector<int>& frames) const {
+  CollisionAvoidance constr(robot, min_distance);
+  addSpheres(constr, frames);
+  ConstraintComponentData data(constr.dimc(), constr.barrier());
+  constr.allocateExtraData(data);
+  const auto contact_status = robot.createContactStatus();
+  const auto s = SplitSolution::Random(robot);
+  constr.setSlack(robot, contact_status, data, s);
+  const Eigen::VectorXd d = distances(robot, constr, frames, s.q);
+  EXPECT_TRUE(data.slack.isApprox((d.array()-min_distance).matrix()));
+}
+
+
+void CollisionAvoidanceTest::test_evalConstraint(
+    Robot& robot, const std::vector<int>& frames) const {
+  // All the pairs are active with a large activation distance.
+  CollisionAvoidance constr(robot, min_distance, 100.0);
+  addSpheres(constr, frames);
+  ConstraintComponentData data(constr.dimc(), constr.barrier());
+  constr.allocateExtraData(data);
+  const auto contact_status = robot.createContactStatus();
+  const auto s = SplitSolution::Random(robot);
+  data.slack.setRandom();
+  data.dual.setRandom();
+  data.slack = data.slack.array().abs();
+  data.dual = data.dual.array().abs();
+  auto data_ref = data;
+  robot.updateKinematics(s.q);
+  constr.evalConstraint(robot, contact_status, data, s);
+  const Eigen::VectorXd d = distances(robot, constr, frames, s.q);
+  for (int i=0; i<constr.dimc(); ++i) {
+    EXPECT_TRUE(constr.isActive(data, i));
+    EXPECT_NEAR(constr.distance(data, i), d.coeff(i), 1.0e-12);
+  }
+  data_ref.residual = min_distance - d.array() + data_ref.slack.array();
+  pdipm::computeComplementarySlackness(barrier, data_ref);
+  data_ref.log_barrier = pdipm::logBarrier(barrier, data_ref.slack);
+  EXPECT_TRUE(data.residual.isApprox(data_ref.residual));
+  EXPECT_TRUE(data.cmpl.isApprox(data_ref.cmpl));
+  EXPECT_DOUBLE_EQ(data.log_barrier, data_ref.log_barrier);
+}
+
+
+void CollisionAvoidanceTest::test_broadPhase(
+    Robot& robot, const std::vector<int>& frames) const {
+  const double activation_distance = 0.2;
+  CollisionAvoidance constr(robot, min_distance, activation_distance);
+  addSpheres(constr, frames);
+  ConstraintComponentData data(constr.dimc(), constr.barrier());
+  constr.allocateExtraData(data);
+  const auto contact_status = robot.createContactStatus();
+  data.slack.setRandom();
+  data.slack = data.slack.array().abs();
+  // The order of the sweep is reused over the evaluations.
+  auto s = SplitSolution::Random(robot);
+  for (int k=0; k<10; ++k) {
+    robot.integrateConfiguration(Eigen::VectorXd::Random(robot.dimv()), 0.05,
+                                 s.q);
+    robot.updateKinematics(s.q);
+    constr.evalConstraint(robot, contact_status, data, s);
+    const Eigen::VectorXd d = distances(robot, constr, frames, s.q);
+    for (int i=0; i<constr.dimc(); ++i) {
+      const bool active = (d.coeff(i) < activation_distance);
+      EXPECT_EQ(constr.isActive(data, i), active);
+      if (active) {
+        EXPECT_NEAR(constr.distance(data, i), d.coeff(i), 1.0e-12);
+        EXPECT_DOUBLE_EQ(data.residual.coeff(i),
+                         min_distance-d.coeff(i)+data.slack.coeff(i));
+      }
+      else {
+        EXPECT_DOUBLE_EQ(data.residual.coeff(i), 0.0);
+      }
+    }
+  }
+}
+
+
+void CollisionAvoidanceTest::test_activation(
+    Robot& robot, const std::vector<int>& frames) const {
+  const double activation_distance = 0.2;
+  CollisionAvoidance constr(robot, min_distance, activation_distance);
+  addSpheres(constr, frames);
+  ConstraintComponentData data(constr.dimc(), constr.barrier());
+  constr.allocateExtraData(data);
+  const auto contact_status = robot.createContactStatus();
+  auto s = SplitSolution::Random(robot);
+  constr.setSlack(robot, contact_status, data, s);
+  std::vector<bool> active_prev(constr.dimc(), true);
+  for (int k=0; k<10; ++k) {
+    robot.integrateConfiguration(Eigen::VectorXd::Random(robot.dimv()), 0.05,
+                                 s.q);
+    // Stale slack and dual of the inactive pairs.
+    for (int i=0; i<constr.dimc(); ++i) {
+      if (!active_prev[i]) {
+        data.slack.coeffRef(i) = std::abs(Eigen::VectorXd::Random(1).coeff(0));
+        data.dual.coeffRef(i) = std::abs(Eigen::VectorXd::Random(1).coeff(0));
+      }
+    }
+    auto data_ref = data;
+    robot.updateKinematics(s.q);
+    constr.evalConstraint(robot, contact_status, data, s);
+    auto kkt_res = SplitKKTResidual::Random(robot);
+    constr.evalDerivatives(robot, contact_status, data, s, kkt_res);
+    const Eigen::VectorXd d = distances(robot, constr, frames, s.q);
+    for (int i=0; i<constr.dimc(); ++i) {
+      if (constr.isActive(data, i) && !active_prev[i]) {
+        const double slack = std::max(d.coeff(i)-min_distance, std::sqrt(barrier));
+        EXPECT_NEAR(data.slack.coeff(i), slack, 1.0e-12);
+        EXPECT_NEAR(data.slack.coeff(i)*data.dual.coeff(i), barrier, 1.0e-12);
+        EXPECT_NEAR(data.residual.coeff(i), min_distance-d.coeff(i)+slack, 1.0e-12);
+        EXPECT_NEAR(data.cmpl.coeff(i), 0.0, 1.0e-12);
+      }
+      else {
+        EXPECT_DOUBLE_EQ(data.slack.coeff(i), data_ref.slack.coeff(i));
+        EXPECT_DOUBLE_EQ(data.dual.coeff(i), data_ref.dual.coeff(i));
+      }
+      active_prev[i] = constr.isActive(data, i);
+    }
+    EXPECT_DOUBLE_EQ(data.log_barrier, pdipm::logBarrier(barrier, data.slack));
+  }
+}
+
+
+void CollisionAvoidanceTest::test_evalDerivatives(
+    Robot& robot, const std::vector<int>& frames) const {
+  CollisionAvoidance constr(robot, min_distance, 100.0);
+  addSpheres(constr, frames);
+  ConstraintComponentData data(constr.dimc(), constr.barrier());
+  constr.allocateExtraData(data);
+  const auto contact_status = robot.createContactStatus();
+  const auto s = SplitSolution::Random(robot);
+  data.slack.setRandom();
+  data.dual.setRandom();
+  data.slack = data.slack.array().abs();
+  data.dual = data.dual.array().abs();
+  robot.updateKinematics(s.q);
+  constr.evalConstraint(robot, contact_status, data, s);
+  auto kkt_res = SplitKKTResidual::Random(robot);
+  auto kkt_res_ref = kkt_res;
+  constr.evalDerivatives(robot, contact_status, data, s, kkt_res);
+  const Eigen::MatrixXd J = numericalJacobian(robot, constr, frames, s.q);
+  kkt_res_ref.lq().noalias() -= J.transpose() * data.dual;
+  EXPECT_TRUE(kkt_res.lq().isApprox(kkt_res_ref.lq(), 1.0e-05));
+}
+
+
+void CollisionAvoidanceTest::test_condenseSlackAndDual(
+    Robot& robot, const std::vector<int>& frames) const {
+  CollisionAvoidance constr(robot, min_distance, 100.0);
+  addSpheres(constr, frames);
+  ConstraintComponentData data(constr.dimc(), constr.barrier());
+  constr.allocateExtraData(data);
+  const auto contact_status = robot.createContactStatus();
+  const auto s = SplitSolution::Random(robot);
+  data.slack.setRandom();
+  data.dual.setRandom();
+  data.slack = data.slack.array().abs();
+  data.dual = data.dual.array().abs();
+  robot.updateKinematics(s.q);
+  constr.evalConstraint(robot, contact_status, data, s);
+  auto kkt_res = SplitKKTResidual::Random(robot);
+  constr.evalDerivatives(robot, contact_status, data, s, kkt_res);
+  auto data_ref = data;
+  auto kkt_mat = SplitKKTMatrix::Random(robot);
+  auto kkt_mat_ref = kkt_mat;
+  auto kkt_res_ref = kkt_res;
+  constr.condenseSlackAndDual(contact_status, data, kkt_mat, kkt_res);
+  const Eigen::MatrixXd J = numericalJacobian(robot, constr, frames, s.q);
+  pdipm::computeCondensingCoeffcient(data_ref);
+  kkt_mat_ref.Qqq().noalias()
+      += J.transpose() * (data_ref.dual.array()/data_ref.slack.array()).matrix().asDiagonal() * J;
+  kkt_res_ref.lq().noalias() -= J.transpose() * data_ref.cond;
+  EXPECT_TRUE(kkt_mat.Qqq().isApprox(kkt_mat_ref.Qqq(), 1.0e-05));
+  EXPECT_TRUE(kkt_res.lq().isApprox(kkt_res_ref.lq(), 1.0e-05));
+  EXPECT_TRUE(kkt_mat.Qqq().isApprox(kkt_mat.Qqq().transpose()));
+}
+
+
+void CollisionAvoidanceTest::test_expandSlackAndDual(
+    Robot& robot, const std::vector<int>& frames) const {
+  CollisionAvoidance constr(robot, min_distance, 100.0);
+  addSpheres(constr, frames);
+  ConstraintComponentData data(constr.dimc(), constr.barrier());
+  constr.allocateExtraData(data);
+  const auto contact_status = robot.createContactStatus();
+  const auto s = SplitSolution::Random(robot);
+  data.slack.setRandom();
+  data.dual.setRandom();
+  data.slack = data.slack.array().abs();
+  data.dual = data.dual.array().abs();
+  robot.updateKinematics(s.q);
+  constr.evalConstraint(robot, contact_status, data, s);
+  auto kkt_res = SplitKKTResidual::Random(robot);
+  constr.evalDerivatives(robot, contact_status, data, s, kkt_res);
+  data.residual.setRandom();
+  data.cmpl.setRandom();
+  auto data_ref = data;
+  const auto d = SplitDirection::Random(robot);
+  constr.expandSlackAndDual(contact_status, data, d);
+  const Eigen::MatrixXd J = numericalJacobian(robot, constr, frames, s.q);
+  data_ref.dslack = J * d.dq() - data_ref.residual;
+  pdipm::computeDualDirection(data_ref);
+  EXPECT_TRUE(data.dslack.isApprox(data_ref.dslack, 1.0e-05));
+  EXPECT_TRUE(data.ddual.isApprox(data_ref.ddual, 1.0e-05));
+}
+
+
+TEST_F(CollisionAvoidanceTest, defaultConstructor) {
+  EXPECT_NO_THROW(
+    auto constr = std::make_shared<CollisionAvoidance>();
+  );
+}
+
+
+TEST_F(CollisionAvoidanceTest, fixedBase) {
+  auto robot = testhelper::CreateRobotManipulator(dt);
+  const std::vector<int> frames = {10, 14, 18};
+  test_kinematics(robot, frames);
+  test_isFeasible(robot, frames);
+  test_setSlack(robot, frames);
+  test_evalConstraint(robot, frames);
+  test_broadPhase(robot, frames);
+  test_activation(robot, frames);
+  test_evalDerivatives(robot, frames);
+  test_condenseSlackAndDual(robot, frames);
+  test_expandSlackAndDual(robot, frames);
+}
+
+
+TEST_F(CollisionAvoidanceTest, floatingBase) {
+  auto robot = testhelper::CreateQuadrupedalRobot(dt);
+  const std::vector<int> frames = robot.contactFrames();
+  test_kinematics(robot, frames);
+  test_isFeasible(robot, frames);
+  test_setSlack(robot, frames);
+  test_evalConstraint(robot, frames);
+  test_broadPhase(robot, frames);
+  test_activation(robot, frames);
+  test_evalDerivatives(robot, frames);
+  test_condenseSlackAndDual(robot, frames);
+  test_expandSlackAndDual(robot, frames);
+}
+
+} // namespace robotoc
+
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
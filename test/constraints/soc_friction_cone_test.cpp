@@ -0,0 +1,463 @@
+#include <memory>
+
+#include <gtest/gtest.h>
+#include "Eigen/Core"
+#include "Eigen/Geometry"
+
+#include "robotoc/robot/robot.hpp"
+#include "robotoc/robot/contact_status.hpp"
+#include "robotoc/ocp/split_solution.hpp"
+#include "robotoc/ocp/split_direction.hpp"
+#include "robotoc/ocp/split_kkt_matrix.hpp"
+#include "robotoc/ocp/split_kkt_residual.hpp"
+#include "robotoc/constraints/soc_pdipm.hpp"
+#include "robotoc/constraints/soc_friction_cone.hpp"
+
+#include "robot_factory.hpp"
+
+namespace robotoc {
+
+class SOCFrictionConeTest : public ::testing::Test {
+protected:
+  virtual void SetUp() {
+    srand((unsigned int) time(0));
+    barrier = 1.0e-03;
+    dt = std::abs(Eigen::VectorXd::Random(1)[0]);
+    mu = 0.7;
+    fraction_to_boundary_rule = 0.995;
+    cone.resize(3, 3);
+    cone.setZero();
+    cone <<  0,  0, -mu, 
+            -1,  0,  0,
+             0, -1,  0;
+    contact_surface = Eigen::Quaterniond::UnitRandom().toRotationMatrix();
+    cone_surface_local = cone * contact_surface.transpose();
+  }
+
+  virtual void TearDown() {
+  }
+
+  void test_kinematics(Robot& robot, const ContactStatus& contact_status) const;
+  void test_isFeasible(Robot& robot, const ContactStatus& contact_status) const;
+  void test_setSlack(Robot& robot, const ContactStatus& contact_status) const;
+  void test_evalConstraint(Robot& robot, const ContactStatus& contact_status) const;
+  void test_evalDerivatives(Robot& robot, const ContactStatus& contact_status) const;
+  void test_condenseSlackAndDual(Robot& robot, 
+                                const ContactStatus& contact_status) const;
+  void test_expandSlackAndDual(Robot& robot, const ContactStatus& contact_status) const;
+  void test_stepSize(Robot& robot, const ContactStatus& contact_status) const;
+
+  static void setRandomInterior(ConstraintComponentData& data) {
+    for (int i=0; i<data.dimc(); i+=3) {
+      Eigen::Vector3d s = Eigen::Vector3d::Random();
+      s.coeffRef(0) = s.tail<2>().norm() + std::abs(s.coeff(0)) + 0.01;
+      Eigen::Vector3d z = Eigen::Vector3d::Random();
+      z.coeffRef(0) = z.tail<2>().norm() + std::abs(z.coeff(0)) + 0.01;
+      data.slack.segment<3>(i) = s;
+      data.dual.segment<3>(i) = z;
+    }
+  }
+
+  double barrier, dt, mu, fraction_to_boundary_rule;
+  Eigen::MatrixXd cone, cone_surface_local;
+  Eigen::Matrix3d contact_surface;
+};
+
+
+void SOCFrictionConeTest::test_kinematics(Robot& robot, 
+                                      const ContactStatus& contact_status) const {
+  SOCFrictionCone constr(robot, mu); 
+  EXPECT_TRUE(constr.useKinematics());
+  EXPECT_TRUE(constr.kinematicsLevel() == KinematicsLevel::AccelerationLevel);
+}
+
+
+void SOCFrictionConeTest::test_isFeasible(Robot& robot, 
+                                      const ContactStatus& contact_status) const {
+  SOCFrictionCone constr(robot, mu); 
+  ConstraintComponentData data(constr.dimc(), constr.barrier());
+  constr.allocateExtraData(data);
+  EXPECT_EQ(constr.dimc(), 3*contact_status.maxNumContacts());
+  const auto s = SplitSolution::Random(robot, contact_status);
+  robot.updateFrameKinematics(s.q);
+  if (contact_status.hasActiveContacts()) {
+    bool feasible = true;
+    for (int i=0; i<contact_status.maxNumContacts(); ++i) {
+      if (contact_status.isContactActive(i)) {
+        Eigen::Vector3d f_world = Eigen::Vector3d::Zero();
+        robot.transformFromLocalToWorld(robot.contactFrames()[i], s.f[i].template head<3>(), f_world);
+        Eigen::VectorXd res =  Eigen::VectorXd::Zero(3);
+        SOCFrictionCone::frictionConeResidual(mu, f_world, contact_surface, res);
+        if (res.tail(2).norm() > - res.coeff(0)) {
+          feasible = false;
+        }
+      }
+    }
+    EXPECT_EQ(constr.isFeasible(robot, contact_status, data, s), feasible);
+  }
+}
+
+
+void SOCFrictionConeTest::test_setSlack(Robot& robot, const ContactStatus& contact_status) const {
+  SOCFrictionCone constr(robot, mu); 
+  ConstraintComponentData data(constr.dimc(), constr.barrier()), data_ref(constr.dimc(), constr.barrier());
+  constr.allocateExtraData(data);
+  constr.allocateExtraData(data_ref);
+  const int dimc = constr.dimc();
+  const auto s = SplitSolution::Random(robot, contact_status);
+  robot.updateFrameKinematics(s.q);
+  constr.setSlack(robot, contact_status, data, s);
+  for (int i=0; i<contact_status.maxNumContacts(); ++i) {
+    Eigen::Vector3d f_world = Eigen::Vector3d::Zero();
+    robot.transformFromLocalToWorld(robot.contactFrames()[i], s.f[i].template head<3>(), f_world);
+    SOCFrictionCone::frictionConeResidual(mu, f_world, contact_surface, data_ref.residual.segment(3*i, 3));
+    data_ref.slack.segment(3*i, 3) = - data_ref.residual.segment(3*i, 3);
+  }
+  EXPECT_TRUE(data.isApprox(data_ref));
+}
+
+
+void SOCFrictionConeTest::test_evalConstraint(Robot& robot, const ContactStatus& contact_status) const {
+  SOCFrictionCone constr(robot, mu); 
+  const int dimc = constr.dimc();
+  const auto s = SplitSolution::Random(robot, contact_status);
+  robot.updateKinematics(s.q);
+  ConstraintComponentData data(constr.dimc(), constr.barrier());
+  constr.allocateExtraData(data);
+  setRandomInterior(data);
+  data.residual.setRandom();
+  data.cmpl.setRandom();
+  auto data_ref = data;
+  constr.evalConstraint(robot, contact_status, data, s);
+  data_ref.residual.setZero();
+  data_ref.cmpl.setZero();
+  data_ref.log_barrier = 0;
+  for (int i=0; i<contact_status.maxNumContacts(); ++i) {
+    if (contact_status.isContactActive(i)) {
+      Eigen::Vector3d f_world = Eigen::Vector3d::Zero();
+      robot.transformFromLocalToWorld(robot.contactFrames()[i], s.f[i].template head<3>(), f_world);
+      SOCFrictionCone::frictionConeResidual(mu, f_world, contact_surface, data_ref.residual.segment(3*i, 3));
+      data_ref.residual.template segment<3>(3*i) += data_ref.slack.segment(3*i, 3);
+      data_ref.cmpl.coeffRef(3*i) 
+          = data_ref.slack.segment(3*i, 3).dot(data_ref.dual.segment(3*i, 3)) - barrier;
+      data_ref.cmpl.segment(3*i+1, 2)
+          = data_ref.slack.coeff(3*i) * data_ref.dual.segment(3*i+1, 2)
+              + data_ref.dual.coeff(3*i) * data_ref.slack.segment(3*i+1, 2);
+      data_ref.log_barrier += socpdipm::logBarrier(barrier, data_ref.slack.segment(3*i, 3));
+    }
+  }
+  EXPECT_TRUE(data.isApprox(data_ref));
+}
+
+
+void SOCFrictionConeTest::test_evalDerivatives(Robot& robot, const ContactStatus& contact_status) const {
+  SOCFrictionCone constr(robot, mu); 
+  ConstraintComponentData data(constr.dimc(), constr.barrier());
+  constr.allocateExtraData(data);
+  const int dimc = constr.dimc();
+  const auto s = SplitSolution::Random(robot, contact_status);
+  robot.updateKinematics(s.q);
+  constr.setSlack(robot, contact_status, data, s);
+  setRandomInterior(data);
+  constr.evalConstraint(robot, contact_status, data, s);
+  auto data_ref = data;
+  auto kkt_res = SplitKKTResidual::Random(robot, contact_status);
+  auto kkt_res_ref = kkt_res;
+  constr.evalDerivatives(robot, contact_status, data, s, kkt_res);
+  int dimf_stack = 0;
+  for (int i=0; i<contact_status.maxNumContacts(); ++i) {
+    if (contact_status.isContactActive(i)) {
+      Eigen::Vector3d f_world = Eigen::Vector3d::Zero();
+      robot.transformFromLocalToWorld(robot.contactFrames()[i], s.f[i].template head<3>(), f_world);
+      Eigen::MatrixXd J = Eigen::MatrixXd::Zero(6, robot.dimv());
+      robot.getFrameJacobian(robot.contactFrames()[i], J);
+      Eigen::MatrixXd dfW_dq = Eigen::MatrixXd::Zero(3, robot.dimv());
+      for (int j=0; j<robot.dimv(); ++j) {
+        dfW_dq.col(j) = J.template bottomRows<3>().col(j).cross(f_world);
+      }
+      const Eigen::MatrixXd dg_dq = cone_surface_local * dfW_dq;
+      const Eigen::MatrixXd dg_df = cone_surface_local * robot.frameRotation(robot.contactFrames()[i]);
+      kkt_res_ref.lq().noalias() 
+          += dg_dq.transpose() * data_ref.dual.segment(3*i, 3);
+      kkt_res_ref.lf().segment(dimf_stack, 3)
+          += dg_df.transpose() * data_ref.dual.segment(3*i, 3);
+      switch (robot.contactType(i)) {
+        case ContactType::PointContact:
+          dimf_stack += 3;
+          break;
+        case ContactType::SurfaceContact:
+          dimf_stack += 6;
+          break;
+        default:
+          break;
+      }
+    }
+  }
+  EXPECT_TRUE(kkt_res.isApprox(kkt_res_ref));
+}
+
+
+void SOCFrictionConeTest::test_condenseSlackAndDual(Robot& robot, 
+                                                const ContactStatus& contact_status) const {
+  SOCFrictionCone constr(robot, mu); 
+  ConstraintComponentData data(constr.dimc(), constr.barrier());
+  constr.allocateExtraData(data);
+  const int dimc = constr.dimc();
+  const auto s = SplitSolution::Random(robot, contact_status);
+  robot.updateKinematics(s.q);
+  constr.setSlack(robot, contact_status, data, s);
+  setRandomInterior(data);
+  data.residual.setRandom();
+  data.cmpl.setRandom();
+  auto kkt_mat = SplitKKTMatrix::Random(robot, contact_status);
+  auto kkt_res = SplitKKTResidual::Random(robot, contact_status);
+  constr.evalConstraint(robot, contact_status, data, s);
+  constr.evalDerivatives(robot, contact_status, data, s, kkt_res);
+  auto data_ref = data;
+  auto kkt_mat_ref = kkt_mat;
+  auto kkt_res_ref = kkt_res;
+  constr.condenseSlackAndDual(contact_status, data, kkt_mat, kkt_res);
+  int dimf_stack = 0;
+  for (int i=0; i<contact_status.maxNumContacts(); ++i) {
+    if (contact_status.isContactActive(i)) {
+      Eigen::Vector3d f_world = Eigen::Vector3d::Zero();
+      robot.transformFromLocalToWorld(robot.contactFrames()[i], s.f[i].template head<3>(), f_world);
+      Eigen::MatrixXd J = Eigen::MatrixXd::Zero(6, robot.dimv());
+      robot.getFrameJacobian(robot.contactFrames()[i], J);
+      Eigen::MatrixXd dfW_dq = Eigen::MatrixXd::Zero(3, robot.dimv());
+      for (int j=0; j<robot.dimv(); ++j) {
+        dfW_dq.col(j) = J.template bottomRows<3>().col(j).cross(f_world);
+      }
+      const Eigen::MatrixXd dg_dq = cone_surface_local * dfW_dq;
+      const Eigen::MatrixXd dg_df = cone_surface_local * robot.frameRotation(robot.contactFrames()[i]);
+      Eigen::Matrix3d W, Winv;
+      socpdipm::computeNesterovToddScaling(data_ref.slack.segment(3*i, 3), 
+                                           data_ref.dual.segment(3*i, 3), W, Winv);
+      const Eigen::Vector3d lambda = W * data_ref.dual.segment(3*i, 3);
+      Eigen::Vector3d lambda_inv;
+      lambda_inv << lambda(0), -lambda(1), -lambda(2);
+      lambda_inv /= (lambda(0)*lambda(0)-lambda(1)*lambda(1)-lambda(2)*lambda(2));
+      const Eigen::Matrix3d H = Winv * Winv;
+      const Eigen::Vector3d r = barrier * Winv * lambda_inv 
+                                  - data_ref.dual.segment(3*i, 3)
+                                  + H * data_ref.residual.segment(3*i, 3);
+      kkt_res_ref.lq() += dg_dq.transpose() * r;
+      kkt_res_ref.lf().template segment<3>(dimf_stack) += dg_df.transpose() * r;
+      kkt_mat_ref.Qqq()
+          += dg_dq.transpose() * H * dg_dq;
+      kkt_mat_ref.Qqf().middleCols(dimf_stack, 3)
+          += dg_dq.transpose() * H * dg_df;
+      kkt_mat_ref.Qff().block(dimf_stack, dimf_stack, 3, 3)
+          += dg_df.transpose() * H * dg_df;
+      switch (robot.contactType(i)) {
+        case ContactType::PointContact:
+          dimf_stack += 3;
+          break;
+        case ContactType::SurfaceContact:
+          dimf_stack += 6;
+          break;
+        default:
+          break;
+      }
+    }
+  }
+  EXPECT_TRUE(kkt_res.isApprox(kkt_res_ref));
+  EXPECT_TRUE(kkt_mat.isApprox(kkt_mat_ref));
+}
+
+
+void SOCFrictionConeTest::test_expandSlackAndDual(Robot& robot, const ContactStatus& contact_status) const {
+  SOCFrictionCone constr(robot, mu); 
+  ConstraintComponentData data(constr.dimc(), constr.barrier());
+  constr.allocateExtraData(data);
+  const int dimc = constr.dimc();
+  const auto s = SplitSolution::Random(robot, contact_status);
+  constr.setSlack(robot, contact_status, data, s);
+  setRandomInterior(data);
+  data.residual.setRandom();
+  data.cmpl.setRandom();
+  data.dslack.setRandom();
+  data.ddual.setRandom();
+  auto kkt_mat = SplitKKTMatrix::Random(robot, contact_status);
+  auto kkt_res = SplitKKTResidual::Random(robot, contact_status);
+  constr.evalConstraint(robot, contact_status, data, s);
+  constr.evalDerivatives(robot, contact_status, data, s, kkt_res);
+  constr.condenseSlackAndDual(contact_status, data, kkt_mat, kkt_res);
+  auto data_ref = data;
+  const auto d = SplitDirection::Random(robot, contact_status);
+  constr.expandSlackAndDual(contact_status, data, d);
+  for (int i=0; i<contact_status.maxNumContacts(); ++i) {
+    data_ref.dslack.segment(3*i, 3) << 1, 0, 0;
+    data_ref.ddual.segment(3*i, 3) << 1, 0, 0;
+  }
+  int dimf_stack = 0;
+  for (int i=0; i<contact_status.maxNumContacts(); ++i) {
+    if (contact_status.isContactActive(i)) {
+      Eigen::Vector3d f_world = Eigen::Vector3d::Zero();
+      robot.transformFromLocalToWorld(robot.contactFrames()[i], s.f[i].template head<3>(), f_world);
+      Eigen::MatrixXd J = Eigen::MatrixXd::Zero(6, robot.dimv());
+      robot.getFrameJacobian(robot.contactFrames()[i], J);
+      Eigen::MatrixXd dfW_dq = Eigen::MatrixXd::Zero(3, robot.dimv());
+      for (int j=0; j<robot.dimv(); ++j) {
+        dfW_dq.col(j) = J.template bottomRows<3>().col(j).cross(f_world);
+      }
+      const Eigen::MatrixXd dg_dq = cone_surface_local * dfW_dq;
+      const Eigen::MatrixXd dg_df = cone_surface_local * robot.frameRotation(robot.contactFrames()[i]);
+      data_ref.dslack.segment(3*i, 3)
+          = - dg_dq * d.dq() - dg_df * d.df().segment(dimf_stack, 3) 
+            - data_ref.residual.segment(3*i, 3);
+      Eigen::Matrix3d W, Winv;
+      socpdipm::computeNesterovToddScaling(data_ref.slack.segment(3*i, 3), 
+                                           data_ref.dual.segment(3*i, 3), W, Winv);
+      const Eigen::Vector3d lambda = W * data_ref.dual.segment(3*i, 3);
+      Eigen::Vector3d lambda_inv;
+      lambda_inv << lambda(0), -lambda(1), -lambda(2);
+      lambda_inv /= (lambda(0)*lambda(0)-lambda(1)*lambda(1)-lambda(2)*lambda(2));
+      data_ref.ddual.segment(3*i, 3) 
+          = barrier * Winv * lambda_inv - data_ref.dual.segment(3*i, 3)
+              - Winv * Winv * data_ref.dslack.segment(3*i, 3);
+      switch (robot.contactType(i)) {
+        case ContactType::PointContact:
+          dimf_stack += 3;
+          break;
+        case ContactType::SurfaceContact:
+          dimf_stack += 6;
+          break;
+        default:
+          break;
+      }
+    }
+  }
+  EXPECT_TRUE(data.isApprox(data_ref));
+}
+
+
+void SOCFrictionConeTest::test_stepSize(Robot& robot, const ContactStatus& contact_status) const {
+  SOCFrictionCone constr(robot, mu); 
+  ConstraintComponentData data(constr.dimc(), constr.barrier());
+  constr.allocateExtraData(data);
+  for (int i=0; i<contact_status.maxNumContacts(); ++i) {
+    EXPECT_TRUE(socpdipm::isInterior(data.slack.segment(3*i, 3)));
+    EXPECT_TRUE(socpdipm::isInterior(data.dual.segment(3*i, 3)));
+  }
+  data.slack.setRandom();
+  data.dual.setRandom();
+  constr.setSlackAndDualPositive(data);
+  for (int i=0; i<contact_status.maxNumContacts(); ++i) {
+    EXPECT_TRUE(socpdipm::isInterior(data.slack.segment(3*i, 3)));
+    EXPECT_TRUE(socpdipm::isInterior(data.dual.segment(3*i, 3)));
+  }
+  data.dslack.setRandom();
+  data.ddual.setRandom();
+  const double slack_step_size = constr.maxSlackStepSize(data);
+  const double dual_step_size = constr.maxDualStepSize(data);
+  EXPECT_DOUBLE_EQ(slack_step_size, socpdipm::fractionToBoundarySlack(constr.fractionToBoundaryRule(), data));
+  EXPECT_DOUBLE_EQ(dual_step_size, socpdipm::fractionToBoundaryDual(constr.fractionToBoundaryRule(), data));
+  constr.updateSlack(data, slack_step_size);
+  constr.updateDual(data, dual_step_size);
+  for (int i=0; i<contact_status.maxNumContacts(); ++i) {
+    EXPECT_TRUE(socpdipm::isInterior(data.slack.segment(3*i, 3)));
+    EXPECT_TRUE(socpdipm::isInterior(data.dual.segment(3*i, 3)));
+  }
+}
+
+
+TEST_F(SOCFrictionConeTest, frictionConeResidual) {
+  const Eigen::Vector3d f = Eigen::Vector3d::Random();
+  const Eigen::VectorXd res_ref = cone_surface_local * f;
+  Eigen::VectorXd res = Eigen::VectorXd::Zero(3);
+  SOCFrictionCone::frictionConeResidual(mu, f, contact_surface, res);
+  EXPECT_TRUE(res.isApprox(res_ref));
+}
+
+
+TEST_F(SOCFrictionConeTest, fixedBase) {
+  auto robot = testhelper::CreateRobotManipulator(dt);
+  auto contact_status = robot.createContactStatus();
+  for (int i=0; i<contact_status.maxNumContacts(); ++i) {
+    contact_status.setContactPlacement(i, Eigen::Vector3d::Random(), contact_surface);
+  }
+  test_kinematics(robot, contact_status);
+  test_isFeasible(robot, contact_status);
+  test_setSlack(robot, contact_status);
+  test_evalConstraint(robot, contact_status);
+  test_evalDerivatives(robot, contact_status);
+  test_condenseSlackAndDual(robot, contact_status);
+  test_expandSlackAndDual(robot, contact_status);
+  test_stepSize(robot, contact_status);
+  contact_status.activateContact(0);
+  test_kinematics(robot, contact_status);
+  test_isFeasible(robot, contact_status);
+  test_setSlack(robot, contact_status);
+  test_evalConstraint(robot, contact_status);
+  test_evalDerivatives(robot, contact_status);
+  test_condenseSlackAndDual(robot, contact_status);
+  test_expandSlackAndDual(robot, contact_status);
+  test_stepSize(robot, contact_status);
+}
+
+
+TEST_F(SOCFrictionConeTest, floatingBase) {
+  auto robot = testhelper::CreateQuadrupedalRobot(dt);
+  auto contact_status = robot.createContactStatus();
+  for (int i=0; i<contact_status.maxNumContacts(); ++i) {
+    contact_status.setContactPlacement(i, Eigen::Vector3d::Random(), contact_surface);
+  }
+  test_kinematics(robot, contact_status);
+  test_isFeasible(robot, contact_status);
+  test_setSlack(robot, contact_status);
+  test_evalConstraint(robot, contact_status);
+  test_evalDerivatives(robot, contact_status);
+  test_condenseSlackAndDual(robot, contact_status);
+  test_expandSlackAndDual(robot, contact_status);
+  test_stepSize(robot, contact_status);
+  contact_status.setRandom();
+  for (int i=0; i<contact_status.maxNumContacts(); ++i) {
+    contact_status.setContactPlacement(i, Eigen::Vector3d::Random(), contact_surface);
+  }
+  test_kinematics(robot, contact_status);
+  test_isFeasible(robot, contact_status);
+  test_setSlack(robot, contact_status);
+  test_evalConstraint(robot, contact_status);
+  test_evalDerivatives(robot, contact_status);
+  test_condenseSlackAndDual(robot, contact_status);
+  test_expandSlackAndDual(robot, contact_status);
+  test_stepSize(robot, contact_status);
+}
+
+
+TEST_F(SOCFrictionConeTest, humanoidRobot) {
+  auto robot = testhelper::CreateHumanoidRobot(dt);
+  auto contact_status = robot.createContactStatus();
+  for (int i=0; i<contact_status.maxNumContacts(); ++i) {
+    contact_status.setContactPlacement(i, Eigen::Vector3d::Random(), contact_surface);
+  }
+  test_kinematics(robot, contact_status);
+  test_isFeasible(robot, contact_status);
+  test_setSlack(robot, contact_status);
+  test_evalConstraint(robot, contact_status);
+  test_evalDerivatives(robot, contact_status);
+  test_condenseSlackAndDual(robot, contact_status);
+  test_expandSlackAndDual(robot, contact_status);
+  test_stepSize(robot, contact_status);
+  contact_status.setRandom();
+  for (int i=0; i<contact_status.maxNumContacts(); ++i) {
+    contact_status.setContactPlacement(i, Eigen::Vector3d::Random(), contact_surface);
+  }
+  test_kinematics(robot, contact_status);
+  test_isFeasible(robot, contact_status);
+  test_setSlack(robot, contact_status);
+  test_evalConstraint(robot, contact_status);
+  test_evalDerivatives(robot, contact_status);
+  test_condenseSlackAndDual(robot, contact_status);
+  test_expandSlackAndDual(robot, contact_status);
+  test_stepSize(robot, contact_status);
+}
+
+} // namespace robotoc
+
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
\ No newline at end of file
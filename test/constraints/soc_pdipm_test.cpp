@@ -0,0 +1,156 @@
+#include <gtest/gtest.h>
+#include "Eigen/Core"
+
+#include "robotoc/constraints/soc_pdipm.hpp"
+#include "robotoc/constraints/constraint_component_data.hpp"
+
+namespace robotoc {
+
+class SOCPDIPMTest : public ::testing::Test {
+protected:
+  virtual void SetUp() {
+    srand((unsigned int) time(0));
+    num_cones = 10;
+    dim = 3 * num_cones;
+    barrier = 0.001;
+    data = ConstraintComponentData(dim, barrier);
+    for (int i=0; i<num_cones; ++i) {
+      data.slack.segment<3>(3*i) = randomInterior();
+      data.dual.segment<3>(3*i) = randomInterior();
+    }
+    data.dslack.setRandom();
+    data.ddual.setRandom();
+  }
+
+  virtual void TearDown() {
+  }
+
+  static Eigen::Vector3d randomInterior() {
+    Eigen::Vector3d v = Eigen::Vector3d::Random();
+    v.coeffRef(0) = v.tail<2>().norm() + std::abs(v.coeff(0)) + 0.01;
+    return v;
+  }
+
+  static Eigen::Vector3d jordanProduct(const Eigen::Vector3d& a,
+                                       const Eigen::Vector3d& b) {
+    Eigen::Vector3d c;
+    c.coeffRef(0) = a.dot(b);
+    c.tail<2>() = a.coeff(0) * b.tail<2>() + b.coeff(0) * a.tail<2>();
+    return c;
+  }
+
+  int num_cones, dim;
+  double barrier;
+  ConstraintComponentData data;
+};
+
+
+TEST_F(SOCPDIPMTest, setSlackAndDualInterior) {
+  data.slack.setRandom();
+  data.dual.setRandom();
+  for (int i=0; i<num_cones; ++i) {
+    socpdipm::setSlackAndDualInterior(barrier, data, 3*i);
+    EXPECT_TRUE(socpdipm::isInterior(data.slack.segment<3>(3*i)));
+    EXPECT_TRUE(socpdipm::isInterior(data.dual.segment<3>(3*i)));
+    Eigen::Vector3d e = Eigen::Vector3d::Zero();
+    e.coeffRef(0) = barrier;
+    EXPECT_TRUE(jordanProduct(data.slack.segment<3>(3*i),
+                              data.dual.segment<3>(3*i)).isApprox(e));
+  }
+}
+
+
+TEST_F(SOCPDIPMTest, computeComplementarySlackness) {
+  for (int i=0; i<num_cones; ++i) {
+    socpdipm::computeComplementarySlackness(barrier, data, 3*i);
+    Eigen::Vector3d cmpl_ref = jordanProduct(data.slack.segment<3>(3*i),
+                                             data.dual.segment<3>(3*i));
+    cmpl_ref.coeffRef(0) -= barrier;
+    EXPECT_TRUE(data.cmpl.segment<3>(3*i).isApprox(cmpl_ref));
+  }
+}
+
+
+TEST_F(SOCPDIPMTest, computeNesterovToddScaling) {
+  const Eigen::Vector3d s = randomInterior();
+  const Eigen::Vector3d z = randomInterior();
+  Eigen::Matrix3d W, Winv;
+  socpdipm::computeNesterovToddScaling(s, z, W, Winv);
+  EXPECT_TRUE((W*Winv).isIdentity());
+  EXPECT_TRUE(W.isApprox(W.transpose()));
+  EXPECT_TRUE((W*z).isApprox(Winv*s));
+}
+
+
+TEST_F(SOCPDIPMTest, condensing) {
+  data.residual.setRandom();
+  Eigen::Matrix3d H;
+  Eigen::Vector3d dz0;
+  for (int i=0; i<num_cones; ++i) {
+    socpdipm::computeComplementarySlackness(barrier, data, 3*i);
+    socpdipm::computeCondensingCoeffcient(barrier, data, 3*i, H, dz0);
+    EXPECT_TRUE(H.isApprox(H.transpose()));
+    EXPECT_TRUE(data.cond.segment<3>(3*i).isApprox(dz0+H*data.residual.segment<3>(3*i)));
+    socpdipm::computeDualDirection(data, 3*i, H, dz0);
+    EXPECT_TRUE(data.ddual.segment<3>(3*i).isApprox(dz0-H*data.dslack.segment<3>(3*i)));
+    // The direction satisfies the linearized complementarity in the scaled
+    // space, i.e., lambda o (W * ddual + W^{-1} * dslack) = barrier * e
+    // - lambda o lambda, where lambda = W * dual.
+    Eigen::Matrix3d W, Winv;
+    socpdipm::computeNesterovToddScaling(data.slack.segment<3>(3*i),
+                                         data.dual.segment<3>(3*i), W, Winv);
+    const Eigen::Vector3d lambda = W * data.dual.segment<3>(3*i);
+    const Eigen::Vector3d lhs
+        = jordanProduct(lambda, W*data.ddual.segment<3>(3*i)
+                                  +Winv*data.dslack.segment<3>(3*i));
+    Eigen::Vector3d rhs = - jordanProduct(lambda, lambda);
+    rhs.coeffRef(0) += barrier;
+    EXPECT_TRUE(lhs.isApprox(rhs, 1.0e-08));
+  }
+}
+
+
+TEST_F(SOCPDIPMTest, fractionToBoundary) {
+  const double fraction_rate = 0.995;
+  for (int i=0; i<num_cones; ++i) {
+    const Eigen::Vector3d v = randomInterior();
+    const Eigen::Vector3d dv = 10 * Eigen::Vector3d::Random();
+    const double step_size = socpdipm::fractionToBoundary(fraction_rate, v, dv);
+    EXPECT_TRUE(step_size > 0);
+    EXPECT_TRUE(step_size <= 1);
+    EXPECT_TRUE(socpdipm::isInterior(v+step_size*dv));
+    if (step_size < 1) {
+      EXPECT_FALSE(socpdipm::isInterior(v+(step_size/fraction_rate)*1.001*dv));
+    }
+  }
+}
+
+
+TEST_F(SOCPDIPMTest, fractionToBoundarySlackAndDual) {
+  const double fraction_rate = 0.995;
+  const double step_slack = socpdipm::fractionToBoundarySlack(fraction_rate, data);
+  const double step_dual = socpdipm::fractionToBoundaryDual(fraction_rate, data);
+  for (int i=0; i<num_cones; ++i) {
+    EXPECT_TRUE(socpdipm::isInterior(data.slack.segment<3>(3*i)
+                                      +step_slack*data.dslack.segment<3>(3*i)));
+    EXPECT_TRUE(socpdipm::isInterior(data.dual.segment<3>(3*i)
+                                      +step_dual*data.ddual.segment<3>(3*i)));
+  }
+}
+
+
+TEST_F(SOCPDIPMTest, logBarrier) {
+  const Eigen::Vector3d v = randomInterior();
+  const double cost_ref
+      = - 0.5 * barrier * std::log(v.coeff(0)*v.coeff(0)-v.tail<2>().squaredNorm());
+  const double cost = socpdipm::logBarrier(barrier, v);
+  EXPECT_DOUBLE_EQ(cost_ref, cost);
+}
+
+} // namespace robotoc
+
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
\ No newline at end of file
@@ -28,7 +28,8 @@ public:
     : q0_ref_(q0_ref),
       v_ref_(v_ref),
       t0_(t0),
-      tf_(tf) {
+      tf_(tf),
+      version_(0) {
   }
 
   TestConfigurationSpaceRef() {}
@@ -58,9 +59,17 @@ public:
       return false;
   }
 
+  void set_q0_ref(const Eigen::VectorXd& q0_ref) {
+    q0_ref_ = q0_ref;
+    ++version_;
+  }
+
+  unsigned long version() const override { return version_; }
+
 private:
   Eigen::VectorXd q0_ref_, v_ref_;
   double t0_, tf_;
+  unsigned long version_;
 };
 
 class ConfigurationSpaceCostTest : public ::testing::Test {
@@ -494,6 +503,79 @@ void ConfigurationSpaceCostTest::testImpulseCost(Robot& robot) const {
 }
 
 
+TEST_F(ConfigurationSpaceCostTest, refCache) {
+  auto robot = testhelper::CreateQuadrupedalRobot(dt);
+  const int dimq = robot.dimq();
+  const int dimv = robot.dimv();
+  const Eigen::VectorXd q_weight = Eigen::VectorXd::Random(dimv).cwiseAbs();
+  const Eigen::VectorXd v_ref = Eigen::VectorXd::Random(dimv); 
+  auto ref = std::make_shared<TestConfigurationSpaceRef>(
+      robot.generateFeasibleConfiguration(), v_ref, t0, tf);
+  auto cost = std::make_shared<ConfigurationSpaceCost>(robot, ref);
+  cost->set_q_weight(q_weight);
+  CostFunctionData data(robot);
+  const auto s = SplitSolution::Random(robot);
+  const auto contact_status = robot.createContactStatus();
+  auto expectedCost = [&](const Eigen::VectorXd& q0_ref, const GridInfo& grid) {
+    Eigen::VectorXd q_ref = Eigen::VectorXd::Zero(dimq);
+    robot.integrateConfiguration(q0_ref, v_ref, (grid.t-t0), q_ref);
+    Eigen::VectorXd q_diff = Eigen::VectorXd::Zero(dimv); 
+    robot.subtractConfiguration(s.q, q_ref, q_diff);
+    return 0.5 * grid.dt * (q_weight.array()*q_diff.array()*q_diff.array()).sum();
+  };
+  // The reference is recomputed whenever its version is changed.
+  for (int i=0; i<3; ++i) {
+    const Eigen::VectorXd q0_ref = robot.generateFeasibleConfiguration();
+    ref->set_q0_ref(q0_ref);
+    const double l = expectedCost(q0_ref, grid_info);
+    EXPECT_DOUBLE_EQ(cost->evalStageCost(robot, contact_status, data, grid_info, s), l);
+    EXPECT_DOUBLE_EQ(cost->evalStageCost(robot, contact_status, data, grid_info, s), l);
+    // The reference is recomputed whenever the grid is changed.
+    auto grid_info_next = grid_info;
+    grid_info_next.t = 0.5 * (t + tf);
+    EXPECT_NEAR(cost->evalStageCost(robot, contact_status, data, grid_info_next, s), 
+                expectedCost(q0_ref, grid_info_next), 1.0e-10);
+  }
+}
+
+
+TEST_F(ConfigurationSpaceCostTest, smallAngleApproximation) {
+  auto robot = testhelper::CreateQuadrupedalRobot(dt);
+  const int dimq = robot.dimq();
+  const int dimv = robot.dimv();
+  const Eigen::VectorXd q_weight = Eigen::VectorXd::Random(dimv).cwiseAbs();
+  const Eigen::VectorXd q_ref = robot.generateFeasibleConfiguration();
+  auto cost = std::make_shared<ConfigurationSpaceCost>(robot);
+  cost->set_q_ref(q_ref);
+  cost->set_q_weight(q_weight);
+  auto cost_approx = std::make_shared<ConfigurationSpaceCost>(robot);
+  cost_approx->set_q_ref(q_ref);
+  cost_approx->set_q_weight(q_weight);
+  cost_approx->set_small_angle_approximation(true);
+  const auto contact_status = robot.createContactStatus();
+  auto s = SplitSolution::Random(robot);
+  // Small deviation from the reference.
+  const Eigen::VectorXd dq = 1.0e-04 * Eigen::VectorXd::Random(dimv);
+  robot.integrateConfiguration(q_ref, dq, 1.0, s.q);
+  CostFunctionData data(robot), data_approx(robot);
+  const double l = cost->evalStageCost(robot, contact_status, data, grid_info, s);
+  const double l_approx 
+      = cost_approx->evalStageCost(robot, contact_status, data_approx, grid_info, s);
+  EXPECT_NEAR(l, l_approx, 1.0e-03*l);
+  SplitKKTResidual kkt_res(robot);
+  auto kkt_res_approx = kkt_res;
+  cost->evalStageCostDerivatives(robot, contact_status, data, grid_info, s, kkt_res);
+  cost_approx->evalStageCostDerivatives(robot, contact_status, data_approx, 
+                                        grid_info, s, kkt_res_approx);
+  EXPECT_TRUE(kkt_res.lq().isApprox(kkt_res_approx.lq(), 1.0e-03));
+  EXPECT_TRUE(data_approx.J_qdiff.isIdentity());
+  // No deviation from the reference.
+  s.q = q_ref;
+  EXPECT_NEAR(cost_approx->evalStageCost(robot, contact_status, data_approx, grid_info, s), 
+              0, 1.0e-12);
+}
+
+
 TEST_F(ConfigurationSpaceCostTest, defaultConstructor) {
   EXPECT_NO_THROW(
     auto cost = std::make_shared<ConfigurationSpaceCost>();
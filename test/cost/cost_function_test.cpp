@@ -1,4 +1,7 @@
 #include <memory>
+#include <vector>
+#include <cmath>
+#include <algorithm>
 
 #include <gtest/gtest.h>
 #include "Eigen/Core"
@@ -28,6 +31,10 @@ protected:
 
   void testStageCost(Robot& robot);
 
+  void testTimeVaryingWeight(Robot& robot);
+
+  void testDiscount(Robot& robot);
+
   GridInfo grid_info;
   double dt, t0, t;
 };
@@ -81,18 +88,128 @@ void CostFunctionTest::testStageCost(Robot& robot) {
   EXPECT_DOUBLE_EQ(non_discounted_value*std::pow(discount_factor, (grid_info.t-grid_info.t0)/discount_time_step), discounted_value);
   non_discounted_cost->setDiscountFactor(discount_factor, discount_time_step);
   EXPECT_DOUBLE_EQ(discounted_value, non_discounted_cost->evalStageCost(robot, contact_status, data, grid_info, s));
+  non_discounted_cost->setDiscountFactor(1.0, 0.0);
+  EXPECT_DOUBLE_EQ(non_discounted_value, non_discounted_cost->evalStageCost(robot, contact_status, data, grid_info, s));
+}
+
+
+void CostFunctionTest::testTimeVaryingWeight(Robot& robot) {
+  const double discount_factor = 0.99;
+  const double discount_time_step = 0.02;
+  auto cost = std::make_shared<CostFunction>();
+  auto discounted_cost = std::make_shared<CostFunction>(discount_factor, discount_time_step);
+  auto config_cost = std::make_shared<ConfigurationSpaceCost>(robot);
+  config_cost->set_q_weight(Eigen::VectorXd::Random(robot.dimv()));
+  config_cost->set_v_weight(Eigen::VectorXd::Random(robot.dimv()));
+  config_cost->set_q_weight_terminal(Eigen::VectorXd::Random(robot.dimv()));
+  cost->push_back(config_cost);
+  discounted_cost->push_back(config_cost);
+  auto contact_status = robot.createContactStatus();
+  contact_status.setRandom();
+  const auto s = SplitSolution::Random(robot, contact_status);
+  auto data = CostFunctionData(robot);
+  const double t0 = 0.5;
+  GridInfo grid_info;
+  grid_info.t0 = t0;
+  grid_info.dt = dt;
+  const double T = 1.0;
+  const std::vector<double> elapsed_times = {0.0, T};
+  const std::vector<double> weights = {1.0, 3.0};
+  const double l = cost->evalStageCost(robot, contact_status, data, grid_info, s);
+  cost->setTimeVaryingWeight(elapsed_times, weights);
+  discounted_cost->setTimeVaryingWeight(elapsed_times, weights);
+  for (const double elapsed_time : {-0.1, 0.0, 0.25, 0.5, 1.0, 2.0}) {
+    grid_info.t = t0 + std::max(elapsed_time, 0.0);
+    const double w = std::min(std::max(1.0+2.0*elapsed_time, 1.0), 3.0);
+    EXPECT_DOUBLE_EQ(cost->weight(grid_info.t0, grid_info.t), w);
+    const double l_stage = cost->evalStageCost(robot, contact_status, data, grid_info, s);
+    const double l_nominal = config_cost->evalStageCost(robot, contact_status, data, grid_info, s);
+    EXPECT_NEAR(l_stage, cost->weight(grid_info.t0, grid_info.t)*l_nominal, 1.0e-08*std::abs(l_nominal)+1.0e-12);
+    const double l_discounted = discounted_cost->evalStageCost(robot, contact_status, data, grid_info, s);
+    const double f = std::pow(discount_factor, (grid_info.t-grid_info.t0)/discount_time_step);
+    EXPECT_NEAR(l_discounted, f*cost->weight(grid_info.t0, grid_info.t)*l_nominal, 1.0e-08*std::abs(l_nominal)+1.0e-12);
+    SplitKKTResidual kkt_res(robot), kkt_res_ref(robot);
+    kkt_res.setContactStatus(contact_status);
+    kkt_res_ref.setContactStatus(contact_status);
+    cost->linearizeTerminalCost(robot, data, grid_info, s, kkt_res);
+    config_cost->evalTerminalCostDerivatives(robot, data, grid_info, s, kkt_res_ref);
+    kkt_res_ref.lx *= cost->weight(grid_info.t0, grid_info.t);
+    EXPECT_TRUE(kkt_res.lx.isApprox(kkt_res_ref.lx));
+  }
+  cost->clearTimeVaryingWeight();
+  grid_info.t = t0;
+  EXPECT_DOUBLE_EQ(cost->weight(grid_info.t0, grid_info.t), 1.0);
+  EXPECT_DOUBLE_EQ(l, cost->evalStageCost(robot, contact_status, data, grid_info, s));
+}
+
+
+void CostFunctionTest::testDiscount(Robot& robot) {
+  const double discount_factor = 0.9;
+  const double discount_time_step = 0.05;
+  auto non_discounted_cost = std::make_shared<CostFunction>();
+  auto discounted_cost = std::make_shared<CostFunction>(discount_factor, discount_time_step);
+  auto config_cost = std::make_shared<ConfigurationSpaceCost>(robot);
+  config_cost->set_q_weight(Eigen::VectorXd::Random(robot.dimv()));
+  config_cost->set_v_weight(Eigen::VectorXd::Random(robot.dimv()));
+  config_cost->set_u_weight(Eigen::VectorXd::Random(robot.dimu()));
+  non_discounted_cost->push_back(config_cost);
+  discounted_cost->push_back(config_cost);
+  auto contact_status = robot.createContactStatus();
+  contact_status.setRandom();
+  const auto s = SplitSolution::Random(robot, contact_status);
+  auto data = CostFunctionData(robot);
+  // The time stage is inconsistent with the elapsed time on purpose: all the 
+  // stage costs are discounted w.r.t. the elapsed time.
+  GridInfo grid_info;
+  grid_info.t0 = 0.5;
+  grid_info.t = 0.8;
+  grid_info.dt = 0.01;
+  grid_info.time_stage = 3;
+  const double f = std::pow(discount_factor, (grid_info.t-grid_info.t0)/discount_time_step);
+  const double l = non_discounted_cost->evalStageCost(robot, contact_status, data, grid_info, s);
+  EXPECT_EQ(discounted_cost->evalStageCost(robot, contact_status, data, grid_info, s), f*l);
+  EXPECT_NE(discounted_cost->evalStageCost(robot, contact_status, data, grid_info, s), 
+            std::pow(discount_factor, grid_info.time_stage)*l);
+  // The cached factor gives the same results as the direct evaluation.
+  SplitKKTMatrix kkt_mat(robot), kkt_mat_ref(robot);
+  SplitKKTResidual kkt_res(robot), kkt_res_ref(robot);
+  kkt_mat.setContactStatus(contact_status);
+  kkt_mat_ref.setContactStatus(contact_status);
+  kkt_res.setContactStatus(contact_status);
+  kkt_res_ref.setContactStatus(contact_status);
+  for (int i=0; i<2; ++i) {
+    kkt_mat.setZero();
+    kkt_mat_ref.setZero();
+    kkt_res.setZero();
+    kkt_res_ref.setZero();
+    const double l_linearized = discounted_cost->linearizeStageCost(robot, contact_status, data, grid_info, s, kkt_res);
+    EXPECT_EQ(l_linearized, f*non_discounted_cost->linearizeStageCost(robot, contact_status, data, grid_info, s, kkt_res_ref));
+    EXPECT_TRUE(kkt_res.lx == (f*kkt_res_ref.lx));
+    EXPECT_TRUE(kkt_res.lu == (f*kkt_res_ref.lu));
+    kkt_res.setZero();
+    kkt_res_ref.setZero();
+    const double l_quadratized = discounted_cost->quadratizeStageCost(robot, contact_status, data, grid_info, s, kkt_res, kkt_mat);
+    EXPECT_EQ(l_quadratized, f*non_discounted_cost->quadratizeStageCost(robot, contact_status, data, grid_info, s, kkt_res_ref, kkt_mat_ref));
+    EXPECT_TRUE(kkt_res.lx == (f*kkt_res_ref.lx));
+    EXPECT_TRUE(kkt_mat.Qxx == (f*kkt_mat_ref.Qxx));
+    EXPECT_TRUE(kkt_mat.Quu == (f*kkt_mat_ref.Quu));
+  }
 }
 
 
 TEST_F(CostFunctionTest, fixedBase) {
   auto robot = testhelper::CreateRobotManipulator(dt);
   testStageCost(robot);
+  testTimeVaryingWeight(robot);
+  testDiscount(robot);
 }
 
 
 TEST_F(CostFunctionTest, floatingBase) {
   auto robot = testhelper::CreateQuadrupedalRobot(dt);
   testStageCost(robot);
+  testTimeVaryingWeight(robot);
+  testDiscount(robot);
 }
 
 } // namespace robotoc
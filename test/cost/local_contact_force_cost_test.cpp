@@ -1,4 +1,5 @@
 #include <memory>
+#include <cmath>
 
 #include <gtest/gtest.h>
 #include "Eigen/Core"
@@ -76,7 +77,9 @@ void LocalContactForceCostTest::testStageCost(Robot& robot) const {
                                     * (fl.array()-f_ref[i].array())).sum();
     }
   }
-  EXPECT_DOUBLE_EQ(cost->evalStageCost(robot, contact_status, data, grid_info, s), 0.5*dt*l_ref);
+  // The summation order of the stacked kernel differs from the reference.
+  EXPECT_NEAR(cost->evalStageCost(robot, contact_status, data, grid_info, s), 
+              0.5*dt*l_ref, 1.0e-12*(1.0+std::abs(l_ref)));
   kkt_res.setContactStatus(contact_status);
   kkt_mat.setContactStatus(contact_status);
   kkt_res.lf().setRandom();
@@ -214,7 +217,8 @@ void LocalContactForceCostTest::testImpulseCost(Robot& robot) const {
                                      * (fl.array()-fi_ref[i].array())).sum();
     }
   }
-  EXPECT_DOUBLE_EQ(cost->evalImpulseCost(robot, impulse_status, data, grid_info, s), 0.5*l_ref);
+  EXPECT_NEAR(cost->evalImpulseCost(robot, impulse_status, data, grid_info, s), 
+              0.5*l_ref, 1.0e-12*(1.0+std::abs(l_ref)));
   kkt_res.setImpulseStatus(impulse_status);
   kkt_mat.setImpulseStatus(impulse_status);
   kkt_res.lf().setRandom();
@@ -0,0 +1,254 @@
+#include <memory>
+#include <thread>
+#include <chrono>
+
+#include <gtest/gtest.h>
+#include "Eigen/Core"
+#include "Eigen/Cholesky"
+
+#include "robotoc/robot/robot.hpp"
+#include "robotoc/cost/terminal_lqr_cost.hpp"
+#include "robotoc/cost/configuration_space_cost.hpp"
+#include "robotoc/cost/cost_function.hpp"
+#include "robotoc/cost/cost_function_data.hpp"
+#include "robotoc/constraints/constraints.hpp"
+#include "robotoc/ocp/split_ocp.hpp"
+#include "robotoc/ocp/split_solution.hpp"
+#include "robotoc/ocp/split_kkt_residual.hpp"
+#include "robotoc/ocp/split_kkt_matrix.hpp"
+#include "robotoc/impulse/impulse_split_solution.hpp"
+#include "robotoc/impulse/impulse_split_kkt_residual.hpp"
+#include "robotoc/impulse/impulse_split_kkt_matrix.hpp"
+#include "robotoc/riccati/riccati_factorizer.hpp"
+
+#include "robotoc/utils/derivative_checker.hpp"
+
+#include "robot_factory.hpp"
+
+
+namespace robotoc {
+
+class TerminalLQRCostTest : public ::testing::Test {
+protected:
+  virtual void SetUp() {
+    srand((unsigned int) time(0));
+    dt = std::abs(Eigen::VectorXd::Random(1)[0]);
+    grid_info = GridInfo::Random();
+  }
+
+  virtual void TearDown() {
+  }
+
+  static Eigen::MatrixXd RandomCostToGo(const int dimx) {
+    const Eigen::MatrixXd A = Eigen::MatrixXd::Random(dimx, dimx);
+    return A * A.transpose() + Eigen::MatrixXd::Identity(dimx, dimx);
+  }
+
+  void testStageAndImpulseCosts(Robot& robot) const;
+  void testTerminalCost(Robot& robot) const;
+  void testCostToGo(Robot& robot) const;
+
+  GridInfo grid_info;
+  double dt;
+};
+
+
+void TerminalLQRCostTest::testStageAndImpulseCosts(Robot& robot) const {
+  auto cost = std::make_shared<TerminalLQRCost>(robot);
+  const int dimv = robot.dimv();
+  cost->setCostToGo(RandomCostToGo(2*dimv),
+                    robot.generateFeasibleConfiguration(),
+                    Eigen::VectorXd::Random(dimv));
+  CostFunctionData data(robot);
+  EXPECT_FALSE(cost->useKinematics());
+  const auto contact_status = robot.createContactStatus();
+  const auto impulse_status = robot.createImpulseStatus();
+  const SplitSolution s = SplitSolution::Random(robot);
+  const ImpulseSplitSolution si = ImpulseSplitSolution::Random(robot);
+  SplitKKTMatrix kkt_mat(robot);
+  SplitKKTResidual kkt_res(robot);
+  kkt_mat.Qxx.setRandom();
+  kkt_res.lx.setRandom();
+  auto kkt_mat_ref = kkt_mat;
+  auto kkt_res_ref = kkt_res;
+  EXPECT_DOUBLE_EQ(cost->evalStageCost(robot, contact_status, data, grid_info, s), 0);
+  cost->evalStageCostDerivatives(robot, contact_status, data, grid_info, s, kkt_res);
+  cost->evalStageCostHessian(robot, contact_status, data, grid_info, s, kkt_mat);
+  EXPECT_TRUE(kkt_mat.isApprox(kkt_mat_ref));
+  EXPECT_TRUE(kkt_res.isApprox(kkt_res_ref));
+  ImpulseSplitKKTMatrix impulse_kkt_mat(robot);
+  ImpulseSplitKKTResidual impulse_kkt_res(robot);
+  impulse_kkt_mat.Qxx.setRandom();
+  impulse_kkt_res.lx.setRandom();
+  auto impulse_kkt_mat_ref = impulse_kkt_mat;
+  auto impulse_kkt_res_ref = impulse_kkt_res;
+  EXPECT_DOUBLE_EQ(cost->evalImpulseCost(robot, impulse_status, data, grid_info, si), 0);
+  cost->evalImpulseCostDerivatives(robot, impulse_status, data, grid_info, si, impulse_kkt_res);
+  cost->evalImpulseCostHessian(robot, impulse_status, data, grid_info, si, impulse_kkt_mat);
+  EXPECT_TRUE(impulse_kkt_mat.isApprox(impulse_kkt_mat_ref));
+  EXPECT_TRUE(impulse_kkt_res.isApprox(impulse_kkt_res_ref));
+}
+
+
+void TerminalLQRCostTest::testTerminalCost(Robot& robot) const {
+  const int dimv = robot.dimv();
+  SplitKKTMatrix kkt_mat(robot);
+  SplitKKTResidual kkt_res(robot);
+  kkt_mat.Qxx.setRandom();
+  kkt_res.lx.setRandom();
+  auto kkt_mat_ref = kkt_mat;
+  auto kkt_res_ref = kkt_res;
+  const Eigen::MatrixXd P = RandomCostToGo(2*dimv);
+  const Eigen::VectorXd q_ref = robot.generateFeasibleConfiguration();
+  const Eigen::VectorXd v_ref = Eigen::VectorXd::Random(dimv);
+  auto cost = std::make_shared<TerminalLQRCost>(robot);
+  cost->setCostToGo(P, q_ref, v_ref);
+  EXPECT_TRUE(cost->costToGoHessian().isApprox(P));
+  EXPECT_TRUE(cost->q_ref().isApprox(q_ref));
+  EXPECT_TRUE(cost->v_ref().isApprox(v_ref));
+  CostFunctionData data(robot);
+  const SplitSolution s = SplitSolution::Random(robot);
+  Eigen::VectorXd dx = Eigen::VectorXd::Zero(2*dimv);
+  robot.subtractConfiguration(s.q, q_ref, dx.head(dimv));
+  dx.tail(dimv) = s.v - v_ref;
+  const double l_ref = 0.5 * dx.dot(P*dx);
+  EXPECT_DOUBLE_EQ(cost->evalTerminalCost(robot, data, grid_info, s), l_ref);
+  cost->evalTerminalCostDerivatives(robot, data, grid_info, s, kkt_res);
+  cost->evalTerminalCostHessian(robot, data, grid_info, s, kkt_mat);
+  Eigen::MatrixXd J = Eigen::MatrixXd::Identity(2*dimv, 2*dimv);
+  if (robot.hasFloatingBase()) {
+    Eigen::MatrixXd J_qdiff = Eigen::MatrixXd::Zero(dimv, dimv);
+    robot.dSubtractConfiguration_dqf(s.q, q_ref, J_qdiff);
+    J.topLeftCorner(dimv, dimv) = J_qdiff;
+  }
+  kkt_res_ref.lx += J.transpose() * P * dx;
+  kkt_mat_ref.Qxx += J.transpose() * P * J;
+  EXPECT_TRUE(kkt_res.isApprox(kkt_res_ref));
+  EXPECT_TRUE(kkt_mat.isApprox(kkt_mat_ref));
+  DerivativeChecker derivative_checker(robot);
+  EXPECT_TRUE(derivative_checker.checkFirstOrderTerminalCostDerivatives(cost));
+  if (!robot.hasFloatingBase()) {
+    EXPECT_TRUE(derivative_checker.checkSecondOrderTerminalCostDerivatives(cost));
+  }
+}
+
+
+void TerminalLQRCostTest::testCostToGo(Robot& robot) const {
+  const int dimv = robot.dimv();
+  auto cost = std::make_shared<CostFunction>();
+  auto config_cost = std::make_shared<ConfigurationSpaceCost>(robot);
+  const Eigen::VectorXd q_ref = robot.generateFeasibleConfiguration();
+  config_cost->set_q_ref(q_ref);
+  config_cost->set_q_weight(Eigen::VectorXd::Constant(dimv, 10));
+  config_cost->set_v_weight(Eigen::VectorXd::Constant(dimv, 1));
+  config_cost->set_a_weight(Eigen::VectorXd::Constant(dimv, 0.01));
+  config_cost->set_u_weight(Eigen::VectorXd::Constant(robot.dimu(), 0.001));
+  cost->push_back(config_cost);
+  auto lqr_cost = std::make_shared<TerminalLQRCost>(robot);
+  cost->push_back(lqr_cost);
+  auto constraints = std::make_shared<Constraints>();
+  const auto contact_status = robot.createContactStatus();
+  // Operating point: equilibrium at the reference configuration.
+  SplitSolution s(robot);
+  s.q = q_ref;
+  s.v.setZero();
+  s.a.setZero();
+  robot.RNEA(s.q, s.v, s.a, s.u);
+  const double dt_ocp = 0.02;
+  EXPECT_TRUE(lqr_cost->computeCostToGo(robot, cost, constraints,
+                                        contact_status, dt_ocp, s));
+  EXPECT_TRUE(lqr_cost->numRiccatiIterations() > 0);
+  const Eigen::MatrixXd P = lqr_cost->costToGoHessian();
+  EXPECT_TRUE(P.isApprox(P.transpose()));
+  Eigen::LLT<Eigen::MatrixXd> llt(P);
+  EXPECT_EQ(llt.info(), Eigen::Success);
+  EXPECT_TRUE(lqr_cost->q_ref().isApprox(s.q));
+  EXPECT_TRUE(lqr_cost->v_ref().isApprox(s.v));
+  // P is the fixed point of the Riccati recursion.
+  SplitOCP ocp(robot, cost, constraints);
+  ocp.initConstraints(robot, contact_status, 1, s);
+  GridInfo grid_info_ocp;
+  grid_info_ocp.dt = dt_ocp;
+  SplitKKTMatrix kkt_mat(robot);
+  SplitKKTResidual kkt_res(robot);
+  ocp.computeKKTSystem(robot, contact_status, grid_info_ocp, s.q, s, s,
+                       kkt_mat, kkt_res);
+  RiccatiFactorizer factorizer(robot);
+  SplitRiccatiFactorization riccati(robot), riccati_next(robot);
+  LQRPolicy lqr_policy(robot);
+  riccati_next.P = P;
+  factorizer.backwardRiccatiRecursion(riccati_next, kkt_mat, kkt_res,
+                                      riccati, lqr_policy);
+  EXPECT_TRUE(riccati.P.isApprox(P, 1.0e-06));
+  // The same cost-to-go is computed in the background.
+  auto lqr_cost_async = std::make_shared<TerminalLQRCost>(robot);
+  EXPECT_FALSE(lqr_cost_async->synchronize());
+  EXPECT_TRUE(lqr_cost_async->requestCostToGoUpdate(robot, cost, constraints,
+                                                    contact_status, dt_ocp, s));
+  if (lqr_cost_async->isUpdating()) {
+    EXPECT_FALSE(lqr_cost_async->requestCostToGoUpdate(robot, cost, constraints,
+                                                       contact_status, dt_ocp, s));
+  }
+  EXPECT_TRUE(lqr_cost_async->synchronize(true));
+  EXPECT_FALSE(lqr_cost_async->isUpdating());
+  EXPECT_TRUE(lqr_cost_async->costToGoHessian().isApprox(P));
+  // The update is skipped if the operating point does not change.
+  lqr_cost_async->setRefreshTolerance(1.0e-03);
+  EXPECT_FALSE(lqr_cost_async->requestCostToGoUpdate(robot, cost, constraints,
+                                                     contact_status, dt_ocp, s));
+  s.q = robot.generateFeasibleConfiguration();
+  robot.RNEA(s.q, s.v, s.a, s.u);
+  const long cost_use_count = cost.use_count();
+  const long constraints_use_count = constraints.use_count();
+  EXPECT_TRUE(lqr_cost_async->requestCostToGoUpdate(robot, cost, constraints,
+                                                    contact_status, dt_ocp, s));
+  // The update in the background does not hold the cost and constraints.
+  EXPECT_EQ(cost.use_count(), cost_use_count);
+  EXPECT_EQ(constraints.use_count(), constraints_use_count);
+  EXPECT_TRUE(lqr_cost_async->synchronize(true));
+  EXPECT_TRUE(lqr_cost_async->q_ref().isApprox(s.q));
+  // The finished but not yet synchronized result is applied by the next 
+  // request instead of being discarded.
+  s.q = robot.generateFeasibleConfiguration();
+  robot.RNEA(s.q, s.v, s.a, s.u);
+  EXPECT_TRUE(lqr_cost_async->requestCostToGoUpdate(robot, cost, constraints,
+                                                    contact_status, dt_ocp, s));
+  while (lqr_cost_async->isUpdating()) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  EXPECT_FALSE(lqr_cost_async->requestCostToGoUpdate(robot, cost, constraints,
+                                                     contact_status, dt_ocp, s));
+  EXPECT_TRUE(lqr_cost_async->q_ref().isApprox(s.q));
+  EXPECT_FALSE(lqr_cost_async->synchronize());
+}
+
+
+TEST_F(TerminalLQRCostTest, defaultConstructor) {
+  EXPECT_NO_THROW(
+    auto cost = std::make_shared<TerminalLQRCost>();
+  );
+}
+
+
+TEST_F(TerminalLQRCostTest, fixedBase) {
+  auto robot = testhelper::CreateRobotManipulator(dt);
+  testStageAndImpulseCosts(robot);
+  testTerminalCost(robot);
+  robot = testhelper::CreateRobotManipulator();
+  testCostToGo(robot);
+}
+
+
+TEST_F(TerminalLQRCostTest, floatingBase) {
+  auto robot = testhelper::CreateQuadrupedalRobot(dt);
+  testStageAndImpulseCosts(robot);
+  testTerminalCost(robot);
+}
+
+} // namespace robotoc
+
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -8,6 +8,7 @@
 #include "robotoc/robot/impulse_status.hpp"
 #include "robotoc/hybrid/discrete_event.hpp"
 #include "robotoc/hybrid/contact_sequence.hpp"
+#include "robotoc/ocp/solution.hpp"
 #include "robotoc/robot/robot.hpp"
 
 #include "robot_factory.hpp"
@@ -36,6 +37,8 @@ protected:
   void test_pop_back(const Robot& robot) const;
   void test_pop_front(const Robot& robot) const;
   void test_setContactPlacements(const Robot& robot) const;
+  void test_reserve(const Robot& robot) const;
+  void test_reservePerEventKind(const Robot& robot) const;
 
   int max_num_each_events;
 };
@@ -81,6 +84,8 @@ void ContactSequenceTest::test_constructor(const Robot& robot) const {
   EXPECT_EQ(contact_sequence.numDiscreteEvents(), 0);
   EXPECT_EQ(contact_sequence.numContactPhases(), 1);
   EXPECT_EQ(contact_sequence.reservedNumDiscreteEvents(), max_num_each_events);
+  EXPECT_EQ(contact_sequence.reservedNumImpulseEvents(), max_num_each_events);
+  EXPECT_EQ(contact_sequence.reservedNumLiftEvents(), max_num_each_events);
   EXPECT_TRUE(contact_sequence.contactStatus(0) == contact_status);
   contact_sequence.pop_back();
   contact_sequence.pop_front();
@@ -312,6 +317,83 @@ void ContactSequenceTest::test_setContactPlacements(const Robot& robot) const {
 }
 
 
+void ContactSequenceTest::test_reserve(const Robot& robot) const {
+  ContactSequence contact_sequence(robot);
+  EXPECT_EQ(contact_sequence.reservedNumDiscreteEvents(), 0);
+  EXPECT_EQ(contact_sequence.reservedNumImpulseEvents(), 0);
+  EXPECT_EQ(contact_sequence.reservedNumLiftEvents(), 0);
+  auto pre_contact_status = robot.createContactStatus();
+  pre_contact_status.setRandom();
+  contact_sequence.init(pre_contact_status);
+  const int num_discrete_events = 10;
+  std::vector<DiscreteEvent> discrete_events 
+      = createDiscreteEvents(robot, pre_contact_status, num_discrete_events);
+  for (int i=0; i<num_discrete_events; ++i) {
+    contact_sequence.push_back(discrete_events[i], 0.1*(i+1), false);
+  }
+  const int num_impulse = contact_sequence.numImpulseEvents();
+  const int num_lift = contact_sequence.numLiftEvents();
+  EXPECT_EQ(contact_sequence.reservedNumDiscreteEvents(), num_discrete_events);
+  EXPECT_EQ(contact_sequence.reservedNumImpulseEvents(), num_impulse);
+  EXPECT_EQ(contact_sequence.reservedNumLiftEvents(), num_lift);
+  // The reserved sizes never shrink.
+  for (int i=0; i<num_discrete_events; ++i) {
+    contact_sequence.pop_front();
+  }
+  EXPECT_EQ(contact_sequence.reservedNumDiscreteEvents(), num_discrete_events);
+  EXPECT_EQ(contact_sequence.reservedNumImpulseEvents(), num_impulse);
+  EXPECT_EQ(contact_sequence.reservedNumLiftEvents(), num_lift);
+  contact_sequence.reserve(max_num_each_events);
+  EXPECT_EQ(contact_sequence.reservedNumDiscreteEvents(), max_num_each_events);
+  EXPECT_EQ(contact_sequence.reservedNumImpulseEvents(), max_num_each_events);
+  EXPECT_EQ(contact_sequence.reservedNumLiftEvents(), max_num_each_events);
+}
+
+
+void ContactSequenceTest::test_reservePerEventKind(const Robot& robot) const {
+  const int reserved_num_impulse = max_num_each_events;
+  const int reserved_num_lift = 1;
+  ContactSequence contact_sequence(robot, reserved_num_impulse, reserved_num_lift);
+  EXPECT_EQ(contact_sequence.reservedNumDiscreteEvents(), reserved_num_impulse);
+  EXPECT_EQ(contact_sequence.reservedNumImpulseEvents(), reserved_num_impulse);
+  EXPECT_EQ(contact_sequence.reservedNumLiftEvents(), reserved_num_lift);
+  EXPECT_EQ(contact_sequence.numDiscreteEvents(), 0);
+  const int N = 20;
+  Solution s(robot, N, contact_sequence.reservedNumImpulseEvents(), 
+             contact_sequence.reservedNumLiftEvents());
+  EXPECT_EQ(s.data.size(), N+1);
+  EXPECT_EQ(s.impulse.size(), reserved_num_impulse);
+  EXPECT_EQ(s.aux.size(), reserved_num_impulse);
+  EXPECT_EQ(s.switching.size(), reserved_num_impulse);
+  EXPECT_EQ(s.lift.size(), reserved_num_lift);
+  // Reserving only the lift events does not touch the impulse events.
+  contact_sequence.reserve(reserved_num_impulse/2, 2*reserved_num_lift);
+  EXPECT_EQ(contact_sequence.reservedNumImpulseEvents(), reserved_num_impulse);
+  EXPECT_EQ(contact_sequence.reservedNumLiftEvents(), 2*reserved_num_lift);
+  EXPECT_EQ(contact_sequence.numDiscreteEvents(), 0);
+  s.reserve(robot, contact_sequence.reservedNumImpulseEvents(), 
+            contact_sequence.reservedNumLiftEvents());
+  EXPECT_EQ(s.impulse.size(), reserved_num_impulse);
+  EXPECT_EQ(s.aux.size(), reserved_num_impulse);
+  EXPECT_EQ(s.switching.size(), reserved_num_impulse);
+  EXPECT_EQ(s.lift.size(), 2*reserved_num_lift);
+  // The single-count reserve grows both kinds.
+  contact_sequence.reserve(2*max_num_each_events);
+  EXPECT_EQ(contact_sequence.reservedNumDiscreteEvents(), 2*max_num_each_events);
+  EXPECT_EQ(contact_sequence.reservedNumImpulseEvents(), 2*max_num_each_events);
+  EXPECT_EQ(contact_sequence.reservedNumLiftEvents(), 2*max_num_each_events);
+  EXPECT_EQ(contact_sequence.numDiscreteEvents(), 0);
+  // Reserving keeps the contact sequence as is.
+  auto pre_contact_status = robot.createContactStatus();
+  pre_contact_status.setRandom();
+  contact_sequence.init(pre_contact_status);
+  contact_sequence.reserve(3*max_num_each_events, 3*max_num_each_events);
+  EXPECT_EQ(contact_sequence.numContactPhases(), 1);
+  EXPECT_EQ(contact_sequence.numDiscreteEvents(), 0);
+  EXPECT_TRUE(contact_sequence.contactStatus(0) == pre_contact_status);
+}
+
+
 TEST_F(ContactSequenceTest, fixedBase) {
   const double dt = 0.001;
   auto robot = testhelper::CreateRobotManipulator(dt);
@@ -321,6 +403,8 @@ TEST_F(ContactSequenceTest, fixedBase) {
   test_pop_back(robot);
   test_pop_front(robot);
   test_setContactPlacements(robot);
+  test_reserve(robot);
+  test_reservePerEventKind(robot);
 }
 
 
@@ -333,6 +417,8 @@ TEST_F(ContactSequenceTest, floatingBase) {
   test_pop_back(robot);
   test_pop_front(robot);
   test_setContactPlacements(robot);
+  test_reserve(robot);
+  test_reservePerEventKind(robot);
 }
 
 } // namespace robotoc
@@ -64,6 +64,7 @@ TEST_F(DwellTimeLowerBoundTest, lub) {
   const double kkt_error = bound.KKTError();
   const double kkt_error_ref = residual_ref*residual_ref + cmpl_ref*cmpl_ref;
   EXPECT_DOUBLE_EQ(kkt_error, kkt_error_ref);
+  EXPECT_DOUBLE_EQ(bound.constraintViolation(), std::abs(residual_ref));
   SplitKKTResidual kkt_res1, kkt_res2;
   bound.evalDerivatives_lub(kkt_res1, kkt_res2);
   double h1_ref = dual_ref;
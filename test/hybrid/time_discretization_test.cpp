@@ -693,6 +693,46 @@ TEST_P(TimeDiscretizationTest, discretizePhaseBased_eventTimesAreLargerThanHoriz
 }
 
 
+TEST_P(TimeDiscretizationTest, setSwitchingTimes) {
+  TimeDiscretization discretization(T, N, max_num_events);
+  discretization.setDiscretizationMethod(DiscretizationMethod::PhaseBased);
+  const auto robot = GetParam();
+  const auto contact_sequence = createContactSequence(robot);
+  discretization.meshRefinement(contact_sequence, t);
+  const int N_impulse = discretization.N_impulse();
+  const int N_lift = discretization.N_lift();
+  Eigen::VectorXd impulse_times = Eigen::VectorXd::Zero(max_num_events);
+  Eigen::VectorXd lift_times = Eigen::VectorXd::Zero(max_num_events);
+  for (int i=0; i<N_impulse; ++i) {
+    impulse_times.coeffRef(i) = contact_sequence->impulseTime(i) + 0.1 * dt;
+    contact_sequence->setImpulseTime(i, impulse_times.coeff(i));
+  }
+  for (int i=0; i<N_lift; ++i) {
+    lift_times.coeffRef(i) = contact_sequence->liftTime(i) + 0.1 * dt;
+    contact_sequence->setLiftTime(i, lift_times.coeff(i));
+  }
+  auto discretization_ref = discretization;
+  discretization_ref.discretize(contact_sequence, t);
+  discretization.setSwitchingTimes(impulse_times, lift_times);
+  EXPECT_EQ(discretization.N(), discretization_ref.N());
+  EXPECT_EQ(discretization.N_impulse(), discretization_ref.N_impulse());
+  EXPECT_EQ(discretization.N_lift(), discretization_ref.N_lift());
+  for (int i=0; i<=N; ++i) {
+    EXPECT_DOUBLE_EQ(discretization.gridInfo(i).t, discretization_ref.gridInfo(i).t);
+    EXPECT_DOUBLE_EQ(discretization.gridInfo(i).dt, discretization_ref.gridInfo(i).dt);
+    EXPECT_EQ(discretization.gridInfo(i).N_phase, discretization_ref.gridInfo(i).N_phase);
+  }
+  for (int i=0; i<N_impulse; ++i) {
+    EXPECT_DOUBLE_EQ(discretization.impulseTime(i), impulse_times.coeff(i));
+    EXPECT_DOUBLE_EQ(discretization.gridInfoImpulse(i).dt, discretization_ref.gridInfoImpulse(i).dt);
+  }
+  for (int i=0; i<N_lift; ++i) {
+    EXPECT_DOUBLE_EQ(discretization.liftTime(i), lift_times.coeff(i));
+    EXPECT_DOUBLE_EQ(discretization.gridInfoLift(i).dt, discretization_ref.gridInfoLift(i).dt);
+  }
+}
+
+
 INSTANTIATE_TEST_SUITE_P(
   TestWithMultipleRobots, TimeDiscretizationTest, 
   ::testing::Values(testhelper::CreateRobotManipulator(std::abs(Eigen::VectorXd::Random(1)[0])),
@@ -0,0 +1,140 @@
+#include <vector>
+#include <thread>
+#include <chrono>
+
+#include <gtest/gtest.h>
+
+#include "Eigen/Core"
+
+#include "robotoc/robot/contact_status.hpp"
+#include "robotoc/mpc/contact_planner_base.hpp"
+#include "robotoc/mpc/contact_planning_pipeline.hpp"
+
+
+namespace robotoc {
+
+class MockContactPlanner : public ContactPlannerBase {
+public:
+  MockContactPlanner()
+    : t(0), num_planning(0), planning_steps(0), thread_id(),
+      contact_placements_(), contact_positions_(), contact_surfaces_(),
+      com_(Eigen::Vector3d::Zero()), R_(Eigen::Matrix3d::Identity()) {}
+
+  void init(const Eigen::VectorXd& q) override {}
+
+  bool plan(const double t, const Eigen::VectorXd& q, const Eigen::VectorXd& v, 
+            const ContactStatus& contact_status, 
+            const int planning_steps) override {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    this->t = t;
+    this->q = q;
+    this->planning_steps = planning_steps;
+    thread_id = std::this_thread::get_id();
+    ++num_planning;
+    return true;
+  }
+
+  const aligned_vector<SE3>& contactPlacements(const int step) const override { 
+    return contact_placements_; 
+  }
+
+  const std::vector<Eigen::Vector3d>& contactPositions(const int step) const override { 
+    return contact_positions_; 
+  }
+
+  const std::vector<Eigen::Matrix3d>& contactSurfaces(const int step) const override { 
+    return contact_surfaces_; 
+  }
+
+  const Eigen::Vector3d& CoM(const int step) const override { return com_; }
+
+  const Eigen::Matrix3d& R(const int step) const override { return R_; }
+
+  int size() const override { return planning_steps; }
+
+  double t;
+  Eigen::VectorXd q;
+  int num_planning, planning_steps;
+  std::thread::id thread_id;
+
+private:
+  aligned_vector<SE3> contact_placements_;
+  std::vector<Eigen::Vector3d> contact_positions_;
+  std::vector<Eigen::Matrix3d> contact_surfaces_;
+  Eigen::Vector3d com_;
+  Eigen::Matrix3d R_;
+};
+
+
+class ContactPlanningPipelineTest : public ::testing::Test {
+protected:
+  virtual void SetUp() {
+    const std::vector<ContactType> contact_types(4, ContactType::PointContact);
+    cs_standing = ContactStatus(contact_types);
+    cs_standing.activateContacts(std::vector<int>({0, 1, 2, 3}));
+    cs_lfrh = ContactStatus(contact_types);
+    cs_lfrh.activateContacts(std::vector<int>({0, 3}));
+    q = Eigen::VectorXd::Random(19);
+    v = Eigen::VectorXd::Random(18);
+  }
+
+  virtual void TearDown() {
+  }
+
+  ContactStatus cs_standing, cs_lfrh;
+  Eigen::VectorXd q, v;
+};
+
+
+TEST_F(ContactPlanningPipelineTest, synchronize) {
+  auto planner = std::make_shared<MockContactPlanner>();
+  ContactPlanningPipeline pipeline;
+  EXPECT_FALSE(pipeline.isInFlight());
+  EXPECT_FALSE(pipeline.synchronize(cs_standing, 3));
+  const double t = 0.1;
+  pipeline.launch(planner, t, q, v, cs_standing, 3);
+  EXPECT_TRUE(pipeline.isInFlight());
+  // The inputs are copied at the launch.
+  const Eigen::VectorXd q_launched = q;
+  q.setRandom();
+  EXPECT_TRUE(pipeline.synchronize(cs_standing, 3));
+  EXPECT_FALSE(pipeline.isInFlight());
+  EXPECT_EQ(planner->num_planning, 1);
+  EXPECT_DOUBLE_EQ(planner->t, t);
+  EXPECT_TRUE(planner->q.isApprox(q_launched));
+  EXPECT_EQ(planner->planning_steps, 3);
+  EXPECT_NE(planner->thread_id, std::this_thread::get_id());
+  // Inconsistent contact structure.
+  pipeline.launch(planner, t, q, v, cs_standing, 3);
+  EXPECT_FALSE(pipeline.synchronize(cs_lfrh, 3));
+  pipeline.launch(planner, t, q, v, cs_standing, 3);
+  EXPECT_FALSE(pipeline.synchronize(cs_standing, 4));
+  EXPECT_EQ(planner->num_planning, 3);
+}
+
+
+TEST_F(ContactPlanningPipelineTest, cancel) {
+  auto planner = std::make_shared<MockContactPlanner>();
+  ContactPlanningPipeline pipeline;
+  pipeline.launch(planner, 0.0, q, v, cs_standing, 3);
+  pipeline.cancel();
+  EXPECT_FALSE(pipeline.isInFlight());
+  EXPECT_EQ(planner->num_planning, 1);
+  EXPECT_FALSE(pipeline.synchronize(cs_standing, 3));
+  pipeline.launch(planner, 0.0, q, v, cs_standing, 3);
+  // Launch again without synchronization waits for the previous planning.
+  pipeline.launch(planner, 0.0, q, v, cs_standing, 3);
+  EXPECT_TRUE(pipeline.synchronize(cs_standing, 3));
+  EXPECT_EQ(planner->num_planning, 3);
+  const auto copy = pipeline;
+  EXPECT_FALSE(copy.isInFlight());
+  pipeline.launch(planner, 0.0, q, v, cs_standing, 3);
+}
+
+} // namespace robotoc
+
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -29,6 +29,7 @@ protected:
   void test_computeResidual(Robot& robot, const ContactStatus& contact_status) const;
   void test_linearize(Robot& robot, const ContactStatus& contact_status) const;
   void test_condense(Robot& robot, const ContactStatus& contact_status) const;
+  void test_computeForwardDynamics(Robot& robot, const ContactStatus& contact_status) const;
 
   double dt;
 };
@@ -208,6 +209,24 @@ void ContactDynamicsTest::test_condense(Robot& robot, const ContactStatus& conta
 }
 
 
+void ContactDynamicsTest::test_computeForwardDynamics(Robot& robot, const ContactStatus& contact_status) const {
+  auto s = SplitSolution::Random(robot, contact_status);
+  const auto s_ref = s;
+  ContactDynamics cd(robot);
+  cd.computeForwardDynamics(robot, contact_status, s);
+  EXPECT_TRUE(s.q.isApprox(s_ref.q));
+  EXPECT_TRUE(s.v.isApprox(s_ref.v));
+  EXPECT_TRUE(s.u.isApprox(s_ref.u));
+  robot.updateKinematics(s.q, s.v, s.a);
+  cd.evalContactDynamics(robot, contact_status, s);
+  EXPECT_NEAR(cd.constraintViolation(), 0, 1.0e-08);
+  auto s_data = s_ref;
+  ContactDynamicsData data(robot);
+  ContactDynamics::computeForwardDynamics(robot, contact_status, data, s_data);
+  EXPECT_TRUE(s_data.isApprox(s));
+}
+
+
 TEST_F(ContactDynamicsTest, robotManipulator) {
   auto robot = testhelper::CreateRobotManipulator(dt);
   auto contact_status = robot.createContactStatus();
@@ -217,10 +236,12 @@ TEST_F(ContactDynamicsTest, robotManipulator) {
   test_computeResidual(robot, contact_status);
   test_linearize(robot, contact_status);
   test_condense(robot, contact_status);
+  test_computeForwardDynamics(robot, contact_status);
   contact_status.activateContact(0);
   test_computeResidual(robot, contact_status);
   test_linearize(robot, contact_status);
   test_condense(robot, contact_status);
+  test_computeForwardDynamics(robot, contact_status);
 }
 
 
@@ -233,6 +254,7 @@ TEST_F(ContactDynamicsTest, quadrupedalRobot) {
   test_computeResidual(robot, contact_status);
   test_linearize(robot, contact_status);
   test_condense(robot, contact_status);
+  test_computeForwardDynamics(robot, contact_status);
   contact_status.setRandom();
   if (!contact_status.hasActiveContacts()) {
     contact_status.activateContact(0);
@@ -240,6 +262,7 @@ TEST_F(ContactDynamicsTest, quadrupedalRobot) {
   test_computeResidual(robot, contact_status);
   test_linearize(robot, contact_status);
   test_condense(robot, contact_status);
+  test_computeForwardDynamics(robot, contact_status);
 }
 
 
@@ -252,6 +275,7 @@ TEST_F(ContactDynamicsTest, humanoidRobot) {
   test_computeResidual(robot, contact_status);
   test_linearize(robot, contact_status);
   test_condense(robot, contact_status);
+  test_computeForwardDynamics(robot, contact_status);
   contact_status.setRandom();
   if (!contact_status.hasActiveContacts()) {
     contact_status.activateContact(0);
@@ -259,6 +283,7 @@ TEST_F(ContactDynamicsTest, humanoidRobot) {
   test_computeResidual(robot, contact_status);
   test_linearize(robot, contact_status);
   test_condense(robot, contact_status);
+  test_computeForwardDynamics(robot, contact_status);
 }
 
 } // namespace robotoc
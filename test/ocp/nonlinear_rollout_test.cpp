@@ -0,0 +1,138 @@
+#include <memory>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include "Eigen/Core"
+
+#include "robotoc/robot/robot.hpp"
+#include "robotoc/hybrid/contact_sequence.hpp"
+#include "robotoc/hybrid/hybrid_container.hpp"
+#include "robotoc/riccati/lqr_policy.hpp"
+#include "robotoc/ocp/ocp.hpp"
+#include "robotoc/ocp/nonlinear_rollout.hpp"
+
+#include "test_helper.hpp"
+#include "robot_factory.hpp"
+#include "contact_sequence_factory.hpp"
+#include "solution_factory.hpp"
+#include "cost_factory.hpp"
+#include "constraints_factory.hpp"
+
+
+namespace robotoc {
+
+class NonlinearRolloutTest : public ::testing::TestWithParam<Robot> {
+protected:
+  virtual void SetUp() {
+    srand((unsigned int) time(0));
+    N = 20;
+    max_num_impulse = 5;
+    T = 1;
+    t = std::abs(Eigen::VectorXd::Random(1)[0]);
+    dt = T / N;
+  }
+
+  virtual void TearDown() {
+  }
+
+  Eigen::VectorXd stateEquationResidual(const Robot& robot, const OCP& ocp,
+                                        const Solution& s, const int i) const;
+
+  int N, max_num_impulse;
+  double T, t, dt;
+};
+
+
+Eigen::VectorXd NonlinearRolloutTest::stateEquationResidual(
+    const Robot& robot, const OCP& ocp, const Solution& s, const int i) const {
+  const int dimv = robot.dimv();
+  const double dt_i = ocp.discrete().gridInfo(i).dt;
+  Eigen::VectorXd F = Eigen::VectorXd::Zero(2*dimv);
+  Eigen::VectorXd Fq = Eigen::VectorXd::Zero(dimv);
+  robot.subtractConfiguration(s[i].q, s[i+1].q, Fq);
+  F.head(dimv) = Fq + dt_i * s[i].v;
+  F.tail(dimv) = s[i].v + dt_i * s[i].a - s[i+1].v;
+  return F;
+}
+
+
+TEST_P(NonlinearRolloutTest, rolloutHorizon) {
+  auto robot = GetParam();
+  auto cost = testhelper::CreateCost(robot);
+  auto constraints = testhelper::CreateConstraints(robot);
+  const auto contact_sequence
+      = testhelper::CreateContactSequenceSharedPtr(robot, N, max_num_impulse,
+                                                   t, 3*dt);
+  auto ocp = OCP(robot, cost, constraints, contact_sequence, T, N);
+  ocp.discretize(t);
+  const int horizon = NonlinearRollout::rolloutHorizon(ocp);
+  EXPECT_TRUE(horizon >= 0);
+  EXPECT_TRUE(horizon <= ocp.discrete().N());
+  for (int i=0; i<horizon; ++i) {
+    EXPECT_FALSE(ocp.discrete().isTimeStageBeforeImpulse(i));
+    EXPECT_FALSE(ocp.discrete().isTimeStageBeforeLift(i));
+  }
+  if (horizon < ocp.discrete().N()) {
+    EXPECT_TRUE(ocp.discrete().isTimeStageBeforeImpulse(horizon)
+                || ocp.discrete().isTimeStageBeforeLift(horizon));
+  }
+}
+
+
+TEST_P(NonlinearRolloutTest, rollout) {
+  auto robot = GetParam();
+  auto cost = testhelper::CreateCost(robot);
+  auto constraints = testhelper::CreateConstraints(robot);
+  const auto contact_sequence
+      = testhelper::CreateContactSequenceSharedPtr(robot, N, max_num_impulse,
+                                                   t, 3*dt);
+  auto ocp = OCP(robot, cost, constraints, contact_sequence, T, N);
+  ocp.discretize(t);
+  const int horizon = NonlinearRollout::rolloutHorizon(ocp);
+  const auto s_init = testhelper::CreateSolution(robot, contact_sequence, T, N,
+                                                 max_num_impulse, t);
+  const hybrid_container<LQRPolicy> lqr_policy(robot, N, max_num_impulse);
+  NonlinearRollout nonlinear_rollout(ocp);
+  // With the full step, the defects are closed.
+  auto s = s_init;
+  nonlinear_rollout.computeDefects(ocp, robot, s);
+  nonlinear_rollout.rollout(ocp, robot, lqr_policy, 1.0, s);
+  EXPECT_TRUE(s[0].q.isApprox(s_init[0].q));
+  EXPECT_TRUE(s[0].v.isApprox(s_init[0].v));
+  for (int i=0; i<horizon; ++i) {
+    EXPECT_TRUE(stateEquationResidual(robot, ocp, s, i).isZero(1.0e-08));
+    EXPECT_TRUE(s[i].u.isApprox(s_init[i].u));
+  }
+  // With a partial step, the defects are reduced by (1 - step size).
+  const double primal_step_size = 0.3;
+  s = s_init;
+  nonlinear_rollout.computeDefects(ocp, robot, s);
+  std::vector<Eigen::VectorXd> defects_ref;
+  for (int i=0; i<horizon; ++i) {
+    defects_ref.push_back(stateEquationResidual(robot, ocp, s, i));
+  }
+  nonlinear_rollout.rollout(ocp, robot, lqr_policy, primal_step_size, s);
+  for (int i=0; i<horizon; ++i) {
+    EXPECT_TRUE(stateEquationResidual(robot, ocp, s, i).isApprox(
+                    (1.0-primal_step_size)*defects_ref[i], 1.0e-06));
+  }
+}
+
+
+INSTANTIATE_TEST_SUITE_P(
+  TestWithMultipleRobots, NonlinearRolloutTest,
+  ::testing::Values(testhelper::CreateRobotManipulator(),
+                    testhelper::CreateRobotManipulator(std::abs(Eigen::VectorXd::Random(1)[0])),
+                    testhelper::CreateQuadrupedalRobot(),
+                    testhelper::CreateQuadrupedalRobot(std::abs(Eigen::VectorXd::Random(1)[0])),
+                    testhelper::CreateHumanoidRobot(),
+                    testhelper::CreateHumanoidRobot(std::abs(Eigen::VectorXd::Random(1)[0])))
+);
+
+} // namespace robotoc
+
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -127,6 +127,141 @@ TEST_F(StateEquationTest, floatingBase) {
   EXPECT_TRUE(d.isApprox(d_ref));
 }
 
+
+TEST_F(StateEquationTest, fixedbaseMidpoint) {
+  auto robot = testhelper::CreateRobotManipulator(dt);
+  const int dimv = robot.dimv();
+  const Eigen::VectorXd q_prev = robot.generateFeasibleConfiguration();
+  const auto s = SplitSolution::Random(robot);
+  const auto s_next = SplitSolution::Random(robot);
+  SplitKKTResidual kkt_residual(robot);
+  SplitKKTMatrix kkt_matrix(robot);
+  StateEquation state_equation(robot);
+  EXPECT_EQ(state_equation.integrationScheme(), IntegrationScheme::ForwardEuler);
+  state_equation.setIntegrationScheme(IntegrationScheme::Midpoint);
+  EXPECT_EQ(state_equation.integrationScheme(), IntegrationScheme::Midpoint);
+  auto kkt_residual_ref = kkt_residual;
+  auto kkt_matrix_ref = kkt_matrix;
+  state_equation.linearizeStateEquation(robot, dt, q_prev, s, s_next, 
+                                        kkt_matrix, kkt_residual);
+  kkt_residual_ref.Fq() = s.q + dt * s.v + 0.5 * dt * dt * s.a - s_next.q;
+  kkt_residual_ref.Fv() = s.v + dt * s.a - s_next.v;
+  kkt_residual_ref.lq() = s_next.lmd - s.lmd;
+  kkt_residual_ref.lv() = dt * s_next.lmd + s_next.gmm - s.gmm;
+  kkt_residual_ref.la   = dt * s_next.gmm + 0.5 * dt * dt * s_next.lmd;
+  kkt_residual_ref.h  = s_next.lmd.dot(s.v) + s_next.gmm.dot(s.a) 
+                          + dt * s_next.lmd.dot(s.a);
+  kkt_matrix_ref.hv() = s_next.lmd;
+  kkt_matrix_ref.ha   = s_next.gmm + dt * s_next.lmd;
+  kkt_matrix_ref.fq() = s.v + dt * s.a;
+  kkt_matrix_ref.fv() = s.a;
+  kkt_matrix_ref.Qtt  = s_next.lmd.dot(s.a);
+  kkt_matrix_ref.Fqq() = Eigen::MatrixXd::Identity(dimv, dimv);
+  kkt_matrix_ref.Fqv() = dt * Eigen::MatrixXd::Identity(dimv, dimv);
+  EXPECT_TRUE(kkt_residual.isApprox(kkt_residual_ref));
+  EXPECT_TRUE(kkt_matrix.isApprox(kkt_matrix_ref));
+  // Emulates the condensed contact dynamics.
+  kkt_matrix.Fvq().setRandom();
+  kkt_matrix.Fvv().setRandom();
+  kkt_matrix.Fvu.setRandom();
+  kkt_residual.Fv().setRandom();
+  kkt_matrix_ref = kkt_matrix;
+  kkt_residual_ref = kkt_residual;
+  state_equation.correctLinearizedStateEquation(robot, dt, s, s_next, 
+                                                kkt_matrix, kkt_residual);
+  kkt_matrix_ref.Fqq() += 0.5 * dt * kkt_matrix_ref.Fvq();
+  kkt_matrix_ref.Fqv() += 0.5 * dt * (kkt_matrix_ref.Fvv() 
+                                      - Eigen::MatrixXd::Identity(dimv, dimv));
+  kkt_matrix_ref.Fqu = 0.5 * dt * kkt_matrix_ref.Fvu;
+  kkt_residual_ref.Fq() += 0.5 * dt * (kkt_residual_ref.Fv() 
+                                       - (s.v + dt * s.a - s_next.v));
+  EXPECT_TRUE(kkt_residual.isApprox(kkt_residual_ref));
+  EXPECT_TRUE(kkt_matrix.isApprox(kkt_matrix_ref));
+  const auto d_next = SplitDirection::Random(robot);
+  state_equation.setCostateDirectionNext(dt, d_next);
+  const Eigen::VectorXd dgmm_next_ref = d_next.dgmm() + 0.5 * dt * d_next.dlmd();
+  EXPECT_TRUE(state_equation.dgmmNext().isApprox(dgmm_next_ref));
+  auto d = SplitDirection::Random(robot);
+  auto d_ref = d;
+  state_equation.correctCostateDirection(d);
+  EXPECT_TRUE(d.isApprox(d_ref));
+}
+
+
+TEST_F(StateEquationTest, floatingBaseMidpoint) {
+  auto robot = testhelper::CreateQuadrupedalRobot(dt);
+  const int dimv = robot.dimv();
+  const Eigen::VectorXd q_prev = robot.generateFeasibleConfiguration();
+  const auto s = SplitSolution::Random(robot);
+  const auto s_next = SplitSolution::Random(robot);
+  SplitKKTResidual kkt_residual(robot);
+  SplitKKTMatrix kkt_matrix(robot);
+  StateEquation state_equation(robot);
+  state_equation.setIntegrationScheme(IntegrationScheme::Midpoint);
+  auto kkt_residual_ref = kkt_residual;
+  auto kkt_matrix_ref = kkt_matrix;
+  state_equation.linearizeStateEquation(robot, dt, q_prev, s, s_next, 
+                                        kkt_matrix, kkt_residual);
+  Eigen::VectorXd qdiff = Eigen::VectorXd::Zero(dimv);
+  robot.subtractConfiguration(s.q, s_next.q, qdiff);
+  Eigen::MatrixXd dsubtract_dq = Eigen::MatrixXd::Zero(dimv, dimv);
+  Eigen::MatrixXd dsubtract_dq_prev = Eigen::MatrixXd::Zero(dimv, dimv);
+  robot.dSubtractConfiguration_dqf(s.q, s_next.q, dsubtract_dq);
+  robot.dSubtractConfiguration_dq0(q_prev, s.q, dsubtract_dq_prev);
+  kkt_residual_ref.Fq() = qdiff + dt * s.v + 0.5 * dt * dt * s.a;
+  kkt_residual_ref.Fv() = s.v + dt * s.a - s_next.v;
+  kkt_residual_ref.lq() = dsubtract_dq.transpose() * s_next.lmd
+                          + dsubtract_dq_prev.transpose() * s.lmd;
+  kkt_residual_ref.lv() = dt * s_next.lmd + s_next.gmm - s.gmm;
+  kkt_residual_ref.la   = dt * s_next.gmm + 0.5 * dt * dt * s_next.lmd;
+  kkt_residual_ref.h  = s_next.lmd.dot(s.v) + s_next.gmm.dot(s.a) 
+                          + dt * s_next.lmd.dot(s.a);
+  kkt_matrix_ref.hv() = s_next.lmd;
+  kkt_matrix_ref.ha   = s_next.gmm + dt * s_next.lmd;
+  kkt_matrix_ref.fq() = s.v + dt * s.a;
+  kkt_matrix_ref.fv() = s.a;
+  kkt_matrix_ref.Qtt  = s_next.lmd.dot(s.a);
+  kkt_matrix_ref.Fqq() = dsubtract_dq;
+  kkt_matrix_ref.Fqv() = dt * Eigen::MatrixXd::Identity(dimv, dimv);
+  kkt_matrix_ref.Fqq_prev = dsubtract_dq_prev;
+  EXPECT_TRUE(kkt_residual.isApprox(kkt_residual_ref));
+  EXPECT_TRUE(kkt_matrix.isApprox(kkt_matrix_ref));
+  // Emulates the condensed contact dynamics.
+  kkt_matrix.Fvq().setRandom();
+  kkt_matrix.Fvv().setRandom();
+  kkt_matrix.Fvu.setRandom();
+  kkt_residual.Fv().setRandom();
+  kkt_matrix_ref = kkt_matrix;
+  kkt_residual_ref = kkt_residual;
+  state_equation.correctLinearizedStateEquation(robot, dt, s, s_next, 
+                                                kkt_matrix, kkt_residual);
+  kkt_matrix_ref.Fqq() += 0.5 * dt * kkt_matrix_ref.Fvq();
+  kkt_matrix_ref.Fqv() += 0.5 * dt * (kkt_matrix_ref.Fvv() 
+                                      - Eigen::MatrixXd::Identity(dimv, dimv));
+  kkt_matrix_ref.Fqu = 0.5 * dt * kkt_matrix_ref.Fvu;
+  kkt_residual_ref.Fq() += 0.5 * dt * (kkt_residual_ref.Fv() 
+                                       - (s.v + dt * s.a - s_next.v));
+  robot.dSubtractConfiguration_dq0(s.q, s_next.q, dsubtract_dq_prev);
+  const Eigen::MatrixXd dsubtract_dq_inv = dsubtract_dq_prev.topLeftCorner(6, 6).inverse();
+  const Eigen::MatrixXd Fqx_tmp = kkt_matrix_ref.Fxx.topRows(6);
+  kkt_matrix_ref.Fxx.topRows(6) = - dsubtract_dq_inv * Fqx_tmp;
+  const Eigen::MatrixXd Fqu_tmp = kkt_matrix_ref.Fqu.topRows(6);
+  kkt_matrix_ref.Fqu.topRows(6) = - dsubtract_dq_inv * Fqu_tmp;
+  const Eigen::VectorXd Fq_tmp = kkt_residual_ref.Fq().head(6);
+  kkt_residual_ref.Fq().head(6) = - dsubtract_dq_inv * Fq_tmp;
+  const Eigen::VectorXd fq_tmp = kkt_matrix_ref.fq().head(6);
+  kkt_matrix_ref.fq().head(6) = - dsubtract_dq_inv * fq_tmp;
+  kkt_matrix_ref.Fqq_prev = dsubtract_dq_prev;
+  EXPECT_TRUE(kkt_residual.isApprox(kkt_residual_ref));
+  EXPECT_TRUE(kkt_matrix.isApprox(kkt_matrix_ref));
+  const auto d_next = SplitDirection::Random(robot);
+  state_equation.setCostateDirectionNext(dt, d_next);
+  Eigen::VectorXd dlmd_next = d_next.dlmd();
+  dlmd_next.head(6) = - dsubtract_dq_inv.transpose() * d_next.dlmd().head(6);
+  const Eigen::VectorXd dgmm_next_ref = d_next.dgmm() + 0.5 * dt * dlmd_next;
+  EXPECT_TRUE(state_equation.dgmmNext().isApprox(dgmm_next_ref));
+}
+
 } // namespace robotoc
 
 
@@ -82,6 +82,10 @@ TEST_F(UnconstrSplitBackwardCorrectionTest, test) {
   s_new_ref.v   = s.v   - d_coarse.segment(4*dimv, dimv);
   EXPECT_TRUE(s_new.isApprox(s_new_ref));
   EXPECT_TRUE(corr.auxMat().isApprox(KKT_mat_inv.topLeftCorner(dimx, dimx)));
+  EXPECT_TRUE(corr.backwardCorrectionMat().isApprox(
+      KKT_mat_inv.block(0, dimKKT-dimx, dimx, dimx)));
+  EXPECT_TRUE(corr.forwardCorrectionMat().isApprox(
+      KKT_mat_inv.block(dimKKT-dimx, 0, dimx, dimx)));
 
   const auto s_prev = SplitSolution::Random(robot);
   const auto s_new_prev = SplitSolution::Random(robot);
@@ -131,6 +135,40 @@ TEST_F(UnconstrSplitBackwardCorrectionTest, test) {
 }
 
 
+TEST_F(UnconstrSplitBackwardCorrectionTest, testResidualVector) {
+  Eigen::MatrixXd aux_mat_seed(Eigen::MatrixXd::Random(dimx, dimx));
+  const Eigen::MatrixXd aux_mat_next = aux_mat_seed * aux_mat_seed.transpose();
+  UnconstrSplitBackwardCorrection corr(robot), corr_ref(robot);
+  auto s_new = SplitSolution::Random(robot);
+  auto s_new_ref = s_new;
+  corr.coarseUpdate(aux_mat_next, dt, kkt_matrix, kkt_residual, s, s_new);
+  corr_ref.coarseUpdate(aux_mat_next, dt, kkt_matrix, kkt_residual, s, s_new_ref);
+
+  const auto s_prev = SplitSolution::Random(robot);
+  const auto s_new_prev = SplitSolution::Random(robot);
+  const auto s_next = SplitSolution::Random(robot);
+  const auto s_new_next = SplitSolution::Random(robot);
+  Eigen::VectorXd x_res = Eigen::VectorXd::Zero(dimx);
+  x_res.head(dimv) = s_new_next.lmd - s_next.lmd;
+  x_res.tail(dimv) = s_new_next.gmm - s_next.gmm;
+  corr.backwardCorrectionSerial(x_res, s_new);
+  corr_ref.backwardCorrectionSerial(s_next, s_new_next, s_new_ref);
+  EXPECT_TRUE(s_new.isApprox(s_new_ref));
+  corr.backwardCorrectionParallel(s_new);
+  corr_ref.backwardCorrectionParallel(s_new_ref);
+  EXPECT_TRUE(s_new.isApprox(s_new_ref));
+
+  x_res.head(dimv) = s_new_prev.q - s_prev.q;
+  x_res.tail(dimv) = s_new_prev.v - s_prev.v;
+  corr.forwardCorrectionSerial(x_res, s_new);
+  corr_ref.forwardCorrectionSerial(s_prev, s_new_prev, s_new_ref);
+  EXPECT_TRUE(s_new.isApprox(s_new_ref));
+  corr.forwardCorrectionParallel(s_new);
+  corr_ref.forwardCorrectionParallel(s_new_ref);
+  EXPECT_TRUE(s_new.isApprox(s_new_ref));
+}
+
+
 TEST_F(UnconstrSplitBackwardCorrectionTest, testTerminal) {
   UnconstrSplitBackwardCorrection corr(robot);
   auto s_new = SplitSolution::Random(robot);
@@ -152,6 +190,10 @@ TEST_F(UnconstrSplitBackwardCorrectionTest, testTerminal) {
   s_new_ref.v   = s.v   - d_coarse.segment(4*dimv, dimv);
   EXPECT_TRUE(s_new.isApprox(s_new_ref));
   EXPECT_TRUE(corr.auxMat().isApprox(KKT_mat_inv.topLeftCorner(dimx, dimx)));
+  EXPECT_TRUE(corr.backwardCorrectionMat().isApprox(
+      KKT_mat_inv.block(0, dimKKT-dimx, dimx, dimx)));
+  EXPECT_TRUE(corr.forwardCorrectionMat().isApprox(
+      KKT_mat_inv.block(dimKKT-dimx, 0, dimx, dimx)));
 }
 
 } // namespace robotoc
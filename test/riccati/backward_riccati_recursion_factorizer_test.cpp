@@ -107,6 +107,82 @@ TEST_P(BackwardRiccatiRecursionFactorizerTest, test) {
 }
 
 
+TEST_P(BackwardRiccatiRecursionFactorizerTest, test_midpoint) {
+  const auto robot = GetParam();
+  const int dimv = robot.dimv();
+  const int dimu = robot.dimu();
+  const auto riccati_next = testhelper::CreateSplitRiccatiFactorization(robot);
+  auto kkt_matrix = testhelper::CreateSplitKKTMatrix(robot, dt);
+  kkt_matrix.Fqu = Eigen::MatrixXd::Random(dimv, dimu);
+  auto kkt_residual = testhelper::CreateSplitKKTResidual(robot);
+  const auto kkt_matrix_ref = kkt_matrix;
+  const auto kkt_residual_ref = kkt_residual;
+  BackwardRiccatiRecursionFactorizer factorizer(robot);
+  factorizer.factorizeKKTMatrix(riccati_next, kkt_matrix, kkt_residual);
+  const Eigen::MatrixXd A = kkt_matrix_ref.Fxx;
+  Eigen::MatrixXd B = Eigen::MatrixXd::Zero(2*dimv, dimu);
+  B.topRows(dimv) = kkt_matrix_ref.Fqu;
+  B.bottomRows(dimv) = kkt_matrix_ref.Fvu;
+  const Eigen::MatrixXd F_ref = kkt_matrix_ref.Qxx + A.transpose() * riccati_next.P * A;
+  const Eigen::MatrixXd H_ref = kkt_matrix_ref.Qxu + A.transpose() * riccati_next.P * B;
+  const Eigen::MatrixXd G_ref = kkt_matrix_ref.Quu + B.transpose() * riccati_next.P * B;
+  const Eigen::VectorXd lu_ref = B.transpose() * riccati_next.P * kkt_residual_ref.Fx - B.transpose() * riccati_next.s + kkt_residual_ref.lu;
+  EXPECT_TRUE(F_ref.isApprox(kkt_matrix.Qxx));
+  EXPECT_TRUE(H_ref.isApprox(kkt_matrix.Qxu));
+  EXPECT_TRUE(G_ref.isApprox(kkt_matrix.Quu));
+  EXPECT_TRUE(kkt_matrix.Quu.isApprox(kkt_matrix.Quu.transpose()));
+  EXPECT_TRUE(lu_ref.isApprox(kkt_residual.lu));
+  SplitRiccatiFactorization riccati(robot), riccati_ref(robot);
+  const bool has_next_sto_phase = true;
+  factorizer.factorizeHamiltonian(riccati_next, kkt_matrix, riccati, has_next_sto_phase);
+  riccati_ref.psi_x = kkt_matrix.hx + A.transpose() * riccati_next.P * kkt_matrix.fx + A.transpose() * riccati_next.Psi;
+  riccati_ref.psi_u = kkt_matrix.hu + B.transpose() * riccati_next.P * kkt_matrix.fx + B.transpose() * riccati_next.Psi;
+  riccati_ref.phi_x = A.transpose() * riccati_next.Phi;
+  riccati_ref.phi_u = B.transpose() * riccati_next.Phi;
+  EXPECT_TRUE(riccati.isApprox(riccati_ref));
+}
+
+
+TEST_P(BackwardRiccatiRecursionFactorizerTest, test_lower_triangular_hessian) {
+  const auto robot = GetParam();
+  const int dimv = robot.dimv();
+  const int dimu = robot.dimu();
+  const auto riccati_next = testhelper::CreateSplitRiccatiFactorization(robot);
+  auto kkt_matrix = testhelper::CreateSplitKKTMatrix(robot, dt);
+  kkt_matrix.Fqu = Eigen::MatrixXd::Random(dimv, dimu);
+  auto kkt_residual = testhelper::CreateSplitKKTResidual(robot);
+  auto kkt_matrix_ref = kkt_matrix;
+  auto kkt_residual_ref = kkt_residual;
+  // The strictly upper triangular parts must not be read.
+  kkt_matrix.setLowerTriangularHessian(true);
+  EXPECT_TRUE(kkt_matrix.isLowerTriangularHessian());
+  EXPECT_FALSE(kkt_matrix_ref.isLowerTriangularHessian());
+  kkt_matrix.Qxx.triangularView<Eigen::StrictlyUpper>().setConstant(1.0e10);
+  kkt_matrix.Quu.triangularView<Eigen::StrictlyUpper>().setConstant(1.0e10);
+  BackwardRiccatiRecursionFactorizer factorizer(robot), factorizer_ref(robot);
+  factorizer.factorizeKKTMatrix(riccati_next, kkt_matrix, kkt_residual);
+  factorizer_ref.factorizeKKTMatrix(riccati_next, kkt_matrix_ref, kkt_residual_ref);
+  const Eigen::MatrixXd F = kkt_matrix.Qxx.selfadjointView<Eigen::Lower>();
+  const Eigen::MatrixXd G = kkt_matrix.Quu.selfadjointView<Eigen::Lower>();
+  EXPECT_TRUE(F.isApprox(kkt_matrix_ref.Qxx));
+  EXPECT_TRUE(G.isApprox(kkt_matrix_ref.Quu));
+  EXPECT_TRUE(kkt_matrix.Qxu.isApprox(kkt_matrix_ref.Qxu));
+  EXPECT_TRUE(kkt_residual.lu.isApprox(kkt_residual_ref.lu));
+  LQRPolicy lqr_policy(robot);
+  lqr_policy.K.setRandom();
+  lqr_policy.k.setRandom();
+  SplitRiccatiFactorization riccati(robot), riccati_ref(robot);
+  factorizer.factorizeRiccatiFactorization(riccati_next, kkt_matrix, kkt_residual, lqr_policy, riccati);
+  factorizer_ref.factorizeRiccatiFactorization(riccati_next, kkt_matrix_ref, kkt_residual_ref, lqr_policy, riccati_ref);
+  EXPECT_TRUE(riccati.P.isApprox(riccati_ref.P));
+  EXPECT_TRUE(riccati.P.isApprox(riccati.P.transpose()));
+  EXPECT_TRUE(riccati.s.isApprox(riccati_ref.s));
+  kkt_matrix.symmetrizeHessian();
+  EXPECT_TRUE(kkt_matrix.Qxx.isApprox(kkt_matrix.Qxx.transpose()));
+  EXPECT_TRUE(kkt_matrix.Quu.isApprox(kkt_matrix.Quu.transpose()));
+}
+
+
 TEST_P(BackwardRiccatiRecursionFactorizerTest, test_impulse) {
   const auto robot = GetParam();
   const int dimv = robot.dimv();
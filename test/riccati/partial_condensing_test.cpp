@@ -0,0 +1,221 @@
+#include <memory>
+
+#include <gtest/gtest.h>
+#include "Eigen/Core"
+
+#include "robotoc/robot/robot.hpp"
+#include "robotoc/utils/aligned_vector.hpp"
+#include "robotoc/ocp/ocp.hpp"
+#include "robotoc/ocp/direct_multiple_shooting.hpp"
+#include "robotoc/riccati/riccati_factorization.hpp"
+#include "robotoc/riccati/riccati_recursion.hpp"
+#include "robotoc/riccati/partial_condensing.hpp"
+
+#include "test_helper.hpp"
+#include "robot_factory.hpp"
+#include "contact_sequence_factory.hpp"
+#include "solution_factory.hpp"
+#include "cost_factory.hpp"
+#include "constraints_factory.hpp"
+
+
+namespace robotoc {
+
+class PartialCondensingTest : public ::testing::TestWithParam<Robot> {
+protected:
+  virtual void SetUp() {
+    srand((unsigned int) time(0));
+    N = 20;
+    max_num_impulse = 5;
+    nthreads = 4;
+    T = 1;
+    t = std::abs(Eigen::VectorXd::Random(1)[0]);
+    dt = T / N;
+  }
+
+  virtual void TearDown() {
+  }
+
+  void test_partition(const Robot& robot, const int block_size) const;
+  void test_riccatiRecursion(const Robot& robot, const int block_size) const;
+
+  int N, max_num_impulse, nthreads;
+  double T, t, dt;
+};
+
+
+void PartialCondensingTest::test_partition(const Robot& robot,
+                                           const int block_size) const {
+  auto cost = testhelper::CreateCost(robot);
+  auto constraints = testhelper::CreateConstraints(robot);
+  const auto contact_sequence
+      = testhelper::CreateContactSequenceSharedPtr(robot, N, max_num_impulse, t, 3*dt);
+  auto ocp = OCP(robot, cost, constraints, contact_sequence, T, N);
+  ocp.discretize(t);
+  PartialCondensing partial_condensing(ocp, block_size);
+  if (block_size == 0) {
+    PartialCondensing other_partial_condensing(ocp, 1);
+    other_partial_condensing.setBlockSize(0);
+    EXPECT_EQ(other_partial_condensing.blockSize(), 
+              partial_condensing.blockSize());
+    EXPECT_EQ(partial_condensing.blockSize(), 
+              PartialCondensing::defaultBlockSize(robot));
+  }
+  partial_condensing.partition(ocp);
+  const auto& discrete = ocp.discrete();
+  int num_blocks = 0;
+  for (int i=0; i<discrete.N(); ++i) {
+    if (partial_condensing.isBlockBegin(i)) {
+      ++num_blocks;
+      const int block_end = partial_condensing.blockEnd(i);
+      EXPECT_TRUE(block_end > i);
+      EXPECT_TRUE(block_end-i+1 <= partial_condensing.blockSize());
+      EXPECT_TRUE(partial_condensing.isBlockEnd(block_end));
+      for (int j=i; j<=block_end; ++j) {
+        EXPECT_EQ(partial_condensing.blockBegin(j), i);
+        EXPECT_EQ(partial_condensing.isBlockInterior(j), (j > i));
+        EXPECT_FALSE(discrete.isTimeStageBeforeImpulse(j));
+        EXPECT_FALSE(discrete.isTimeStageBeforeLift(j));
+        EXPECT_FALSE(discrete.isTimeStageBeforeImpulse(j+1));
+      }
+    }
+  }
+  EXPECT_EQ(num_blocks, partial_condensing.numBlocks());
+  if (partial_condensing.blockSize() <= 1) {
+    EXPECT_FALSE(partial_condensing.isEnabled());
+    EXPECT_EQ(partial_condensing.numBlocks(), 0);
+  }
+  partial_condensing.setBlockSize(1);
+  partial_condensing.partition(ocp);
+  EXPECT_EQ(partial_condensing.numBlocks(), 0);
+  for (int i=0; i<discrete.N(); ++i) {
+    EXPECT_FALSE(partial_condensing.isBlockBegin(i));
+    EXPECT_FALSE(partial_condensing.isBlockInterior(i));
+  }
+}
+
+
+void PartialCondensingTest::test_riccatiRecursion(const Robot& robot,
+                                                  const int block_size) const {
+  auto cost = testhelper::CreateCost(robot);
+  auto constraints = testhelper::CreateConstraints(robot);
+  const auto contact_sequence
+      = testhelper::CreateContactSequenceSharedPtr(robot, N, max_num_impulse, t, 3*dt);
+  auto ocp = OCP(robot, cost, constraints, contact_sequence, T, N);
+  ocp.discretize(t);
+  const Eigen::VectorXd q = robot.generateFeasibleConfiguration();
+  const Eigen::VectorXd v = Eigen::VectorXd::Random(robot.dimv());
+  const auto s = testhelper::CreateSolution(robot, contact_sequence, T, N,
+                                            max_num_impulse, t);
+  DirectMultipleShooting dms(nthreads);
+  aligned_vector<Robot> robots(nthreads, robot);
+  dms.initConstraints(ocp, robots, contact_sequence, s);
+  KKTMatrix kkt_matrix(robot, N, max_num_impulse);
+  KKTResidual kkt_residual(robot, N, max_num_impulse);
+  dms.computeKKTSystem(ocp, robots, contact_sequence, q, v, s, kkt_matrix, kkt_residual);
+  auto kkt_matrix_ref = kkt_matrix;
+  auto kkt_residual_ref = kkt_residual;
+  auto ocp_ref = ocp;
+  // Reference without the partial condensing.
+  RiccatiRecursion riccati_recursion_ref(ocp_ref, nthreads);
+  RiccatiFactorization factorization_ref(robot, N, max_num_impulse);
+  riccati_recursion_ref.backwardRiccatiRecursion(ocp_ref, kkt_matrix_ref,
+                                                 kkt_residual_ref, factorization_ref);
+  Direction d_ref(robot, N, max_num_impulse);
+  dms.computeInitialStateDirection(ocp_ref, robots, q, v, s, d_ref);
+  riccati_recursion_ref.forwardRiccatiRecursion(ocp_ref, kkt_matrix_ref,
+                                                kkt_residual_ref, d_ref);
+  riccati_recursion_ref.computeDirection(ocp_ref, contact_sequence,
+                                         factorization_ref, d_ref);
+  // With the partial condensing.
+  RiccatiRecursion riccati_recursion(ocp, nthreads, 0.1, block_size);
+  RiccatiFactorization factorization(robot, N, max_num_impulse);
+  riccati_recursion.backwardRiccatiRecursion(ocp, kkt_matrix, kkt_residual,
+                                             factorization);
+  const auto& partial_condensing = riccati_recursion.getPartialCondensing();
+  if (robot.maxNumContacts() == 0 && partial_condensing.blockSize() > 1) {
+    EXPECT_TRUE(partial_condensing.numBlocks() > 0);
+  }
+  Direction d(robot, N, max_num_impulse);
+  dms.computeInitialStateDirection(ocp, robots, q, v, s, d);
+  riccati_recursion.forwardRiccatiRecursion(ocp, kkt_matrix, kkt_residual, d);
+  riccati_recursion.computeDirection(ocp, contact_sequence, factorization, d);
+  EXPECT_FALSE(testhelper::HasNaN(factorization));
+  const double tol = 1.0e-06;
+  const int N_stages = ocp.discrete().N();
+  for (int i=0; i<=N_stages; ++i) {
+    EXPECT_TRUE(d[i].dx.isApprox(d_ref[i].dx, tol));
+    EXPECT_TRUE(d[i].dlmdgmm.isApprox(d_ref[i].dlmdgmm, tol));
+    if (i < N_stages) {
+      EXPECT_TRUE(d[i].du.isApprox(d_ref[i].du, tol));
+      if (!partial_condensing.isBlockInterior(i)) {
+        EXPECT_TRUE(factorization[i].P.isApprox(factorization_ref[i].P, tol));
+        EXPECT_TRUE(factorization[i].s.isApprox(factorization_ref[i].s, tol));
+        EXPECT_TRUE(riccati_recursion.getLQRPolicy()[i].K.isApprox(
+                        riccati_recursion_ref.getLQRPolicy()[i].K, tol));
+        EXPECT_TRUE(riccati_recursion.getLQRPolicy()[i].k.isApprox(
+                        riccati_recursion_ref.getLQRPolicy()[i].k, tol));
+      }
+    }
+  }
+  for (int i=0; i<ocp.discrete().N_impulse(); ++i) {
+    EXPECT_TRUE(d.impulse[i].dx.isApprox(d_ref.impulse[i].dx, tol));
+    EXPECT_TRUE(d.aux[i].dx.isApprox(d_ref.aux[i].dx, tol));
+    EXPECT_TRUE(d.aux[i].du.isApprox(d_ref.aux[i].du, tol));
+  }
+  for (int i=0; i<ocp.discrete().N_lift(); ++i) {
+    EXPECT_TRUE(d.lift[i].dx.isApprox(d_ref.lift[i].dx, tol));
+    EXPECT_TRUE(d.lift[i].du.isApprox(d_ref.lift[i].du, tol));
+  }
+  EXPECT_NEAR(riccati_recursion.maxPrimalStepSize(),
+              riccati_recursion_ref.maxPrimalStepSize(), tol);
+  EXPECT_NEAR(riccati_recursion.maxDualStepSize(),
+              riccati_recursion_ref.maxDualStepSize(), tol);
+}
+
+
+TEST_P(PartialCondensingTest, defaultBlockSize) {
+  const auto robot = GetParam();
+  const int block_size = PartialCondensing::defaultBlockSize(robot);
+  EXPECT_TRUE(block_size >= 1);
+  EXPECT_TRUE(block_size*robot.dimu() >= robot.dimv());
+  EXPECT_TRUE(block_size*robot.dimu() <= 3*robot.dimv());
+}
+
+
+TEST_P(PartialCondensingTest, partition) {
+  const auto robot = GetParam();
+  test_partition(robot, 0);
+  test_partition(robot, 1);
+  test_partition(robot, 2);
+  test_partition(robot, 4);
+  test_partition(robot, N);
+}
+
+
+TEST_P(PartialCondensingTest, riccatiRecursion) {
+  const auto robot = GetParam();
+  test_riccatiRecursion(robot, 0);
+  test_riccatiRecursion(robot, 2);
+  test_riccatiRecursion(robot, 3);
+  test_riccatiRecursion(robot, N);
+}
+
+
+INSTANTIATE_TEST_SUITE_P(
+  TestWithMultipleRobots, PartialCondensingTest,
+  ::testing::Values(testhelper::CreateRobotManipulator(),
+                    testhelper::CreateRobotManipulator(std::abs(Eigen::VectorXd::Random(1)[0])),
+                    testhelper::CreateQuadrupedalRobot(),
+                    testhelper::CreateQuadrupedalRobot(std::abs(Eigen::VectorXd::Random(1)[0])),
+                    testhelper::CreateHumanoidRobot(),
+                    testhelper::CreateHumanoidRobot(std::abs(Eigen::VectorXd::Random(1)[0])))
+);
+
+} // namespace robotoc
+
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
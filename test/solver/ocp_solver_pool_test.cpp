@@ -0,0 +1,209 @@
+#include <vector>
+#include <memory>
+
+#include <gtest/gtest.h>
+
+#include "robotoc/solver/ocp_solver_pool.hpp"
+#include "robotoc/solver/ocp_solver.hpp"
+#include "robotoc/ocp/ocp.hpp"
+#include "robotoc/robot/robot.hpp"
+#include "robotoc/hybrid/contact_sequence.hpp"
+#include "robotoc/cost/cost_function.hpp"
+#include "robotoc/cost/configuration_space_cost.hpp"
+#include "robotoc/constraints/constraints.hpp"
+#include "robotoc/constraints/joint_position_lower_limit.hpp"
+#include "robotoc/constraints/joint_position_upper_limit.hpp"
+#include "robotoc/constraints/joint_velocity_lower_limit.hpp"
+#include "robotoc/constraints/joint_velocity_upper_limit.hpp"
+#include "robotoc/constraints/joint_torques_lower_limit.hpp"
+#include "robotoc/constraints/joint_torques_upper_limit.hpp"
+#include "robotoc/solver/solver_options.hpp"
+
+#include "robot_factory.hpp"
+
+
+namespace robotoc {
+
+class OCPSolverPoolTest : public ::testing::Test {
+protected:
+  virtual void SetUp() {
+    robot = testhelper::CreateRobotManipulator();
+    cost = std::make_shared<CostFunction>();
+    auto config_cost = std::make_shared<ConfigurationSpaceCost>(robot);
+    config_cost->set_q_weight(Eigen::VectorXd::Constant(robot.dimv(), 10));
+    config_cost->set_q_weight_terminal(Eigen::VectorXd::Constant(robot.dimv(), 10));
+    config_cost->set_v_weight(Eigen::VectorXd::Constant(robot.dimv(), 0.1));
+    config_cost->set_v_weight_terminal(Eigen::VectorXd::Constant(robot.dimv(), 0.1));
+    config_cost->set_a_weight(Eigen::VectorXd::Constant(robot.dimv(), 0.001));
+    cost->push_back(config_cost);
+    constraints = std::make_shared<Constraints>();
+    constraints->push_back(std::make_shared<JointPositionLowerLimit>(robot));
+    constraints->push_back(std::make_shared<JointPositionUpperLimit>(robot));
+    constraints->push_back(std::make_shared<JointVelocityLowerLimit>(robot));
+    constraints->push_back(std::make_shared<JointVelocityUpperLimit>(robot));
+    constraints->push_back(std::make_shared<JointTorquesLowerLimit>(robot));
+    constraints->push_back(std::make_shared<JointTorquesUpperLimit>(robot));
+    contact_sequence = std::make_shared<ContactSequence>(robot);
+    contact_sequence->init(robot.createContactStatus());
+    T = 0.5;
+    N = 20;
+    t = 0;
+  }
+
+  virtual void TearDown() {
+  }
+
+  OCPSolverRequest createRequest(const int N) const {
+    OCPSolverRequest request;
+    request.ocp = OCP(robot, cost, constraints, contact_sequence, T, N);
+    request.t = t;
+    request.q = robot.generateFeasibleConfiguration();
+    request.v = Eigen::VectorXd::Zero(robot.dimv());
+    return request;
+  }
+
+  Robot robot;
+  std::shared_ptr<CostFunction> cost;
+  std::shared_ptr<Constraints> constraints;
+  std::shared_ptr<ContactSequence> contact_sequence;
+  double T, t;
+  int N;
+};
+
+
+TEST_F(OCPSolverPoolTest, coldStart) {
+  const int nworkers = 2;
+  OCPSolverPool pool(nworkers);
+  EXPECT_EQ(pool.nworkers(), nworkers);
+  std::vector<OCPSolverRequest> requests;
+  for (int i=0; i<4; ++i) {
+    auto request = createRequest(N);
+    request.use_warm_start = false;
+    requests.push_back(request);
+  }
+  const auto results = pool.solve(requests);
+  ASSERT_EQ(results.size(), requests.size());
+  EXPECT_LE(pool.numSolvers(), nworkers);
+  EXPECT_EQ(pool.numPendingRequests(), 0);
+  for (int i=0; i<requests.size(); ++i) {
+    EXPECT_FALSE(results[i].warm_started);
+    OCPSolver ocp_solver(requests[i].ocp, requests[i].solver_options);
+    ocp_solver.setSolution("q", requests[i].q);
+    ocp_solver.setSolution("v", requests[i].v);
+    ocp_solver.solve(requests[i].t, requests[i].q, requests[i].v);
+    const auto& statistics = ocp_solver.getSolverStatistics();
+    EXPECT_EQ(results[i].statistics.convergence, statistics.convergence);
+    EXPECT_EQ(results[i].statistics.iter, statistics.iter);
+    EXPECT_DOUBLE_EQ(results[i].kkt_error, ocp_solver.KKTError());
+    for (int j=0; j<=N; ++j) {
+      EXPECT_TRUE(results[i].solution[j].q.isApprox(ocp_solver.getSolution(j).q));
+      EXPECT_TRUE(results[i].solution[j].v.isApprox(ocp_solver.getSolution(j).v));
+    }
+    for (int j=0; j<N; ++j) {
+      EXPECT_TRUE(results[i].solution[j].u.isApprox(ocp_solver.getSolution(j).u));
+    }
+  }
+}
+
+
+TEST_F(OCPSolverPoolTest, coldStartReusedSolver) {
+  OCPSolverPool pool(1);
+  auto request = createRequest(N);
+  request.use_warm_start = false;
+  auto request_other = createRequest(N);
+  request_other.use_warm_start = false;
+  const auto result = pool.submit(request).get();
+  pool.submit(request_other).get();
+  EXPECT_EQ(pool.numSolvers(), 1);
+  // The pooled solver is reset, so the previous request does not affect the
+  // cold start.
+  const auto result_reused = pool.submit(request).get();
+  EXPECT_EQ(result_reused.statistics.iter, result.statistics.iter);
+  EXPECT_DOUBLE_EQ(result_reused.kkt_error, result.kkt_error);
+  for (int j=0; j<N; ++j) {
+    EXPECT_TRUE(result_reused.solution[j].u.isApprox(result.solution[j].u));
+  }
+}
+
+
+TEST_F(OCPSolverPoolTest, warmStart) {
+  OCPSolverPool pool(1);
+  auto request = createRequest(N);
+  auto result = pool.submit(request).get();
+  EXPECT_TRUE(result.statistics.convergence);
+  EXPECT_FALSE(result.warm_started);
+  EXPECT_EQ(pool.numWarmStarts(), 1);
+  result = pool.submit(request).get();
+  EXPECT_TRUE(result.statistics.convergence);
+  EXPECT_TRUE(result.warm_started);
+  EXPECT_EQ(pool.numSolvers(), 1);
+  pool.clearWarmStarts();
+  EXPECT_EQ(pool.numWarmStarts(), 0);
+  result = pool.submit(request).get();
+  EXPECT_FALSE(result.warm_started);
+}
+
+
+TEST_F(OCPSolverPoolTest, warmStartFromNominal) {
+  const auto request_nominal = createRequest(N);
+  OCPSolver ocp_solver_nominal(request_nominal.ocp, 
+                               request_nominal.solver_options);
+  ocp_solver_nominal.setSolution("q", request_nominal.q);
+  ocp_solver_nominal.setSolution("v", request_nominal.v);
+  ocp_solver_nominal.solve(request_nominal.t, request_nominal.q, 
+                           request_nominal.v);
+  const Solution s_nominal = ocp_solver_nominal.getSolution();
+  const int nworkers = 2;
+  OCPSolverPool pool(nworkers);
+  pool.setWarmStart(request_nominal.ocp, s_nominal);
+  EXPECT_EQ(pool.numWarmStarts(), 1);
+  std::vector<OCPSolverRequest> requests;
+  for (int i=0; i<4; ++i) {
+    auto request = createRequest(N);
+    request.update_warm_start = false;
+    requests.push_back(request);
+  }
+  const auto results = pool.solve(requests);
+  ASSERT_EQ(results.size(), requests.size());
+  EXPECT_EQ(pool.numWarmStarts(), 1);
+  // Every request starts from the nominal solution regardless of the order 
+  // of the dispatch.
+  for (int i=0; i<requests.size(); ++i) {
+    EXPECT_TRUE(results[i].warm_started);
+    OCPSolver ocp_solver(requests[i].ocp, requests[i].solver_options);
+    ocp_solver.setSolution(s_nominal);
+    ocp_solver.solve(requests[i].t, requests[i].q, requests[i].v);
+    const auto& statistics = ocp_solver.getSolverStatistics();
+    EXPECT_EQ(results[i].statistics.convergence, statistics.convergence);
+    EXPECT_EQ(results[i].statistics.iter, statistics.iter);
+    EXPECT_DOUBLE_EQ(results[i].kkt_error, ocp_solver.KKTError());
+    for (int j=0; j<N; ++j) {
+      EXPECT_TRUE(results[i].solution[j].u.isApprox(ocp_solver.getSolution(j).u));
+    }
+  }
+}
+
+
+TEST_F(OCPSolverPoolTest, signature) {
+  const auto request = createRequest(N);
+  const auto request_other_N = createRequest(N+10);
+  EXPECT_TRUE(OCPSignature(request.ocp) == OCPSignature(createRequest(N).ocp));
+  EXPECT_FALSE(OCPSignature(request.ocp) == OCPSignature(request_other_N.ocp));
+  OCPSolverPool pool(1);
+  pool.reserve(request.ocp, 1);
+  EXPECT_EQ(pool.numSolvers(), 1);
+  pool.submit(request).get();
+  EXPECT_EQ(pool.numSolvers(), 1);
+  pool.submit(request_other_N).get();
+  EXPECT_EQ(pool.numSolvers(), 2);
+  pool.submit(request_other_N).get();
+  EXPECT_EQ(pool.numSolvers(), 2);
+}
+
+} // namespace robotoc
+
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -2,6 +2,9 @@
 
 #include <gtest/gtest.h>
 
+#include "Eigen/Core"
+#include "Eigen/Geometry"
+
 #include "robotoc/solver/ocp_solver.hpp"
 #include "robotoc/ocp/ocp.hpp"
 #include "robotoc/robot/robot.hpp"
@@ -133,9 +136,176 @@ TEST_F(OCPSolverTest, test) {
   contact_sequence->push_back(contact_status_flying, 0.2);
 
   ocp_solver.initConstraints(t);
+  const auto q_sol = ocp_solver.getSolution("q");
+  for (const auto& e : q_sol) {
+    EXPECT_TRUE(e.isApprox(q));
+  }
+  const auto f_sol = ocp_solver.getSolution("f");
+  EXPECT_EQ(f_sol.size()+1, q_sol.size());
   ocp_solver.solve(t, q, v);
   const auto result = ocp_solver.getSolverStatistics();
   EXPECT_TRUE(result.convergence);
+  // The components of the KKT error are recorded at the last iteration.
+  const double kkt_error_squared 
+      = result.kkt_error_dynamics * result.kkt_error_dynamics 
+          + result.kkt_error_constraints * result.kkt_error_constraints 
+          + result.kkt_error_complementarity * result.kkt_error_complementarity 
+          + result.kkt_error_sto * result.kkt_error_sto;
+  EXPECT_NEAR(std::sqrt(kkt_error_squared), result.kkt_error.back(), 1.0e-08);
+  EXPECT_DOUBLE_EQ(ocp_solver.KKTError(), result.kkt_error.back());
+}
+
+
+
+TEST_F(OCPSolverTest, extrapolateSolutionPeriodic) {
+  const double baumgarte_time_step = 0.5 / 20;
+  auto robot = testhelper::CreateQuadrupedalRobot(baumgarte_time_step);
+  auto cost = std::make_shared<robotoc::CostFunction>();
+  auto config_cost = std::make_shared<robotoc::ConfigurationSpaceCost>(robot);
+  config_cost->set_q_weight(Eigen::VectorXd::Constant(robot.dimv(), 10));
+  config_cost->set_v_weight(Eigen::VectorXd::Constant(robot.dimv(), 1));
+  cost->push_back(config_cost);
+  auto constraints = std::make_shared<robotoc::Constraints>();
+  Eigen::VectorXd q_standing(robot.dimq());
+  q_standing << 0, 0, 0.4792, 0, 0, 0, 1, 
+                -0.1,  0.7, -1.0, 
+                -0.1, -0.7,  1.0, 
+                 0.1,  0.7, -1.0, 
+                 0.1, -0.7,  1.0;
+  // A periodic gait of two contact phases.
+  auto contact_sequence = std::make_shared<robotoc::ContactSequence>(robot);
+  auto contact_status_standing = robot.createContactStatus();
+  contact_status_standing.activateContacts({0, 1, 2, 3});
+  const auto contact_status_flying = robot.createContactStatus();
+  contact_sequence->init(contact_status_standing);
+  contact_sequence->push_back(contact_status_flying, 0.11);
+  contact_sequence->push_back(contact_status_standing, 0.21);
+  contact_sequence->push_back(contact_status_flying, 0.31);
+  contact_sequence->push_back(contact_status_standing, 0.41);
+  const double T = 0.5;
+  const int N = 20;
+  robotoc::OCP ocp(robot, cost, constraints, contact_sequence, T, N);
+  robotoc::OCPSolver ocp_solver(ocp, robotoc::SolverOptions::defaultOptions());
+  const double t = 0;
+  ocp_solver.setSolution("q", q_standing);
+  ocp_solver.initConstraints(t);
+  const double yaw = 0.1;
+  const Eigen::Matrix3d R 
+      = Eigen::AngleAxisd(yaw, Eigen::Vector3d::UnitZ()).toRotationMatrix();
+  const Eigen::Vector3d p = {0.2, 0.1, 0};
+  ocp_solver.extrapolateSolutionPeriodic(t, 2, R, p);
+  // The stages of the initial phase are not changed.
+  EXPECT_TRUE(ocp_solver.getSolution(0).q.isApprox(q_standing));
+  // The stages of the last phase are displaced.
+  Eigen::VectorXd q_ref = q_standing;
+  q_ref.head<3>() = R * q_standing.head<3>() + p;
+  q_ref.segment<4>(3) = Eigen::Quaterniond(R).coeffs();
+  EXPECT_TRUE(ocp_solver.getSolution(N).q.isApprox(q_ref));
+  EXPECT_TRUE(ocp_solver.getSolution(N).v.isApprox(ocp_solver.getSolution(0).v));
+}
+
+
+TEST_F(OCPSolverTest, stageWeightedConvergence) {
+  const double baumgarte_time_step = 0.5 / 20;
+  auto robot = testhelper::CreateQuadrupedalRobot(baumgarte_time_step);
+  auto cost = std::make_shared<robotoc::CostFunction>();
+  auto config_cost = std::make_shared<robotoc::ConfigurationSpaceCost>(robot);
+  config_cost->set_q_weight(Eigen::VectorXd::Constant(robot.dimv(), 10));
+  config_cost->set_v_weight(Eigen::VectorXd::Constant(robot.dimv(), 1));
+  cost->push_back(config_cost);
+  auto constraints = std::make_shared<robotoc::Constraints>();
+  Eigen::VectorXd q_standing(robot.dimq());
+  q_standing << 0, 0, 0.4792, 0, 0, 0, 1, 
+                -0.1,  0.7, -1.0, 
+                -0.1, -0.7,  1.0, 
+                 0.1,  0.7, -1.0, 
+                 0.1, -0.7,  1.0;
+  const Eigen::VectorXd v_standing = Eigen::VectorXd::Zero(robot.dimv());
+  auto contact_sequence = std::make_shared<robotoc::ContactSequence>(robot);
+  auto contact_status_standing = robot.createContactStatus();
+  contact_status_standing.activateContacts({0, 1, 2, 3});
+  const auto contact_status_flying = robot.createContactStatus();
+  contact_sequence->init(contact_status_standing);
+  contact_sequence->push_back(contact_status_flying, 0.21);
+  contact_sequence->push_back(contact_status_standing, 0.31);
+  const double T = 0.5;
+  const int N = 20;
+  robotoc::OCP ocp(robot, cost, constraints, contact_sequence, T, N);
+  const double t = 0;
+  auto solver_options = robotoc::SolverOptions::defaultOptions();
+  solver_options.max_iter = 10;
+  solver_options.kkt_tol = 1.0e-14;
+  robotoc::OCPSolver ocp_solver(ocp, solver_options);
+  ocp_solver.setSolution("q", q_standing);
+  ocp_solver.solve(t, q_standing, v_standing);
+  const int iter_default = ocp_solver.getSolverStatistics().iter;
+  EXPECT_EQ(ocp_solver.getSolverStatistics().kkt_error_leading, 0.0);
+  EXPECT_EQ(ocp_solver.getSolverStatistics().kkt_error_tail, 0.0);
+
+  solver_options.num_leading_stages = 5;
+  solver_options.kkt_tol_leading = 1.0e-04;
+  solver_options.kkt_tol_tail = 1.0e+03;
+  ocp_solver.setSolverOptions(solver_options);
+  ocp_solver.setSolution("q", q_standing);
+  ocp_solver.solve(t, q_standing, v_standing);
+  const auto& statistics = ocp_solver.getSolverStatistics();
+  EXPECT_TRUE(statistics.convergence);
+  EXPECT_LE(statistics.iter, iter_default);
+  EXPECT_LT(statistics.kkt_error_leading, solver_options.kkt_tol_leading);
+  const double kkt_error = statistics.kkt_error.back();
+  EXPECT_NEAR(statistics.kkt_error_leading*statistics.kkt_error_leading
+                + statistics.kkt_error_tail*statistics.kkt_error_tail,
+              kkt_error*kkt_error, 1.0e-08);
+
+  // The first-input stagnation test.
+  solver_options.num_leading_stages = 0;
+  solver_options.initial_input_tol = 1.0e+03;
+  ocp_solver.setSolverOptions(solver_options);
+  ocp_solver.setSolution("q", q_standing);
+  ocp_solver.solve(t, q_standing, v_standing);
+  EXPECT_TRUE(ocp_solver.getSolverStatistics().convergence);
+  EXPECT_EQ(ocp_solver.getSolverStatistics().iter, 1);
+}
+
+TEST_F(OCPSolverTest, initialInputStagnationAfterTruncatedStep) {
+  auto robot = testhelper::CreateRobotManipulator();
+  auto cost = std::make_shared<robotoc::CostFunction>();
+  auto config_cost = std::make_shared<robotoc::ConfigurationSpaceCost>(robot);
+  // The reference lies beyond the joint position limits so that the first 
+  // step is truncated by the fraction-to-boundary rule.
+  const Eigen::VectorXd q_ref 
+      = robot.upperJointPositionLimit() + Eigen::VectorXd::Constant(robot.dimq(), 1.0);
+  config_cost->set_q_ref(q_ref);
+  config_cost->set_q_weight(Eigen::VectorXd::Constant(robot.dimv(), 100));
+  config_cost->set_q_weight_terminal(Eigen::VectorXd::Constant(robot.dimv(), 100));
+  config_cost->set_u_weight(Eigen::VectorXd::Constant(robot.dimu(), 1.0e-06));
+  cost->push_back(config_cost);
+  auto constraints = std::make_shared<robotoc::Constraints>();
+  constraints->push_back(std::make_shared<robotoc::JointPositionLowerLimit>(robot));
+  constraints->push_back(std::make_shared<robotoc::JointPositionUpperLimit>(robot));
+  const double T = 0.5;
+  const int N = 20;
+  auto contact_sequence = std::make_shared<robotoc::ContactSequence>(robot);
+  contact_sequence->init(robot.createContactStatus());
+  robotoc::OCP ocp(robot, cost, constraints, contact_sequence, T, N);
+  const double t = 0;
+  const Eigen::VectorXd q = Eigen::VectorXd::Zero(robot.dimq());
+  const Eigen::VectorXd v = Eigen::VectorXd::Zero(robot.dimv());
+  auto solver_options = robotoc::SolverOptions::defaultOptions();
+  solver_options.max_iter = 20;
+  solver_options.kkt_tol = 1.0e-14;
+  solver_options.initial_input_tol = 1.0e+03;
+  robotoc::OCPSolver ocp_solver(ocp, solver_options);
+  ocp_solver.setSolution("q", q);
+  ocp_solver.solve(t, q, v);
+  const auto& statistics = ocp_solver.getSolverStatistics();
+  ASSERT_LT(statistics.primal_step_size.front(), 1.0);
+  // The small input update after the truncated step is not regarded as 
+  // the convergence.
+  EXPECT_GT(statistics.iter, 1);
+  if (statistics.convergence) {
+    EXPECT_EQ(statistics.primal_step_size[statistics.iter-1], 1.0);
+  }
 }
 
 } // namespace robotoc
@@ -0,0 +1,147 @@
+#include <vector>
+#include <string>
+#include <cstdio>
+#include <fstream>
+
+#include <gtest/gtest.h>
+
+#include "robotoc/solver/solver_autotuner.hpp"
+#include "robotoc/ocp/ocp.hpp"
+#include "robotoc/robot/robot.hpp"
+#include "robotoc/hybrid/contact_sequence.hpp"
+#include "robotoc/cost/cost_function.hpp"
+#include "robotoc/cost/configuration_space_cost.hpp"
+#include "robotoc/constraints/constraints.hpp"
+#include "robotoc/constraints/joint_position_lower_limit.hpp"
+#include "robotoc/constraints/joint_position_upper_limit.hpp"
+#include "robotoc/constraints/joint_velocity_lower_limit.hpp"
+#include "robotoc/constraints/joint_velocity_upper_limit.hpp"
+#include "robotoc/solver/solver_options.hpp"
+
+#include "robot_factory.hpp"
+
+
+namespace robotoc {
+
+class SolverAutotunerTest : public ::testing::Test {
+protected:
+  virtual void SetUp() {
+    cache_file = "solver_autotuner_test_cache.txt";
+    std::remove(cache_file.c_str());
+  }
+
+  virtual void TearDown() {
+    std::remove(cache_file.c_str());
+  }
+
+  static OCP createOCP(const Robot& robot, const int N);
+
+  std::string cache_file;
+};
+
+
+OCP SolverAutotunerTest::createOCP(const Robot& robot, const int N) {
+  auto cost = std::make_shared<CostFunction>();
+  auto config_cost = std::make_shared<ConfigurationSpaceCost>(robot);
+  Eigen::VectorXd q_ref(Eigen::VectorXd::Zero(robot.dimq()));
+  q_ref << 0, M_PI_2, 0, M_PI_2, 0, M_PI_2, 0;
+  config_cost->set_q_ref(q_ref);
+  config_cost->set_q_weight(Eigen::VectorXd::Constant(robot.dimv(), 10));
+  config_cost->set_q_weight_terminal(Eigen::VectorXd::Constant(robot.dimv(), 10));
+  config_cost->set_v_weight(Eigen::VectorXd::Constant(robot.dimv(), 0.01));
+  config_cost->set_a_weight(Eigen::VectorXd::Constant(robot.dimv(), 0.01));
+  cost->push_back(config_cost);
+  auto constraints = std::make_shared<Constraints>();
+  constraints->push_back(std::make_shared<JointPositionLowerLimit>(robot));
+  constraints->push_back(std::make_shared<JointPositionUpperLimit>(robot));
+  constraints->push_back(std::make_shared<JointVelocityLowerLimit>(robot));
+  constraints->push_back(std::make_shared<JointVelocityUpperLimit>(robot));
+  auto contact_sequence = std::make_shared<ContactSequence>(robot);
+  contact_sequence->init(robot.createContactStatus());
+  const double T = 1;
+  return OCP(robot, cost, constraints, contact_sequence, T, N);
+}
+
+
+TEST_F(SolverAutotunerTest, tune) {
+  auto robot = testhelper::CreateRobotManipulator();
+  const int N = 20;
+  const auto ocp = createOCP(robot, N);
+  const double t = 0;
+  const Eigen::VectorXd q = Eigen::VectorXd::Zero(robot.dimq());
+  const Eigen::VectorXd v = Eigen::VectorXd::Zero(robot.dimv());
+  const int max_threads = 4;
+  SolverAutotuner autotuner(cache_file, max_threads, 1, 2);
+  const int nthreads = autotuner.tune(ocp, SolverOptions::defaultOptions(), t, q, v);
+  EXPECT_FALSE(autotuner.isCached());
+  EXPECT_EQ(nthreads, autotuner.nthreads());
+  EXPECT_GE(nthreads, 1);
+  EXPECT_LE(nthreads, max_threads);
+  const std::vector<int> candidates = {1, 2, 4};
+  EXPECT_EQ(autotuner.candidateNumThreads(), candidates);
+  EXPECT_EQ(autotuner.cpuTimes().size(), candidates.size());
+  for (const auto e : autotuner.cpuTimes()) {
+    EXPECT_TRUE(e > 0);
+  }
+  // The second call reads the cache.
+  SolverAutotuner other(cache_file, max_threads, 1, 2);
+  EXPECT_EQ(other.tune(ocp, SolverOptions::defaultOptions(), t, q, v), nthreads);
+  EXPECT_TRUE(other.isCached());
+  EXPECT_TRUE(other.cpuTimes().empty());
+  // Different problem signature is not cached.
+  const auto ocp_other = createOCP(robot, N+1);
+  EXPECT_NE(SolverAutotuner::problemSignature(ocp),
+            SolverAutotuner::problemSignature(ocp_other));
+  other.tune(ocp_other, SolverOptions::defaultOptions(), t, q, v);
+  EXPECT_FALSE(other.isCached());
+}
+
+
+TEST_F(SolverAutotunerTest, corruptedCache) {
+  auto robot = testhelper::CreateRobotManipulator();
+  const auto ocp = createOCP(robot, 10);
+  const double t = 0;
+  const Eigen::VectorXd q = Eigen::VectorXd::Zero(robot.dimq());
+  const Eigen::VectorXd v = Eigen::VectorXd::Zero(robot.dimv());
+  const std::string key = SolverAutotuner::machineSignature() + ";" 
+                            + SolverAutotuner::problemSignature(ocp);
+  const std::vector<std::string> corrupted_values 
+      = {"abc", "99999999999999999999", "0", "-2", "2x", ""};
+  for (const auto& e : corrupted_values) {
+    std::remove(cache_file.c_str());
+    std::ofstream ofs(cache_file);
+    ofs << key << " " << e << '\n';
+    ofs.close();
+    SolverAutotuner autotuner(cache_file, 2, 1, 1);
+    const int nthreads = autotuner.tune(ocp, SolverOptions::defaultOptions(), t, q, v);
+    EXPECT_FALSE(autotuner.isCached());
+    EXPECT_GE(nthreads, 1);
+    // The calibrated entry overrides the corrupted one.
+    SolverAutotuner other(cache_file, 2, 1, 1);
+    EXPECT_EQ(other.tune(ocp, SolverOptions::defaultOptions(), t, q, v), nthreads);
+    EXPECT_TRUE(other.isCached());
+  }
+}
+
+
+TEST_F(SolverAutotunerTest, noCache) {
+  auto robot = testhelper::CreateRobotManipulator();
+  const auto ocp = createOCP(robot, 10);
+  const double t = 0;
+  const Eigen::VectorXd q = Eigen::VectorXd::Zero(robot.dimq());
+  const Eigen::VectorXd v = Eigen::VectorXd::Zero(robot.dimv());
+  SolverAutotuner autotuner("", 2, 1, 1);
+  autotuner.tune(ocp, SolverOptions::defaultOptions(), t, q, v);
+  EXPECT_FALSE(autotuner.isCached());
+  autotuner.tune(ocp, SolverOptions::defaultOptions(), t, q, v);
+  EXPECT_FALSE(autotuner.isCached());
+  EXPECT_FALSE(SolverAutotuner::machineSignature().empty());
+}
+
+} // namespace robotoc
+
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
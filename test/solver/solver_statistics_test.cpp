@@ -1,8 +1,12 @@
 #include <vector>
+#include <cmath>
+#include <string>
+#include <sstream>
 
 #include <gtest/gtest.h>
 
 #include "robotoc/solver/solver_statistics.hpp"
+#include "robotoc/utils/performance_counter.hpp"
 
 
 namespace robotoc {
@@ -24,6 +28,59 @@ TEST_F(SolverStatisticsTest, cout) {
   );
 }
 
+
+TEST_F(SolverStatisticsTest, kktErrorComponents) {
+  SolverStatistics statistics;
+  std::stringstream ss;
+  statistics.disp(ss);
+  EXPECT_EQ(ss.str().find("dynamics ="), std::string::npos);
+  statistics.kkt_error_dynamics = 1.0;
+  ss.str("");
+  statistics.disp(ss);
+  EXPECT_NE(ss.str().find("dynamics ="), std::string::npos);
+  statistics.clear();
+  ss.str("");
+  statistics.disp(ss);
+  EXPECT_EQ(ss.str().find("dynamics ="), std::string::npos);
+}
+
+
+TEST_F(SolverStatisticsTest, performanceCounts) {
+  const int nthreads = 2;
+  PerformanceCounter performance_counter(nthreads);
+  EXPECT_FALSE(performance_counter.isOpen());
+  const bool available = performance_counter.open();
+  EXPECT_TRUE(performance_counter.isOpen());
+  EXPECT_EQ(performance_counter.isAvailable(), available);
+  double sum = 0;
+  performance_counter.start();
+  for (int i=0; i<100000; ++i) { sum += std::sqrt(static_cast<double>(i)); }
+  performance_counter.stop(SolverPhase::BackwardRiccati);
+  EXPECT_TRUE(sum > 0);
+  EXPECT_TRUE(performance_counter.cpuTime(SolverPhase::BackwardRiccati) > 0);
+  EXPECT_DOUBLE_EQ(performance_counter.cpuTime(SolverPhase::KKTSystem), 0);
+  EXPECT_EQ(performance_counter.counts(SolverPhase::BackwardRiccati).size(), nthreads);
+  if (available) {
+    EXPECT_TRUE(performance_counter.counts(SolverPhase::BackwardRiccati)[0].instructions > 0);
+  }
+  SolverStatistics statistics;
+  statistics.setPerformanceCounts(performance_counter);
+  EXPECT_EQ(statistics.phase_cpu_time.size(), kNumSolverPhases);
+  EXPECT_EQ(statistics.performance_counts.size(), kNumSolverPhases);
+  EXPECT_EQ(statistics.performance_counter_available, available);
+  EXPECT_NO_THROW(
+    std::cout << statistics << std::endl;
+  );
+  statistics.clear();
+  EXPECT_TRUE(statistics.phase_cpu_time.empty());
+  performance_counter.reset();
+  EXPECT_DOUBLE_EQ(performance_counter.cpuTime(SolverPhase::BackwardRiccati), 0);
+  const auto copy = performance_counter;
+  EXPECT_FALSE(copy.isOpen());
+  performance_counter.close();
+  EXPECT_FALSE(performance_counter.isOpen());
+}
+
 } // namespace robotoc
 
 
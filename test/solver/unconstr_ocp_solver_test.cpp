@@ -90,6 +90,154 @@ TEST_F(UnconstrOCPSolverTest, test) {
   EXPECT_TRUE(result.convergence);
 }
 
+
+TEST_F(UnconstrOCPSolverTest, nonlinearRollout) {
+  auto robot = testhelper::CreateRobotManipulator();
+  auto cost = std::make_shared<robotoc::CostFunction>();
+  auto config_cost = std::make_shared<robotoc::ConfigurationSpaceCost>(robot);
+  Eigen::VectorXd q_ref(Eigen::VectorXd::Zero(robot.dimq()));
+  q_ref << 0, M_PI_2, 0, M_PI_2, 0, M_PI_2, 0;
+  config_cost->set_q_ref(q_ref);
+  config_cost->set_q_weight(Eigen::VectorXd::Constant(robot.dimv(), 10));
+  config_cost->set_q_weight_terminal(Eigen::VectorXd::Constant(robot.dimv(), 10));
+  config_cost->set_v_weight(Eigen::VectorXd::Constant(robot.dimv(), 0.01));
+  config_cost->set_v_weight_terminal(Eigen::VectorXd::Constant(robot.dimv(), 0.01));
+  config_cost->set_a_weight(Eigen::VectorXd::Constant(robot.dimv(), 0.01));
+  cost->push_back(config_cost);
+  auto constraints = std::make_shared<robotoc::Constraints>();
+  const double T = 1;
+  const int N = 20;
+  robotoc::UnconstrOCP ocp(robot, cost, constraints, T, N);
+  auto solver_options = robotoc::SolverOptions::defaultOptions();
+  solver_options.forward_pass_method = robotoc::ForwardPassMethod::NonlinearRollout;
+  robotoc::UnconstrOCPSolver ocp_solver(ocp, solver_options);
+  const double t = 0;
+  Eigen::VectorXd q(Eigen::VectorXd::Zero(robot.dimq()));
+  q << M_PI_2, 0, M_PI_2, 0, M_PI_2, 0, M_PI_2;
+  const Eigen::VectorXd v = Eigen::VectorXd::Zero(robot.dimv());
+  ocp_solver.setSolution("q", q);
+  ocp_solver.setSolution("v", v);
+  ocp_solver.initConstraints();
+  auto ocp_solver_linear = ocp_solver;
+  auto solver_options_linear = solver_options;
+  solver_options_linear.forward_pass_method = robotoc::ForwardPassMethod::LinearStep;
+  ocp_solver_linear.setSolverOptions(solver_options_linear);
+  ocp_solver.updateSolution(t, q, v);
+  ocp_solver_linear.updateSolution(t, q, v);
+  // The control input satisfies the inverse dynamics at every iterate unless 
+  // the rollout is discarded by the merit check.
+  const bool rolled_out 
+      = !ocp_solver.getSolution(N).q.isApprox(ocp_solver_linear.getSolution(N).q);
+  Eigen::VectorXd u(Eigen::VectorXd::Zero(robot.dimu()));
+  for (int i=0; i<N; ++i) {
+    const auto& s = ocp_solver.getSolution(i);
+    if (rolled_out) {
+      robot.RNEA(s.q, s.v, s.a, u);
+      EXPECT_TRUE(s.u.isApprox(u));
+    }
+    else {
+      EXPECT_TRUE(s.isApprox(ocp_solver_linear.getSolution(i)));
+    }
+  }
+  ocp_solver.solve(t, q, v);
+  EXPECT_TRUE(ocp_solver.getSolverStatistics().convergence);
+}
+
+
+TEST_F(UnconstrOCPSolverTest, shiftSolution) {
+  auto robot = testhelper::CreateRobotManipulator();
+  auto cost = std::make_shared<robotoc::CostFunction>();
+  auto config_cost = std::make_shared<robotoc::ConfigurationSpaceCost>(robot);
+  Eigen::VectorXd q_ref(Eigen::VectorXd::Zero(robot.dimq()));
+  q_ref << 0, M_PI_2, 0, M_PI_2, 0, M_PI_2, 0;
+  config_cost->set_q_ref(q_ref);
+  config_cost->set_q_weight(Eigen::VectorXd::Constant(robot.dimv(), 10));
+  config_cost->set_q_weight_terminal(Eigen::VectorXd::Constant(robot.dimv(), 10));
+  config_cost->set_v_weight(Eigen::VectorXd::Constant(robot.dimv(), 0.01));
+  config_cost->set_v_weight_terminal(Eigen::VectorXd::Constant(robot.dimv(), 0.01));
+  config_cost->set_a_weight(Eigen::VectorXd::Constant(robot.dimv(), 0.01));
+  cost->push_back(config_cost);
+  auto constraints = std::make_shared<robotoc::Constraints>();
+  const double T = 1;
+  const int N = 20;
+  const double dt = T / N;
+  robotoc::UnconstrOCP ocp(robot, cost, constraints, T, N);
+  robotoc::UnconstrOCPSolver ocp_solver(ocp);
+  const double t = 0;
+  Eigen::VectorXd q(Eigen::VectorXd::Zero(robot.dimq()));
+  q << M_PI_2, 0, M_PI_2, 0, M_PI_2, 0, M_PI_2;
+  const Eigen::VectorXd v = Eigen::VectorXd::Zero(robot.dimv());
+  ocp_solver.setSolution("q", q);
+  ocp_solver.setSolution("v", v);
+  ocp_solver.solve(t, q, v);
+  const auto q_prev = ocp_solver.getSolution("q");
+  const auto u_prev = ocp_solver.getSolution("u");
+  // Shift by a fraction of the time step.
+  const double r = 0.3;
+  ocp_solver.shiftSolution(r*dt);
+  for (int i=0; i<N; ++i) {
+    EXPECT_TRUE(ocp_solver.getSolution(i).q.isApprox((1.0-r)*q_prev[i]+r*q_prev[i+1]));
+  }
+  EXPECT_TRUE(ocp_solver.getSolution(N).q.isApprox(q_prev[N]));
+  for (int i=0; i<N-1; ++i) {
+    EXPECT_TRUE(ocp_solver.getSolution(i).u.isApprox((1.0-r)*u_prev[i]+r*u_prev[i+1]));
+  }
+  // Shift beyond the horizon.
+  ocp_solver.shiftSolution(2*T);
+  for (int i=0; i<N; ++i) {
+    EXPECT_TRUE(ocp_solver.getSolution(i).q.isApprox(q_prev[N]));
+  }
+}
+
+
+TEST_F(UnconstrOCPSolverTest, shiftSolutionWithConstraints) {
+  auto robot = testhelper::CreateRobotManipulator();
+  auto cost = std::make_shared<robotoc::CostFunction>();
+  auto config_cost = std::make_shared<robotoc::ConfigurationSpaceCost>(robot);
+  Eigen::VectorXd q_ref(Eigen::VectorXd::Zero(robot.dimq()));
+  q_ref << 0, M_PI_2, 0, M_PI_2, 0, M_PI_2, 0;
+  config_cost->set_q_ref(q_ref);
+  config_cost->set_q_weight(Eigen::VectorXd::Constant(robot.dimv(), 10));
+  config_cost->set_q_weight_terminal(Eigen::VectorXd::Constant(robot.dimv(), 10));
+  config_cost->set_v_weight(Eigen::VectorXd::Constant(robot.dimv(), 0.01));
+  config_cost->set_v_weight_terminal(Eigen::VectorXd::Constant(robot.dimv(), 0.01));
+  config_cost->set_a_weight(Eigen::VectorXd::Constant(robot.dimv(), 0.01));
+  cost->push_back(config_cost);
+  auto constraints = std::make_shared<robotoc::Constraints>();
+  constraints->push_back(std::make_shared<robotoc::JointPositionLowerLimit>(robot));
+  constraints->push_back(std::make_shared<robotoc::JointPositionUpperLimit>(robot));
+  constraints->push_back(std::make_shared<robotoc::JointVelocityLowerLimit>(robot));
+  constraints->push_back(std::make_shared<robotoc::JointVelocityUpperLimit>(robot));
+  const double T = 1;
+  const int N = 20;
+  const double dt = T / N;
+  robotoc::UnconstrOCP ocp(robot, cost, constraints, T, N);
+  auto solver_options = robotoc::SolverOptions::defaultOptions();
+  solver_options.max_iter = 5;
+  robotoc::UnconstrOCPSolver ocp_solver(ocp, solver_options);
+  const double t = 0;
+  Eigen::VectorXd q(Eigen::VectorXd::Zero(robot.dimq()));
+  q << M_PI_2, 0, M_PI_2, 0, M_PI_2, 0, M_PI_2;
+  const Eigen::VectorXd v = Eigen::VectorXd::Zero(robot.dimv());
+  ocp_solver.setSolution("q", q);
+  ocp_solver.setSolution("v", v);
+  ocp_solver.solve(t, q, v);
+  ocp_solver.shiftSolution(0.3*dt);
+  // The warm start after the shift is the same as the solve with the 
+  // initialization of the constraints from the shifted solution.
+  auto ocp_solver_ref = ocp_solver;
+  const Eigen::VectorXd q_next = ocp_solver.getSolution(0).q;
+  const Eigen::VectorXd v_next = ocp_solver.getSolution(0).v;
+  ocp_solver.solve(t+0.3*dt, q_next, v_next, false);
+  ocp_solver_ref.solve(t+0.3*dt, q_next, v_next, true);
+  const auto& kkt_error = ocp_solver.getSolverStatistics().kkt_error;
+  const auto& kkt_error_ref = ocp_solver_ref.getSolverStatistics().kkt_error;
+  ASSERT_EQ(kkt_error.size(), kkt_error_ref.size());
+  for (int i=0; i<kkt_error.size(); ++i) {
+    EXPECT_DOUBLE_EQ(kkt_error[i], kkt_error_ref[i]);
+  }
+}
+
 } // namespace robotoc
 
 
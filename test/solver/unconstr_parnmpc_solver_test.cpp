@@ -88,6 +88,45 @@ TEST_F(UnconstrParNMPCSolverTest, test) {
   ocp_solver.solve(t, q, v);
   const auto result = ocp_solver.getSolverStatistics();
   EXPECT_TRUE(result.convergence);
+
+  // Solves the ParNMPC with the different initialization of the auxiliary 
+  // matrices.
+  const std::vector<AuxMatInitialization> aux_mat_initializations 
+      = {AuxMatInitialization::TerminalCostHessian, 
+         AuxMatInitialization::TerminalLQR,
+         AuxMatInitialization::Riccati,
+         AuxMatInitialization::Shift};
+  for (const auto aux_mat_initialization : aux_mat_initializations) {
+    solver_options.aux_mat_initialization = aux_mat_initialization;
+    robotoc::UnconstrParNMPCSolver other_solver(ocp, solver_options, nthreads);
+    other_solver.setSolution("q", q);
+    other_solver.setSolution("v", v);
+    other_solver.initConstraints();
+    other_solver.solve(t, q, v);
+    EXPECT_TRUE(other_solver.getSolverStatistics().convergence);
+    // Warm-started solve after the horizon moves forward.
+    const double dt = T / N;
+    other_solver.solve(t+dt, other_solver.getSolution(0).q, 
+                       other_solver.getSolution(0).v);
+    EXPECT_TRUE(other_solver.getSolverStatistics().convergence);
+    // Warm-started solve without the initialization of the solver, in which 
+    // only AuxMatInitialization::Shift updates the auxiliary matrices.
+    other_solver.solve(t+2*dt, other_solver.getSolution(0).q, 
+                       other_solver.getSolution(0).v, false);
+    EXPECT_TRUE(other_solver.getSolverStatistics().convergence);
+  }
+  solver_options.aux_mat_initialization = AuxMatInitialization::TerminalCostHessian;
+
+  // Solves the ParNMPC with the block-granular backward correction.
+  for (const int num_blocks : {1, 3, N}) {
+    solver_options.num_blocks_parnmpc = num_blocks;
+    robotoc::UnconstrParNMPCSolver other_solver(ocp, solver_options, nthreads);
+    other_solver.setSolution("q", q);
+    other_solver.setSolution("v", v);
+    other_solver.initConstraints();
+    other_solver.solve(t, q, v);
+    EXPECT_TRUE(other_solver.getSolverStatistics().convergence);
+  }
 }
 
 } // namespace robotoc